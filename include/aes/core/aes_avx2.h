@@ -0,0 +1,132 @@
+/**
+ * @file aes/core/aes_avx2.h
+ * @brief AES-NI multi-block kernels compiled for AVX2 (VEX encoding).
+ *
+ * These kernels run the same 8-way interleaved AES-NI round sequence as the
+ * kernels of aes_encrypt.h and aes_decrypt.h, but are compiled with the AVX2
+ * target so that they use the non-destructive 3-operand VEX forms (`vaesenc`
+ * on xmm registers) and avoid SSE/AVX transition penalties on AVX2 machines
+ * without VAES.
+ *
+ * They must only be called after checking that the running CPU supports AVX2
+ * and AES-NI (see aes_cpu.h).
+ */
+
+#ifndef AES_AVX2_H
+#define AES_AVX2_H
+
+#include "aes/core/aes_constants.h"
+#include <stddef.h>
+#include <emmintrin.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Encrypts num_blocks independent blocks using AES-128 (AVX2 build).
+ *
+ * @param plaintext Array of num_blocks input blocks (may be unaligned).
+ * @param ciphertext Output array receiving num_blocks encrypted blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to process.
+ * @param enc_round_keys Array of 11 encryption round keys.
+ */
+void aes128_encrypt_blocks_avx2(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks independent blocks using AES-192 (AVX2 build).
+ *
+ * @param plaintext Array of num_blocks input blocks (may be unaligned).
+ * @param ciphertext Output array receiving num_blocks encrypted blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to process.
+ * @param enc_round_keys Array of 13 encryption round keys.
+ */
+void aes192_encrypt_blocks_avx2(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks independent blocks using AES-256 (AVX2 build).
+ *
+ * @param plaintext Array of num_blocks input blocks (may be unaligned).
+ * @param ciphertext Output array receiving num_blocks encrypted blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to process.
+ * @param enc_round_keys Array of 15 encryption round keys.
+ */
+void aes256_encrypt_blocks_avx2(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts num_blocks independent blocks using AES-128 (AVX2 build).
+ *
+ * @param ciphertext Array of num_blocks input blocks (may be unaligned).
+ * @param plaintext Output array receiving num_blocks decrypted blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to process.
+ * @param dec_round_keys Array of 11 decryption round keys.
+ */
+void aes128_decrypt_blocks_avx2(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts num_blocks independent blocks using AES-192 (AVX2 build).
+ *
+ * @param ciphertext Array of num_blocks input blocks (may be unaligned).
+ * @param plaintext Output array receiving num_blocks decrypted blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to process.
+ * @param dec_round_keys Array of 13 decryption round keys.
+ */
+void aes192_decrypt_blocks_avx2(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts num_blocks independent blocks using AES-256 (AVX2 build).
+ *
+ * @param ciphertext Array of num_blocks input blocks (may be unaligned).
+ * @param plaintext Output array receiving num_blocks decrypted blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to process.
+ * @param dec_round_keys Array of 15 decryption round keys.
+ */
+void aes256_decrypt_blocks_avx2(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_256_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks whole blocks in CTR mode using AES-128 (AVX2 build).
+ *
+ * Each input block is XORed with the encryption of the current counter, which
+ * is then incremented as a 128-bit big-endian integer.
+ *
+ * @param input Array of num_blocks input blocks (may be unaligned).
+ * @param output Output array receiving num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks on return.
+ * @param enc_round_keys Array of 11 encryption round keys.
+ */
+void aes128_ctr_blocks_avx2(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks whole blocks in CTR mode using AES-192 (AVX2 build).
+ *
+ * Each input block is XORed with the encryption of the current counter, which
+ * is then incremented as a 128-bit big-endian integer.
+ *
+ * @param input Array of num_blocks input blocks (may be unaligned).
+ * @param output Output array receiving num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks on return.
+ * @param enc_round_keys Array of 13 encryption round keys.
+ */
+void aes192_ctr_blocks_avx2(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks whole blocks in CTR mode using AES-256 (AVX2 build).
+ *
+ * Each input block is XORed with the encryption of the current counter, which
+ * is then incremented as a 128-bit big-endian integer.
+ *
+ * @param input Array of num_blocks input blocks (may be unaligned).
+ * @param output Output array receiving num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks on return.
+ * @param enc_round_keys Array of 15 encryption round keys.
+ */
+void aes256_ctr_blocks_avx2(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_AVX2_H
@@ -0,0 +1,124 @@
+/**
+ * @file aes/core/aes_clmul.h
+ * @brief Inline GF(2^128) multiplication helpers built on PCLMULQDQ.
+ *
+ * GHASH (GCM, GMAC) multiplies 128-bit blocks in GF(2^128) modulo
+ * x^128 + x^7 + x^2 + x + 1, with a bit order reflected with respect to the
+ * carry-less multiplication instruction. These helpers work on byte-reflected
+ * blocks (each block loaded, then byte-swapped with aes_bswap_mask()), following
+ * the Intel carry-less multiplication white paper.
+ *
+ * The product of two elements is accumulated unreduced in three parts, so that
+ * several products (e.g. 8 blocks times H^8..H^1) are summed and reduced modulo
+ * the polynomial only once (aggregated reduction).
+ */
+
+#ifndef AES_CLMUL_H
+#define AES_CLMUL_H
+
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Accumulates the unreduced 256-bit carry-less product a * b.
+ *
+ * The product is kept as three parts (low, middle, high) so that the products
+ * of several blocks can be summed and reduced once.
+ *
+ * @param a Byte-reflected operand.
+ * @param b Byte-reflected operand.
+ * @param lo [in/out] Low 128 bits accumulator.
+ * @param mid [in/out] Middle (cross products) accumulator.
+ * @param hi [in/out] High 128 bits accumulator.
+ */
+static inline void aes_clmul_acc(__m128i a, __m128i b, __m128i* lo, __m128i* mid, __m128i* hi)
+{
+	*lo = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, b, 0x00));
+	*hi = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, b, 0x11));
+	*mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x10));
+	*mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x01));
+}
+
+/**
+ * @brief Reduces an accumulated 256-bit product modulo the GCM polynomial.
+ *
+ * Byte-reflected operands give a product shifted right by one bit, so the
+ * 256-bit value is first shifted left by one, then reduced modulo
+ * x^128 + x^7 + x^2 + x + 1 in two phases.
+ *
+ * @param lo Low 128 bits.
+ * @param mid Middle cross products.
+ * @param hi High 128 bits.
+ * @return Reduced byte-reflected product.
+ */
+static inline __m128i aes_clmul_reduce(__m128i lo, __m128i mid, __m128i hi)
+{
+	lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+	hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+	// Shift the 256-bit value hi:lo left by one bit
+	__m128i lo_carry = _mm_srli_epi32(lo, 31);
+	__m128i hi_carry = _mm_srli_epi32(hi, 31);
+	lo = _mm_slli_epi32(lo, 1);
+	hi = _mm_slli_epi32(hi, 1);
+	hi = _mm_or_si128(hi, _mm_srli_si128(lo_carry, 12));
+	hi = _mm_or_si128(hi, _mm_slli_si128(hi_carry, 4));
+	lo = _mm_or_si128(lo, _mm_slli_si128(lo_carry, 4));
+
+	// First phase of the reduction
+	__m128i t = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)), _mm_slli_epi32(lo, 25));
+	__m128i t_high = _mm_srli_si128(t, 4);
+	lo = _mm_xor_si128(lo, _mm_slli_si128(t, 12));
+
+	// Second phase of the reduction
+	__m128i u = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7));
+	u = _mm_xor_si128(u, t_high);
+	lo = _mm_xor_si128(lo, u);
+
+	return _mm_xor_si128(hi, lo);
+}
+
+/**
+ * @brief Multiplies two byte-reflected elements of GF(2^128).
+ *
+ * @param a Byte-reflected operand.
+ * @param b Byte-reflected operand.
+ * @return Byte-reflected product.
+ */
+static inline __m128i aes_clmul_gfmul(__m128i a, __m128i b)
+{
+	__m128i lo = _mm_setzero_si128(), mid = _mm_setzero_si128(), hi = _mm_setzero_si128();
+	aes_clmul_acc(a, b, &lo, &mid, &hi);
+	return aes_clmul_reduce(lo, mid, hi);
+}
+
+/**
+ * @brief Absorbs 8 byte-reflected blocks into a GHASH accumulator with one reduction.
+ *
+ * acc' = (acc + x0) * H^8 + x1 * H^7 + ... + x7 * H.
+ *
+ * @param acc GHASH accumulator.
+ * @param x 8 byte-reflected blocks.
+ * @param h_powers H^1..H^8, byte-reflected.
+ * @return Updated accumulator.
+ */
+static inline __m128i aes_clmul_x8(__m128i acc, const __m128i x[8], const __m128i h_powers[8])
+{
+	__m128i lo = _mm_setzero_si128(), mid = _mm_setzero_si128(), hi = _mm_setzero_si128();
+
+	aes_clmul_acc(_mm_xor_si128(x[0], acc), h_powers[7], &lo, &mid, &hi);
+	for (int j = 1; j < 8; ++j)
+		aes_clmul_acc(x[j], h_powers[7 - j], &lo, &mid, &hi);
+
+	return aes_clmul_reduce(lo, mid, hi);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_CLMUL_H
\ No newline at end of file
@@ -43,6 +43,15 @@ extern "C" {
 /// Total number of round keys (128-bit words) for AES-256
 #define AES_256_NUM_ROUND_KEYS (AES_256_NUM_ROUNDS + 1)
 
+/// Number of independent blocks kept in flight by the multi-block AES-NI kernels
+#define AES_PARALLEL_BLOCKS 8
+
+/// Number of blocks staged per multi-block kernel call by the CBC decryption loop (fills VAES-512 registers)
+#define AES_WIDE_BLOCKS 32
+
+/// Cache line size in bytes, used to align precomputed key tables
+#define AES_CACHE_LINE_SIZE 64
+
 #ifdef __cplusplus
 }
 #endif
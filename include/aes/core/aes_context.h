@@ -3,17 +3,27 @@
  * @brief AES context definition and initialization for AES-128, AES-192, and AES-256.
  *
  * This header defines the `aes_context_t` structure, which holds encryption and
- * decryption round keys, as well as function pointers for block-level AES operations.
+ * decryption round keys, as well as a pointer to the block-level AES kernels
+ * selected for the running CPU (see aes_dispatch.h).
  *
  * The context is initialized using `aes_context_init()` and can then be reused
  * for multiple encryption/decryption calls with the associated key.
+ *
+ * CTR, OFB, CFB, GCM, GCM-SIV, CCM, CMAC, SIV and the encryption direction of
+ * the other modes only use the encryption schedule. `aes_context_init_encrypt()`
+ * skips the inversion into the decryption schedule, which is the last member of
+ * the context: an encrypt-only context needs only its first
+ * AES_CONTEXT_ENCRYPT_SIZE bytes. `aes_context_prepare_decrypt()` computes the
+ * decryption schedule later if a context turns out to be needed for decryption.
  */
 
 #ifndef AES_CONTEXT_H
 #define AES_CONTEXT_H
 
 #include "aes/core/aes_constants.h"
+#include "aes/core/aes_dispatch.h"
 #include <stdint.h>
+#include <stddef.h>
 #include <emmintrin.h>
 #include <wmmintrin.h>
 
@@ -30,17 +40,6 @@ typedef enum {
 	AES_256 = AES_256_KEY_SIZE ///< AES-256 uses 32-byte keys
 } aes_key_size_t;
 
-/**
- * @brief Function pointer type for AES encryption and decryption functions.
- *
- * This allows for dynamic selection of the encryption/decryption function based on key size.
- *
- * @param plaintext Input 16-byte block to encrypt/decrypt.
- * @param ciphertext Output pointer to receive the encrypted/decrypted 16-byte block.
- * @param enc_round_keys Array of round keys for encryption/decryption.
- */
-typedef void (*aes_encrypt_func_t)(const __m128i plaintext, __m128i* ciphertext, const __m128i* enc_round_keys);
-
 /**
  * @brief AES context structure containing round keys for encryption and decryption.
  *
@@ -49,22 +48,83 @@ typedef void (*aes_encrypt_func_t)(const __m128i plaintext, __m128i* ciphertext,
  */
 typedef struct {
 	aes_key_size_t key_size; ///< Key size used (AES_128, AES_192, or AES_256)
+	int has_dec_round_keys; ///< Non-zero if dec_round_keys holds the decryption schedule
+	const aes_dispatch_t* dispatch; ///< Kernels selected for the key size and the running CPU (name in dispatch->name)
 	__m128i enc_round_keys[AES_256_NUM_ROUND_KEYS]; ///< Expanded encryption round keys (up to 14 + 1 for AES-256)
-	__m128i dec_round_keys[AES_256_NUM_ROUND_KEYS]; ///< Expanded decryption round keys (same count as enc keys)
-	aes_encrypt_func_t encrypt_func; ///< Pointer to the encryption function (AES-128, AES-192, or AES-256)
-	aes_encrypt_func_t decrypt_func; ///< Pointer to the decryption function (AES-128, AES-192, or AES-256)
+	__m128i dec_round_keys[AES_256_NUM_ROUND_KEYS]; ///< Expanded decryption round keys (same count as enc keys); last member, unused by encrypt-only contexts
 } aes_context_t;
 
+/// Bytes of an aes_context_t used by an encrypt-only context (everything before the decryption schedule)
+#define AES_CONTEXT_ENCRYPT_SIZE offsetof(aes_context_t, dec_round_keys)
+
 /**
  * @brief Initializes an AES context by expanding the encryption and decryption keys.
  *
+ * The kernels are taken from the dispatch table entry of the fastest implementation
+ * supported by the running CPU (see aes_dispatch_get()).
+ *
  * @param ctx Pointer to the AES context to initialize.
  * @param key Raw AES key (must be 16, 24, or 32 bytes depending on AES version).
  * @param key_size Size of the key in bytes (must match AES_128, AES_192, or AES_256).
- * @return 0 on success, non-zero on failure (e.g., invalid key size or null pointers).
+ * @return 0 on success, non-zero on failure (e.g., invalid key size, null pointers, or no AES-NI support).
  */
 int aes_context_init(aes_context_t* ctx, const uint8_t* key, size_t key_size);
 
+/**
+ * @brief Initializes an encrypt-only AES context: the decryption schedule is not computed.
+ *
+ * Takes about half the setup time of aes_context_init(). Decryption functions
+ * (ECB, CBC, XTS, OCB and HCTR2 decryption) reject the context until
+ * aes_context_prepare_decrypt() is called on it. Only the first
+ * AES_CONTEXT_ENCRYPT_SIZE bytes of the context are written or read.
+ *
+ * @param ctx Pointer to the AES context to initialize.
+ * @param key Raw AES key (must be 16, 24, or 32 bytes depending on AES version).
+ * @param key_size Size of the key in bytes (must match AES_128, AES_192, or AES_256).
+ * @return 0 on success, non-zero on failure (e.g., invalid key size, null pointers, or no AES-NI support).
+ */
+int aes_context_init_encrypt(aes_context_t* ctx, const uint8_t* key, size_t key_size);
+
+/**
+ * @brief Computes the decryption schedule of a context, if it is not there yet.
+ *
+ * Needs a full aes_context_t. Not thread-safe with respect to other uses of the
+ * same context: call it before sharing an encrypt-only context for decryption.
+ *
+ * @param ctx Initialized AES context.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_context_prepare_decrypt(aes_context_t* ctx);
+
+/**
+ * @brief Erases the round keys of a context.
+ *
+ * The stores are not optimized away, even if the context is freed right after.
+ * The whole aes_context_t is cleared, whatever the context holds: an
+ * encrypt-only context may still hold the decryption schedule of the key it
+ * was initialized with before. Contexts stored in AES_CONTEXT_ENCRYPT_SIZE
+ * bytes must be cleared by their owner instead.
+ *
+ * @param ctx Context to wipe (may be NULL); its key size is reset to 0.
+ */
+void aes_context_wipe(aes_context_t* ctx);
+
+/**
+ * @brief Initializes several AES contexts whose keys have the same size.
+ *
+ * Gives the same contexts as calling aes_context_init() on each key, but the
+ * key schedules are expanded AES_KEY_EXPANSION_LANES at a time, interleaved
+ * (see aes128_key_expansion_x4()). Meant for workloads that set up a fresh
+ * context for every short message.
+ *
+ * @param ctxs Array of count contexts to initialize.
+ * @param keys Array of count raw AES keys, each key_size bytes long.
+ * @param key_size Size of every key in bytes (AES_128, AES_192 or AES_256).
+ * @param count Number of keys.
+ * @return 0 on success, non-zero on failure (no context is initialized then).
+ */
+int aes_context_init_batch(aes_context_t* ctxs, const uint8_t* const* keys, size_t key_size, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,153 @@
+/**
+ * @file aes/core/aes_context_arena.h
+ * @brief Cache-aligned slab storage for large numbers of AES contexts.
+ *
+ * Servers holding one schedule per tenant would otherwise malloc each context,
+ * scattering hot round keys over the heap with allocator headers in between. An
+ * arena packs contexts into slabs of 64-byte aligned slots, so that a schedule
+ * never shares a cache line with another one, and optionally backs the slabs
+ * with huge pages to cut TLB misses when random tenants are looked up.
+ *
+ * Contexts are referred to by compact 32-bit handles. Allocation, release and
+ * lookup are O(1): released slots are chained in a free list and a handle maps
+ * to its slot with a shift and a mask. Each slot has an 8-bit generation,
+ * bumped when it is released and stored in the high bits of its handles, so a
+ * stale handle does not resolve to the context that later took its slot (until
+ * the slot has been reused 256 times).
+ *
+ * An arena is not internally synchronized: callers sharing one between threads
+ * must serialize alloc/free. Lookups of live handles may run concurrently.
+ */
+
+#ifndef AES_CONTEXT_ARENA_H
+#define AES_CONTEXT_ARENA_H
+
+#include "aes/core/aes_context.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Back the slabs with huge pages when the system provides them.
+ *
+ * On Linux reserved huge pages are tried first, then transparent huge pages.
+ * Elsewhere the flag only enlarges the slabs.
+ */
+#define AES_CONTEXT_ARENA_HUGE_PAGES 0x1
+
+/**
+ * @brief Store encrypt-only contexts (see aes_context_init_encrypt()).
+ *
+ * Slots shrink to AES_CONTEXT_ENCRYPT_SIZE bytes, halving the footprint of
+ * CTR/GCM/CMAC style workloads. aes_context_prepare_decrypt() must not be
+ * called on contexts of such an arena.
+ */
+#define AES_CONTEXT_ARENA_ENCRYPT_ONLY 0x2
+
+/**
+ * @brief Handle to a context of an arena; 0 is never a valid handle.
+ */
+typedef uint32_t aes_context_handle_t;
+
+/**
+ * @brief Invalid context handle.
+ */
+#define AES_CONTEXT_HANDLE_INVALID 0
+
+/**
+ * @brief Low bits of a handle, holding its slot index plus one; the high bits
+ *        hold the generation of the slot.
+ */
+#define AES_CONTEXT_HANDLE_INDEX_BITS 24
+
+/**
+ * @brief Largest capacity of an arena.
+ */
+#define AES_CONTEXT_ARENA_MAX_CAPACITY (((size_t)1 << AES_CONTEXT_HANDLE_INDEX_BITS) - 1)
+
+/**
+ * @brief Returns the slot index of a valid handle.
+ *
+ * Indices are below the capacity of the arena, so callers can keep data about
+ * each context in a plain array.
+ *
+ * @param handle Valid context handle.
+ * @return Slot index.
+ */
+static inline size_t aes_context_handle_index(aes_context_handle_t handle)
+{
+	return (size_t)(handle & AES_CONTEXT_ARENA_MAX_CAPACITY) - 1;
+}
+
+/**
+ * @brief Opaque context arena.
+ */
+typedef struct aes_context_arena aes_context_arena_t;
+
+/**
+ * @brief Creates an arena.
+ *
+ * Slabs are only allocated once contexts need them.
+ *
+ * @param capacity Maximum number of live contexts (1 to AES_CONTEXT_ARENA_MAX_CAPACITY).
+ * @param flags Combination of AES_CONTEXT_ARENA_* flags.
+ * @return New arena, or NULL on invalid argument or allocation failure.
+ */
+aes_context_arena_t* aes_context_arena_create(size_t capacity, unsigned flags);
+
+/**
+ * @brief Wipes all contexts and releases the arena.
+ *
+ * @param arena Arena to destroy (may be NULL).
+ */
+void aes_context_arena_destroy(aes_context_arena_t* arena);
+
+/**
+ * @brief Expands a key into a new context of the arena.
+ *
+ * @param arena Arena.
+ * @param key Encryption key.
+ * @param key_size Key size in bytes (16, 24 or 32).
+ * @return Handle of the context, or AES_CONTEXT_HANDLE_INVALID on invalid
+ *         argument, full arena or slab allocation failure.
+ */
+aes_context_handle_t aes_context_arena_alloc(aes_context_arena_t* arena, const uint8_t* key, size_t key_size);
+
+/**
+ * @brief Wipes a context and returns its slot to the arena.
+ *
+ * @param arena Arena.
+ * @param handle Handle returned by aes_context_arena_alloc().
+ * @return 0 on success, 1 if the handle is invalid or already released (even if
+ *         its slot was handed out again).
+ */
+int aes_context_arena_free(aes_context_arena_t* arena, aes_context_handle_t handle);
+
+/**
+ * @brief Returns the context of a handle.
+ *
+ * The pointer stays valid until the handle is released or the arena destroyed.
+ *
+ * @param arena Arena.
+ * @param handle Context handle.
+ * @return Context, or NULL if the handle is invalid or released (even if its
+ *         slot was handed out again).
+ */
+const aes_context_t* aes_context_arena_get(const aes_context_arena_t* arena, aes_context_handle_t handle);
+
+/**
+ * @brief Returns the number of live contexts of an arena.
+ *
+ * @param arena Arena (may be NULL, which holds no context).
+ * @return Number of contexts.
+ */
+size_t aes_context_arena_count(const aes_context_arena_t* arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_CONTEXT_ARENA_H
\ No newline at end of file
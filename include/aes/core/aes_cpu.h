@@ -0,0 +1,49 @@
+/**
+ * @file aes/core/aes_cpu.h
+ * @brief Runtime CPU feature detection for the AES kernels.
+ *
+ * This header exposes the instruction set extensions relevant to the AES kernels
+ * (AES-NI, PCLMULQDQ, AVX2, VAES, VPCLMULQDQ, AVX-512). Detection uses `cpuid`
+ * and `xgetbv`, so an extension is only reported when both the CPU and the
+ * operating system (register state saving) support it.
+ *
+ * Detection runs once at program startup; later queries return the cached result.
+ */
+
+#ifndef AES_CPU_H
+#define AES_CPU_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Instruction set extensions available on the running CPU.
+ *
+ * Each field is 1 when the extension is usable, 0 otherwise.
+ */
+typedef struct {
+	int sse41; ///< SSE4.1
+	int aesni; ///< AES-NI (aesenc, aesdec, aeskeygenassist, aesimc)
+	int pclmulqdq; ///< Carry-less multiplication on 128-bit registers
+	int avx; ///< AVX (256-bit register state enabled by the OS)
+	int avx2; ///< AVX2
+	int vaes; ///< Vector AES on 256-bit (and 512-bit with AVX-512F) registers
+	int vpclmulqdq; ///< Vector carry-less multiplication on 256/512-bit registers
+	int avx512f; ///< AVX-512 Foundation (512-bit register state enabled by the OS)
+	int avx512bw; ///< AVX-512 Byte and Word instructions
+	int avx512vl; ///< AVX-512 Vector Length extensions
+} aes_cpu_features_t;
+
+/**
+ * @brief Returns the features of the running CPU.
+ *
+ * @return Pointer to the cached feature set (never NULL).
+ */
+const aes_cpu_features_t* aes_cpu_get_features(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_CPU_H
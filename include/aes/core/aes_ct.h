@@ -0,0 +1,31 @@
+/**
+ * @file aes/core/aes_ct.h
+ * @brief Constant-time helpers shared by the MAC and authenticated modes.
+ */
+
+#ifndef AES_CT_H
+#define AES_CT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Compares two byte strings in time independent of their contents.
+ *
+ * Used to check tags, so that the time taken does not reveal how many leading
+ * bytes of a forged tag are correct.
+ *
+ * @param a First string.
+ * @param b Second string.
+ * @param len Number of bytes to compare.
+ * @return 0 if the strings are equal, 1 otherwise.
+ */
+static inline int aes_ct_memcmp(const uint8_t* a, const uint8_t* b, size_t len)
+{
+	uint8_t diff = 0;
+	for (size_t i = 0; i < len; ++i)
+		diff |= a[i] ^ b[i];
+	return diff != 0;
+}
+
+#endif // AES_CT_H
\ No newline at end of file
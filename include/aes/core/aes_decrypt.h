@@ -2,8 +2,10 @@
  * @file aes/core/aes_decrypt.h
  * @brief AES block decryption functions (AES-128, AES-192, AES-256) using AES-NI.
  *
- * This header declares functions for decrypting a single 16-byte block using
- * AES with hardware acceleration via Intel AES-NI intrinsics.
+ * This header declares functions for decrypting 16-byte blocks using AES with
+ * hardware acceleration via Intel AES-NI intrinsics, either one block at a time
+ * or 4/8 independent blocks at a time for the parallelizable decryption paths
+ * (ECB, CBC).
  *
  * Each function requires precomputed decryption round keys, which can be derived
  * from the encryption round keys using the corresponding inversion functions.
@@ -13,6 +15,7 @@
 #define AES_DECRYPT_H
 
 #include "aes/core/aes_constants.h"
+#include <stddef.h>
 #include <emmintrin.h>
 #include <wmmintrin.h>
 
@@ -47,6 +50,96 @@ void aes192_decrypt_block(const __m128i ciphertext, __m128i* plaintext, const __
  */
 void aes256_decrypt_block(const __m128i ciphertext, __m128i* plaintext, const __m128i dec_round_keys[AES_256_NUM_ROUND_KEYS]);
 
+/**
+ * @brief Decrypts 4 independent 128-bit blocks using AES-128.
+ *
+ * @param ciphertext Array of 4 input blocks (may be unaligned).
+ * @param plaintext Output array receiving the 4 decrypted blocks (may alias ciphertext).
+ * @param dec_round_keys Array of 11 decryption round keys.
+ */
+void aes128_decrypt_blocks4(const __m128i ciphertext[4], __m128i plaintext[4], const __m128i dec_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts 8 independent 128-bit blocks using AES-128.
+ *
+ * @param ciphertext Array of 8 input blocks (may be unaligned).
+ * @param plaintext Output array receiving the 8 decrypted blocks (may alias ciphertext).
+ * @param dec_round_keys Array of 11 decryption round keys.
+ */
+void aes128_decrypt_blocks8(const __m128i ciphertext[8], __m128i plaintext[8], const __m128i dec_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts an arbitrary number of independent 128-bit blocks using AES-128.
+ *
+ * Blocks are processed 8 at a time, then 4 at a time, then one by one.
+ *
+ * @param ciphertext Array of num_blocks input blocks (may be unaligned).
+ * @param plaintext Output array receiving num_blocks decrypted blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to decrypt.
+ * @param dec_round_keys Array of 11 decryption round keys.
+ */
+void aes128_decrypt_blocks(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts 4 independent 128-bit blocks using AES-192.
+ *
+ * @param ciphertext Array of 4 input blocks (may be unaligned).
+ * @param plaintext Output array receiving the 4 decrypted blocks (may alias ciphertext).
+ * @param dec_round_keys Array of 13 decryption round keys.
+ */
+void aes192_decrypt_blocks4(const __m128i ciphertext[4], __m128i plaintext[4], const __m128i dec_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts 8 independent 128-bit blocks using AES-192.
+ *
+ * @param ciphertext Array of 8 input blocks (may be unaligned).
+ * @param plaintext Output array receiving the 8 decrypted blocks (may alias ciphertext).
+ * @param dec_round_keys Array of 13 decryption round keys.
+ */
+void aes192_decrypt_blocks8(const __m128i ciphertext[8], __m128i plaintext[8], const __m128i dec_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts an arbitrary number of independent 128-bit blocks using AES-192.
+ *
+ * Blocks are processed 8 at a time, then 4 at a time, then one by one.
+ *
+ * @param ciphertext Array of num_blocks input blocks (may be unaligned).
+ * @param plaintext Output array receiving num_blocks decrypted blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to decrypt.
+ * @param dec_round_keys Array of 13 decryption round keys.
+ */
+void aes192_decrypt_blocks(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts 4 independent 128-bit blocks using AES-256.
+ *
+ * @param ciphertext Array of 4 input blocks (may be unaligned).
+ * @param plaintext Output array receiving the 4 decrypted blocks (may alias ciphertext).
+ * @param dec_round_keys Array of 15 decryption round keys.
+ */
+void aes256_decrypt_blocks4(const __m128i ciphertext[4], __m128i plaintext[4], const __m128i dec_round_keys[AES_256_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts 8 independent 128-bit blocks using AES-256.
+ *
+ * @param ciphertext Array of 8 input blocks (may be unaligned).
+ * @param plaintext Output array receiving the 8 decrypted blocks (may alias ciphertext).
+ * @param dec_round_keys Array of 15 decryption round keys.
+ */
+void aes256_decrypt_blocks8(const __m128i ciphertext[8], __m128i plaintext[8], const __m128i dec_round_keys[AES_256_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts an arbitrary number of independent 128-bit blocks using AES-256.
+ *
+ * Blocks are processed 8 at a time, then 4 at a time, then one by one.
+ *
+ * @param ciphertext Array of num_blocks input blocks (may be unaligned).
+ * @param plaintext Output array receiving num_blocks decrypted blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to decrypt.
+ * @param dec_round_keys Array of 15 decryption round keys.
+ */
+void aes256_decrypt_blocks(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_256_NUM_ROUND_KEYS]);
+
 #ifdef __cplusplus
 }
 #endif
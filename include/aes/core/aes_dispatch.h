@@ -0,0 +1,135 @@
+/**
+ * @file aes/core/aes_dispatch.h
+ * @brief Kernel dispatch table selected from the CPU features at runtime.
+ *
+ * Every AES kernel family exists in several implementations (AES-NI, AES-NI
+ * compiled for AVX2, VAES on 256-bit and 512-bit registers). This header defines
+ * the dispatch table that groups, for one implementation and one key size, the
+ * kernels used by the modes, and the functions that select the fastest
+ * implementation supported by the running CPU (see aes_cpu.h).
+ *
+ * This lets a single portable binary run the fastest code path on each machine.
+ * Contexts capture a pointer to the selected table entry in aes_context_init().
+ */
+
+#ifndef AES_DISPATCH_H
+#define AES_DISPATCH_H
+
+#include "aes/core/aes_constants.h"
+#include <stddef.h>
+#include <emmintrin.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Function pointer type for AES encryption and decryption functions.
+ *
+ * This allows for dynamic selection of the encryption/decryption function based on key size.
+ *
+ * @param plaintext Input 16-byte block to encrypt/decrypt.
+ * @param ciphertext Output pointer to receive the encrypted/decrypted 16-byte block.
+ * @param enc_round_keys Array of round keys for encryption/decryption.
+ */
+typedef void (*aes_encrypt_func_t)(const __m128i plaintext, __m128i* ciphertext, const __m128i* enc_round_keys);
+
+/**
+ * @brief Function pointer type for multi-block AES encryption and decryption functions.
+ *
+ * Processes num_blocks independent blocks, interleaving them through the AES pipeline.
+ *
+ * @param input Array of num_blocks input blocks (may be unaligned).
+ * @param output Output array receiving num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param round_keys Array of round keys for encryption/decryption.
+ */
+typedef void (*aes_blocks_func_t)(const __m128i* input, __m128i* output, size_t num_blocks, const __m128i* round_keys);
+
+/**
+ * @brief Function pointer type for CTR mode kernels.
+ *
+ * XORs num_blocks whole blocks with the encryption of consecutive counter values.
+ *
+ * @param input Array of num_blocks input blocks (may be unaligned).
+ * @param output Output array receiving num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks on return.
+ * @param round_keys Array of encryption round keys.
+ */
+typedef void (*aes_ctr_func_t)(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i* round_keys);
+
+/**
+ * @brief Available kernel implementations, from the most to the least portable.
+ */
+typedef enum {
+	AES_IMPL_AESNI, ///< 128-bit AES-NI (SSE encoding)
+	AES_IMPL_AESNI_AVX2, ///< 128-bit AES-NI compiled for AVX2 (VEX encoding)
+	AES_IMPL_VAES256, ///< VAES on 256-bit registers (AVX2 + VAES)
+	AES_IMPL_VAES512, ///< VAES on 512-bit registers (AVX-512F/BW + VAES)
+	AES_IMPL_COUNT ///< Number of implementations
+} aes_impl_t;
+
+/**
+ * @brief Kernels of one implementation for one key size.
+ */
+typedef struct {
+	aes_impl_t impl; ///< Implementation these kernels belong to
+	const char* name; ///< Implementation name (e.g. "aesni", "vaes512")
+	aes_encrypt_func_t encrypt_block; ///< Single-block encryption
+	aes_encrypt_func_t decrypt_block; ///< Single-block decryption
+	aes_blocks_func_t encrypt_blocks; ///< Multi-block encryption (ECB encryption)
+	aes_blocks_func_t decrypt_blocks; ///< Multi-block decryption (ECB and CBC decryption)
+	aes_ctr_func_t ctr_blocks; ///< CTR keystream generation fused with the input XOR
+} aes_dispatch_t;
+
+/**
+ * @brief Returns the fastest implementation supported by the running CPU.
+ *
+ * The result is overridden by aes_dispatch_set_impl() if it was called.
+ *
+ * @return Selected implementation.
+ */
+aes_impl_t aes_dispatch_get_impl(void);
+
+/**
+ * @brief Restricts the selection to the given implementation.
+ *
+ * Intended for testing and benchmarking. Only contexts initialized afterwards
+ * are affected. May be called while other threads initialize contexts; each
+ * of those sees either the previous or the new setting.
+ *
+ * @param impl Implementation to use, or AES_IMPL_COUNT to restore automatic selection.
+ * @return 0 on success, non-zero if the running CPU does not support impl.
+ */
+int aes_dispatch_set_impl(aes_impl_t impl);
+
+/**
+ * @brief Tells whether the running CPU supports an implementation.
+ *
+ * @param impl Implementation to check.
+ * @return 1 if supported, 0 otherwise.
+ */
+int aes_dispatch_is_supported(aes_impl_t impl);
+
+/**
+ * @brief Returns the name of an implementation.
+ *
+ * @param impl Implementation.
+ * @return Static string (e.g. "aesni", "aesni-avx2", "vaes256", "vaes512"), or "unknown".
+ */
+const char* aes_dispatch_impl_name(aes_impl_t impl);
+
+/**
+ * @brief Returns the dispatch table entry for a key size and the selected implementation.
+ *
+ * @param key_size Key size in bytes (16, 24 or 32).
+ * @return Pointer to a static table entry, or NULL for an invalid key size.
+ */
+const aes_dispatch_t* aes_dispatch_get(size_t key_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_DISPATCH_H
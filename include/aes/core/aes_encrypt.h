@@ -5,14 +5,20 @@
  * This header declares functions for encrypting single 16-byte blocks using
  * AES with hardware acceleration through Intel AES-NI intrinsics.
  *
- * Each function operates on a single block and requires the corresponding
- * number of encryption round keys as generated by the key expansion functions.
+ * The single-block functions operate on one block at a time. The multi-block
+ * functions push 4 or 8 independent blocks through each round together so that
+ * the AES unit runs at throughput rather than latency; they are used by the
+ * parallelizable modes (ECB, CTR, ...).
+ *
+ * Every function requires the corresponding number of encryption round keys
+ * as generated by the key expansion functions.
  */
 
 #ifndef AES_ENCRYPT_H
 #define AES_ENCRYPT_H
 
 #include "aes/core/aes_constants.h"
+#include <stddef.h>
 #include <emmintrin.h>
 #include <wmmintrin.h>
 
@@ -47,6 +53,141 @@ void aes192_encrypt_block(const __m128i plaintext, __m128i* ciphertext, const __
  */
 void aes256_encrypt_block(const __m128i plaintext, __m128i* ciphertext, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS]);
 
+/**
+ * @brief Encrypts 4 independent 128-bit blocks using AES-128.
+ *
+ * @param plaintext Array of 4 input blocks (may be unaligned).
+ * @param ciphertext Output array receiving the 4 encrypted blocks (may alias plaintext).
+ * @param enc_round_keys Array of 11 round keys generated by aes128_key_expansion().
+ */
+void aes128_encrypt_blocks4(const __m128i plaintext[4], __m128i ciphertext[4], const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts 8 independent 128-bit blocks using AES-128.
+ *
+ * @param plaintext Array of 8 input blocks (may be unaligned).
+ * @param ciphertext Output array receiving the 8 encrypted blocks (may alias plaintext).
+ * @param enc_round_keys Array of 11 round keys generated by aes128_key_expansion().
+ */
+void aes128_encrypt_blocks8(const __m128i plaintext[8], __m128i ciphertext[8], const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts an arbitrary number of independent 128-bit blocks using AES-128.
+ *
+ * Blocks are processed 8 at a time, then 4 at a time, then one by one.
+ *
+ * @param plaintext Array of num_blocks input blocks (may be unaligned).
+ * @param ciphertext Output array receiving num_blocks encrypted blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to encrypt.
+ * @param enc_round_keys Array of 11 round keys generated by aes128_key_expansion().
+ */
+void aes128_encrypt_blocks(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts 4 independent 128-bit blocks using AES-192.
+ *
+ * @param plaintext Array of 4 input blocks (may be unaligned).
+ * @param ciphertext Output array receiving the 4 encrypted blocks (may alias plaintext).
+ * @param enc_round_keys Array of 13 round keys generated by aes192_key_expansion().
+ */
+void aes192_encrypt_blocks4(const __m128i plaintext[4], __m128i ciphertext[4], const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts 8 independent 128-bit blocks using AES-192.
+ *
+ * @param plaintext Array of 8 input blocks (may be unaligned).
+ * @param ciphertext Output array receiving the 8 encrypted blocks (may alias plaintext).
+ * @param enc_round_keys Array of 13 round keys generated by aes192_key_expansion().
+ */
+void aes192_encrypt_blocks8(const __m128i plaintext[8], __m128i ciphertext[8], const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts an arbitrary number of independent 128-bit blocks using AES-192.
+ *
+ * Blocks are processed 8 at a time, then 4 at a time, then one by one.
+ *
+ * @param plaintext Array of num_blocks input blocks (may be unaligned).
+ * @param ciphertext Output array receiving num_blocks encrypted blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to encrypt.
+ * @param enc_round_keys Array of 13 round keys generated by aes192_key_expansion().
+ */
+void aes192_encrypt_blocks(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts 4 independent 128-bit blocks using AES-256.
+ *
+ * @param plaintext Array of 4 input blocks (may be unaligned).
+ * @param ciphertext Output array receiving the 4 encrypted blocks (may alias plaintext).
+ * @param enc_round_keys Array of 15 round keys generated by aes256_key_expansion().
+ */
+void aes256_encrypt_blocks4(const __m128i plaintext[4], __m128i ciphertext[4], const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts 8 independent 128-bit blocks using AES-256.
+ *
+ * @param plaintext Array of 8 input blocks (may be unaligned).
+ * @param ciphertext Output array receiving the 8 encrypted blocks (may alias plaintext).
+ * @param enc_round_keys Array of 15 round keys generated by aes256_key_expansion().
+ */
+void aes256_encrypt_blocks8(const __m128i plaintext[8], __m128i ciphertext[8], const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts an arbitrary number of independent 128-bit blocks using AES-256.
+ *
+ * Blocks are processed 8 at a time, then 4 at a time, then one by one.
+ *
+ * @param plaintext Array of num_blocks input blocks (may be unaligned).
+ * @param ciphertext Output array receiving num_blocks encrypted blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to encrypt.
+ * @param enc_round_keys Array of 15 round keys generated by aes256_key_expansion().
+ */
+void aes256_encrypt_blocks(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks whole blocks in CTR mode using AES-128.
+ *
+ * Each input block is XORed with the encryption of the current counter, which
+ * is then incremented as a 128-bit big-endian integer. Blocks are processed 8 at a time, then
+ * 4 at a time, then one by one.
+ *
+ * @param input Array of num_blocks input blocks (may be unaligned).
+ * @param output Output array receiving num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks on return.
+ * @param enc_round_keys Array of 11 encryption round keys.
+ */
+void aes128_ctr_blocks(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks whole blocks in CTR mode using AES-192.
+ *
+ * Each input block is XORed with the encryption of the current counter, which
+ * is then incremented as a 128-bit big-endian integer. Blocks are processed 8 at a time, then
+ * 4 at a time, then one by one.
+ *
+ * @param input Array of num_blocks input blocks (may be unaligned).
+ * @param output Output array receiving num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks on return.
+ * @param enc_round_keys Array of 13 encryption round keys.
+ */
+void aes192_ctr_blocks(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks whole blocks in CTR mode using AES-256.
+ *
+ * Each input block is XORed with the encryption of the current counter, which
+ * is then incremented as a 128-bit big-endian integer. Blocks are processed 8 at a time, then
+ * 4 at a time, then one by one.
+ *
+ * @param input Array of num_blocks input blocks (may be unaligned).
+ * @param output Output array receiving num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks on return.
+ * @param enc_round_keys Array of 15 encryption round keys.
+ */
+void aes256_ctr_blocks(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS]);
+
 #ifdef __cplusplus
 }
 #endif
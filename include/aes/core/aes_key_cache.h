@@ -0,0 +1,103 @@
+/**
+ * @file aes/core/aes_key_cache.h
+ * @brief Thread-safe LRU cache of expanded key schedules.
+ *
+ * Request paths that receive a key identifier would otherwise expand the key
+ * for every message. The cache maps 64-bit key identifiers (or hashes of the key
+ * material) to ready contexts, so repeated traffic for hot keys skips key
+ * expansion.
+ *
+ * The cache is split into shards, each with its own lock, hash table, LRU list
+ * and context arena, so threads working on different keys rarely contend.
+ * Memory is bounded by the capacity given at creation: once a shard is full,
+ * its least recently used schedule is wiped and its slot reused.
+ *
+ * Lookups copy the schedule out of the cache, so evictions by other threads
+ * never invalidate a context in use. The copy is far cheaper than a key
+ * expansion; callers should wipe it with aes_context_wipe() once done.
+ */
+
+#ifndef AES_KEY_CACHE_H
+#define AES_KEY_CACHE_H
+
+#include "aes/core/aes_context.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opaque key schedule cache.
+ */
+typedef struct aes_key_cache aes_key_cache_t;
+
+/**
+ * @brief Cache counters, summed over all shards.
+ */
+typedef struct {
+	uint64_t hits; ///< Lookups served from the cache
+	uint64_t misses; ///< Lookups that did not find a matching schedule
+	uint64_t evictions; ///< Schedules wiped to make room for new ones
+	size_t count; ///< Schedules currently cached
+} aes_key_cache_stats_t;
+
+/**
+ * @brief Creates a cache.
+ *
+ * @param capacity Maximum number of cached schedules (at least num_shards);
+ *        it is split evenly between the shards, rounding up.
+ * @param num_shards Number of independently locked shards (at least 1).
+ * @param flags Combination of AES_CONTEXT_ARENA_* flags from aes_context_arena.h.
+ *        With AES_CONTEXT_ARENA_ENCRYPT_ONLY, cached and returned contexts have
+ *        no decryption schedule.
+ * @return New cache, or NULL on invalid argument or allocation failure.
+ */
+aes_key_cache_t* aes_key_cache_create(size_t capacity, size_t num_shards, unsigned flags);
+
+/**
+ * @brief Wipes all schedules and releases the cache.
+ *
+ * @param cache Cache to destroy (may be NULL). Must not be in use by other threads.
+ */
+void aes_key_cache_destroy(aes_key_cache_t* cache);
+
+/**
+ * @brief Looks up the schedule of a key, expanding and caching it on a miss.
+ *
+ * When key is provided, a cached schedule only counts as a hit if it was
+ * expanded from the same key, which makes key material hashes safe to use as
+ * identifiers; a stale schedule is replaced. Without key, only hits succeed.
+ *
+ * @param cache Cache.
+ * @param key_id Key identifier.
+ * @param key Key material, or NULL for a lookup without insertion.
+ * @param key_size Key size in bytes (16, 24 or 32); ignored when key is NULL.
+ * @param ctx Receives a copy of the schedule.
+ * @return 0 on success, 1 on invalid argument or on a miss without key.
+ */
+int aes_key_cache_get(aes_key_cache_t* cache, uint64_t key_id, const uint8_t* key, size_t key_size, aes_context_t* ctx);
+
+/**
+ * @brief Wipes and removes the schedule of a key, e.g. when the key is revoked.
+ *
+ * @param cache Cache.
+ * @param key_id Key identifier.
+ * @return 0 if a schedule was removed, 1 otherwise.
+ */
+int aes_key_cache_remove(aes_key_cache_t* cache, uint64_t key_id);
+
+/**
+ * @brief Reads the cache counters.
+ *
+ * @param cache Cache.
+ * @param stats Receives the counters.
+ */
+void aes_key_cache_stats(aes_key_cache_t* cache, aes_key_cache_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_KEY_CACHE_H
\ No newline at end of file
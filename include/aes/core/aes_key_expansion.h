@@ -10,6 +10,13 @@
  *   - AES-128: 10 rounds, 11 round keys
  *   - AES-192: 12 rounds, 13 round keys
  *   - AES-256: 14 rounds, 15 round keys
+ *
+ * The _x4 variants expand AES_KEY_EXPANSION_LANES independent keys of the same
+ * size together. Each schedule is a serial chain, so expanding one key leaves
+ * the AES unit idle between rounds; interleaving four chains fills those gaps.
+ * They derive SubWord(RotWord(w)) xor rcon with aesenclast on the broadcast,
+ * rotated word (all columns equal, so ShiftRows has no effect) instead of
+ * aeskeygenassist, which is microcoded with a low throughput on many cores.
  */
 
 #ifndef AES_KEY_EXPANSION_H
@@ -23,6 +30,9 @@
 extern "C" {
 #endif
 
+/// Number of keys expanded together by the _x4 key expansion functions
+#define AES_KEY_EXPANSION_LANES 4
+
 /**
  * @brief Expands a 128-bit AES user key into the encryption round key schedule.
  *
@@ -47,6 +57,30 @@ void aes192_key_expansion(const __m128i user_key[2], __m128i enc_round_keys[AES_
  */
 void aes256_key_expansion(const __m128i user_key[2], __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS]);
 
+/**
+ * @brief Expands 4 independent 128-bit AES user keys, interleaved.
+ *
+ * @param user_keys The 4 user keys.
+ * @param enc_round_keys Output arrays of 11 encryption round keys, one per user key (may all be the same array).
+ */
+void aes128_key_expansion_x4(const __m128i user_keys[AES_KEY_EXPANSION_LANES], __m128i* const enc_round_keys[AES_KEY_EXPANSION_LANES]);
+
+/**
+ * @brief Expands 4 independent 192-bit AES user keys, interleaved.
+ *
+ * @param user_keys The 4 user keys (two __m128i blocks each, only the low 64 bits of the second used).
+ * @param enc_round_keys Output arrays of 13 encryption round keys, one per user key (may all be the same array).
+ */
+void aes192_key_expansion_x4(const __m128i user_keys[AES_KEY_EXPANSION_LANES][2], __m128i* const enc_round_keys[AES_KEY_EXPANSION_LANES]);
+
+/**
+ * @brief Expands 4 independent 256-bit AES user keys, interleaved.
+ *
+ * @param user_keys The 4 user keys (two full __m128i blocks each).
+ * @param enc_round_keys Output arrays of 15 encryption round keys, one per user key (may all be the same array).
+ */
+void aes256_key_expansion_x4(const __m128i user_keys[AES_KEY_EXPANSION_LANES][2], __m128i* const enc_round_keys[AES_KEY_EXPANSION_LANES]);
+
 /**
  * @brief Inverts the AES-128 encryption round keys into decryption round keys.
  *
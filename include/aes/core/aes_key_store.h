@@ -0,0 +1,123 @@
+/**
+ * @file aes/core/aes_key_store.h
+ * @brief Persistent store of expanded key schedules, loadable in place.
+ *
+ * A key store file holds schedules that are already expanded, laid out as
+ * aes_context_t records. Opening a store maps the file into memory and checks
+ * its header; schedules are then used in place, with no key expansion. Startup
+ * cost does not depend on the number of keys: pages are read on first use.
+ *
+ * File format (version 1, native byte order):
+ * - a 64-byte header: magic "AESKSTR1", version, header size, record size,
+ *   writer's sizeof(aes_context_t), required CPU features, flags, record count,
+ *   checksum of the records and checksum of the header itself;
+ * - count records of sizeof(aes_context_t) bytes rounded up to 64, or of
+ *   AES_CONTEXT_ENCRYPT_SIZE bytes in encrypt-only stores.
+ *
+ * Records are stored with a NULL dispatch table, since function addresses do
+ * not survive a restart; it is filled on first access of each record.
+ */
+
+#ifndef AES_KEY_STORE_H
+#define AES_KEY_STORE_H
+
+#include "aes/core/aes_context.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Current version of the file format.
+ */
+#define AES_KEY_STORE_VERSION 1
+
+/**
+ * @brief Writing: store encryption schedules only, in half-size records.
+ */
+#define AES_KEY_STORE_ENCRYPT_ONLY 0x1
+
+/**
+ * @brief Opening: also verify the checksum of all records, reading the whole file.
+ */
+#define AES_KEY_STORE_VERIFY 0x2
+
+/**
+ * @brief CPU feature tag: schedules use the AES-NI layout, with decryption round
+ *        keys transformed by aesimc.
+ */
+#define AES_KEY_STORE_CPU_AESNI 0x1
+
+/**
+ * @brief Opaque opened key store.
+ */
+typedef struct aes_key_store aes_key_store_t;
+
+/**
+ * @brief Writes contexts to a key store file.
+ *
+ * Contexts without a decryption schedule get one in the file, unless
+ * AES_KEY_STORE_ENCRYPT_ONLY is set.
+ *
+ * The store is written to a new owner-only file in the same directory, synced,
+ * then renamed over path, so stores still opened by other processes stay valid.
+ *
+ * @param path File to create or replace.
+ * @param ctxs Array of count initialized contexts.
+ * @param count Number of contexts.
+ * @param flags 0 or AES_KEY_STORE_ENCRYPT_ONLY.
+ * @return 0 on success, 1 on invalid argument or I/O error.
+ */
+int aes_key_store_write(const char* path, const aes_context_t* ctxs, size_t count, unsigned flags);
+
+/**
+ * @brief Opens a key store file.
+ *
+ * Fails if the header is corrupted, if the file was written by a build with a
+ * different context layout, or if the running CPU lacks a feature the
+ * schedules were tagged with.
+ *
+ * @param path Key store file.
+ * @param flags 0 or AES_KEY_STORE_VERIFY.
+ * @return Opened store, or NULL on error.
+ */
+aes_key_store_t* aes_key_store_open(const char* path, unsigned flags);
+
+/**
+ * @brief Closes a key store; contexts obtained from it become invalid.
+ *
+ * @param store Store to close (may be NULL).
+ */
+void aes_key_store_close(aes_key_store_t* store);
+
+/**
+ * @brief Returns the number of contexts of a store.
+ *
+ * @param store Store (may be NULL, which holds no context).
+ * @return Number of contexts.
+ */
+size_t aes_key_store_count(const aes_key_store_t* store);
+
+/**
+ * @brief Returns a context of a store, used in place.
+ *
+ * May be called concurrently. Contexts of encrypt-only stores have no
+ * decryption schedule and cannot be given one. Their records are only
+ * AES_CONTEXT_ENCRYPT_SIZE bytes long: only those bytes are valid, and the
+ * context must not be copied as a whole aes_context_t (e.g. by assignment),
+ * which would read into the next record or, for the last one, past the end
+ * of the mapping.
+ *
+ * @param store Store.
+ * @param index Index of the context, in the order it was written.
+ * @return Context, or NULL if the index is out of range or the record is invalid.
+ */
+const aes_context_t* aes_key_store_get(aes_key_store_t* store, size_t index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_KEY_STORE_H
\ No newline at end of file
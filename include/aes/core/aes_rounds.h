@@ -0,0 +1,527 @@
+/**
+ * @file aes/core/aes_rounds.h
+ * @brief Inline AES-NI round helpers shared by the single- and multi-block kernels.
+ *
+ * This header provides `static inline` helpers that run the full AES round
+ * sequence over 1, 4 or 8 independent blocks. Interleaving independent blocks
+ * lets consecutive `aesenc`/`aesdec` instructions issue back to back, so the
+ * AES unit runs at throughput instead of latency.
+ *
+ * The `*_blocks_x4/x8/xn` variants load their input from (possibly unaligned)
+ * memory and store the result back, and are the bodies of the bulk kernels.
+ * aes_ctr_blocks_xn() is the body of the CTR kernels: counters are kept as
+ * 128-bit little-endian integers in registers and byte-swapped on the fly.
+ *
+ * The number of rounds is passed as a parameter; callers pass a compile-time
+ * constant (AES_128_NUM_ROUNDS, ...) so that the compiler fully unrolls the
+ * round loop for each key size. Serial mode loops (CBC encryption, CFB, OFB)
+ * use AES_KEY_SIZE_SWITCH() to get one specialized copy per key size, which
+ * keeps the round keys in registers across blocks and removes the per-block
+ * indirect call.
+ */
+
+#ifndef AES_ROUNDS_H
+#define AES_ROUNDS_H
+
+#include "aes/core/aes_constants.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+
+/**
+ * @brief Forces inlining of a helper so that it is specialized at each call site.
+ */
+#define AES_FORCE_INLINE inline __attribute__((always_inline))
+
+/**
+ * @brief Calls FN with the number of rounds matching key_size as a compile-time constant.
+ *
+ * Expands to a switch evaluated once per call; each case gets its own inlined,
+ * fully unrolled copy of FN. Invalid key sizes are ignored.
+ *
+ * @param key_size Key size (AES_128, AES_192 or AES_256).
+ * @param FN Function or macro taking the number of rounds as first argument.
+ * @param ... Remaining arguments of FN.
+ */
+#define AES_KEY_SIZE_SWITCH(key_size, FN, ...) \
+	do { \
+		switch (key_size) \
+		{ \
+			case AES_128: FN(AES_128_NUM_ROUNDS, __VA_ARGS__); break; \
+			case AES_192: FN(AES_192_NUM_ROUNDS, __VA_ARGS__); break; \
+			case AES_256: FN(AES_256_NUM_ROUNDS, __VA_ARGS__); break; \
+			default: break; \
+		} \
+	} while (0)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Copies the round keys into a local array.
+ *
+ * Once inlined with a constant num_rounds, the copy is scalarized into registers
+ * that stay live for the whole mode loop.
+ *
+ * @param dst Local array of at least num_rounds + 1 entries.
+ * @param src Round keys (e.g. from an aes_context_t).
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline void aes_load_round_keys(__m128i* dst, const __m128i* src, int num_rounds)
+{
+	for (int r = 0; r <= num_rounds; ++r)
+		dst[r] = _mm_loadu_si128(src + r);
+}
+
+/**
+ * @brief Encrypts one block with the given round keys.
+ *
+ * @param block Input block.
+ * @param round_keys Encryption round keys (num_rounds + 1 entries).
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ * @return Encrypted block.
+ */
+static inline __m128i aes_encrypt_x1(__m128i block, const __m128i* round_keys, int num_rounds)
+{
+	block = _mm_xor_si128(block, round_keys[0]);
+
+	for (int r = 1; r < num_rounds; ++r)
+		block = _mm_aesenc_si128(block, round_keys[r]);
+
+	return _mm_aesenclast_si128(block, round_keys[num_rounds]);
+}
+
+/**
+ * @brief Encrypts 4 independent blocks in place, interleaving their rounds.
+ *
+ * @param blocks [in/out] 4 blocks to encrypt.
+ * @param round_keys Encryption round keys (num_rounds + 1 entries).
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline void aes_encrypt_x4(__m128i blocks[4], const __m128i* round_keys, int num_rounds)
+{
+	__m128i b0 = _mm_xor_si128(blocks[0], round_keys[0]);
+	__m128i b1 = _mm_xor_si128(blocks[1], round_keys[0]);
+	__m128i b2 = _mm_xor_si128(blocks[2], round_keys[0]);
+	__m128i b3 = _mm_xor_si128(blocks[3], round_keys[0]);
+
+	for (int r = 1; r < num_rounds; ++r)
+	{
+		const __m128i rk = round_keys[r];
+		b0 = _mm_aesenc_si128(b0, rk);
+		b1 = _mm_aesenc_si128(b1, rk);
+		b2 = _mm_aesenc_si128(b2, rk);
+		b3 = _mm_aesenc_si128(b3, rk);
+	}
+
+	const __m128i last = round_keys[num_rounds];
+	blocks[0] = _mm_aesenclast_si128(b0, last);
+	blocks[1] = _mm_aesenclast_si128(b1, last);
+	blocks[2] = _mm_aesenclast_si128(b2, last);
+	blocks[3] = _mm_aesenclast_si128(b3, last);
+}
+
+/**
+ * @brief Encrypts 8 independent blocks in place, interleaving their rounds.
+ *
+ * @param blocks [in/out] 8 blocks to encrypt.
+ * @param round_keys Encryption round keys (num_rounds + 1 entries).
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline void aes_encrypt_x8(__m128i blocks[8], const __m128i* round_keys, int num_rounds)
+{
+	__m128i b0 = _mm_xor_si128(blocks[0], round_keys[0]);
+	__m128i b1 = _mm_xor_si128(blocks[1], round_keys[0]);
+	__m128i b2 = _mm_xor_si128(blocks[2], round_keys[0]);
+	__m128i b3 = _mm_xor_si128(blocks[3], round_keys[0]);
+	__m128i b4 = _mm_xor_si128(blocks[4], round_keys[0]);
+	__m128i b5 = _mm_xor_si128(blocks[5], round_keys[0]);
+	__m128i b6 = _mm_xor_si128(blocks[6], round_keys[0]);
+	__m128i b7 = _mm_xor_si128(blocks[7], round_keys[0]);
+
+	for (int r = 1; r < num_rounds; ++r)
+	{
+		const __m128i rk = round_keys[r];
+		b0 = _mm_aesenc_si128(b0, rk);
+		b1 = _mm_aesenc_si128(b1, rk);
+		b2 = _mm_aesenc_si128(b2, rk);
+		b3 = _mm_aesenc_si128(b3, rk);
+		b4 = _mm_aesenc_si128(b4, rk);
+		b5 = _mm_aesenc_si128(b5, rk);
+		b6 = _mm_aesenc_si128(b6, rk);
+		b7 = _mm_aesenc_si128(b7, rk);
+	}
+
+	const __m128i last = round_keys[num_rounds];
+	blocks[0] = _mm_aesenclast_si128(b0, last);
+	blocks[1] = _mm_aesenclast_si128(b1, last);
+	blocks[2] = _mm_aesenclast_si128(b2, last);
+	blocks[3] = _mm_aesenclast_si128(b3, last);
+	blocks[4] = _mm_aesenclast_si128(b4, last);
+	blocks[5] = _mm_aesenclast_si128(b5, last);
+	blocks[6] = _mm_aesenclast_si128(b6, last);
+	blocks[7] = _mm_aesenclast_si128(b7, last);
+}
+
+/**
+ * @brief Decrypts one block with the given round keys.
+ *
+ * @param block Input block.
+ * @param round_keys Decryption round keys (num_rounds + 1 entries).
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ * @return Decrypted block.
+ */
+static inline __m128i aes_decrypt_x1(__m128i block, const __m128i* round_keys, int num_rounds)
+{
+	block = _mm_xor_si128(block, round_keys[0]);
+
+	for (int r = 1; r < num_rounds; ++r)
+		block = _mm_aesdec_si128(block, round_keys[r]);
+
+	return _mm_aesdeclast_si128(block, round_keys[num_rounds]);
+}
+
+/**
+ * @brief Decrypts 4 independent blocks in place, interleaving their rounds.
+ *
+ * @param blocks [in/out] 4 blocks to decrypt.
+ * @param round_keys Decryption round keys (num_rounds + 1 entries).
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline void aes_decrypt_x4(__m128i blocks[4], const __m128i* round_keys, int num_rounds)
+{
+	__m128i b0 = _mm_xor_si128(blocks[0], round_keys[0]);
+	__m128i b1 = _mm_xor_si128(blocks[1], round_keys[0]);
+	__m128i b2 = _mm_xor_si128(blocks[2], round_keys[0]);
+	__m128i b3 = _mm_xor_si128(blocks[3], round_keys[0]);
+
+	for (int r = 1; r < num_rounds; ++r)
+	{
+		const __m128i rk = round_keys[r];
+		b0 = _mm_aesdec_si128(b0, rk);
+		b1 = _mm_aesdec_si128(b1, rk);
+		b2 = _mm_aesdec_si128(b2, rk);
+		b3 = _mm_aesdec_si128(b3, rk);
+	}
+
+	const __m128i last = round_keys[num_rounds];
+	blocks[0] = _mm_aesdeclast_si128(b0, last);
+	blocks[1] = _mm_aesdeclast_si128(b1, last);
+	blocks[2] = _mm_aesdeclast_si128(b2, last);
+	blocks[3] = _mm_aesdeclast_si128(b3, last);
+}
+
+/**
+ * @brief Decrypts 8 independent blocks in place, interleaving their rounds.
+ *
+ * @param blocks [in/out] 8 blocks to decrypt.
+ * @param round_keys Decryption round keys (num_rounds + 1 entries).
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline void aes_decrypt_x8(__m128i blocks[8], const __m128i* round_keys, int num_rounds)
+{
+	__m128i b0 = _mm_xor_si128(blocks[0], round_keys[0]);
+	__m128i b1 = _mm_xor_si128(blocks[1], round_keys[0]);
+	__m128i b2 = _mm_xor_si128(blocks[2], round_keys[0]);
+	__m128i b3 = _mm_xor_si128(blocks[3], round_keys[0]);
+	__m128i b4 = _mm_xor_si128(blocks[4], round_keys[0]);
+	__m128i b5 = _mm_xor_si128(blocks[5], round_keys[0]);
+	__m128i b6 = _mm_xor_si128(blocks[6], round_keys[0]);
+	__m128i b7 = _mm_xor_si128(blocks[7], round_keys[0]);
+
+	for (int r = 1; r < num_rounds; ++r)
+	{
+		const __m128i rk = round_keys[r];
+		b0 = _mm_aesdec_si128(b0, rk);
+		b1 = _mm_aesdec_si128(b1, rk);
+		b2 = _mm_aesdec_si128(b2, rk);
+		b3 = _mm_aesdec_si128(b3, rk);
+		b4 = _mm_aesdec_si128(b4, rk);
+		b5 = _mm_aesdec_si128(b5, rk);
+		b6 = _mm_aesdec_si128(b6, rk);
+		b7 = _mm_aesdec_si128(b7, rk);
+	}
+
+	const __m128i last = round_keys[num_rounds];
+	blocks[0] = _mm_aesdeclast_si128(b0, last);
+	blocks[1] = _mm_aesdeclast_si128(b1, last);
+	blocks[2] = _mm_aesdeclast_si128(b2, last);
+	blocks[3] = _mm_aesdeclast_si128(b3, last);
+	blocks[4] = _mm_aesdeclast_si128(b4, last);
+	blocks[5] = _mm_aesdeclast_si128(b5, last);
+	blocks[6] = _mm_aesdeclast_si128(b6, last);
+	blocks[7] = _mm_aesdeclast_si128(b7, last);
+}
+
+/**
+ * @brief Encrypts 4 blocks from (possibly unaligned) memory.
+ *
+ * @param plaintext Array of 4 input blocks.
+ * @param ciphertext Output array of 4 blocks (may alias plaintext).
+ * @param enc_round_keys Encryption round keys.
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline void aes_encrypt_blocks_x4(const __m128i* plaintext, __m128i* ciphertext, const __m128i* enc_round_keys, int num_rounds)
+{
+	__m128i blocks[4];
+
+	for (int i = 0; i < 4; ++i)
+		blocks[i] = _mm_loadu_si128(plaintext + i);
+
+	aes_encrypt_x4(blocks, enc_round_keys, num_rounds);
+
+	for (int i = 0; i < 4; ++i)
+		_mm_storeu_si128(ciphertext + i, blocks[i]);
+}
+
+/**
+ * @brief Encrypts 8 blocks from (possibly unaligned) memory.
+ *
+ * @param plaintext Array of 8 input blocks.
+ * @param ciphertext Output array of 8 blocks (may alias plaintext).
+ * @param enc_round_keys Encryption round keys.
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline void aes_encrypt_blocks_x8(const __m128i* plaintext, __m128i* ciphertext, const __m128i* enc_round_keys, int num_rounds)
+{
+	__m128i blocks[8];
+
+	for (int i = 0; i < 8; ++i)
+		blocks[i] = _mm_loadu_si128(plaintext + i);
+
+	aes_encrypt_x8(blocks, enc_round_keys, num_rounds);
+
+	for (int i = 0; i < 8; ++i)
+		_mm_storeu_si128(ciphertext + i, blocks[i]);
+}
+
+/**
+ * @brief Encrypts num_blocks blocks, 8 at a time, then 4, then one by one.
+ *
+ * @param plaintext Array of num_blocks input blocks.
+ * @param ciphertext Output array of num_blocks blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to encrypt.
+ * @param enc_round_keys Encryption round keys.
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline void aes_encrypt_blocks_xn(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i* enc_round_keys, int num_rounds)
+{
+	size_t i = 0;
+
+	for (; i + 8 <= num_blocks; i += 8)
+		aes_encrypt_blocks_x8(plaintext + i, ciphertext + i, enc_round_keys, num_rounds);
+
+	if (i + 4 <= num_blocks)
+	{
+		aes_encrypt_blocks_x4(plaintext + i, ciphertext + i, enc_round_keys, num_rounds);
+		i += 4;
+	}
+
+	for (; i < num_blocks; ++i)
+		_mm_storeu_si128(ciphertext + i, aes_encrypt_x1(_mm_loadu_si128(plaintext + i), enc_round_keys, num_rounds));
+}
+
+/**
+ * @brief Decrypts 4 blocks from (possibly unaligned) memory.
+ *
+ * @param ciphertext Array of 4 input blocks.
+ * @param plaintext Output array of 4 blocks (may alias ciphertext).
+ * @param dec_round_keys Decryption round keys.
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline void aes_decrypt_blocks_x4(const __m128i* ciphertext, __m128i* plaintext, const __m128i* dec_round_keys, int num_rounds)
+{
+	__m128i blocks[4];
+
+	for (int i = 0; i < 4; ++i)
+		blocks[i] = _mm_loadu_si128(ciphertext + i);
+
+	aes_decrypt_x4(blocks, dec_round_keys, num_rounds);
+
+	for (int i = 0; i < 4; ++i)
+		_mm_storeu_si128(plaintext + i, blocks[i]);
+}
+
+/**
+ * @brief Decrypts 8 blocks from (possibly unaligned) memory.
+ *
+ * @param ciphertext Array of 8 input blocks.
+ * @param plaintext Output array of 8 blocks (may alias ciphertext).
+ * @param dec_round_keys Decryption round keys.
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline void aes_decrypt_blocks_x8(const __m128i* ciphertext, __m128i* plaintext, const __m128i* dec_round_keys, int num_rounds)
+{
+	__m128i blocks[8];
+
+	for (int i = 0; i < 8; ++i)
+		blocks[i] = _mm_loadu_si128(ciphertext + i);
+
+	aes_decrypt_x8(blocks, dec_round_keys, num_rounds);
+
+	for (int i = 0; i < 8; ++i)
+		_mm_storeu_si128(plaintext + i, blocks[i]);
+}
+
+/**
+ * @brief Decrypts num_blocks blocks, 8 at a time, then 4, then one by one.
+ *
+ * @param ciphertext Array of num_blocks input blocks.
+ * @param plaintext Output array of num_blocks blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to decrypt.
+ * @param dec_round_keys Decryption round keys.
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline void aes_decrypt_blocks_xn(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i* dec_round_keys, int num_rounds)
+{
+	size_t i = 0;
+
+	for (; i + 8 <= num_blocks; i += 8)
+		aes_decrypt_blocks_x8(ciphertext + i, plaintext + i, dec_round_keys, num_rounds);
+
+	if (i + 4 <= num_blocks)
+	{
+		aes_decrypt_blocks_x4(ciphertext + i, plaintext + i, dec_round_keys, num_rounds);
+		i += 4;
+	}
+
+	for (; i < num_blocks; ++i)
+		_mm_storeu_si128(plaintext + i, aes_decrypt_x1(_mm_loadu_si128(ciphertext + i), dec_round_keys, num_rounds));
+}
+
+/**
+ * @brief Returns the shuffle mask reversing the byte order of a block.
+ *
+ * Converts a big-endian counter block to a little-endian 128-bit integer and back.
+ *
+ * @return Byte-reversal mask for _mm_shuffle_epi8().
+ */
+static inline __m128i aes_bswap_mask(void)
+{
+	return _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+}
+
+/**
+ * @brief Multiplies a block by x in GF(2^128) (shift left by one bit, big-endian).
+ *
+ * This is the doubling of CMAC subkeys, OCB offsets and SIV's S2V.
+ *
+ * @param block Block as stored in memory.
+ * @return block * x, reduced with 0x87.
+ */
+static inline __m128i aes_gf128_double(__m128i block)
+{
+	const __m128i bswap = aes_bswap_mask();
+	__m128i value = _mm_shuffle_epi8(block, bswap);
+
+	// Shift each 32-bit lane and move the bits shifted out to the next lane
+	__m128i carries = _mm_shuffle_epi32(_mm_srai_epi32(value, 31), 0x93);
+	value = _mm_xor_si128(_mm_slli_epi32(value, 1), _mm_and_si128(carries, _mm_set_epi32(1, 1, 1, 0x87)));
+
+	return _mm_shuffle_epi8(value, bswap);
+}
+
+/**
+ * @brief Adds n to a 128-bit little-endian counter, carrying into the high half.
+ *
+ * @param counter Counter as a little-endian 128-bit integer.
+ * @param n Value to add.
+ * @return counter + n (mod 2^128).
+ */
+static inline __m128i aes_ctr_add(__m128i counter, uint64_t n)
+{
+	__m128i sum = _mm_add_epi64(counter, _mm_set_epi64x(0, (long long)n));
+
+	// The low half wrapped around: propagate the carry
+	if ((uint64_t)_mm_cvtsi128_si64(sum) < n)
+		sum = _mm_add_epi64(sum, _mm_set_epi64x(1, 0));
+
+	return sum;
+}
+
+/**
+ * @brief Produces count consecutive big-endian counter blocks.
+ *
+ * When the low 64 bits cannot wrap within the batch (all but once every 2^64
+ * blocks), the counters are derived with plain 64-bit SIMD additions.
+ *
+ * @param counter First counter as a little-endian 128-bit integer.
+ * @param blocks Output array of count big-endian counter blocks.
+ * @param count Number of counters (at most 8).
+ */
+static inline void aes_ctr_load_xn(__m128i counter, __m128i* blocks, int count)
+{
+	const __m128i bswap = aes_bswap_mask();
+
+	if ((uint64_t)_mm_cvtsi128_si64(counter) <= UINT64_MAX - (uint64_t)count)
+	{
+		for (int j = 0; j < count; ++j)
+			blocks[j] = _mm_shuffle_epi8(_mm_add_epi64(counter, _mm_set_epi64x(0, j)), bswap);
+	}
+	else
+	{
+		for (int j = 0; j < count; ++j)
+			blocks[j] = _mm_shuffle_epi8(aes_ctr_add(counter, (uint64_t)j), bswap);
+	}
+}
+
+/**
+ * @brief Encrypts num_blocks whole blocks in CTR mode, 8 counters in flight.
+ *
+ * @param input Array of num_blocks input blocks.
+ * @param output Output array of num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks.
+ * @param enc_round_keys Encryption round keys.
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline void aes_ctr_blocks_xn(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i* enc_round_keys, int num_rounds)
+{
+	const __m128i bswap = aes_bswap_mask();
+	__m128i ctr = _mm_shuffle_epi8(_mm_loadu_si128(counter), bswap);
+	__m128i blocks[8];
+	size_t i = 0;
+
+	for (; i + 8 <= num_blocks; i += 8)
+	{
+		aes_ctr_load_xn(ctr, blocks, 8);
+		ctr = aes_ctr_add(ctr, 8);
+
+		aes_encrypt_x8(blocks, enc_round_keys, num_rounds);
+
+		for (int j = 0; j < 8; ++j)
+			_mm_storeu_si128(output + i + j, _mm_xor_si128(_mm_loadu_si128(input + i + j), blocks[j]));
+	}
+
+	if (i + 4 <= num_blocks)
+	{
+		aes_ctr_load_xn(ctr, blocks, 4);
+		ctr = aes_ctr_add(ctr, 4);
+
+		aes_encrypt_x4(blocks, enc_round_keys, num_rounds);
+
+		for (int j = 0; j < 4; ++j)
+			_mm_storeu_si128(output + i + j, _mm_xor_si128(_mm_loadu_si128(input + i + j), blocks[j]));
+
+		i += 4;
+	}
+
+	for (; i < num_blocks; ++i)
+	{
+		__m128i keystream = aes_encrypt_x1(_mm_shuffle_epi8(ctr, bswap), enc_round_keys, num_rounds);
+		ctr = aes_ctr_add(ctr, 1);
+
+		_mm_storeu_si128(output + i, _mm_xor_si128(_mm_loadu_si128(input + i), keystream));
+	}
+
+	_mm_storeu_si128(counter, _mm_shuffle_epi8(ctr, bswap));
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_ROUNDS_H
\ No newline at end of file
@@ -0,0 +1,237 @@
+/**
+ * @file aes/core/aes_vaes.h
+ * @brief Wide-vector AES block kernels (VAES on 256-bit and 512-bit registers).
+ *
+ * This header declares multi-block encryption and decryption kernels built on the
+ * VAES extension, which applies one AES round to 2 (`_mm256_aesenc_epi128`) or
+ * 4 (`_mm512_aesenc_epi128`) independent blocks per instruction.
+ *
+ * The kernels share the signature of the AES-NI kernels (see aes_blocks_func_t
+ * and aes_ctr_func_t)
+ * so that aes_context_init() can select them when the CPU supports them. They are
+ * compiled with per-function target attributes and must only be called after
+ * checking that the running CPU supports the required extensions:
+ *   - `*_vaes256`: AVX2 + VAES
+ *   - `*_vaes512`: AVX-512F + AVX-512BW + VAES
+ */
+
+#ifndef AES_VAES_H
+#define AES_VAES_H
+
+#include "aes/core/aes_constants.h"
+#include <stddef.h>
+#include <emmintrin.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Encrypts num_blocks independent blocks using AES-128 and VAES-256.
+ *
+ * @param plaintext Array of num_blocks input blocks (may be unaligned).
+ * @param ciphertext Output array receiving num_blocks encrypted blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to encrypt.
+ * @param enc_round_keys Array of 11 encryption round keys.
+ */
+void aes128_encrypt_blocks_vaes256(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks independent blocks using AES-192 and VAES-256.
+ *
+ * @param plaintext Array of num_blocks input blocks (may be unaligned).
+ * @param ciphertext Output array receiving num_blocks encrypted blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to encrypt.
+ * @param enc_round_keys Array of 13 encryption round keys.
+ */
+void aes192_encrypt_blocks_vaes256(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks independent blocks using AES-256 and VAES-256.
+ *
+ * @param plaintext Array of num_blocks input blocks (may be unaligned).
+ * @param ciphertext Output array receiving num_blocks encrypted blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to encrypt.
+ * @param enc_round_keys Array of 15 encryption round keys.
+ */
+void aes256_encrypt_blocks_vaes256(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts num_blocks independent blocks using AES-128 and VAES-256.
+ *
+ * @param ciphertext Array of num_blocks input blocks (may be unaligned).
+ * @param plaintext Output array receiving num_blocks decrypted blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to decrypt.
+ * @param dec_round_keys Array of 11 decryption round keys.
+ */
+void aes128_decrypt_blocks_vaes256(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts num_blocks independent blocks using AES-192 and VAES-256.
+ *
+ * @param ciphertext Array of num_blocks input blocks (may be unaligned).
+ * @param plaintext Output array receiving num_blocks decrypted blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to decrypt.
+ * @param dec_round_keys Array of 13 decryption round keys.
+ */
+void aes192_decrypt_blocks_vaes256(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts num_blocks independent blocks using AES-256 and VAES-256.
+ *
+ * @param ciphertext Array of num_blocks input blocks (may be unaligned).
+ * @param plaintext Output array receiving num_blocks decrypted blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to decrypt.
+ * @param dec_round_keys Array of 15 decryption round keys.
+ */
+void aes256_decrypt_blocks_vaes256(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_256_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks independent blocks using AES-128 and VAES-512.
+ *
+ * @param plaintext Array of num_blocks input blocks (may be unaligned).
+ * @param ciphertext Output array receiving num_blocks encrypted blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to encrypt.
+ * @param enc_round_keys Array of 11 encryption round keys.
+ */
+void aes128_encrypt_blocks_vaes512(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks independent blocks using AES-192 and VAES-512.
+ *
+ * @param plaintext Array of num_blocks input blocks (may be unaligned).
+ * @param ciphertext Output array receiving num_blocks encrypted blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to encrypt.
+ * @param enc_round_keys Array of 13 encryption round keys.
+ */
+void aes192_encrypt_blocks_vaes512(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks independent blocks using AES-256 and VAES-512.
+ *
+ * @param plaintext Array of num_blocks input blocks (may be unaligned).
+ * @param ciphertext Output array receiving num_blocks encrypted blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to encrypt.
+ * @param enc_round_keys Array of 15 encryption round keys.
+ */
+void aes256_encrypt_blocks_vaes512(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts num_blocks independent blocks using AES-128 and VAES-512.
+ *
+ * @param ciphertext Array of num_blocks input blocks (may be unaligned).
+ * @param plaintext Output array receiving num_blocks decrypted blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to decrypt.
+ * @param dec_round_keys Array of 11 decryption round keys.
+ */
+void aes128_decrypt_blocks_vaes512(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts num_blocks independent blocks using AES-192 and VAES-512.
+ *
+ * @param ciphertext Array of num_blocks input blocks (may be unaligned).
+ * @param plaintext Output array receiving num_blocks decrypted blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to decrypt.
+ * @param dec_round_keys Array of 13 decryption round keys.
+ */
+void aes192_decrypt_blocks_vaes512(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Decrypts num_blocks independent blocks using AES-256 and VAES-512.
+ *
+ * @param ciphertext Array of num_blocks input blocks (may be unaligned).
+ * @param plaintext Output array receiving num_blocks decrypted blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to decrypt.
+ * @param dec_round_keys Array of 15 decryption round keys.
+ */
+void aes256_decrypt_blocks_vaes512(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_256_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks whole blocks in CTR mode using AES-128 and VAES-256.
+ *
+ * Each input block is XORed with the encryption of the current counter, which
+ * is then incremented as a 128-bit big-endian integer.
+ *
+ * @param input Array of num_blocks input blocks (may be unaligned).
+ * @param output Output array receiving num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks on return.
+ * @param enc_round_keys Array of 11 encryption round keys.
+ */
+void aes128_ctr_blocks_vaes256(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks whole blocks in CTR mode using AES-192 and VAES-256.
+ *
+ * Each input block is XORed with the encryption of the current counter, which
+ * is then incremented as a 128-bit big-endian integer.
+ *
+ * @param input Array of num_blocks input blocks (may be unaligned).
+ * @param output Output array receiving num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks on return.
+ * @param enc_round_keys Array of 13 encryption round keys.
+ */
+void aes192_ctr_blocks_vaes256(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks whole blocks in CTR mode using AES-256 and VAES-256.
+ *
+ * Each input block is XORed with the encryption of the current counter, which
+ * is then incremented as a 128-bit big-endian integer.
+ *
+ * @param input Array of num_blocks input blocks (may be unaligned).
+ * @param output Output array receiving num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks on return.
+ * @param enc_round_keys Array of 15 encryption round keys.
+ */
+void aes256_ctr_blocks_vaes256(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks whole blocks in CTR mode using AES-128 and VAES-512.
+ *
+ * Each input block is XORed with the encryption of the current counter, which
+ * is then incremented as a 128-bit big-endian integer.
+ *
+ * @param input Array of num_blocks input blocks (may be unaligned).
+ * @param output Output array receiving num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks on return.
+ * @param enc_round_keys Array of 11 encryption round keys.
+ */
+void aes128_ctr_blocks_vaes512(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks whole blocks in CTR mode using AES-192 and VAES-512.
+ *
+ * Each input block is XORed with the encryption of the current counter, which
+ * is then incremented as a 128-bit big-endian integer.
+ *
+ * @param input Array of num_blocks input blocks (may be unaligned).
+ * @param output Output array receiving num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks on return.
+ * @param enc_round_keys Array of 13 encryption round keys.
+ */
+void aes192_ctr_blocks_vaes512(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS]);
+
+/**
+ * @brief Encrypts num_blocks whole blocks in CTR mode using AES-256 and VAES-512.
+ *
+ * Each input block is XORed with the encryption of the current counter, which
+ * is then incremented as a 128-bit big-endian integer.
+ *
+ * @param input Array of num_blocks input blocks (may be unaligned).
+ * @param output Output array receiving num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks on return.
+ * @param enc_round_keys Array of 15 encryption round keys.
+ */
+void aes256_ctr_blocks_vaes512(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_VAES_H
@@ -0,0 +1,141 @@
+/**
+ * @file aes/mac/aes_cmac.h
+ * @brief AES-CMAC message authentication code (RFC 4493, NIST SP 800-38B).
+ *
+ * The subkeys K1 and K2 are derived once per AES key into an aes_cmac_key_t,
+ * meant to be kept next to the AES context and shared by every message
+ * authenticated under that key, so that each MAC costs only its CBC-MAC chain.
+ *
+ * A single CBC-MAC chain is latency-bound: each block waits for the previous
+ * AES result. aes_cmac_batch() authenticates independent messages together,
+ * running up to 8 chains interleaved through the AES pipeline, which is the
+ * fast path for large numbers of short messages.
+ */
+
+#ifndef AES_CMAC_H
+#define AES_CMAC_H
+
+#include "aes/core/aes_context.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// CMAC output size in bytes
+#define AES_CMAC_SIZE 16
+
+/// Shortest accepted tag in bytes when verifying a truncated MAC
+#define AES_CMAC_MIN_TAG_SIZE 4
+
+/// Number of message chains interleaved by aes_cmac_batch()
+#define AES_CMAC_BATCH_LANES 8
+
+/**
+ * @brief CMAC key: AES context and cached subkeys.
+ *
+ * Read-only once initialized; may be shared between threads. The AES context
+ * must outlive it.
+ */
+typedef struct {
+	const aes_context_t* ctx; ///< AES context of the key
+	__m128i k1; ///< Subkey for messages ending on a whole block
+	__m128i k2; ///< Subkey for padded messages
+} aes_cmac_key_t;
+
+/**
+ * @brief State of an incremental CMAC computation.
+ *
+ * Initialized with aes_cmac_init(); the key must outlive it.
+ */
+typedef struct {
+	const aes_cmac_key_t* key; ///< CMAC key
+	__m128i mac; ///< CBC-MAC chain value
+	uint8_t buffer[AES_BLOCK_SIZE]; ///< Pending block (the last block is only processed by aes_cmac_final())
+	size_t buffer_len; ///< Number of bytes in buffer
+} aes_cmac_t;
+
+/**
+ * @brief Derives the subkeys K1 and K2 of an AES key.
+ *
+ * @param key CMAC key to initialize.
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_cmac_key_init(aes_cmac_key_t* key, const aes_context_t* ctx);
+
+/**
+ * @brief Starts a CMAC computation.
+ *
+ * @param cmac State to initialize.
+ * @param key Initialized CMAC key.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_cmac_init(aes_cmac_t* cmac, const aes_cmac_key_t* key);
+
+/**
+ * @brief Authenticates the next part of the message.
+ *
+ * Parts may have any length; a sequence of calls authenticates the
+ * concatenated data.
+ *
+ * @param cmac Initialized state.
+ * @param data Data (may be NULL if len is 0).
+ * @param len Length of the data in bytes.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_cmac_update(aes_cmac_t* cmac, const uint8_t* data, size_t len);
+
+/**
+ * @brief Processes the last block and returns the MAC.
+ *
+ * @param cmac Initialized state (must be re-initialized before reuse).
+ * @param tag Buffer receiving the AES_CMAC_SIZE-byte MAC.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_cmac_final(aes_cmac_t* cmac, uint8_t* tag);
+
+/**
+ * @brief Computes the MAC of a message in one call.
+ *
+ * @param key Initialized CMAC key.
+ * @param data Message (may be NULL if len is 0).
+ * @param len Length of the message in bytes.
+ * @param tag Buffer receiving the AES_CMAC_SIZE-byte MAC.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_cmac(const aes_cmac_key_t* key, const uint8_t* data, size_t len, uint8_t* tag);
+
+/**
+ * @brief Verifies a possibly truncated MAC in constant time.
+ *
+ * @param key Initialized CMAC key.
+ * @param data Message (may be NULL if len is 0).
+ * @param len Length of the message in bytes.
+ * @param tag MAC to check (its first tag_len bytes).
+ * @param tag_len Tag length in bytes (AES_CMAC_MIN_TAG_SIZE to AES_CMAC_SIZE).
+ * @return 0 if the MAC is valid, non-zero on mismatch or invalid argument.
+ */
+int aes_cmac_verify(const aes_cmac_key_t* key, const uint8_t* data, size_t len, const uint8_t* tag, size_t tag_len);
+
+/**
+ * @brief Computes the MACs of independent messages under the same key.
+ *
+ * Messages are taken AES_CMAC_BATCH_LANES at a time and their CBC-MAC chains
+ * advance together, one block of each message per step. Messages of similar
+ * lengths make the best use of the interleaving.
+ *
+ * @param key Initialized CMAC key.
+ * @param messages Array of count message pointers (entries may be NULL for empty messages).
+ * @param lengths Array of count message lengths in bytes.
+ * @param count Number of messages.
+ * @param tags Array of count AES_CMAC_SIZE-byte buffers receiving the MACs.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_cmac_batch(const aes_cmac_key_t* key, const uint8_t* const* messages, const size_t* lengths, size_t count, uint8_t (*tags)[AES_CMAC_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_CMAC_H
\ No newline at end of file
@@ -0,0 +1,136 @@
+/**
+ * @file aes/mac/aes_ghash.h
+ * @brief GHASH universal hash over GF(2^128) with precomputed hash key powers.
+ *
+ * GHASH (NIST SP 800-38D) is the authentication component of GCM and GMAC.
+ * This header exposes it on its own: the hash key H and its powers H^2..H^8
+ * are computed once per key into a cache-aligned table (aes_ghash_key_t), meant
+ * to be kept next to the AES context it was derived from and shared by every
+ * message authenticated under that key.
+ *
+ * Data is hashed 8 blocks per reduction with PCLMULQDQ (aggregated reduction).
+ * When the kernels selected at key initialization are VAES (see aes_dispatch.h)
+ * and the CPU supports VPCLMULQDQ, the 8 multiplications run on 256-bit
+ * registers, 2 blocks each.
+ *
+ * The streaming interface (aes_ghash_init(), aes_ghash_update(), aes_ghash_final())
+ * accepts data in parts of any length, so streams are hashed without buffering.
+ */
+
+#ifndef AES_GHASH_H
+#define AES_GHASH_H
+
+#include "aes/core/aes_context.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Number of hash key powers, i.e. blocks hashed per reduction
+#define AES_GHASH_H_POWERS 8
+
+/// GHASH output size in bytes
+#define AES_GHASH_SIZE 16
+
+/**
+ * @brief Precomputed GHASH key: H^1..H^8, byte-reflected.
+ *
+ * The 128-byte power table is aligned on a cache line, so it spans exactly two
+ * lines. Read-only once initialized; may be shared between threads.
+ */
+typedef struct {
+	_Alignas(AES_CACHE_LINE_SIZE) __m128i h_powers[AES_GHASH_H_POWERS]; ///< h_powers[i] = H^(i+1)
+	int vpclmulqdq; ///< 1 if bulk hashing uses the 256-bit VPCLMULQDQ kernel (selected at initialization)
+} aes_ghash_key_t;
+
+/**
+ * @brief State of an incremental GHASH computation.
+ *
+ * Initialized with aes_ghash_init(); the key table must outlive it.
+ */
+typedef struct {
+	const aes_ghash_key_t* key; ///< Hash key table
+	__m128i acc; ///< Accumulator, byte-reflected
+	uint8_t buffer[AES_BLOCK_SIZE]; ///< Pending partial block
+	size_t buffer_len; ///< Number of bytes in buffer
+} aes_ghash_t;
+
+/**
+ * @brief Derives the GHASH key of an AES key, H = E(K, 0^128), as used by GCM and GMAC.
+ *
+ * @param key Key table to initialize.
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @return 0 on success, non-zero on invalid argument or missing PCLMULQDQ support.
+ */
+int aes_ghash_key_init(aes_ghash_key_t* key, const aes_context_t* ctx);
+
+/**
+ * @brief Initializes a GHASH key table from a raw hash key.
+ *
+ * @param key Key table to initialize.
+ * @param h 16-byte hash key H.
+ * @return 0 on success, non-zero on invalid argument or missing PCLMULQDQ support.
+ */
+int aes_ghash_key_init_raw(aes_ghash_key_t* key, const uint8_t* h);
+
+/**
+ * @brief Starts a GHASH computation with a zero accumulator.
+ *
+ * @param ghash State to initialize.
+ * @param key Initialized key table.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_ghash_init(aes_ghash_t* ghash, const aes_ghash_key_t* key);
+
+/**
+ * @brief Hashes the next part of the data.
+ *
+ * Parts may have any length: bytes that do not complete a block are kept until
+ * the next call, so a sequence of calls hashes the concatenated data.
+ *
+ * @param ghash Initialized state.
+ * @param data Data (may be NULL if len is 0).
+ * @param len Length of the data in bytes.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_ghash_update(aes_ghash_t* ghash, const uint8_t* data, size_t len);
+
+/**
+ * @brief Zero-pads and hashes the pending partial block, if any.
+ *
+ * Used to separate fields that are padded independently (e.g. AAD and ciphertext in GCM).
+ *
+ * @param ghash Initialized state.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_ghash_pad(aes_ghash_t* ghash);
+
+/**
+ * @brief Pads the data and returns the hash value.
+ *
+ * The state may be updated further afterwards; the data hashed so far is then
+ * considered padded to a whole number of blocks.
+ *
+ * @param ghash Initialized state.
+ * @param digest Buffer receiving the AES_GHASH_SIZE-byte hash value.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_ghash_final(aes_ghash_t* ghash, uint8_t* digest);
+
+/**
+ * @brief Hashes a message in one call: GHASH_H of the zero-padded data.
+ *
+ * @param key Initialized key table.
+ * @param data Data (may be NULL if len is 0).
+ * @param len Length of the data in bytes.
+ * @param digest Buffer receiving the AES_GHASH_SIZE-byte hash value.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_ghash(const aes_ghash_key_t* key, const uint8_t* data, size_t len, uint8_t* digest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_GHASH_H
\ No newline at end of file
@@ -0,0 +1,119 @@
+/**
+ * @file aes/mac/aes_polyval.h
+ * @brief POLYVAL universal hash (RFC 8452) with precomputed hash key powers.
+ *
+ * POLYVAL is the little-endian counterpart of GHASH used by AES-GCM-SIV and
+ * HCTR2. By RFC 8452 appendix A, POLYVAL(H, X) equals the byte-reversed GHASH of
+ * the byte-reversed blocks under the key mulX_GHASH(ByteReverse(H)). The blocks
+ * are therefore multiplied as loaded, without byte swaps, by the same
+ * PCLMULQDQ helpers as GHASH (see aes_clmul.h), 8 blocks per reduction.
+ *
+ * The key table is derived from a raw 16-byte key: GCM-SIV derives a new one
+ * for every nonce, so the table is small and cheap to build.
+ */
+
+#ifndef AES_POLYVAL_H
+#define AES_POLYVAL_H
+
+#include "aes/core/aes_constants.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <emmintrin.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Number of hash key powers, i.e. blocks hashed per reduction
+#define AES_POLYVAL_H_POWERS 8
+
+/// POLYVAL output size in bytes
+#define AES_POLYVAL_SIZE 16
+
+/**
+ * @brief Precomputed POLYVAL key: powers of mulX_GHASH(ByteReverse(H)), in the GHASH domain.
+ *
+ * Read-only once initialized; may be shared between threads.
+ */
+typedef struct {
+	_Alignas(AES_CACHE_LINE_SIZE) __m128i h_powers[AES_POLYVAL_H_POWERS]; ///< h_powers[i] = power i+1 of the converted key
+} aes_polyval_key_t;
+
+/**
+ * @brief State of an incremental POLYVAL computation.
+ *
+ * Initialized with aes_polyval_init(); the key table must outlive it.
+ */
+typedef struct {
+	const aes_polyval_key_t* key; ///< Hash key table
+	__m128i acc; ///< Accumulator (the POLYVAL value as stored in memory)
+	uint8_t buffer[AES_BLOCK_SIZE]; ///< Pending partial block
+	size_t buffer_len; ///< Number of bytes in buffer
+} aes_polyval_t;
+
+/**
+ * @brief Initializes a POLYVAL key table from a raw hash key.
+ *
+ * @param key Key table to initialize.
+ * @param h 16-byte hash key H.
+ * @return 0 on success, non-zero on invalid argument or missing PCLMULQDQ support.
+ */
+int aes_polyval_key_init(aes_polyval_key_t* key, const uint8_t* h);
+
+/**
+ * @brief Starts a POLYVAL computation with a zero accumulator.
+ *
+ * @param polyval State to initialize.
+ * @param key Initialized key table.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_polyval_init(aes_polyval_t* polyval, const aes_polyval_key_t* key);
+
+/**
+ * @brief Hashes the next part of the data.
+ *
+ * Parts may have any length: bytes that do not complete a block are kept until
+ * the next call, so a sequence of calls hashes the concatenated data.
+ *
+ * @param polyval Initialized state.
+ * @param data Data (may be NULL if len is 0).
+ * @param len Length of the data in bytes.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_polyval_update(aes_polyval_t* polyval, const uint8_t* data, size_t len);
+
+/**
+ * @brief Zero-pads and hashes the pending partial block, if any.
+ *
+ * Used to separate fields that are padded independently (e.g. AAD and plaintext in GCM-SIV).
+ *
+ * @param polyval Initialized state.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_polyval_pad(aes_polyval_t* polyval);
+
+/**
+ * @brief Pads the data and returns the hash value.
+ *
+ * @param polyval Initialized state.
+ * @param digest Buffer receiving the AES_POLYVAL_SIZE-byte hash value.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_polyval_final(aes_polyval_t* polyval, uint8_t* digest);
+
+/**
+ * @brief Hashes a message in one call: POLYVAL_H of the zero-padded data.
+ *
+ * @param key Initialized key table.
+ * @param data Data (may be NULL if len is 0).
+ * @param len Length of the data in bytes.
+ * @param digest Buffer receiving the AES_POLYVAL_SIZE-byte hash value.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_polyval(const aes_polyval_key_t* key, const uint8_t* data, size_t len, uint8_t* digest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_POLYVAL_H
\ No newline at end of file
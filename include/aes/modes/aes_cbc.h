@@ -8,6 +8,9 @@
  * CBC mode ensures better confidentiality than ECB by chaining blocks.
  * The input must be a multiple of AES_BLOCK_SIZE (16 bytes). Padding
  * must be applied before encryption and removed after decryption.
+ *
+ * CBC encryption of one message is serial; aes_cbc_encrypt_multi() recovers
+ * throughput by interleaving the chains of up to 8 independent messages.
  */
 
 #ifndef AES_CBC_H
@@ -20,6 +23,17 @@
 extern "C" {
 #endif
 
+/**
+ * @brief One independent CBC encryption for aes_cbc_encrypt_multi().
+ */
+typedef struct {
+	const aes_context_t* ctx; ///< AES context of the message
+	const uint8_t* iv; ///< 16-byte initialization vector of the message
+	const uint8_t* input; ///< Plaintext (input_len bytes)
+	size_t input_len; ///< Length in bytes (must be a multiple of 16)
+	uint8_t* output; ///< Ciphertext (input_len bytes, may alias input)
+} aes_cbc_job_t;
+
 /**
  * @brief Encrypts a buffer using AES in CBC mode.
  *
@@ -36,6 +50,23 @@ extern "C" {
  */
 void aes_cbc_encrypt(const aes_context_t* ctx, const uint8_t iv[16], const uint8_t* input, size_t input_len, uint8_t* output);
 
+/**
+ * @brief Encrypts several independent messages in CBC mode, interleaving their chains.
+ *
+ * Up to 8 messages (lanes) are in the AES pipeline at once, each with its own
+ * context, IV and length. When a lane finishes, the next pending message takes
+ * its place. Messages are grouped by key size; the output of each message is
+ * identical to aes_cbc_encrypt(). All jobs are checked first: if any is
+ * invalid (NULL pointer, length not a multiple of 16), no output is written.
+ *
+ * Buffers of different jobs must not overlap.
+ *
+ * @param jobs Array of jobs.
+ * @param num_jobs Number of jobs.
+ * @return 0 on success, 1 if the array or any job is invalid.
+ */
+int aes_cbc_encrypt_multi(const aes_cbc_job_t* jobs, size_t num_jobs);
+
 /**
  * @brief Decrypts a buffer using AES in CBC mode.
  *
@@ -43,7 +74,7 @@ void aes_cbc_encrypt(const aes_context_t* ctx, const uint8_t iv[16], const uint8
  * Padding removal must be handled externally after decryption.
  * The IV must be the same as used during encryption.
  *
- * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param ctx Pointer to a valid AES context with its decryption schedule (aes_context_init, or aes_context_prepare_decrypt after aes_context_init_encrypt).
  * @param iv 16-byte initialization vector (IV) used during encryption. Must not be NULL.
  * @param input Pointer to the ciphertext buffer.
  * @param input_len Length of the input in bytes (must be a multiple of 16).
@@ -0,0 +1,88 @@
+/**
+ * @file aes/modes/aes_ccm.h
+ * @brief AES Counter with CBC-MAC (CCM) authenticated encryption.
+ *
+ * This header provides AES-CCM (NIST SP 800-38C, RFC 3610) on top of a
+ * pre-initialized AES context. CCM authenticates the nonce, the lengths, the
+ * additional data (AAD) and the plaintext with a CBC-MAC, and encrypts the
+ * plaintext and the MAC in CTR mode.
+ *
+ * The payload is processed in a single pass: the CBC-MAC chain, which must wait
+ * for each AES result, runs interleaved with the independent CTR block of the
+ * same step, so the counter encryption fills the AES pipeline while the chain
+ * waits on latency. When decrypting, the keystream is computed one block ahead
+ * so that the MAC of each plaintext block overlaps with the next keystream block.
+ *
+ * Since CCM encodes the payload length before the data, only a one-shot
+ * interface is available.
+ */
+
+#ifndef AES_CCM_H
+#define AES_CCM_H
+
+#include "aes/core/aes_context.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Shortest nonce in bytes (leaves 8 bytes for the payload length)
+#define AES_CCM_MIN_NONCE_SIZE 7
+
+/// Longest nonce in bytes (leaves 2 bytes for the payload length)
+#define AES_CCM_MAX_NONCE_SIZE 13
+
+/// Shortest authentication tag in bytes (tag lengths are even)
+#define AES_CCM_MIN_TAG_SIZE 4
+
+/// Longest authentication tag in bytes
+#define AES_CCM_MAX_TAG_SIZE 16
+
+/**
+ * @brief Encrypts and authenticates a message in one call.
+ *
+ * The payload length must fit in the 15 - nonce_len bytes left by the nonce
+ * (e.g. less than 64 KiB with a 13-byte nonce).
+ *
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param nonce Nonce; must never repeat for the same key.
+ * @param nonce_len Length of the nonce in bytes (AES_CCM_MIN_NONCE_SIZE to AES_CCM_MAX_NONCE_SIZE).
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0).
+ * @param aad_len Length of the additional data in bytes.
+ * @param input Plaintext (may be NULL if input_len is 0).
+ * @param input_len Length of the plaintext in bytes.
+ * @param output Buffer receiving input_len bytes of ciphertext (may alias input).
+ * @param tag Buffer receiving the authentication tag.
+ * @param tag_len Tag length in bytes (even, AES_CCM_MIN_TAG_SIZE to AES_CCM_MAX_TAG_SIZE).
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_ccm_encrypt(const aes_context_t* ctx, const uint8_t* nonce, size_t nonce_len, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, uint8_t* output, uint8_t* tag, size_t tag_len);
+
+/**
+ * @brief Decrypts and verifies a message in one call.
+ *
+ * The tag is compared in constant time. On authentication failure the output
+ * buffer is zeroed.
+ *
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param nonce Nonce used for encryption.
+ * @param nonce_len Length of the nonce in bytes (AES_CCM_MIN_NONCE_SIZE to AES_CCM_MAX_NONCE_SIZE).
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0).
+ * @param aad_len Length of the additional data in bytes.
+ * @param input Ciphertext (may be NULL if input_len is 0).
+ * @param input_len Length of the ciphertext in bytes.
+ * @param output Buffer receiving input_len bytes of plaintext (may alias input).
+ * @param tag Authentication tag to check.
+ * @param tag_len Tag length in bytes (even, AES_CCM_MIN_TAG_SIZE to AES_CCM_MAX_TAG_SIZE).
+ * @return 0 if the message is authentic, non-zero on authentication failure or invalid argument.
+ */
+int aes_ccm_decrypt(const aes_context_t* ctx, const uint8_t* nonce, size_t nonce_len, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, uint8_t* output, const uint8_t* tag, size_t tag_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_CCM_H
\ No newline at end of file
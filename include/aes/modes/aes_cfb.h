@@ -39,7 +39,8 @@ void aes_cfb_encrypt(const aes_context_t* ctx, const uint8_t iv[16], const uint8
  * @brief Decrypts a buffer using AES in CFB mode.
  *
  * CFB decryption mirrors the encryption process and supports arbitrary-length input.
- * The IV must match the one used during encryption.
+ * The IV must match the one used during encryption. Since every keystream block only
+ * depends on the previous ciphertext block, blocks are decrypted several at a time.
  *
  * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
  * @param iv 16-byte initialization vector (IV) used during encryption. Must not be NULL.
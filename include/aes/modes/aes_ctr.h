@@ -7,6 +7,9 @@
  *
  * CTR mode turns a block cipher into a stream cipher by encrypting an incrementing counter
  * and XORing the result with the input. It supports parallel processing and does not require padding.
+ *
+ * Because the keystream of any block only depends on its index, aes_ctr_crypt_at()
+ * can start at an arbitrary byte offset of a stream without processing what precedes it.
  */
 
 #ifndef AES_CTR_H
@@ -33,6 +36,24 @@ extern "C" {
  */
 void aes_ctr_crypt(const aes_context_t* ctx, const uint8_t iv[16], const uint8_t* input, size_t input_len, uint8_t* output);
 
+/**
+ * @brief Encrypts or decrypts a range of a CTR stream starting at a byte offset.
+ *
+ * The counter of the first block is computed as IV + offset / 16 (128-bit big-endian
+ * addition), and processing starts at byte offset % 16 of its keystream. The result
+ * equals bytes [offset, offset + input_len) of aes_ctr_crypt() run from the start of
+ * the stream, at a cost proportional to input_len only.
+ *
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param iv 16-byte initialization vector of the stream (nonce + counter). Must not be NULL.
+ * @param offset Position of input[0] in the stream, in bytes.
+ * @param input Pointer to the input buffer (plaintext or ciphertext).
+ * @param input_len Number of bytes to process.
+ * @param output Pointer to the buffer that will receive the output.
+ *               Must be at least input_len bytes.
+ */
+void aes_ctr_crypt_at(const aes_context_t* ctx, const uint8_t iv[16], uint64_t offset, const uint8_t* input, size_t input_len, uint8_t* output);
+
 #ifdef __cplusplus
 }
 #endif
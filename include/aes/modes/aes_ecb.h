@@ -41,7 +41,7 @@ void aes_ecb_encrypt(const aes_context_t* ctx, const uint8_t* input, size_t inpu
  * The input must be a multiple of 16 bytes (AES block size).
  * Padding removal must be handled externally after decryption.
  *
- * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param ctx Pointer to a valid AES context with its decryption schedule (aes_context_init, or aes_context_prepare_decrypt after aes_context_init_encrypt).
  * @param input Pointer to the ciphertext buffer.
  * @param input_len Length of the input in bytes (must be a multiple of 16).
  * @param output Pointer to the buffer that will receive the plaintext.
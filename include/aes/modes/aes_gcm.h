@@ -0,0 +1,280 @@
+/**
+ * @file aes/modes/aes_gcm.h
+ * @brief AES Galois/Counter Mode (GCM) authenticated encryption.
+ *
+ * This header provides AES-GCM (NIST SP 800-38D) on top of a pre-initialized
+ * AES context: CTR mode encryption with 32-bit counter increments, authenticated
+ * together with additional data (AAD) by GHASH, a polynomial hash over GF(2^128)
+ * computed with the PCLMULQDQ carry-less multiplication instruction.
+ *
+ * Bulk data goes through a stitched kernel that runs the AES rounds of 8 counter
+ * blocks interleaved with the GHASH multiplications of 8 ciphertext blocks, and
+ * reduces the 8 products modulo the GCM polynomial only once (aggregated reduction
+ * with the precomputed powers H^1..H^8 of the hash key).
+ *
+ * The powers of H are computed once per key with aes_ghash_key_init() (see
+ * aes_ghash.h) and passed to every call, next to the AES context.
+ *
+ * Two interfaces are available:
+ *   - one-shot: aes_gcm_encrypt() / aes_gcm_decrypt();
+ *   - incremental: aes_gcm_init(), aes_gcm_update_aad(), aes_gcm_encrypt_update()
+ *     or aes_gcm_decrypt_update(), then aes_gcm_finish() or aes_gcm_verify().
+ *
+ * Long texts can also be split into block-aligned segments processed independently
+ * (e.g. by several threads, see aes_parallel.h): aes_gcm_encrypt_segment() or
+ * aes_gcm_decrypt_segment() return the partial GHASH of a segment, and
+ * aes_gcm_append_segments() folds the partial hashes in order, multiplying by
+ * powers of H, into exactly the state a serial pass would have reached.
+ *
+ * GMAC, the authentication-only variant, is GCM without text: aes_gmac() and
+ * aes_gmac_verify() in one call, or aes_gcm_init(), aes_gcm_update_aad() on the
+ * stream, then aes_gcm_finish() or aes_gcm_verify().
+ */
+
+#ifndef AES_GCM_H
+#define AES_GCM_H
+
+#include "aes/core/aes_context.h"
+#include "aes/mac/aes_ghash.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Recommended IV size in bytes (the only size not requiring a GHASH pass)
+#define AES_GCM_IV_SIZE 12
+
+/// Full authentication tag size in bytes
+#define AES_GCM_TAG_SIZE 16
+
+/// Shortest accepted authentication tag in bytes
+#define AES_GCM_MIN_TAG_SIZE 4
+
+/// Maximum plaintext length in bytes (2^39 - 256 bits)
+#define AES_GCM_MAX_TEXT_SIZE ((1ULL << 36) - 32)
+
+/**
+ * @brief State of an incremental GCM encryption or decryption.
+ *
+ * Initialized with aes_gcm_init(); the AES context and the GHASH key table must outlive it.
+ */
+typedef struct {
+	const aes_context_t* ctx; ///< AES context (encryption round keys)
+	aes_ghash_t ghash; ///< GHASH state (AAD, then ciphertext)
+	__m128i tag_mask; ///< E(K, J0), XORed into the final hash to form the tag
+	__m128i counter; ///< Next counter block (big-endian)
+	uint64_t aad_len; ///< Bytes of AAD absorbed
+	uint64_t text_len; ///< Bytes of plaintext/ciphertext processed
+	uint8_t keystream[AES_BLOCK_SIZE]; ///< Keystream of the pending partial text block
+	size_t keystream_pos; ///< Bytes of keystream already used, 0 if no partial block is pending
+	int text_started; ///< 1 once encryption or decryption data has been processed
+} aes_gcm_context_t;
+
+/**
+ * @brief Result of a text segment processed with aes_gcm_encrypt_segment() or aes_gcm_decrypt_segment().
+ */
+typedef struct {
+	__m128i hash; ///< GHASH of the segment ciphertext from a zero accumulator, byte-reflected
+	uint64_t len; ///< Length of the segment in bytes
+} aes_gcm_segment_t;
+
+/**
+ * @brief Starts a GCM operation.
+ *
+ * Derives the pre-counter block J0 from the IV (directly for 12-byte IVs,
+ * through GHASH otherwise).
+ *
+ * @param gcm GCM state to initialize.
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param hkey GHASH key table of ctx (initialized with aes_ghash_key_init).
+ * @param iv Initialization vector; must never repeat for the same key.
+ * @param iv_len Length of the IV in bytes (non-zero; AES_GCM_IV_SIZE recommended).
+ * @return 0 on success, non-zero on invalid argument or missing PCLMULQDQ support.
+ */
+int aes_gcm_init(aes_gcm_context_t* gcm, const aes_context_t* ctx, const aes_ghash_key_t* hkey, const uint8_t* iv, size_t iv_len);
+
+/**
+ * @brief Absorbs additional authenticated data.
+ *
+ * May be called several times, but only before any encryption or decryption data.
+ *
+ * @param gcm Initialized GCM state.
+ * @param aad Additional data (may be NULL if aad_len is 0).
+ * @param aad_len Length of the data in bytes.
+ * @return 0 on success, non-zero if text has already been processed or on invalid argument.
+ */
+int aes_gcm_update_aad(aes_gcm_context_t* gcm, const uint8_t* aad, size_t aad_len);
+
+/**
+ * @brief Encrypts the next part of the plaintext.
+ *
+ * Parts may have any length; the output of a sequence of calls equals the
+ * output of a single call on the concatenated input.
+ *
+ * @param gcm Initialized GCM state.
+ * @param input Plaintext part.
+ * @param input_len Length of the part in bytes.
+ * @param output Buffer receiving input_len bytes of ciphertext (may alias input).
+ * @return 0 on success, non-zero on invalid argument or if the total length exceeds AES_GCM_MAX_TEXT_SIZE.
+ */
+int aes_gcm_encrypt_update(aes_gcm_context_t* gcm, const uint8_t* input, size_t input_len, uint8_t* output);
+
+/**
+ * @brief Decrypts the next part of the ciphertext.
+ *
+ * The plaintext is released before the tag is checked: it must not be used
+ * until aes_gcm_verify() succeeds.
+ *
+ * @param gcm Initialized GCM state.
+ * @param input Ciphertext part.
+ * @param input_len Length of the part in bytes.
+ * @param output Buffer receiving input_len bytes of plaintext (may alias input).
+ * @return 0 on success, non-zero on invalid argument or if the total length exceeds AES_GCM_MAX_TEXT_SIZE.
+ */
+int aes_gcm_decrypt_update(aes_gcm_context_t* gcm, const uint8_t* input, size_t input_len, uint8_t* output);
+
+/**
+ * @brief Encrypts a segment of the text independently of the other segments.
+ *
+ * The segment starts offset bytes after the current text position of gcm, which
+ * is only read: segments of the same state may be processed concurrently. The
+ * result is folded into gcm with aes_gcm_append_segments().
+ *
+ * @param gcm GCM state after aes_gcm_init() and the AAD, at a block-aligned text position.
+ * @param offset Offset of the segment from the current text position (multiple of AES_BLOCK_SIZE).
+ * @param input Plaintext segment.
+ * @param input_len Length of the segment in bytes (only the last segment may end with a partial block).
+ * @param output Buffer receiving input_len bytes of ciphertext (may alias input).
+ * @param segment Receives the partial GHASH and length of the segment.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_gcm_encrypt_segment(const aes_gcm_context_t* gcm, uint64_t offset, const uint8_t* input, size_t input_len, uint8_t* output, aes_gcm_segment_t* segment);
+
+/**
+ * @brief Decrypts a segment of the text independently of the other segments.
+ *
+ * See aes_gcm_encrypt_segment(); the plaintext must not be used until the tag is verified.
+ *
+ * @param gcm GCM state after aes_gcm_init() and the AAD, at a block-aligned text position.
+ * @param offset Offset of the segment from the current text position (multiple of AES_BLOCK_SIZE).
+ * @param input Ciphertext segment.
+ * @param input_len Length of the segment in bytes (only the last segment may end with a partial block).
+ * @param output Buffer receiving input_len bytes of plaintext (may alias input).
+ * @param segment Receives the partial GHASH and length of the segment.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_gcm_decrypt_segment(const aes_gcm_context_t* gcm, uint64_t offset, const uint8_t* input, size_t input_len, uint8_t* output, aes_gcm_segment_t* segment);
+
+/**
+ * @brief Folds consecutive segments into the GCM state, as if their text had been processed serially.
+ *
+ * The hash is combined as acc' = acc * H^n + hash, n being the number of blocks
+ * of each segment. Segments must be given in text order and start at the
+ * current position. A segment ending with a partial block must be the last text
+ * of the operation: only aes_gcm_finish() or aes_gcm_verify() may follow.
+ *
+ * @param gcm GCM state the segments were computed from.
+ * @param segments Segments in text order.
+ * @param num_segments Number of segments.
+ * @return 0 on success, non-zero on invalid argument or if the total length exceeds AES_GCM_MAX_TEXT_SIZE.
+ */
+int aes_gcm_append_segments(aes_gcm_context_t* gcm, const aes_gcm_segment_t* segments, size_t num_segments);
+
+/**
+ * @brief Completes the operation and produces the authentication tag.
+ *
+ * @param gcm Initialized GCM state.
+ * @param tag Buffer receiving the first tag_len bytes of the tag.
+ * @param tag_len Tag length in bytes (AES_GCM_MIN_TAG_SIZE to AES_GCM_TAG_SIZE).
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_gcm_finish(aes_gcm_context_t* gcm, uint8_t* tag, size_t tag_len);
+
+/**
+ * @brief Completes the operation and checks the authentication tag in constant time.
+ *
+ * @param gcm Initialized GCM state.
+ * @param tag Expected tag.
+ * @param tag_len Tag length in bytes (AES_GCM_MIN_TAG_SIZE to AES_GCM_TAG_SIZE).
+ * @return 0 if the tag matches, non-zero otherwise.
+ */
+int aes_gcm_verify(aes_gcm_context_t* gcm, const uint8_t* tag, size_t tag_len);
+
+/**
+ * @brief Encrypts and authenticates a message in one call.
+ *
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param hkey GHASH key table of ctx, or NULL to derive it for this call only.
+ * @param iv Initialization vector; must never repeat for the same key.
+ * @param iv_len Length of the IV in bytes (AES_GCM_IV_SIZE recommended).
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0).
+ * @param aad_len Length of the additional data in bytes.
+ * @param input Plaintext (may be NULL if input_len is 0).
+ * @param input_len Length of the plaintext in bytes.
+ * @param output Buffer receiving input_len bytes of ciphertext (may alias input).
+ * @param tag Buffer receiving the authentication tag.
+ * @param tag_len Tag length in bytes (AES_GCM_MIN_TAG_SIZE to AES_GCM_TAG_SIZE).
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_gcm_encrypt(const aes_context_t* ctx, const aes_ghash_key_t* hkey, const uint8_t* iv, size_t iv_len,
+	const uint8_t* aad, size_t aad_len, const uint8_t* input, size_t input_len, uint8_t* output, uint8_t* tag, size_t tag_len);
+
+/**
+ * @brief Decrypts and verifies a message in one call.
+ *
+ * On authentication failure the output buffer is zeroed.
+ *
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param hkey GHASH key table of ctx, or NULL to derive it for this call only.
+ * @param iv Initialization vector used for encryption.
+ * @param iv_len Length of the IV in bytes.
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0).
+ * @param aad_len Length of the additional data in bytes.
+ * @param input Ciphertext (may be NULL if input_len is 0).
+ * @param input_len Length of the ciphertext in bytes.
+ * @param output Buffer receiving input_len bytes of plaintext (may alias input).
+ * @param tag Authentication tag to check.
+ * @param tag_len Tag length in bytes (AES_GCM_MIN_TAG_SIZE to AES_GCM_TAG_SIZE).
+ * @return 0 if the message is authentic, non-zero on authentication failure or invalid argument.
+ */
+int aes_gcm_decrypt(const aes_context_t* ctx, const aes_ghash_key_t* hkey, const uint8_t* iv, size_t iv_len,
+	const uint8_t* aad, size_t aad_len, const uint8_t* input, size_t input_len, uint8_t* output, const uint8_t* tag, size_t tag_len);
+
+/**
+ * @brief Computes the GMAC tag of a message (GCM with the message as AAD and no text).
+ *
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param hkey GHASH key table of ctx, or NULL to derive it for this call only.
+ * @param iv Initialization vector; must never repeat for the same key.
+ * @param iv_len Length of the IV in bytes (AES_GCM_IV_SIZE recommended).
+ * @param data Message to authenticate (may be NULL if len is 0).
+ * @param len Length of the message in bytes.
+ * @param tag Buffer receiving the authentication tag.
+ * @param tag_len Tag length in bytes (AES_GCM_MIN_TAG_SIZE to AES_GCM_TAG_SIZE).
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_gmac(const aes_context_t* ctx, const aes_ghash_key_t* hkey, const uint8_t* iv, size_t iv_len,
+	const uint8_t* data, size_t len, uint8_t* tag, size_t tag_len);
+
+/**
+ * @brief Checks the GMAC tag of a message in constant time.
+ *
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param hkey GHASH key table of ctx, or NULL to derive it for this call only.
+ * @param iv Initialization vector used to compute the tag.
+ * @param iv_len Length of the IV in bytes.
+ * @param data Message to authenticate (may be NULL if len is 0).
+ * @param len Length of the message in bytes.
+ * @param tag Authentication tag to check.
+ * @param tag_len Tag length in bytes (AES_GCM_MIN_TAG_SIZE to AES_GCM_TAG_SIZE).
+ * @return 0 if the message is authentic, non-zero on authentication failure or invalid argument.
+ */
+int aes_gmac_verify(const aes_context_t* ctx, const aes_ghash_key_t* hkey, const uint8_t* iv, size_t iv_len,
+	const uint8_t* data, size_t len, const uint8_t* tag, size_t tag_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_GCM_H
\ No newline at end of file
@@ -0,0 +1,77 @@
+/**
+ * @file aes/modes/aes_gcm_siv.h
+ * @brief AES-GCM-SIV nonce-misuse-resistant authenticated encryption (RFC 8452).
+ *
+ * GCM-SIV derives a fresh authentication key and encryption key from the
+ * key-generating key and each nonce, computes the tag with POLYVAL over the
+ * plaintext, and uses the tag as the initial counter of the CTR pass. Repeating
+ * a nonce only reveals whether the same message was encrypted twice.
+ *
+ * The per-nonce key blocks are encrypted with one multi-block call, POLYVAL
+ * hashes 8 blocks per reduction (see aes_polyval.h), and the keystream is
+ * generated in batches by the widest multi-block kernel of the running CPU.
+ * When decrypting, each batch of plaintext is hashed right after it is
+ * produced, while it is still in cache.
+ *
+ * Only AES-128 and AES-256 key-generating keys are defined by the RFC.
+ */
+
+#ifndef AES_GCM_SIV_H
+#define AES_GCM_SIV_H
+
+#include "aes/core/aes_context.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Nonce size in bytes
+#define AES_GCM_SIV_NONCE_SIZE 12
+
+/// Authentication tag size in bytes
+#define AES_GCM_SIV_TAG_SIZE 16
+
+/// Longest plaintext or additional data in bytes (2^36)
+#define AES_GCM_SIV_MAX_INPUT_SIZE ((uint64_t)1 << 36)
+
+/**
+ * @brief Encrypts and authenticates a message in one call.
+ *
+ * @param ctx AES-128 or AES-256 context of the key-generating key.
+ * @param nonce AES_GCM_SIV_NONCE_SIZE-byte nonce.
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0).
+ * @param aad_len Length of the additional data in bytes (at most AES_GCM_SIV_MAX_INPUT_SIZE).
+ * @param input Plaintext (may be NULL if input_len is 0).
+ * @param input_len Length of the plaintext in bytes (at most AES_GCM_SIV_MAX_INPUT_SIZE).
+ * @param output Buffer receiving input_len bytes of ciphertext (may alias input).
+ * @param tag Buffer receiving the AES_GCM_SIV_TAG_SIZE-byte tag.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_gcm_siv_encrypt(const aes_context_t* ctx, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, uint8_t* output, uint8_t* tag);
+
+/**
+ * @brief Decrypts and verifies a message in one call.
+ *
+ * The tag is compared in constant time. On authentication failure the output
+ * buffer is zeroed.
+ *
+ * @param ctx AES-128 or AES-256 context of the key-generating key.
+ * @param nonce AES_GCM_SIV_NONCE_SIZE-byte nonce.
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0).
+ * @param aad_len Length of the additional data in bytes (at most AES_GCM_SIV_MAX_INPUT_SIZE).
+ * @param input Ciphertext (may be NULL if input_len is 0).
+ * @param input_len Length of the ciphertext in bytes (at most AES_GCM_SIV_MAX_INPUT_SIZE).
+ * @param output Buffer receiving input_len bytes of plaintext (may alias input).
+ * @param tag AES_GCM_SIV_TAG_SIZE-byte tag to check.
+ * @return 0 if the message is authentic, non-zero on authentication failure or invalid argument.
+ */
+int aes_gcm_siv_decrypt(const aes_context_t* ctx, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, uint8_t* output, const uint8_t* tag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_GCM_SIV_H
\ No newline at end of file
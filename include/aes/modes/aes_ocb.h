@@ -0,0 +1,105 @@
+/**
+ * @file aes/modes/aes_ocb.h
+ * @brief AES-OCB3 authenticated encryption (RFC 7253).
+ *
+ * OCB encrypts each block once, masked with an offset that changes by one
+ * table lookup per block, and authenticates the plaintext through a running
+ * XOR checksum. All blocks are independent, so the payload and the additional
+ * data are processed 8 blocks at a time through the interleaved AES-NI
+ * kernels (see aes_rounds.h), with the checksum accumulated in the same pass.
+ *
+ * The key-dependent values L_*, L_$ and L_i = 2^i * L_$ are derived once into
+ * an aes_ocb_key_t, kept next to the AES context and shared by every message
+ * encrypted under that key. Encryption uses the context's encryption round
+ * keys and decryption its decryption round keys, so an encrypt-only context
+ * (see aes_context_init_encrypt()) is rejected by aes_ocb_decrypt().
+ */
+
+#ifndef AES_OCB_H
+#define AES_OCB_H
+
+#include "aes/core/aes_context.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Longest nonce in bytes (RFC 7253 allows 1 to 15 bytes)
+#define AES_OCB_MAX_NONCE_SIZE 15
+
+/// Shortest accepted authentication tag in bytes
+#define AES_OCB_MIN_TAG_SIZE 4
+
+/// Longest authentication tag in bytes
+#define AES_OCB_TAG_SIZE 16
+
+/// Number of precomputed L_i values; bounds the payload and AAD to 2^32 - 1 blocks each
+#define AES_OCB_L_TABLE_SIZE 32
+
+/**
+ * @brief OCB key: AES context and precomputed offsets.
+ *
+ * Read-only once initialized; may be shared between threads. The AES context
+ * must outlive it.
+ */
+typedef struct {
+	_Alignas(AES_CACHE_LINE_SIZE) __m128i l[AES_OCB_L_TABLE_SIZE]; ///< l[i] = L_i, the offset step of block numbers with i trailing zeros
+	__m128i l_star; ///< L_* = E(0^128), offset step of the final partial block
+	__m128i l_dollar; ///< L_$ = double(L_*), mixed into the tag
+	const aes_context_t* ctx; ///< AES context of the key
+} aes_ocb_key_t;
+
+/**
+ * @brief Derives the OCB offset table of an AES key.
+ *
+ * @param key OCB key to initialize.
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_ocb_key_init(aes_ocb_key_t* key, const aes_context_t* ctx);
+
+/**
+ * @brief Encrypts and authenticates a message in one call.
+ *
+ * @param key Initialized OCB key.
+ * @param nonce Nonce; must never repeat for the same key.
+ * @param nonce_len Length of the nonce in bytes (1 to AES_OCB_MAX_NONCE_SIZE, 12 recommended).
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0).
+ * @param aad_len Length of the additional data in bytes.
+ * @param input Plaintext (may be NULL if input_len is 0).
+ * @param input_len Length of the plaintext in bytes.
+ * @param output Buffer receiving input_len bytes of ciphertext (may alias input).
+ * @param tag Buffer receiving the authentication tag.
+ * @param tag_len Tag length in bytes (AES_OCB_MIN_TAG_SIZE to AES_OCB_TAG_SIZE); part of the nonce formatting.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_ocb_encrypt(const aes_ocb_key_t* key, const uint8_t* nonce, size_t nonce_len, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, uint8_t* output, uint8_t* tag, size_t tag_len);
+
+/**
+ * @brief Decrypts and verifies a message in one call.
+ *
+ * The tag is compared in constant time. On authentication failure the output
+ * buffer is zeroed.
+ *
+ * @param key Initialized OCB key.
+ * @param nonce Nonce used for encryption.
+ * @param nonce_len Length of the nonce in bytes (1 to AES_OCB_MAX_NONCE_SIZE).
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0).
+ * @param aad_len Length of the additional data in bytes.
+ * @param input Ciphertext (may be NULL if input_len is 0).
+ * @param input_len Length of the ciphertext in bytes.
+ * @param output Buffer receiving input_len bytes of plaintext (may alias input).
+ * @param tag Authentication tag to check.
+ * @param tag_len Tag length in bytes (AES_OCB_MIN_TAG_SIZE to AES_OCB_TAG_SIZE).
+ * @return 0 if the message is authentic, non-zero on authentication failure or invalid argument.
+ */
+int aes_ocb_decrypt(const aes_ocb_key_t* key, const uint8_t* nonce, size_t nonce_len, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, uint8_t* output, const uint8_t* tag, size_t tag_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_OCB_H
\ No newline at end of file
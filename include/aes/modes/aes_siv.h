@@ -0,0 +1,130 @@
+/**
+ * @file aes/modes/aes_siv.h
+ * @brief AES-SIV deterministic authenticated encryption (RFC 5297).
+ *
+ * SIV computes a synthetic IV with S2V, a CMAC-based PRF over a vector of
+ * associated data components and the plaintext, then encrypts the plaintext in
+ * CTR mode under that IV. Encryption is deterministic: equal (AD, plaintext)
+ * pairs give equal ciphertexts, which lets identical records deduplicate
+ * without revealing anything else about their contents.
+ *
+ * The SIV key is made of two AES keys of the same size: one for S2V (CMAC) and
+ * one for CTR. An aes_siv_key_t holds the CMAC subkeys and S2V's constant first
+ * value, so neither is derived again per message. The CTR pass uses the wide
+ * CTR kernels (see aes_ctr.h), and aes_siv_encrypt_batch() runs the CMAC chains
+ * of several small records interleaved (see aes_cmac_batch()).
+ */
+
+#ifndef AES_SIV_H
+#define AES_SIV_H
+
+#include "aes/core/aes_context.h"
+#include "aes/mac/aes_cmac.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Synthetic IV (authentication tag) size in bytes
+#define AES_SIV_IV_SIZE 16
+
+/// Largest number of associated data components per message
+#define AES_SIV_MAX_COMPONENTS 126
+
+/// Largest record whose final CMAC runs interleaved in aes_siv_encrypt_batch(); longer records are streamed
+#define AES_SIV_BATCH_INLINE_SIZE 256
+
+/**
+ * @brief SIV key: CMAC key of the S2V half, cached S2V state, and CTR context.
+ *
+ * Read-only once initialized; may be shared between threads. Both AES
+ * contexts must outlive it.
+ */
+typedef struct {
+	aes_cmac_key_t mac_key; ///< CMAC key (K1, K2 subkeys) of the S2V half
+	__m128i zero_mac; ///< CMAC(<zero>), the first S2V value
+	const aes_context_t* ctr_ctx; ///< AES context of the CTR half
+} aes_siv_key_t;
+
+/**
+ * @brief One record of aes_siv_encrypt_batch(), with a single associated data component.
+ */
+typedef struct {
+	const uint8_t* aad; ///< Associated data (may be NULL if aad_len is 0; an empty component is still authenticated)
+	size_t aad_len; ///< Length of the associated data in bytes
+	const uint8_t* input; ///< Plaintext (may be NULL if input_len is 0)
+	size_t input_len; ///< Length of the plaintext in bytes
+	uint8_t* output; ///< Receives input_len bytes of ciphertext (may alias input)
+	uint8_t* siv; ///< Receives the AES_SIV_IV_SIZE-byte synthetic IV
+} aes_siv_record_t;
+
+/**
+ * @brief Initializes a SIV key from its two halves.
+ *
+ * For a 256-, 384- or 512-bit RFC 5297 key, mac_ctx is initialized with the
+ * first half and ctr_ctx with the second.
+ *
+ * @param key SIV key to initialize.
+ * @param mac_ctx AES context of the S2V (CMAC) half.
+ * @param ctr_ctx AES context of the CTR half (same key size).
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_siv_key_init(aes_siv_key_t* key, const aes_context_t* mac_ctx, const aes_context_t* ctr_ctx);
+
+/**
+ * @brief Encrypts a message deterministically.
+ *
+ * @param key Initialized SIV key.
+ * @param aad Array of num_aad associated data components (entries may be NULL for empty components).
+ * @param aad_lens Array of num_aad component lengths in bytes.
+ * @param num_aad Number of components (at most AES_SIV_MAX_COMPONENTS).
+ * @param input Plaintext (may be NULL if input_len is 0).
+ * @param input_len Length of the plaintext in bytes.
+ * @param output Buffer receiving input_len bytes of ciphertext (may alias input).
+ * @param siv Buffer receiving the AES_SIV_IV_SIZE-byte synthetic IV.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_siv_encrypt(const aes_siv_key_t* key, const uint8_t* const* aad, const size_t* aad_lens, size_t num_aad,
+	const uint8_t* input, size_t input_len, uint8_t* output, uint8_t* siv);
+
+/**
+ * @brief Decrypts and verifies a message.
+ *
+ * The synthetic IV is compared in constant time. On authentication failure the
+ * output buffer is zeroed.
+ *
+ * @param key Initialized SIV key.
+ * @param aad Array of num_aad associated data components (entries may be NULL for empty components).
+ * @param aad_lens Array of num_aad component lengths in bytes.
+ * @param num_aad Number of components (at most AES_SIV_MAX_COMPONENTS).
+ * @param input Ciphertext (may be NULL if input_len is 0).
+ * @param input_len Length of the ciphertext in bytes.
+ * @param output Buffer receiving input_len bytes of plaintext (may alias input).
+ * @param siv AES_SIV_IV_SIZE-byte synthetic IV to check.
+ * @return 0 if the message is authentic, non-zero on authentication failure or invalid argument.
+ */
+int aes_siv_decrypt(const aes_siv_key_t* key, const uint8_t* const* aad, const size_t* aad_lens, size_t num_aad,
+	const uint8_t* input, size_t input_len, uint8_t* output, const uint8_t* siv);
+
+/**
+ * @brief Encrypts independent records under the same key.
+ *
+ * Records are processed AES_CMAC_BATCH_LANES at a time: the CMACs of their
+ * associated data, then the final CMACs of records up to
+ * AES_SIV_BATCH_INLINE_SIZE bytes, advance together through the interleaved
+ * CMAC kernel. Each record gives the same result as aes_siv_encrypt() with its
+ * single associated data component.
+ *
+ * @param key Initialized SIV key.
+ * @param records Array of count records.
+ * @param count Number of records.
+ * @return 0 on success, non-zero on invalid argument (no record is written then).
+ */
+int aes_siv_encrypt_batch(const aes_siv_key_t* key, const aes_siv_record_t* records, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_SIV_H
\ No newline at end of file
@@ -0,0 +1,99 @@
+/**
+ * @file aes/modes/aes_xts.h
+ * @brief AES XTS mode (IEEE 1619 / NIST SP 800-38E) for storage encryption.
+ *
+ * XTS is a length-preserving, tweakable mode for fixed-size data units such as
+ * disk sectors. It uses two AES contexts: the data key encrypts the blocks and
+ * the tweak key encrypts the tweak (the data unit number). Block j of a data
+ * unit is masked with T * alpha^j, where T = E(K2, tweak) and alpha is the
+ * primitive element of GF(2^128).
+ *
+ * Every block of a data unit is independent once its tweak is known, so blocks
+ * are processed 8 at a time: the 8 tweaks are advanced together by alpha^8 with
+ * one carry-less multiplication each, then interleaved through the AES rounds.
+ * Data units whose length is not a multiple of 16 bytes use ciphertext stealing.
+ *
+ * aes_xts_encrypt_sectors() / aes_xts_decrypt_sectors() process a run of
+ * consecutive sectors in one call, encrypting their tweaks 8 at a time.
+ */
+
+#ifndef AES_XTS_H
+#define AES_XTS_H
+
+#include "aes/core/aes_context.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Tweak size in bytes
+#define AES_XTS_TWEAK_SIZE 16
+
+/// Maximum data unit size in bytes (2^20 blocks, IEEE 1619)
+#define AES_XTS_MAX_DATA_UNIT_SIZE ((size_t)1 << 24)
+
+/**
+ * @brief Encrypts one data unit in XTS mode.
+ *
+ * @param data_ctx AES context of the data key (K1).
+ * @param tweak_ctx AES context of the tweak key (K2); same key size as data_ctx, different key.
+ * @param tweak 16-byte tweak of the data unit (e.g. the little-endian sector number).
+ * @param input Plaintext of the data unit.
+ * @param input_len Length of the data unit in bytes (AES_BLOCK_SIZE to AES_XTS_MAX_DATA_UNIT_SIZE).
+ * @param output Buffer receiving input_len bytes of ciphertext (may alias input).
+ * @return 0 on success, non-zero on invalid argument (including identical keys).
+ */
+int aes_xts_encrypt(const aes_context_t* data_ctx, const aes_context_t* tweak_ctx, const uint8_t tweak[16], const uint8_t* input, size_t input_len, uint8_t* output);
+
+/**
+ * @brief Decrypts one data unit in XTS mode.
+ *
+ * @param data_ctx AES context of the data key (K1), with its decryption schedule.
+ * @param tweak_ctx AES context of the tweak key (K2); same key size as data_ctx, different key.
+ * @param tweak 16-byte tweak of the data unit.
+ * @param input Ciphertext of the data unit.
+ * @param input_len Length of the data unit in bytes (AES_BLOCK_SIZE to AES_XTS_MAX_DATA_UNIT_SIZE).
+ * @param output Buffer receiving input_len bytes of plaintext (may alias input).
+ * @return 0 on success, non-zero on invalid argument (including identical keys).
+ */
+int aes_xts_decrypt(const aes_context_t* data_ctx, const aes_context_t* tweak_ctx, const uint8_t tweak[16], const uint8_t* input, size_t input_len, uint8_t* output);
+
+/**
+ * @brief Encrypts consecutive sectors in XTS mode.
+ *
+ * Sector i of the buffer is a data unit of sector_size bytes whose tweak is the
+ * 128-bit little-endian encoding of first_sector + i.
+ *
+ * @param data_ctx AES context of the data key (K1).
+ * @param tweak_ctx AES context of the tweak key (K2); same key size as data_ctx, different key.
+ * @param first_sector Number of the first sector.
+ * @param sector_size Data unit size in bytes (AES_BLOCK_SIZE to AES_XTS_MAX_DATA_UNIT_SIZE).
+ * @param input Plaintext sectors.
+ * @param input_len Length of the input in bytes (multiple of sector_size).
+ * @param output Buffer receiving input_len bytes of ciphertext (may alias input).
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_xts_encrypt_sectors(const aes_context_t* data_ctx, const aes_context_t* tweak_ctx, uint64_t first_sector, size_t sector_size,
+	const uint8_t* input, size_t input_len, uint8_t* output);
+
+/**
+ * @brief Decrypts consecutive sectors in XTS mode.
+ *
+ * @param data_ctx AES context of the data key (K1), with its decryption schedule.
+ * @param tweak_ctx AES context of the tweak key (K2); same key size as data_ctx, different key.
+ * @param first_sector Number of the first sector.
+ * @param sector_size Data unit size in bytes (AES_BLOCK_SIZE to AES_XTS_MAX_DATA_UNIT_SIZE).
+ * @param input Ciphertext sectors.
+ * @param input_len Length of the input in bytes (multiple of sector_size).
+ * @param output Buffer receiving input_len bytes of plaintext (may alias input).
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_xts_decrypt_sectors(const aes_context_t* data_ctx, const aes_context_t* tweak_ctx, uint64_t first_sector, size_t sector_size,
+	const uint8_t* input, size_t input_len, uint8_t* output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_XTS_H
\ No newline at end of file
@@ -0,0 +1,131 @@
+/**
+ * @file aes/parallel/aes_parallel.h
+ * @brief Multi-threaded AES modes over large buffers.
+ *
+ * This header provides parallel variants of the modes whose blocks are independent
+ * (ECB, CTR) or only depend on already known ciphertext (CFB decryption). The buffer is split into chunks of AES_PARALLEL_CHUNK_SIZE bytes,
+ * small enough to stay in the per-core caches, which the threads of an
+ * aes_thread_pool_t process concurrently with the wide single-thread kernels.
+ * CTR chunks start at the counter matching their offset in the stream, and CFB
+ * chunks at the ciphertext block preceding them.
+ *
+ * GCM chunks are encrypted at the counter matching their offset and hashed from
+ * a zero accumulator; the partial hashes are then combined in order with powers
+ * of H (see aes_gcm_append_segments()).
+ *
+ * The output is identical to the one of the corresponding single-threaded function.
+ * Buffers smaller than two chunks, or a NULL pool, are processed on the calling thread.
+ */
+
+#ifndef AES_PARALLEL_H
+#define AES_PARALLEL_H
+
+#include "aes/core/aes_context.h"
+#include "aes/mac/aes_ghash.h"
+#include "aes/parallel/aes_thread_pool.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Number of bytes processed per task (multiple of AES_BLOCK_SIZE)
+#define AES_PARALLEL_CHUNK_SIZE (256 * 1024)
+
+/**
+ * @brief Encrypts a buffer in ECB mode using the threads of a pool.
+ *
+ * @param pool Thread pool (may be NULL to run on the calling thread).
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param input Pointer to the plaintext buffer.
+ * @param input_len Length of the input in bytes (must be a multiple of 16).
+ * @param output Pointer to the buffer that will receive the ciphertext (may alias input).
+ */
+void aes_ecb_encrypt_parallel(aes_thread_pool_t* pool, const aes_context_t* ctx, const uint8_t* input, size_t input_len, uint8_t* output);
+
+/**
+ * @brief Decrypts a buffer in ECB mode using the threads of a pool.
+ *
+ * @param pool Thread pool (may be NULL to run on the calling thread).
+ * @param ctx Pointer to a valid AES context with its decryption schedule (see aes_ecb_decrypt).
+ * @param input Pointer to the ciphertext buffer.
+ * @param input_len Length of the input in bytes (must be a multiple of 16).
+ * @param output Pointer to the buffer that will receive the plaintext (may alias input).
+ */
+void aes_ecb_decrypt_parallel(aes_thread_pool_t* pool, const aes_context_t* ctx, const uint8_t* input, size_t input_len, uint8_t* output);
+
+/**
+ * @brief Encrypts or decrypts a buffer in CTR mode using the threads of a pool.
+ *
+ * @param pool Thread pool (may be NULL to run on the calling thread).
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param iv 16-byte initialization vector (nonce + counter). Must not be NULL.
+ * @param input Pointer to the input buffer (plaintext or ciphertext).
+ * @param input_len Number of bytes to process.
+ * @param output Pointer to the buffer that will receive the output (may alias input).
+ */
+void aes_ctr_crypt_parallel(aes_thread_pool_t* pool, const aes_context_t* ctx, const uint8_t iv[16], const uint8_t* input, size_t input_len, uint8_t* output);
+
+/**
+ * @brief Decrypts a buffer in CFB mode using the threads of a pool.
+ *
+ * Supports arbitrary-length input; the final partial block is handled as in aes_cfb_decrypt().
+ *
+ * @param pool Thread pool (may be NULL to run on the calling thread).
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param iv 16-byte initialization vector (IV) used during encryption. Must not be NULL.
+ * @param input Pointer to the ciphertext buffer.
+ * @param input_len Length of the input in bytes.
+ * @param output Pointer to the buffer that will receive the plaintext (may alias input).
+ */
+void aes_cfb_decrypt_parallel(aes_thread_pool_t* pool, const aes_context_t* ctx, const uint8_t iv[16], const uint8_t* input, size_t input_len, uint8_t* output);
+
+/**
+ * @brief Encrypts and authenticates a message in GCM mode using the threads of a pool.
+ *
+ * Produces the same ciphertext and tag as aes_gcm_encrypt().
+ *
+ * @param pool Thread pool (may be NULL to run on the calling thread).
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param hkey GHASH key table of ctx, or NULL to derive it for this call only.
+ * @param iv Initialization vector; must never repeat for the same key.
+ * @param iv_len Length of the IV in bytes (12 recommended).
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0).
+ * @param aad_len Length of the additional data in bytes.
+ * @param input Plaintext (may be NULL if input_len is 0).
+ * @param input_len Length of the plaintext in bytes.
+ * @param output Buffer receiving input_len bytes of ciphertext (may alias input).
+ * @param tag Buffer receiving the authentication tag.
+ * @param tag_len Tag length in bytes (4 to 16).
+ * @return 0 on success, non-zero on invalid argument.
+ */
+int aes_gcm_encrypt_parallel(aes_thread_pool_t* pool, const aes_context_t* ctx, const aes_ghash_key_t* hkey, const uint8_t* iv, size_t iv_len,
+	const uint8_t* aad, size_t aad_len, const uint8_t* input, size_t input_len, uint8_t* output, uint8_t* tag, size_t tag_len);
+
+/**
+ * @brief Decrypts and verifies a message in GCM mode using the threads of a pool.
+ *
+ * Same result as aes_gcm_decrypt(): on authentication failure the output buffer is zeroed.
+ *
+ * @param pool Thread pool (may be NULL to run on the calling thread).
+ * @param ctx Pointer to a valid AES context (initialized with aes_context_init).
+ * @param hkey GHASH key table of ctx, or NULL to derive it for this call only.
+ * @param iv Initialization vector used for encryption.
+ * @param iv_len Length of the IV in bytes.
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0).
+ * @param aad_len Length of the additional data in bytes.
+ * @param input Ciphertext (may be NULL if input_len is 0).
+ * @param input_len Length of the ciphertext in bytes.
+ * @param output Buffer receiving input_len bytes of plaintext (may alias input).
+ * @param tag Authentication tag to check.
+ * @param tag_len Tag length in bytes (4 to 16).
+ * @return 0 if the message is authentic, non-zero on authentication failure or invalid argument.
+ */
+int aes_gcm_decrypt_parallel(aes_thread_pool_t* pool, const aes_context_t* ctx, const aes_ghash_key_t* hkey, const uint8_t* iv, size_t iv_len,
+	const uint8_t* aad, size_t aad_len, const uint8_t* input, size_t input_len, uint8_t* output, const uint8_t* tag, size_t tag_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_PARALLEL_H
\ No newline at end of file
@@ -0,0 +1,78 @@
+/**
+ * @file aes/parallel/aes_thread_pool.h
+ * @brief Reusable worker thread pool for the parallel AES APIs.
+ *
+ * A pool owns a fixed set of worker threads created once and reused across calls,
+ * so repeated parallel operations do not pay thread creation costs. Work is
+ * submitted as a number of independent tasks; the calling thread takes part in
+ * their execution and returns once all of them are done.
+ *
+ * A pool may be shared between threads: concurrent submissions are serialized.
+ */
+
+#ifndef AES_THREAD_POOL_H
+#define AES_THREAD_POOL_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opaque worker thread pool.
+ */
+typedef struct aes_thread_pool aes_thread_pool_t;
+
+/**
+ * @brief Function executed for each task of a submission.
+ *
+ * @param arg User argument passed to aes_thread_pool_run().
+ * @param task_index Index of the task, in [0, num_tasks).
+ */
+typedef void (*aes_task_func_t)(void* arg, size_t task_index);
+
+/**
+ * @brief Creates a thread pool.
+ *
+ * The calling thread of aes_thread_pool_run() counts as one of the threads,
+ * so num_threads - 1 worker threads are started.
+ *
+ * @param num_threads Total number of threads executing tasks (at least 1).
+ * @return New pool, or NULL on invalid argument or allocation/thread creation failure.
+ */
+aes_thread_pool_t* aes_thread_pool_create(size_t num_threads);
+
+/**
+ * @brief Stops the worker threads and releases the pool.
+ *
+ * @param pool Pool to destroy (may be NULL). Must not be running tasks.
+ */
+void aes_thread_pool_destroy(aes_thread_pool_t* pool);
+
+/**
+ * @brief Returns the number of threads executing tasks, including the caller.
+ *
+ * @param pool Pool (may be NULL, which counts as a single thread).
+ * @return Number of threads.
+ */
+size_t aes_thread_pool_size(const aes_thread_pool_t* pool);
+
+/**
+ * @brief Runs num_tasks tasks on the pool and waits for their completion.
+ *
+ * Tasks are handed out one at a time in increasing index order to whichever
+ * thread is free. With a NULL pool, the tasks run sequentially on the caller.
+ *
+ * @param pool Pool (may be NULL).
+ * @param func Function called once per task.
+ * @param arg Argument passed to func.
+ * @param num_tasks Number of tasks.
+ */
+void aes_thread_pool_run(aes_thread_pool_t* pool, aes_task_func_t func, void* arg, size_t num_tasks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_THREAD_POOL_H
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "aes/core/aes_avx2.h"
+#include <immintrin.h>
+
+// Compile the shared round helpers below for AVX2 so they use VEX-encoded instructions
+#pragma GCC push_options
+#pragma GCC target("avx2,aes")
+
+#include "aes/core/aes_rounds.h"
+
+void aes128_encrypt_blocks_avx2(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_xn(plaintext, ciphertext, num_blocks, enc_round_keys, AES_128_NUM_ROUNDS);
+}
+
+void aes192_encrypt_blocks_avx2(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_xn(plaintext, ciphertext, num_blocks, enc_round_keys, AES_192_NUM_ROUNDS);
+}
+
+void aes256_encrypt_blocks_avx2(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_xn(plaintext, ciphertext, num_blocks, enc_round_keys, AES_256_NUM_ROUNDS);
+}
+
+void aes128_decrypt_blocks_avx2(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_xn(ciphertext, plaintext, num_blocks, dec_round_keys, AES_128_NUM_ROUNDS);
+}
+
+void aes192_decrypt_blocks_avx2(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_xn(ciphertext, plaintext, num_blocks, dec_round_keys, AES_192_NUM_ROUNDS);
+}
+
+void aes256_decrypt_blocks_avx2(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_xn(ciphertext, plaintext, num_blocks, dec_round_keys, AES_256_NUM_ROUNDS);
+}
+
+void aes128_ctr_blocks_avx2(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_ctr_blocks_xn(input, output, num_blocks, counter, enc_round_keys, AES_128_NUM_ROUNDS);
+}
+
+void aes192_ctr_blocks_avx2(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_ctr_blocks_xn(input, output, num_blocks, counter, enc_round_keys, AES_192_NUM_ROUNDS);
+}
+
+void aes256_ctr_blocks_avx2(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_ctr_blocks_xn(input, output, num_blocks, counter, enc_round_keys, AES_256_NUM_ROUNDS);
+}
+
+#pragma GCC pop_options
\ No newline at end of file
@@ -1,14 +1,41 @@
 #include "aes/core/aes_context.h"
 #include "aes/core/aes_key_expansion.h"
-#include "aes/core/aes_encrypt.h"
-#include "aes/core/aes_decrypt.h"
+#include "aes/core/aes_cpu.h"
 #include <stdio.h>
+#include <string.h>
 
-int aes_context_init(aes_context_t* ctx, const uint8_t* key, size_t key_size)
+/**
+ * @brief Inverts the encryption schedule of a context into its decryption schedule.
+ *
+ * @param ctx Context with a valid key size and encryption schedule.
+ */
+static void aes_context_invert(aes_context_t* ctx)
+{
+	switch (ctx->key_size)
+	{
+		case AES_128:
+			aes128_invert_round_keys(ctx->enc_round_keys, ctx->dec_round_keys);
+			break;
+		case AES_192:
+			aes192_invert_round_keys(ctx->enc_round_keys, ctx->dec_round_keys);
+			break;
+		default:
+			aes256_invert_round_keys(ctx->enc_round_keys, ctx->dec_round_keys);
+			break;
+	}
+
+	ctx->has_dec_round_keys = 1;
+}
+
+int aes_context_init_encrypt(aes_context_t* ctx, const uint8_t* key, size_t key_size)
 {
 	if (!ctx || !key)
 		return 1;
 
+	// Refuse to run on CPUs without AES-NI instead of faulting on the first aesenc
+	if (!aes_cpu_get_features()->aesni)
+		return 1;
+
 	switch (key_size)
 	{
 		// AES_128
@@ -16,9 +43,6 @@ int aes_context_init(aes_context_t* ctx, const uint8_t* key, size_t key_size)
 		{
 			ctx->key_size = AES_128;
 			aes128_key_expansion(_mm_loadu_si128((const __m128i*)key), ctx->enc_round_keys);
-			aes128_invert_round_keys(ctx->enc_round_keys, ctx->dec_round_keys);
-			ctx->encrypt_func = (aes_encrypt_func_t)aes128_encrypt_block;
-			ctx->decrypt_func = (aes_encrypt_func_t)aes128_decrypt_block;
 			break;
 		}
 		// AES_192
@@ -27,12 +51,9 @@ int aes_context_init(aes_context_t* ctx, const uint8_t* key, size_t key_size)
 			ctx->key_size = AES_192;
 			__m128i key192[2] = {
 				_mm_loadu_si128((const __m128i*)key),
-				_mm_loadu_si128((const __m128i*)(key + 16))
+				_mm_loadl_epi64((const __m128i*)(key + 16))
 			};
 			aes192_key_expansion(key192, ctx->enc_round_keys);
-			aes192_invert_round_keys(ctx->enc_round_keys, ctx->dec_round_keys);
-			ctx->encrypt_func = (aes_encrypt_func_t)aes192_encrypt_block;
-			ctx->decrypt_func = (aes_encrypt_func_t)aes192_decrypt_block;
 			break;
 		}
 		// AES_256
@@ -44,14 +65,123 @@ int aes_context_init(aes_context_t* ctx, const uint8_t* key, size_t key_size)
 				_mm_loadu_si128((const __m128i*)(key + 16))
 			};
 			aes256_key_expansion(key256, ctx->enc_round_keys);
-			aes256_invert_round_keys(ctx->enc_round_keys, ctx->dec_round_keys);
-			ctx->encrypt_func = (aes_encrypt_func_t)aes256_encrypt_block;
-			ctx->decrypt_func = (aes_encrypt_func_t)aes256_decrypt_block;
 			break;
 		}
 		default:
 			return 1;
 	}
 
+	ctx->has_dec_round_keys = 0;
+	ctx->dispatch = aes_dispatch_get(key_size);
+
+	return 0;
+}
+
+int aes_context_init(aes_context_t* ctx, const uint8_t* key, size_t key_size)
+{
+	if (aes_context_init_encrypt(ctx, key, key_size) != 0)
+		return 1;
+
+	aes_context_invert(ctx);
+	return 0;
+}
+
+int aes_context_prepare_decrypt(aes_context_t* ctx)
+{
+	if (!ctx || (ctx->key_size != AES_128 && ctx->key_size != AES_192 && ctx->key_size != AES_256))
+		return 1;
+
+	if (!ctx->has_dec_round_keys)
+		aes_context_invert(ctx);
+
+	return 0;
+}
+
+void aes_context_wipe(aes_context_t* ctx)
+{
+	if (!ctx)
+		return;
+
+	// Even an encrypt-only context may hold the decryption schedule of a previous key
+	memset(ctx, 0, sizeof(*ctx));
+
+	// Keep the stores: the memory is about to be released or reused
+	__asm__ volatile ("" : : "r"(ctx) : "memory");
+}
+
+int aes_context_init_batch(aes_context_t* ctxs, const uint8_t* const* keys, size_t key_size, size_t count)
+{
+	if (count > 0 && (!ctxs || !keys))
+		return 1;
+
+	if (!aes_cpu_get_features()->aesni || (key_size != AES_128 && key_size != AES_192 && key_size != AES_256))
+		return 1;
+
+	for (size_t i = 0; i < count; ++i)
+		if (!keys[i])
+			return 1;
+
+	const aes_dispatch_t* dispatch = aes_dispatch_get(key_size);
+
+	for (size_t i = 0; i < count; i += AES_KEY_EXPANSION_LANES)
+	{
+		__m128i user_keys[AES_KEY_EXPANSION_LANES][2];
+		__m128i* round_keys[AES_KEY_EXPANSION_LANES];
+		__m128i spare[AES_256_NUM_ROUND_KEYS];
+		size_t lanes = count - i < AES_KEY_EXPANSION_LANES ? count - i : AES_KEY_EXPANSION_LANES;
+
+		// Lanes past the last key expand the group's first key into a spare schedule
+		for (size_t j = 0; j < AES_KEY_EXPANSION_LANES; ++j)
+		{
+			const uint8_t* key = keys[j < lanes ? i + j : i];
+
+			round_keys[j] = j < lanes ? ctxs[i + j].enc_round_keys : spare;
+			user_keys[j][0] = _mm_loadu_si128((const __m128i*)key);
+
+			// Only the 8 remaining bytes of an AES-192 key are read
+			if (key_size == AES_192)
+				user_keys[j][1] = _mm_loadl_epi64((const __m128i*)(key + 16));
+			else if (key_size == AES_256)
+				user_keys[j][1] = _mm_loadu_si128((const __m128i*)(key + 16));
+			else
+				user_keys[j][1] = _mm_setzero_si128();
+		}
+
+		switch (key_size)
+		{
+			case AES_128:
+			{
+				__m128i keys128[AES_KEY_EXPANSION_LANES];
+				for (size_t j = 0; j < AES_KEY_EXPANSION_LANES; ++j)
+					keys128[j] = user_keys[j][0];
+				aes128_key_expansion_x4(keys128, round_keys);
+				memset(keys128, 0, sizeof(keys128));
+				__asm__ volatile ("" : : "r"(keys128) : "memory");
+				break;
+			}
+			case AES_192:
+				aes192_key_expansion_x4(user_keys, round_keys);
+				break;
+			default:
+				aes256_key_expansion_x4(user_keys, round_keys);
+				break;
+		}
+
+		for (size_t j = 0; j < lanes; ++j)
+		{
+			aes_context_t* ctx = &ctxs[i + j];
+
+			ctx->key_size = (aes_key_size_t)key_size;
+			ctx->dispatch = dispatch;
+			aes_context_invert(ctx);
+		}
+
+		// Raw keys, and the spare schedule of the group's first key if the group was short
+		memset(user_keys, 0, sizeof(user_keys));
+		if (lanes < AES_KEY_EXPANSION_LANES)
+			memset(spare, 0, sizeof(spare));
+		__asm__ volatile ("" : : "r"(user_keys), "r"(spare) : "memory");
+	}
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,267 @@
+#define _DEFAULT_SOURCE // MAP_ANONYMOUS, MAP_HUGETLB and madvise() under -std=c11
+
+#include "aes/core/aes_context_arena.h"
+#include "aes/core/aes_constants.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#define AES_ARENA_SLAB_SIZE (64 * 1024) ///< Slab size with regular pages
+#define AES_ARENA_HUGE_SLAB_SIZE (2 * 1024 * 1024) ///< Slab size with huge pages (one x86-64 huge page)
+
+/**
+ * @brief Slot size of a full context, rounded up to whole cache lines.
+ */
+#define AES_ARENA_SLOT_SIZE \
+	((sizeof(aes_context_t) + AES_CACHE_LINE_SIZE - 1) & ~(size_t)(AES_CACHE_LINE_SIZE - 1))
+
+/**
+ * @brief Contiguous block of slots.
+ */
+typedef struct {
+	uint8_t* base; ///< First slot
+	int mapped; ///< Allocated with mmap() rather than aligned_alloc()
+} aes_arena_slab_t;
+
+struct aes_context_arena {
+	aes_arena_slab_t* slabs; ///< Slab table, sized for the capacity up front
+	uint8_t* generations; ///< Generation of each slot, sized for the capacity up front
+	size_t num_slabs; ///< Number of allocated slabs
+	size_t slab_size; ///< Bytes per slab
+	size_t slot_size; ///< Bytes per slot, a multiple of the cache line size
+	unsigned slot_shift; ///< log2 of the number of slots per slab
+	size_t capacity; ///< Maximum number of live contexts
+	size_t next_unused; ///< Slots below this index have been handed out at least once
+	aes_context_handle_t free_head; ///< Most recently released handle, 0 if none
+	size_t count; ///< Number of live contexts
+	unsigned flags; ///< AES_CONTEXT_ARENA_* flags
+};
+
+/**
+ * @brief Allocates the memory of a slab.
+ *
+ * @param slab Slab to fill.
+ * @param size Slab size in bytes.
+ * @param huge Whether huge pages are requested.
+ * @return 0 on success, 1 on allocation failure.
+ */
+static int aes_arena_slab_alloc(aes_arena_slab_t* slab, size_t size, int huge)
+{
+#ifdef __linux__
+	if (huge)
+	{
+		void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (base != MAP_FAILED)
+		{
+			slab->base = (uint8_t*)base;
+			slab->mapped = 1;
+			return 0;
+		}
+	}
+#endif
+
+	// Aligning huge slabs on their size lets the kernel back them with a single huge page
+	slab->base = (uint8_t*)aligned_alloc(huge ? size : AES_CACHE_LINE_SIZE, size);
+	slab->mapped = 0;
+	if (!slab->base)
+		return 1;
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+	// No reserved huge pages: fall back to transparent huge pages
+	if (huge)
+		madvise(slab->base, size, MADV_HUGEPAGE);
+#endif
+
+	return 0;
+}
+
+/**
+ * @brief Releases the memory of a slab.
+ *
+ * @param slab Slab to release.
+ * @param size Slab size in bytes.
+ */
+static void aes_arena_slab_release(aes_arena_slab_t* slab, size_t size)
+{
+#ifdef __linux__
+	if (slab->mapped)
+	{
+		munmap(slab->base, size);
+		return;
+	}
+#else
+	(void)size;
+#endif
+	free(slab->base);
+}
+
+/**
+ * @brief Returns the context stored in a slot.
+ *
+ * @param arena Arena.
+ * @param index Slot index, below arena->next_unused.
+ * @return Context of the slot.
+ */
+static inline aes_context_t* aes_arena_slot(const aes_context_arena_t* arena, size_t index)
+{
+	size_t slot_mask = ((size_t)1 << arena->slot_shift) - 1;
+	uint8_t* slab = arena->slabs[index >> arena->slot_shift].base;
+	return (aes_context_t*)(slab + (index & slot_mask) * arena->slot_size);
+}
+
+/**
+ * @brief Pushes a wiped slot on the free list.
+ *
+ * A free slot keeps a zero key size, which tells it apart from live contexts,
+ * and stores the next free handle in its first round key.
+ *
+ * @param arena Arena.
+ * @param handle Handle of the slot.
+ */
+static void aes_arena_push_free(aes_context_arena_t* arena, aes_context_handle_t handle)
+{
+	aes_context_t* ctx = aes_arena_slot(arena, aes_context_handle_index(handle));
+	memcpy(&ctx->enc_round_keys[0], &arena->free_head, sizeof(arena->free_head));
+	arena->free_head = handle;
+}
+
+aes_context_arena_t* aes_context_arena_create(size_t capacity, unsigned flags)
+{
+	if (capacity == 0 || capacity > AES_CONTEXT_ARENA_MAX_CAPACITY)
+		return NULL;
+	if (flags & ~(unsigned)(AES_CONTEXT_ARENA_HUGE_PAGES | AES_CONTEXT_ARENA_ENCRYPT_ONLY))
+		return NULL;
+
+	aes_context_arena_t* arena = (aes_context_arena_t*)calloc(1, sizeof(*arena));
+	if (!arena)
+		return NULL;
+
+	arena->flags = flags;
+	arena->capacity = capacity;
+	arena->slab_size = (flags & AES_CONTEXT_ARENA_HUGE_PAGES) ? AES_ARENA_HUGE_SLAB_SIZE : AES_ARENA_SLAB_SIZE;
+	arena->slot_size = (flags & AES_CONTEXT_ARENA_ENCRYPT_ONLY) ? AES_CONTEXT_ENCRYPT_SIZE : AES_ARENA_SLOT_SIZE;
+
+	// Both sizes are powers of two, so slots never straddle slabs
+	size_t slots_per_slab = arena->slab_size / arena->slot_size;
+	while (((size_t)1 << arena->slot_shift) < slots_per_slab)
+		arena->slot_shift++;
+
+	size_t max_slabs = (capacity + slots_per_slab - 1) / slots_per_slab;
+	arena->slabs = (aes_arena_slab_t*)calloc(max_slabs, sizeof(*arena->slabs));
+	arena->generations = (uint8_t*)calloc(capacity, sizeof(*arena->generations));
+	if (!arena->slabs || !arena->generations)
+	{
+		free(arena->slabs);
+		free(arena->generations);
+		free(arena);
+		return NULL;
+	}
+
+	return arena;
+}
+
+void aes_context_arena_destroy(aes_context_arena_t* arena)
+{
+	if (!arena)
+		return;
+
+	for (size_t i = 0; i < arena->num_slabs; ++i)
+	{
+		// Free slots are already wiped, but clearing whole slabs is simpler than walking them
+		memset(arena->slabs[i].base, 0, arena->slab_size);
+		__asm__ volatile ("" : : "r"(arena->slabs[i].base) : "memory");
+		aes_arena_slab_release(&arena->slabs[i], arena->slab_size);
+	}
+
+	free(arena->slabs);
+	free(arena->generations);
+	free(arena);
+}
+
+aes_context_handle_t aes_context_arena_alloc(aes_context_arena_t* arena, const uint8_t* key, size_t key_size)
+{
+	if (!arena || !key || (key_size != AES_128 && key_size != AES_192 && key_size != AES_256))
+		return AES_CONTEXT_HANDLE_INVALID;
+
+	aes_context_handle_t handle;
+	aes_context_t* ctx;
+
+	if (arena->free_head != AES_CONTEXT_HANDLE_INVALID)
+	{
+		handle = arena->free_head;
+		ctx = aes_arena_slot(arena, aes_context_handle_index(handle));
+		memcpy(&arena->free_head, &ctx->enc_round_keys[0], sizeof(arena->free_head));
+	}
+	else
+	{
+		if (arena->next_unused == arena->capacity)
+			return AES_CONTEXT_HANDLE_INVALID;
+
+		size_t index = arena->next_unused;
+		if ((index >> arena->slot_shift) == arena->num_slabs)
+		{
+			int huge = (arena->flags & AES_CONTEXT_ARENA_HUGE_PAGES) != 0;
+			if (aes_arena_slab_alloc(&arena->slabs[arena->num_slabs], arena->slab_size, huge))
+				return AES_CONTEXT_HANDLE_INVALID;
+			arena->num_slabs++;
+		}
+
+		arena->next_unused++;
+		handle = (aes_context_handle_t)(index + 1);
+		ctx = aes_arena_slot(arena, index);
+	}
+
+	int status = (arena->flags & AES_CONTEXT_ARENA_ENCRYPT_ONLY)
+		? aes_context_init_encrypt(ctx, key, key_size)
+		: aes_context_init(ctx, key, key_size);
+	if (status)
+	{
+		// E.g. no AES-NI: the slot may hold a partial schedule or, in a new slab, garbage
+		memset(ctx, 0, arena->slot_size);
+		__asm__ volatile ("" : : "r"(ctx) : "memory");
+		aes_arena_push_free(arena, handle);
+		return AES_CONTEXT_HANDLE_INVALID;
+	}
+
+	arena->count++;
+	return handle;
+}
+
+int aes_context_arena_free(aes_context_arena_t* arena, aes_context_handle_t handle)
+{
+	aes_context_t* ctx = (aes_context_t*)aes_context_arena_get(arena, handle);
+	if (!ctx)
+		return 1;
+
+	// Encrypt-only slots are shorter than an aes_context_t: clear the slot itself
+	memset(ctx, 0, arena->slot_size);
+	__asm__ volatile ("" : : "r"(ctx) : "memory");
+
+	// Outstanding copies of the handle must not reach the next context of the slot
+	size_t index = aes_context_handle_index(handle);
+	arena->generations[index]++;
+	aes_arena_push_free(arena, (aes_context_handle_t)((size_t)arena->generations[index] << AES_CONTEXT_HANDLE_INDEX_BITS | (index + 1)));
+	arena->count--;
+	return 0;
+}
+
+const aes_context_t* aes_context_arena_get(const aes_context_arena_t* arena, aes_context_handle_t handle)
+{
+	if (!arena || (handle & AES_CONTEXT_ARENA_MAX_CAPACITY) == 0)
+		return NULL;
+
+	size_t index = aes_context_handle_index(handle);
+	if (index >= arena->next_unused || arena->generations[index] != handle >> AES_CONTEXT_HANDLE_INDEX_BITS)
+		return NULL;
+
+	const aes_context_t* ctx = aes_arena_slot(arena, index);
+	return ctx->key_size ? ctx : NULL;
+}
+
+size_t aes_context_arena_count(const aes_context_arena_t* arena)
+{
+	return arena ? arena->count : 0;
+}
\ No newline at end of file
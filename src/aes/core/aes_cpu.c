@@ -0,0 +1,70 @@
+#include "aes/core/aes_cpu.h"
+#include <cpuid.h>
+#include <stddef.h>
+#include <stdint.h>
+
+static aes_cpu_features_t aes_cpu_features;
+static volatile int aes_cpu_detected = 0;
+
+/**
+ * @brief Reads the XCR0 register (state components enabled by the OS).
+ *
+ * Must only be called when cpuid reports OSXSAVE.
+ *
+ * @return Low 32 bits of XCR0.
+ */
+static inline uint32_t aes_cpu_xgetbv(void)
+{
+	uint32_t eax, edx;
+	__asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	(void)edx;
+	return eax;
+}
+
+/**
+ * @brief Detects the CPU features with cpuid/xgetbv.
+ *
+ * Registered as a constructor so that detection runs once at program startup.
+ */
+__attribute__((constructor)) static void aes_cpu_detect(void)
+{
+	aes_cpu_features_t features = {0};
+	unsigned int eax, ebx, ecx, edx;
+	unsigned int max_leaf = __get_cpuid_max(0, NULL);
+
+	if (max_leaf >= 1 && __get_cpuid(1, &eax, &ebx, &ecx, &edx))
+	{
+		features.sse41 = (ecx & bit_SSE4_1) != 0;
+		features.aesni = (ecx & bit_AES) != 0;
+		features.pclmulqdq = (ecx & bit_PCLMUL) != 0;
+
+		// AVX and AVX-512 also need the OS to save the wider register state
+		uint32_t xcr0 = (ecx & bit_OSXSAVE) ? aes_cpu_xgetbv() : 0;
+		int os_ymm = (xcr0 & 0x06) == 0x06; // XMM + YMM state
+		int os_zmm = (xcr0 & 0xe6) == 0xe6; // XMM + YMM + opmask + ZMM state
+
+		features.avx = os_ymm && (ecx & bit_AVX) != 0;
+
+		if (max_leaf >= 7 && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+		{
+			features.avx2 = features.avx && (ebx & bit_AVX2) != 0;
+			features.vaes = features.avx && features.aesni && (ecx & bit_VAES) != 0;
+			features.vpclmulqdq = features.avx && features.pclmulqdq && (ecx & bit_VPCLMULQDQ) != 0;
+			features.avx512f = os_zmm && (ebx & bit_AVX512F) != 0;
+			features.avx512bw = features.avx512f && (ebx & bit_AVX512BW) != 0;
+			features.avx512vl = features.avx512f && (ebx & bit_AVX512VL) != 0;
+		}
+	}
+
+	aes_cpu_features = features;
+	aes_cpu_detected = 1;
+}
+
+const aes_cpu_features_t* aes_cpu_get_features(void)
+{
+	// Detection is idempotent, so running it again from a late caller is harmless
+	if (!aes_cpu_detected)
+		aes_cpu_detect();
+
+	return &aes_cpu_features;
+}
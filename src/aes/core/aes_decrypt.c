@@ -1,4 +1,5 @@
 #include "aes/core/aes_decrypt.h"
+#include "aes/core/aes_rounds.h"
 
 void aes128_decrypt_block(const __m128i ciphertext, __m128i* plaintext, const __m128i dec_round_keys[AES_128_NUM_ROUND_KEYS])
 {
@@ -73,4 +74,49 @@ void aes256_decrypt_block(const __m128i ciphertext, __m128i* plaintext, const __
 
 	// Store the result
 	*plaintext = tmp;
+}
+
+void aes128_decrypt_blocks4(const __m128i ciphertext[4], __m128i plaintext[4], const __m128i dec_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_x4(ciphertext, plaintext, dec_round_keys, AES_128_NUM_ROUNDS);
+}
+
+void aes128_decrypt_blocks8(const __m128i ciphertext[8], __m128i plaintext[8], const __m128i dec_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_x8(ciphertext, plaintext, dec_round_keys, AES_128_NUM_ROUNDS);
+}
+
+void aes128_decrypt_blocks(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_xn(ciphertext, plaintext, num_blocks, dec_round_keys, AES_128_NUM_ROUNDS);
+}
+
+void aes192_decrypt_blocks4(const __m128i ciphertext[4], __m128i plaintext[4], const __m128i dec_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_x4(ciphertext, plaintext, dec_round_keys, AES_192_NUM_ROUNDS);
+}
+
+void aes192_decrypt_blocks8(const __m128i ciphertext[8], __m128i plaintext[8], const __m128i dec_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_x8(ciphertext, plaintext, dec_round_keys, AES_192_NUM_ROUNDS);
+}
+
+void aes192_decrypt_blocks(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_xn(ciphertext, plaintext, num_blocks, dec_round_keys, AES_192_NUM_ROUNDS);
+}
+
+void aes256_decrypt_blocks4(const __m128i ciphertext[4], __m128i plaintext[4], const __m128i dec_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_x4(ciphertext, plaintext, dec_round_keys, AES_256_NUM_ROUNDS);
+}
+
+void aes256_decrypt_blocks8(const __m128i ciphertext[8], __m128i plaintext[8], const __m128i dec_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_x8(ciphertext, plaintext, dec_round_keys, AES_256_NUM_ROUNDS);
+}
+
+void aes256_decrypt_blocks(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_xn(ciphertext, plaintext, num_blocks, dec_round_keys, AES_256_NUM_ROUNDS);
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "aes/core/aes_dispatch.h"
+#include "aes/core/aes_cpu.h"
+#include "aes/core/aes_encrypt.h"
+#include "aes/core/aes_decrypt.h"
+#include "aes/core/aes_avx2.h"
+#include "aes/core/aes_vaes.h"
+
+/**
+ * @brief Builds the dispatch table entry of one implementation for one key size.
+ *
+ * @param impl_id Implementation identifier (aes_impl_t).
+ * @param impl_name Implementation name.
+ * @param bits Key size in bits (128, 192 or 256).
+ * @param suffix Kernel name suffix of the implementation (e.g. _vaes512).
+ */
+#define AES_DISPATCH_ENTRY(impl_id, impl_name, bits, suffix) \
+	{ \
+		.impl = impl_id, \
+		.name = impl_name, \
+		.encrypt_block = (aes_encrypt_func_t)aes##bits##_encrypt_block, \
+		.decrypt_block = (aes_encrypt_func_t)aes##bits##_decrypt_block, \
+		.encrypt_blocks = (aes_blocks_func_t)aes##bits##_encrypt_blocks##suffix, \
+		.decrypt_blocks = (aes_blocks_func_t)aes##bits##_decrypt_blocks##suffix, \
+		.ctr_blocks = (aes_ctr_func_t)aes##bits##_ctr_blocks##suffix \
+	}
+
+/**
+ * @brief Builds the dispatch table entries of one implementation for all key sizes.
+ */
+#define AES_DISPATCH_ROW(impl_id, impl_name, suffix) \
+	{ \
+		AES_DISPATCH_ENTRY(impl_id, impl_name, 128, suffix), \
+		AES_DISPATCH_ENTRY(impl_id, impl_name, 192, suffix), \
+		AES_DISPATCH_ENTRY(impl_id, impl_name, 256, suffix) \
+	}
+
+/// Dispatch table, indexed by implementation then key size (128, 192, 256)
+static const aes_dispatch_t AES_DISPATCH_TABLE[AES_IMPL_COUNT][3] = {
+	[AES_IMPL_AESNI] = AES_DISPATCH_ROW(AES_IMPL_AESNI, "aesni", ),
+	[AES_IMPL_AESNI_AVX2] = AES_DISPATCH_ROW(AES_IMPL_AESNI_AVX2, "aesni-avx2", _avx2),
+	[AES_IMPL_VAES256] = AES_DISPATCH_ROW(AES_IMPL_VAES256, "vaes256", _vaes256),
+	[AES_IMPL_VAES512] = AES_DISPATCH_ROW(AES_IMPL_VAES512, "vaes512", _vaes512)
+};
+
+/// Implementation forced with aes_dispatch_set_impl(), AES_IMPL_COUNT for automatic selection; accessed atomically
+static aes_impl_t aes_forced_impl = AES_IMPL_COUNT;
+
+int aes_dispatch_is_supported(aes_impl_t impl)
+{
+	const aes_cpu_features_t* cpu = aes_cpu_get_features();
+
+	switch (impl)
+	{
+		case AES_IMPL_AESNI: return cpu->aesni;
+		case AES_IMPL_AESNI_AVX2: return cpu->aesni && cpu->avx2;
+		case AES_IMPL_VAES256: return cpu->vaes && cpu->avx2;
+		case AES_IMPL_VAES512: return cpu->vaes && cpu->avx512f && cpu->avx512bw;
+		default: return 0;
+	}
+}
+
+aes_impl_t aes_dispatch_get_impl(void)
+{
+	// Read by every context initialization, possibly while another thread sets it
+	aes_impl_t forced = __atomic_load_n(&aes_forced_impl, __ATOMIC_RELAXED);
+	if (forced != AES_IMPL_COUNT)
+		return forced;
+
+	// Pick the widest implementation supported by the CPU
+	for (int impl = AES_IMPL_COUNT - 1; impl > AES_IMPL_AESNI; --impl)
+	{
+		if (aes_dispatch_is_supported((aes_impl_t)impl))
+			return (aes_impl_t)impl;
+	}
+
+	return AES_IMPL_AESNI;
+}
+
+int aes_dispatch_set_impl(aes_impl_t impl)
+{
+	if (impl == AES_IMPL_COUNT)
+	{
+		__atomic_store_n(&aes_forced_impl, AES_IMPL_COUNT, __ATOMIC_RELAXED);
+		return 0;
+	}
+
+	if (!aes_dispatch_is_supported(impl))
+		return 1;
+
+	__atomic_store_n(&aes_forced_impl, impl, __ATOMIC_RELAXED);
+	return 0;
+}
+
+const char* aes_dispatch_impl_name(aes_impl_t impl)
+{
+	if ((unsigned)impl >= AES_IMPL_COUNT)
+		return "unknown";
+
+	return AES_DISPATCH_TABLE[impl][0].name;
+}
+
+const aes_dispatch_t* aes_dispatch_get(size_t key_size)
+{
+	aes_impl_t impl = aes_dispatch_get_impl();
+
+	switch (key_size)
+	{
+		case AES_128_KEY_SIZE: return &AES_DISPATCH_TABLE[impl][0];
+		case AES_192_KEY_SIZE: return &AES_DISPATCH_TABLE[impl][1];
+		case AES_256_KEY_SIZE: return &AES_DISPATCH_TABLE[impl][2];
+		default: return NULL;
+	}
+}
\ No newline at end of file
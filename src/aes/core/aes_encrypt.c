@@ -1,4 +1,5 @@
 #include "aes/core/aes_encrypt.h"
+#include "aes/core/aes_rounds.h"
 
 void aes128_encrypt_block(const __m128i plaintext, __m128i* ciphertext, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS])
 {
@@ -73,4 +74,64 @@ void aes256_encrypt_block(const __m128i plaintext, __m128i* ciphertext, const __
 
 	// Store the result
 	*ciphertext = tmp;
+}
+
+void aes128_encrypt_blocks4(const __m128i plaintext[4], __m128i ciphertext[4], const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_x4(plaintext, ciphertext, enc_round_keys, AES_128_NUM_ROUNDS);
+}
+
+void aes128_encrypt_blocks8(const __m128i plaintext[8], __m128i ciphertext[8], const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_x8(plaintext, ciphertext, enc_round_keys, AES_128_NUM_ROUNDS);
+}
+
+void aes128_encrypt_blocks(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_xn(plaintext, ciphertext, num_blocks, enc_round_keys, AES_128_NUM_ROUNDS);
+}
+
+void aes192_encrypt_blocks4(const __m128i plaintext[4], __m128i ciphertext[4], const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_x4(plaintext, ciphertext, enc_round_keys, AES_192_NUM_ROUNDS);
+}
+
+void aes192_encrypt_blocks8(const __m128i plaintext[8], __m128i ciphertext[8], const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_x8(plaintext, ciphertext, enc_round_keys, AES_192_NUM_ROUNDS);
+}
+
+void aes192_encrypt_blocks(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_xn(plaintext, ciphertext, num_blocks, enc_round_keys, AES_192_NUM_ROUNDS);
+}
+
+void aes256_encrypt_blocks4(const __m128i plaintext[4], __m128i ciphertext[4], const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_x4(plaintext, ciphertext, enc_round_keys, AES_256_NUM_ROUNDS);
+}
+
+void aes256_encrypt_blocks8(const __m128i plaintext[8], __m128i ciphertext[8], const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_x8(plaintext, ciphertext, enc_round_keys, AES_256_NUM_ROUNDS);
+}
+
+void aes256_encrypt_blocks(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_xn(plaintext, ciphertext, num_blocks, enc_round_keys, AES_256_NUM_ROUNDS);
+}
+
+void aes128_ctr_blocks(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_ctr_blocks_xn(input, output, num_blocks, counter, enc_round_keys, AES_128_NUM_ROUNDS);
+}
+
+void aes192_ctr_blocks(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_ctr_blocks_xn(input, output, num_blocks, counter, enc_round_keys, AES_192_NUM_ROUNDS);
+}
+
+void aes256_ctr_blocks(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_ctr_blocks_xn(input, output, num_blocks, counter, enc_round_keys, AES_256_NUM_ROUNDS);
 }
\ No newline at end of file
@@ -0,0 +1,338 @@
+#include "aes/core/aes_key_cache.h"
+#include "aes/core/aes_context_arena.h"
+#include "aes/core/aes_constants.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Bookkeeping of a cached schedule, stored at the index of its arena handle.
+ */
+typedef struct {
+	uint64_t key_id; ///< Key identifier
+	aes_context_handle_t lru_prev; ///< More recently used entry, 0 if none
+	aes_context_handle_t lru_next; ///< Less recently used entry, 0 if none
+	aes_context_handle_t hash_next; ///< Next entry of the same bucket, 0 if none
+} aes_key_cache_entry_t;
+
+/**
+ * @brief Independently locked part of the cache.
+ *
+ * Aligned on a cache line so that threads locking neighbouring shards do not
+ * share lines.
+ */
+typedef struct {
+	_Alignas(AES_CACHE_LINE_SIZE) pthread_mutex_t mutex; ///< Protects the fields below
+	aes_context_arena_t* arena; ///< Cached schedules
+	aes_key_cache_entry_t* entries; ///< Entries, indexed by slot index of their arena handle
+	aes_context_handle_t* buckets; ///< First entry of each hash bucket, 0 if empty
+	size_t bucket_mask; ///< Number of buckets - 1
+	aes_context_handle_t lru_head; ///< Most recently used entry
+	aes_context_handle_t lru_tail; ///< Least recently used entry
+	size_t capacity; ///< Maximum number of entries
+	uint64_t hits; ///< Lookups served from the shard
+	uint64_t misses; ///< Lookups not served from the shard
+	uint64_t evictions; ///< Entries evicted to make room
+} aes_key_cache_shard_t;
+
+struct aes_key_cache {
+	aes_key_cache_shard_t* shards; ///< Shards
+	size_t num_shards; ///< Number of shards
+	size_t context_size; ///< Bytes copied out per lookup
+};
+
+/**
+ * @brief Mixes the bits of a key identifier (SplitMix64 finalizer).
+ *
+ * Sequential identifiers are common, so they are spread before choosing a shard and a bucket.
+ *
+ * @param key_id Key identifier.
+ * @return Hash of the identifier.
+ */
+static inline uint64_t aes_key_cache_hash(uint64_t key_id)
+{
+	key_id ^= key_id >> 30;
+	key_id *= 0xbf58476d1ce4e5b9ULL;
+	key_id ^= key_id >> 27;
+	key_id *= 0x94d049bb133111ebULL;
+	key_id ^= key_id >> 31;
+	return key_id;
+}
+
+/**
+ * @brief Returns the bucket of a key identifier within its shard.
+ *
+ * @param shard Shard of the identifier.
+ * @param hash Hash of the identifier; its low bits select the shard, so the high bits are used.
+ * @return Head of the bucket.
+ */
+static inline aes_context_handle_t* aes_key_cache_bucket(aes_key_cache_shard_t* shard, uint64_t hash)
+{
+	return &shard->buckets[(hash >> 32) & shard->bucket_mask];
+}
+
+/**
+ * @brief Finds the entry of a key identifier.
+ *
+ * @param shard Shard of the identifier.
+ * @param key_id Key identifier.
+ * @param hash Hash of the identifier.
+ * @return Handle of the entry, 0 if the key is not cached.
+ */
+static aes_context_handle_t aes_key_cache_find(aes_key_cache_shard_t* shard, uint64_t key_id, uint64_t hash)
+{
+	aes_context_handle_t handle = *aes_key_cache_bucket(shard, hash);
+	while (handle && shard->entries[aes_context_handle_index(handle)].key_id != key_id)
+		handle = shard->entries[aes_context_handle_index(handle)].hash_next;
+	return handle;
+}
+
+/**
+ * @brief Unlinks an entry from the LRU list.
+ *
+ * @param shard Shard of the entry.
+ * @param handle Handle of the entry.
+ */
+static void aes_key_cache_lru_unlink(aes_key_cache_shard_t* shard, aes_context_handle_t handle)
+{
+	aes_key_cache_entry_t* entry = &shard->entries[aes_context_handle_index(handle)];
+
+	if (entry->lru_prev)
+		shard->entries[aes_context_handle_index(entry->lru_prev)].lru_next = entry->lru_next;
+	else
+		shard->lru_head = entry->lru_next;
+
+	if (entry->lru_next)
+		shard->entries[aes_context_handle_index(entry->lru_next)].lru_prev = entry->lru_prev;
+	else
+		shard->lru_tail = entry->lru_prev;
+}
+
+/**
+ * @brief Links an entry at the most recently used end of the LRU list.
+ *
+ * @param shard Shard of the entry.
+ * @param handle Handle of the entry.
+ */
+static void aes_key_cache_lru_push(aes_key_cache_shard_t* shard, aes_context_handle_t handle)
+{
+	aes_key_cache_entry_t* entry = &shard->entries[aes_context_handle_index(handle)];
+
+	entry->lru_prev = 0;
+	entry->lru_next = shard->lru_head;
+	if (shard->lru_head)
+		shard->entries[aes_context_handle_index(shard->lru_head)].lru_prev = handle;
+	else
+		shard->lru_tail = handle;
+	shard->lru_head = handle;
+}
+
+/**
+ * @brief Unlinks an entry from the shard and wipes its schedule.
+ *
+ * @param shard Shard of the entry.
+ * @param handle Handle of the entry.
+ */
+static void aes_key_cache_evict(aes_key_cache_shard_t* shard, aes_context_handle_t handle)
+{
+	aes_key_cache_entry_t* entry = &shard->entries[aes_context_handle_index(handle)];
+
+	aes_context_handle_t* link = aes_key_cache_bucket(shard, aes_key_cache_hash(entry->key_id));
+	while (*link != handle)
+		link = &shard->entries[aes_context_handle_index(*link)].hash_next;
+	*link = entry->hash_next;
+
+	aes_key_cache_lru_unlink(shard, handle);
+	memset(entry, 0, sizeof(*entry));
+	aes_context_arena_free(shard->arena, handle);
+}
+
+/**
+ * @brief Checks in constant time whether a schedule was expanded from a key.
+ *
+ * The first key_size bytes of an encryption schedule are the key itself.
+ *
+ * @param ctx Cached context.
+ * @param key Key material.
+ * @param key_size Key size in bytes.
+ * @return 1 if the context was expanded from the key, 0 otherwise.
+ */
+static int aes_key_cache_matches(const aes_context_t* ctx, const uint8_t* key, size_t key_size)
+{
+	if ((size_t)ctx->key_size != key_size)
+		return 0;
+
+	const uint8_t* schedule = (const uint8_t*)ctx->enc_round_keys;
+	uint8_t diff = 0;
+	for (size_t i = 0; i < key_size; ++i)
+		diff |= schedule[i] ^ key[i];
+	return diff == 0;
+}
+
+aes_key_cache_t* aes_key_cache_create(size_t capacity, size_t num_shards, unsigned flags)
+{
+	if (num_shards == 0 || capacity < num_shards)
+		return NULL;
+
+	size_t shard_capacity = (capacity + num_shards - 1) / num_shards;
+	if (shard_capacity > AES_CONTEXT_ARENA_MAX_CAPACITY)
+		return NULL;
+
+	aes_key_cache_t* cache = (aes_key_cache_t*)calloc(1, sizeof(*cache));
+	if (!cache)
+		return NULL;
+
+	cache->context_size = (flags & AES_CONTEXT_ARENA_ENCRYPT_ONLY) ? AES_CONTEXT_ENCRYPT_SIZE : sizeof(aes_context_t);
+	cache->shards = (aes_key_cache_shard_t*)aligned_alloc(AES_CACHE_LINE_SIZE, num_shards * sizeof(aes_key_cache_shard_t));
+	if (!cache->shards)
+	{
+		free(cache);
+		return NULL;
+	}
+	memset(cache->shards, 0, num_shards * sizeof(aes_key_cache_shard_t));
+
+	// At most one entry per bucket on average
+	size_t num_buckets = 1;
+	while (num_buckets < shard_capacity)
+		num_buckets <<= 1;
+
+	for (; cache->num_shards < num_shards; ++cache->num_shards)
+	{
+		aes_key_cache_shard_t* shard = &cache->shards[cache->num_shards];
+		shard->capacity = shard_capacity;
+		shard->bucket_mask = num_buckets - 1;
+		shard->arena = aes_context_arena_create(shard_capacity, flags);
+		shard->entries = (aes_key_cache_entry_t*)calloc(shard_capacity, sizeof(*shard->entries));
+		shard->buckets = (aes_context_handle_t*)calloc(num_buckets, sizeof(*shard->buckets));
+
+		if (!shard->arena || !shard->entries || !shard->buckets || pthread_mutex_init(&shard->mutex, NULL) != 0)
+		{
+			aes_context_arena_destroy(shard->arena);
+			free(shard->entries);
+			free(shard->buckets);
+			aes_key_cache_destroy(cache);
+			return NULL;
+		}
+	}
+
+	return cache;
+}
+
+void aes_key_cache_destroy(aes_key_cache_t* cache)
+{
+	if (!cache)
+		return;
+
+	for (size_t i = 0; i < cache->num_shards; ++i)
+	{
+		aes_key_cache_shard_t* shard = &cache->shards[i];
+		pthread_mutex_destroy(&shard->mutex);
+		aes_context_arena_destroy(shard->arena);
+		free(shard->entries);
+		free(shard->buckets);
+	}
+
+	free(cache->shards);
+	free(cache);
+}
+
+int aes_key_cache_get(aes_key_cache_t* cache, uint64_t key_id, const uint8_t* key, size_t key_size, aes_context_t* ctx)
+{
+	if (!cache || !ctx)
+		return 1;
+	if (key && key_size != AES_128 && key_size != AES_192 && key_size != AES_256)
+		return 1;
+
+	uint64_t hash = aes_key_cache_hash(key_id);
+	aes_key_cache_shard_t* shard = &cache->shards[hash % cache->num_shards];
+
+	pthread_mutex_lock(&shard->mutex);
+
+	aes_context_handle_t handle = aes_key_cache_find(shard, key_id, hash);
+	if (handle)
+	{
+		const aes_context_t* cached = aes_context_arena_get(shard->arena, handle);
+		if (!key || aes_key_cache_matches(cached, key, key_size))
+		{
+			shard->hits++;
+			aes_key_cache_lru_unlink(shard, handle);
+			aes_key_cache_lru_push(shard, handle);
+			memcpy(ctx, cached, cache->context_size);
+			pthread_mutex_unlock(&shard->mutex);
+			return 0;
+		}
+
+		// The identifier now names another key
+		aes_key_cache_evict(shard, handle);
+	}
+
+	shard->misses++;
+	if (!key)
+	{
+		pthread_mutex_unlock(&shard->mutex);
+		return 1;
+	}
+
+	if (aes_context_arena_count(shard->arena) == shard->capacity)
+	{
+		aes_key_cache_evict(shard, shard->lru_tail);
+		shard->evictions++;
+	}
+
+	// The expansion runs under the lock so that concurrent misses on a key expand it once
+	handle = aes_context_arena_alloc(shard->arena, key, key_size);
+	if (handle == AES_CONTEXT_HANDLE_INVALID)
+	{
+		pthread_mutex_unlock(&shard->mutex);
+		return 1;
+	}
+
+	aes_key_cache_entry_t* entry = &shard->entries[aes_context_handle_index(handle)];
+	aes_context_handle_t* bucket = aes_key_cache_bucket(shard, hash);
+	entry->key_id = key_id;
+	entry->hash_next = *bucket;
+	*bucket = handle;
+	aes_key_cache_lru_push(shard, handle);
+
+	memcpy(ctx, aes_context_arena_get(shard->arena, handle), cache->context_size);
+	pthread_mutex_unlock(&shard->mutex);
+	return 0;
+}
+
+int aes_key_cache_remove(aes_key_cache_t* cache, uint64_t key_id)
+{
+	if (!cache)
+		return 1;
+
+	uint64_t hash = aes_key_cache_hash(key_id);
+	aes_key_cache_shard_t* shard = &cache->shards[hash % cache->num_shards];
+
+	pthread_mutex_lock(&shard->mutex);
+	aes_context_handle_t handle = aes_key_cache_find(shard, key_id, hash);
+	if (handle)
+		aes_key_cache_evict(shard, handle);
+	pthread_mutex_unlock(&shard->mutex);
+
+	return handle ? 0 : 1;
+}
+
+void aes_key_cache_stats(aes_key_cache_t* cache, aes_key_cache_stats_t* stats)
+{
+	if (!stats)
+		return;
+
+	memset(stats, 0, sizeof(*stats));
+	if (!cache)
+		return;
+
+	for (size_t i = 0; i < cache->num_shards; ++i)
+	{
+		aes_key_cache_shard_t* shard = &cache->shards[i];
+		pthread_mutex_lock(&shard->mutex);
+		stats->hits += shard->hits;
+		stats->misses += shard->misses;
+		stats->evictions += shard->evictions;
+		stats->count += aes_context_arena_count(shard->arena);
+		pthread_mutex_unlock(&shard->mutex);
+	}
+}
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "aes/core/aes_key_expansion.h"
+#include <stdint.h>
+#include <tmmintrin.h>
 
 /**
  * @brief Helper function for AES-128 key expansion.
@@ -236,6 +238,136 @@ void aes256_key_expansion(const __m128i user_key[2], __m128i enc_round_keys[AES_
 	enc_round_keys[14] = temp1;
 }
 
+/**
+ * @brief XORs each 32-bit word of a block with all the words below it.
+ *
+ * @param block Block (w0, w1, w2, w3).
+ * @return (w0, w0^w1, w0^w1^w2, w0^w1^w2^w3).
+ */
+static inline __m128i aes_key_prefix_xor(__m128i block)
+{
+	block = _mm_xor_si128(block, _mm_slli_si128(block, 0x4));
+	return _mm_xor_si128(block, _mm_slli_si128(block, 0x8));
+}
+
+/**
+ * @brief Computes SubWord(RotWord(w)) xor rcon in every word with aesenclast.
+ *
+ * @param block Block holding w.
+ * @param rotate Shuffle mask broadcasting RotWord(w) to all four words.
+ * @param rcon Round constant in every word (zero for a plain SubWord).
+ * @return The substituted word, broadcast.
+ */
+static inline __m128i aes_key_sub_word(__m128i block, __m128i rotate, __m128i rcon)
+{
+	// All four columns are equal, so ShiftRows is the identity and only SubBytes and the XOR remain
+	return _mm_aesenclast_si128(_mm_shuffle_epi8(block, rotate), rcon);
+}
+
+void aes128_key_expansion_x4(const __m128i user_keys[AES_KEY_EXPANSION_LANES], __m128i* const enc_round_keys[AES_KEY_EXPANSION_LANES])
+{
+	const __m128i rotate = _mm_set1_epi32(0x0c0f0e0d); // RotWord(w3)
+	__m128i rcon = _mm_set1_epi32(0x01);
+	__m128i keys[AES_KEY_EXPANSION_LANES];
+
+	for (int j = 0; j < AES_KEY_EXPANSION_LANES; ++j)
+	{
+		keys[j] = user_keys[j];
+		enc_round_keys[j][0] = keys[j];
+	}
+
+	for (int round = 1; round < AES_128_NUM_ROUND_KEYS; ++round)
+	{
+		// 0x01 ... 0x80 by doubling, then 0x1b and 0x36
+		if (round == 9)
+			rcon = _mm_set1_epi32(0x1b);
+
+		// Independent chains: the next lane's aesenclast issues while this one completes
+		for (int j = 0; j < AES_KEY_EXPANSION_LANES; ++j)
+		{
+			keys[j] = _mm_xor_si128(aes_key_prefix_xor(keys[j]), aes_key_sub_word(keys[j], rotate, rcon));
+			enc_round_keys[j][round] = keys[j];
+		}
+
+		rcon = _mm_slli_epi32(rcon, 1);
+	}
+}
+
+void aes192_key_expansion_x4(const __m128i user_keys[AES_KEY_EXPANSION_LANES][2], __m128i* const enc_round_keys[AES_KEY_EXPANSION_LANES])
+{
+	const __m128i rotate = _mm_set1_epi32(0x04070605); // RotWord(w1) of the second part
+	__m128i rcon = _mm_set1_epi32(0x01);
+	__m128i first[AES_KEY_EXPANSION_LANES];
+	__m128i second[AES_KEY_EXPANSION_LANES];
+
+	// Each step yields 6 words: the first part and the low half of the second,
+	// stored back to back in the schedule viewed as bytes
+	for (int j = 0; j < AES_KEY_EXPANSION_LANES; ++j)
+	{
+		first[j] = user_keys[j][0];
+		second[j] = user_keys[j][1];
+		_mm_storeu_si128(enc_round_keys[j], first[j]);
+		_mm_storel_epi64(enc_round_keys[j] + 1, second[j]);
+	}
+
+	for (int step = 1; step <= 8; ++step)
+	{
+		for (int j = 0; j < AES_KEY_EXPANSION_LANES; ++j)
+		{
+			uint8_t* schedule = (uint8_t*)enc_round_keys[j] + step * 24;
+
+			first[j] = _mm_xor_si128(aes_key_prefix_xor(first[j]), aes_key_sub_word(second[j], rotate, rcon));
+			second[j] = _mm_xor_si128(_mm_xor_si128(second[j], _mm_slli_si128(second[j], 0x4)), _mm_shuffle_epi32(first[j], 0xff));
+
+			// The 13th round key ends the schedule after the first part of step 8
+			_mm_storeu_si128((__m128i*)schedule, first[j]);
+			if (step < 8)
+				_mm_storel_epi64((__m128i*)(schedule + 16), second[j]);
+		}
+
+		rcon = _mm_slli_epi32(rcon, 1);
+	}
+}
+
+void aes256_key_expansion_x4(const __m128i user_keys[AES_KEY_EXPANSION_LANES][2], __m128i* const enc_round_keys[AES_KEY_EXPANSION_LANES])
+{
+	const __m128i rotate = _mm_set1_epi32(0x0c0f0e0d); // RotWord(w3)
+	const __m128i broadcast = _mm_set1_epi32(0x0f0e0d0c); // w3, not rotated
+	const __m128i zero = _mm_setzero_si128();
+	__m128i rcon = _mm_set1_epi32(0x01);
+	__m128i first[AES_KEY_EXPANSION_LANES];
+	__m128i second[AES_KEY_EXPANSION_LANES];
+
+	for (int j = 0; j < AES_KEY_EXPANSION_LANES; ++j)
+	{
+		first[j] = user_keys[j][0];
+		second[j] = user_keys[j][1];
+		enc_round_keys[j][0] = first[j];
+		enc_round_keys[j][1] = second[j];
+	}
+
+	for (int round = 2; round < AES_256_NUM_ROUND_KEYS; round += 2)
+	{
+		for (int j = 0; j < AES_KEY_EXPANSION_LANES; ++j)
+		{
+			first[j] = _mm_xor_si128(aes_key_prefix_xor(first[j]), aes_key_sub_word(second[j], rotate, rcon));
+			enc_round_keys[j][round] = first[j];
+		}
+
+		if (round + 1 == AES_256_NUM_ROUND_KEYS)
+			break;
+
+		// Odd round keys use SubWord without rotation or round constant
+		for (int j = 0; j < AES_KEY_EXPANSION_LANES; ++j)
+		{
+			second[j] = _mm_xor_si128(aes_key_prefix_xor(second[j]), aes_key_sub_word(first[j], broadcast, zero));
+			enc_round_keys[j][round + 1] = second[j];
+		}
+
+		rcon = _mm_slli_epi32(rcon, 1);
+	}
+}
+
 void aes128_invert_round_keys(const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS], __m128i dec_round_keys[AES_128_NUM_ROUND_KEYS])
 {
 	// First decryption round key = last encryption round key
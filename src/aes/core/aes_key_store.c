@@ -0,0 +1,444 @@
+#define _DEFAULT_SOURCE // open(), fstat(), fsync(), fdopen() and mmap() under -std=c11
+
+#include "aes/core/aes_key_store.h"
+#include "aes/core/aes_constants.h"
+#include "aes/core/aes_cpu.h"
+#include "aes/core/aes_dispatch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define AES_KEY_STORE_MMAP
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define AES_KEY_STORE_MAGIC "AESKSTR1" ///< File signature, without terminator
+
+/**
+ * @brief Size of a record holding a full context, rounded up to whole cache lines.
+ */
+#define AES_KEY_STORE_RECORD_SIZE \
+	((sizeof(aes_context_t) + AES_CACHE_LINE_SIZE - 1) & ~(size_t)(AES_CACHE_LINE_SIZE - 1))
+
+#define AES_KEY_STORE_FNV_BASIS 0xcbf29ce484222325ULL ///< FNV-1a 64-bit offset basis
+#define AES_KEY_STORE_FNV_PRIME 0x100000001b3ULL ///< FNV-1a 64-bit prime
+
+/**
+ * @brief On-disk header, one cache line long so that records stay aligned.
+ */
+typedef struct {
+	char magic[8]; ///< AES_KEY_STORE_MAGIC
+	uint32_t version; ///< AES_KEY_STORE_VERSION
+	uint32_t header_size; ///< sizeof(aes_key_store_header_t)
+	uint32_t record_size; ///< Bytes per record
+	uint32_t context_size; ///< sizeof(aes_context_t) of the writer
+	uint32_t cpu_features; ///< AES_KEY_STORE_CPU_* features the schedules need
+	uint32_t flags; ///< AES_KEY_STORE_ENCRYPT_ONLY or 0
+	uint64_t count; ///< Number of records
+	uint64_t payload_checksum; ///< Checksum of all records
+	uint64_t header_checksum; ///< Checksum of the fields above
+	uint64_t reserved; ///< Zero
+} aes_key_store_header_t;
+
+_Static_assert(sizeof(aes_key_store_header_t) == AES_CACHE_LINE_SIZE, "key store header must fill a cache line");
+
+struct aes_key_store {
+	uint8_t* data; ///< Whole file contents
+	size_t size; ///< File size in bytes
+	int mapped; ///< data is a private mapping rather than a heap copy
+	uint8_t* records; ///< First record
+	size_t record_size; ///< Bytes per record
+	size_t count; ///< Number of records
+	uint8_t* resolved; ///< Per record, 1 once its dispatch table has been set
+};
+
+/**
+ * @brief Updates a checksum (FNV-1a over 64-bit words).
+ *
+ * Not a MAC: it detects truncated or corrupted files, not tampering.
+ *
+ * @param hash Current checksum, AES_KEY_STORE_FNV_BASIS initially.
+ * @param data Data to add.
+ * @param size Size of the data, a multiple of 8 bytes.
+ * @return Updated checksum.
+ */
+static uint64_t aes_key_store_checksum(uint64_t hash, const uint8_t* data, size_t size)
+{
+	for (size_t i = 0; i < size; i += 8)
+	{
+		uint64_t word;
+		memcpy(&word, data + i, sizeof(word));
+		hash = (hash ^ word) * AES_KEY_STORE_FNV_PRIME;
+	}
+	return hash;
+}
+
+/**
+ * @brief Returns the checksum of a header.
+ *
+ * @param header Header.
+ * @return Checksum of the fields preceding header_checksum.
+ */
+static uint64_t aes_key_store_header_checksum(const aes_key_store_header_t* header)
+{
+	return aes_key_store_checksum(AES_KEY_STORE_FNV_BASIS, (const uint8_t*)header, offsetof(aes_key_store_header_t, header_checksum));
+}
+
+/**
+ * @brief Returns the CPU features required by schedules that the running CPU provides.
+ *
+ * @return Combination of AES_KEY_STORE_CPU_* flags.
+ */
+static uint32_t aes_key_store_cpu_features(void)
+{
+	return aes_cpu_get_features()->aesni ? AES_KEY_STORE_CPU_AESNI : 0;
+}
+
+/**
+ * @brief Builds the on-disk record of a context.
+ *
+ * @param record Receives the record; AES_KEY_STORE_RECORD_SIZE bytes, 16-byte aligned.
+ * @param ctx Initialized context.
+ * @param encrypt_only Whether the decryption schedule is left out.
+ */
+static void aes_key_store_make_record(uint8_t* record, const aes_context_t* ctx, int encrypt_only)
+{
+	aes_context_t* copy = (aes_context_t*)record;
+	size_t num_round_keys = (size_t)ctx->key_size / 4 + 7;
+
+	// Encrypt-only contexts may live in AES_CONTEXT_ENCRYPT_SIZE bytes; unused round keys may hold stale data
+	memset(record, 0, AES_KEY_STORE_RECORD_SIZE);
+	copy->key_size = ctx->key_size;
+	memcpy(copy->enc_round_keys, ctx->enc_round_keys, num_round_keys * sizeof(__m128i));
+
+	if (!encrypt_only)
+	{
+		if (ctx->has_dec_round_keys)
+			memcpy(copy->dec_round_keys, ctx->dec_round_keys, num_round_keys * sizeof(__m128i));
+		else
+			aes_context_prepare_decrypt(copy);
+		copy->has_dec_round_keys = 1;
+	}
+}
+
+/**
+ * @brief Creates a new file next to a store, to be renamed over it once complete.
+ *
+ * Stores are never rewritten in place: processes may still have the old file
+ * mapped, and truncating it would fault their untouched pages. The file is
+ * only readable by its owner since schedules start with the raw keys.
+ *
+ * @param path Path of the store.
+ * @param temp_path Receives the path of the new file; strlen(path) + 32 bytes.
+ * @param temp_size Size of the temp_path buffer.
+ * @return File opened for writing, or NULL on error.
+ */
+static FILE* aes_key_store_create_temp(const char* path, char* temp_path, size_t temp_size)
+{
+#ifdef AES_KEY_STORE_MMAP
+	// O_EXCL never reuses an existing file; retry if another writer holds the name
+	for (unsigned attempt = 0; attempt < 100; ++attempt)
+	{
+		snprintf(temp_path, temp_size, "%s.%ld.%u.tmp", path, (long)getpid(), attempt);
+
+		int fd = open(temp_path, O_CREAT | O_EXCL | O_WRONLY, 0600);
+		if (fd < 0)
+		{
+			if (errno == EEXIST)
+				continue;
+			return NULL;
+		}
+
+		FILE* file = fdopen(fd, "wb");
+		if (!file)
+		{
+			close(fd);
+			remove(temp_path);
+		}
+		return file;
+	}
+	return NULL;
+#else
+	snprintf(temp_path, temp_size, "%s.tmp", path);
+	return fopen(temp_path, "wb");
+#endif
+}
+
+/**
+ * @brief Flushes a complete temporary file to disk and renames it over the store.
+ *
+ * @param file Temporary file, closed by this function.
+ * @param temp_path Path of the temporary file, removed on error.
+ * @param path Path of the store.
+ * @return 0 on success, 1 on I/O error.
+ */
+static int aes_key_store_replace(FILE* file, const char* temp_path, const char* path)
+{
+	int status = fflush(file) != 0;
+#ifdef AES_KEY_STORE_MMAP
+	if (!status)
+		status = fsync(fileno(file)) != 0;
+#endif
+	if (fclose(file) != 0)
+		status = 1;
+
+#ifndef AES_KEY_STORE_MMAP
+	// rename() does not replace existing files everywhere
+	if (!status)
+		remove(path);
+#endif
+	if (!status)
+		status = rename(temp_path, path) != 0;
+
+	if (status)
+		remove(temp_path);
+	return status;
+}
+
+int aes_key_store_write(const char* path, const aes_context_t* ctxs, size_t count, unsigned flags)
+{
+	if (!path || (count > 0 && !ctxs) || (flags & ~(unsigned)AES_KEY_STORE_ENCRYPT_ONLY))
+		return 1;
+
+	for (size_t i = 0; i < count; ++i)
+		if (ctxs[i].key_size != AES_128 && ctxs[i].key_size != AES_192 && ctxs[i].key_size != AES_256)
+			return 1;
+
+	int encrypt_only = (flags & AES_KEY_STORE_ENCRYPT_ONLY) != 0;
+
+	aes_key_store_header_t header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, AES_KEY_STORE_MAGIC, sizeof(header.magic));
+	header.version = AES_KEY_STORE_VERSION;
+	header.header_size = sizeof(header);
+	header.record_size = (uint32_t)(encrypt_only ? AES_CONTEXT_ENCRYPT_SIZE : AES_KEY_STORE_RECORD_SIZE);
+	header.context_size = sizeof(aes_context_t);
+	header.cpu_features = AES_KEY_STORE_CPU_AESNI;
+	header.flags = flags;
+	header.count = count;
+
+	size_t temp_size = strlen(path) + 32;
+	char* temp_path = (char*)malloc(temp_size);
+	if (!temp_path)
+		return 1;
+
+	FILE* file = aes_key_store_create_temp(path, temp_path, temp_size);
+	if (!file)
+	{
+		free(temp_path);
+		return 1;
+	}
+
+	// The header is written again once the records checksum is known
+	int status = fwrite(&header, sizeof(header), 1, file) != 1;
+
+	_Alignas(AES_CACHE_LINE_SIZE) uint8_t record[AES_KEY_STORE_RECORD_SIZE];
+	uint64_t checksum = AES_KEY_STORE_FNV_BASIS;
+
+	for (size_t i = 0; i < count && !status; ++i)
+	{
+		aes_key_store_make_record(record, &ctxs[i], encrypt_only);
+		checksum = aes_key_store_checksum(checksum, record, header.record_size);
+		status = fwrite(record, header.record_size, 1, file) != 1;
+	}
+	memset(record, 0, sizeof(record));
+	__asm__ volatile ("" : : "r"(record) : "memory");
+
+	header.payload_checksum = checksum;
+	header.header_checksum = aes_key_store_header_checksum(&header);
+	if (!status)
+		status = fseek(file, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, file) != 1;
+
+	if (status)
+	{
+		fclose(file);
+		remove(temp_path);
+	}
+	else
+	{
+		status = aes_key_store_replace(file, temp_path, path);
+	}
+
+	free(temp_path);
+	return status;
+}
+
+/**
+ * @brief Loads a whole file into a store.
+ *
+ * Files are mapped privately where mmap() exists, so pages are only read when
+ * touched and dispatch tables can be filled without writing back to the file.
+ *
+ * @param store Store whose data, size and mapped fields are filled.
+ * @param path File to load.
+ * @return 0 on success, 1 on I/O error or file too small to hold a header.
+ */
+static int aes_key_store_load(aes_key_store_t* store, const char* path)
+{
+#ifdef AES_KEY_STORE_MMAP
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return 1;
+
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(aes_key_store_header_t))
+	{
+		close(fd);
+		return 1;
+	}
+
+	store->size = (size_t)info.st_size;
+	void* data = mmap(NULL, store->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return 1;
+
+	store->data = (uint8_t*)data;
+	store->mapped = 1;
+	return 0;
+#else
+	FILE* file = fopen(path, "rb");
+	if (!file)
+		return 1;
+
+	long size = -1;
+	if (fseek(file, 0, SEEK_END) == 0)
+		size = ftell(file);
+	if (size < (long)sizeof(aes_key_store_header_t) || fseek(file, 0, SEEK_SET) != 0)
+	{
+		fclose(file);
+		return 1;
+	}
+
+	// aligned_alloc() wants a multiple of the alignment
+	store->size = (size_t)size;
+	size_t alloc_size = (store->size + AES_CACHE_LINE_SIZE - 1) & ~(size_t)(AES_CACHE_LINE_SIZE - 1);
+	store->data = (uint8_t*)aligned_alloc(AES_CACHE_LINE_SIZE, alloc_size);
+	int status = !store->data || fread(store->data, 1, store->size, file) != store->size;
+	fclose(file);
+
+	return status;
+#endif
+}
+
+/**
+ * @brief Checks the header of a loaded store and fills its record fields.
+ *
+ * @param store Loaded store.
+ * @param flags Open flags.
+ * @return 0 if the store can be used, 1 otherwise.
+ */
+static int aes_key_store_check(aes_key_store_t* store, unsigned flags)
+{
+	aes_key_store_header_t header;
+	memcpy(&header, store->data, sizeof(header));
+
+	if (memcmp(header.magic, AES_KEY_STORE_MAGIC, sizeof(header.magic)) != 0
+		|| header.version != AES_KEY_STORE_VERSION
+		|| header.header_size != sizeof(header)
+		|| header.header_checksum != aes_key_store_header_checksum(&header))
+		return 1;
+
+	// Layout of the writer's build
+	int encrypt_only = (header.flags & AES_KEY_STORE_ENCRYPT_ONLY) != 0;
+	size_t record_size = encrypt_only ? AES_CONTEXT_ENCRYPT_SIZE : AES_KEY_STORE_RECORD_SIZE;
+	if (header.context_size != sizeof(aes_context_t) || header.record_size != record_size
+		|| (header.flags & ~(uint32_t)AES_KEY_STORE_ENCRYPT_ONLY))
+		return 1;
+
+	if (header.cpu_features & ~aes_key_store_cpu_features())
+		return 1;
+
+	size_t payload_size = store->size - sizeof(header);
+	if (header.count != payload_size / record_size || payload_size % record_size != 0)
+		return 1;
+
+	store->records = store->data + sizeof(header);
+	store->record_size = record_size;
+	store->count = (size_t)header.count;
+
+	if ((flags & AES_KEY_STORE_VERIFY)
+		&& aes_key_store_checksum(AES_KEY_STORE_FNV_BASIS, store->records, payload_size) != header.payload_checksum)
+		return 1;
+
+	return 0;
+}
+
+aes_key_store_t* aes_key_store_open(const char* path, unsigned flags)
+{
+	if (!path || (flags & ~(unsigned)AES_KEY_STORE_VERIFY))
+		return NULL;
+
+	aes_key_store_t* store = (aes_key_store_t*)calloc(1, sizeof(*store));
+	if (!store)
+		return NULL;
+
+	if (aes_key_store_load(store, path) || aes_key_store_check(store, flags))
+	{
+		aes_key_store_close(store);
+		return NULL;
+	}
+
+	// Zeroed pages are only committed for the records actually used
+	store->resolved = (uint8_t*)calloc(store->count ? store->count : 1, 1);
+	if (!store->resolved)
+	{
+		aes_key_store_close(store);
+		return NULL;
+	}
+
+	return store;
+}
+
+void aes_key_store_close(aes_key_store_t* store)
+{
+	if (!store)
+		return;
+
+#ifdef AES_KEY_STORE_MMAP
+	if (store->mapped)
+		munmap(store->data, store->size);
+	else
+#endif
+	if (store->data)
+	{
+		// Heap copies of the schedules are wiped like any other context memory
+		memset(store->data, 0, store->size);
+		__asm__ volatile ("" : : "r"(store->data) : "memory");
+		free(store->data);
+	}
+
+	free(store->resolved);
+	free(store);
+}
+
+size_t aes_key_store_count(const aes_key_store_t* store)
+{
+	return store ? store->count : 0;
+}
+
+const aes_context_t* aes_key_store_get(aes_key_store_t* store, size_t index)
+{
+	if (!store || index >= store->count)
+		return NULL;
+
+	aes_context_t* ctx = (aes_context_t*)(store->records + index * store->record_size);
+	if (__atomic_load_n(&store->resolved[index], __ATOMIC_ACQUIRE))
+		return ctx;
+
+	// First use: reject records that would make the modes read out of bounds
+	if (ctx->key_size != AES_128 && ctx->key_size != AES_192 && ctx->key_size != AES_256)
+		return NULL;
+	if (ctx->has_dec_round_keys != (store->record_size == AES_KEY_STORE_RECORD_SIZE))
+		return NULL;
+
+	// Concurrent first uses store the same pointer
+	__atomic_store_n(&ctx->dispatch, aes_dispatch_get(ctx->key_size), __ATOMIC_RELAXED);
+	__atomic_store_n(&store->resolved[index], 1, __ATOMIC_RELEASE);
+	return ctx;
+}
\ No newline at end of file
@@ -0,0 +1,438 @@
+#include "aes/core/aes_vaes.h"
+#include "aes/core/aes_rounds.h"
+#include <immintrin.h>
+
+/// Target attribute for the 256-bit VAES kernels
+#define AES_VAES256_TARGET __attribute__((target("avx2,aes,vaes")))
+
+/// Target attribute for the 512-bit VAES kernels
+#define AES_VAES512_TARGET __attribute__((target("avx512f,avx512bw,aes,vaes")))
+
+/**
+ * @brief Encrypts num_blocks blocks with 256-bit VAES, 2 blocks per register.
+ *
+ * The main loop keeps 8 registers (16 blocks) in flight; the remainder is
+ * handled one register at a time, then block by block with AES-NI.
+ *
+ * @param plaintext Array of num_blocks input blocks.
+ * @param ciphertext Output array of num_blocks blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to process.
+ * @param enc_round_keys AES encryption round keys.
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline AES_VAES256_TARGET void aes_encrypt_blocks_vaes256(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i* enc_round_keys, int num_rounds)
+{
+	__m256i rk[AES_256_NUM_ROUND_KEYS];
+	size_t i = 0;
+
+	// Broadcast every round key to all lanes once per call
+	for (int r = 0; r <= num_rounds; ++r)
+		rk[r] = _mm256_broadcastsi128_si256(enc_round_keys[r]);
+
+	for (; i + 16 <= num_blocks; i += 16)
+	{
+		__m256i b[8];
+
+		for (int j = 0; j < 8; ++j)
+			b[j] = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(plaintext + i + 2 * j)), rk[0]);
+
+		for (int r = 1; r < num_rounds; ++r)
+		{
+			for (int j = 0; j < 8; ++j)
+				b[j] = _mm256_aesenc_epi128(b[j], rk[r]);
+		}
+
+		for (int j = 0; j < 8; ++j)
+			_mm256_storeu_si256((__m256i*)(ciphertext + i + 2 * j), _mm256_aesenclast_epi128(b[j], rk[num_rounds]));
+	}
+
+	for (; i + 2 <= num_blocks; i += 2)
+	{
+		__m256i b = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(plaintext + i)), rk[0]);
+
+		for (int r = 1; r < num_rounds; ++r)
+			b = _mm256_aesenc_epi128(b, rk[r]);
+
+		_mm256_storeu_si256((__m256i*)(ciphertext + i), _mm256_aesenclast_epi128(b, rk[num_rounds]));
+	}
+
+	for (; i < num_blocks; ++i)
+		_mm_storeu_si128(ciphertext + i, aes_encrypt_x1(_mm_loadu_si128(plaintext + i), enc_round_keys, num_rounds));
+}
+
+/**
+ * @brief Decrypts num_blocks blocks with 256-bit VAES, 2 blocks per register.
+ *
+ * The main loop keeps 8 registers (16 blocks) in flight; the remainder is
+ * handled one register at a time, then block by block with AES-NI.
+ *
+ * @param ciphertext Array of num_blocks input blocks.
+ * @param plaintext Output array of num_blocks blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to process.
+ * @param dec_round_keys AES decryption round keys.
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline AES_VAES256_TARGET void aes_decrypt_blocks_vaes256(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i* dec_round_keys, int num_rounds)
+{
+	__m256i rk[AES_256_NUM_ROUND_KEYS];
+	size_t i = 0;
+
+	// Broadcast every round key to all lanes once per call
+	for (int r = 0; r <= num_rounds; ++r)
+		rk[r] = _mm256_broadcastsi128_si256(dec_round_keys[r]);
+
+	for (; i + 16 <= num_blocks; i += 16)
+	{
+		__m256i b[8];
+
+		for (int j = 0; j < 8; ++j)
+			b[j] = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(ciphertext + i + 2 * j)), rk[0]);
+
+		for (int r = 1; r < num_rounds; ++r)
+		{
+			for (int j = 0; j < 8; ++j)
+				b[j] = _mm256_aesdec_epi128(b[j], rk[r]);
+		}
+
+		for (int j = 0; j < 8; ++j)
+			_mm256_storeu_si256((__m256i*)(plaintext + i + 2 * j), _mm256_aesdeclast_epi128(b[j], rk[num_rounds]));
+	}
+
+	for (; i + 2 <= num_blocks; i += 2)
+	{
+		__m256i b = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(ciphertext + i)), rk[0]);
+
+		for (int r = 1; r < num_rounds; ++r)
+			b = _mm256_aesdec_epi128(b, rk[r]);
+
+		_mm256_storeu_si256((__m256i*)(plaintext + i), _mm256_aesdeclast_epi128(b, rk[num_rounds]));
+	}
+
+	for (; i < num_blocks; ++i)
+		_mm_storeu_si128(plaintext + i, aes_decrypt_x1(_mm_loadu_si128(ciphertext + i), dec_round_keys, num_rounds));
+}
+
+/**
+ * @brief Encrypts num_blocks blocks with 512-bit VAES, 4 blocks per register.
+ *
+ * The main loop keeps 8 registers (32 blocks) in flight; the remainder is
+ * handled one register at a time, then block by block with AES-NI.
+ *
+ * @param plaintext Array of num_blocks input blocks.
+ * @param ciphertext Output array of num_blocks blocks (may alias plaintext).
+ * @param num_blocks Number of blocks to process.
+ * @param enc_round_keys AES encryption round keys.
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline AES_VAES512_TARGET void aes_encrypt_blocks_vaes512(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i* enc_round_keys, int num_rounds)
+{
+	__m512i rk[AES_256_NUM_ROUND_KEYS];
+	size_t i = 0;
+
+	// Broadcast every round key to all lanes once per call
+	for (int r = 0; r <= num_rounds; ++r)
+		rk[r] = _mm512_broadcast_i32x4(enc_round_keys[r]);
+
+	for (; i + 32 <= num_blocks; i += 32)
+	{
+		__m512i b[8];
+
+		for (int j = 0; j < 8; ++j)
+			b[j] = _mm512_xor_si512(_mm512_loadu_si512((const __m512i*)(plaintext + i + 4 * j)), rk[0]);
+
+		for (int r = 1; r < num_rounds; ++r)
+		{
+			for (int j = 0; j < 8; ++j)
+				b[j] = _mm512_aesenc_epi128(b[j], rk[r]);
+		}
+
+		for (int j = 0; j < 8; ++j)
+			_mm512_storeu_si512((__m512i*)(ciphertext + i + 4 * j), _mm512_aesenclast_epi128(b[j], rk[num_rounds]));
+	}
+
+	for (; i + 4 <= num_blocks; i += 4)
+	{
+		__m512i b = _mm512_xor_si512(_mm512_loadu_si512((const __m512i*)(plaintext + i)), rk[0]);
+
+		for (int r = 1; r < num_rounds; ++r)
+			b = _mm512_aesenc_epi128(b, rk[r]);
+
+		_mm512_storeu_si512((__m512i*)(ciphertext + i), _mm512_aesenclast_epi128(b, rk[num_rounds]));
+	}
+
+	for (; i < num_blocks; ++i)
+		_mm_storeu_si128(ciphertext + i, aes_encrypt_x1(_mm_loadu_si128(plaintext + i), enc_round_keys, num_rounds));
+}
+
+/**
+ * @brief Decrypts num_blocks blocks with 512-bit VAES, 4 blocks per register.
+ *
+ * The main loop keeps 8 registers (32 blocks) in flight; the remainder is
+ * handled one register at a time, then block by block with AES-NI.
+ *
+ * @param ciphertext Array of num_blocks input blocks.
+ * @param plaintext Output array of num_blocks blocks (may alias ciphertext).
+ * @param num_blocks Number of blocks to process.
+ * @param dec_round_keys AES decryption round keys.
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline AES_VAES512_TARGET void aes_decrypt_blocks_vaes512(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i* dec_round_keys, int num_rounds)
+{
+	__m512i rk[AES_256_NUM_ROUND_KEYS];
+	size_t i = 0;
+
+	// Broadcast every round key to all lanes once per call
+	for (int r = 0; r <= num_rounds; ++r)
+		rk[r] = _mm512_broadcast_i32x4(dec_round_keys[r]);
+
+	for (; i + 32 <= num_blocks; i += 32)
+	{
+		__m512i b[8];
+
+		for (int j = 0; j < 8; ++j)
+			b[j] = _mm512_xor_si512(_mm512_loadu_si512((const __m512i*)(ciphertext + i + 4 * j)), rk[0]);
+
+		for (int r = 1; r < num_rounds; ++r)
+		{
+			for (int j = 0; j < 8; ++j)
+				b[j] = _mm512_aesdec_epi128(b[j], rk[r]);
+		}
+
+		for (int j = 0; j < 8; ++j)
+			_mm512_storeu_si512((__m512i*)(plaintext + i + 4 * j), _mm512_aesdeclast_epi128(b[j], rk[num_rounds]));
+	}
+
+	for (; i + 4 <= num_blocks; i += 4)
+	{
+		__m512i b = _mm512_xor_si512(_mm512_loadu_si512((const __m512i*)(ciphertext + i)), rk[0]);
+
+		for (int r = 1; r < num_rounds; ++r)
+			b = _mm512_aesdec_epi128(b, rk[r]);
+
+		_mm512_storeu_si512((__m512i*)(plaintext + i), _mm512_aesdeclast_epi128(b, rk[num_rounds]));
+	}
+
+	for (; i < num_blocks; ++i)
+		_mm_storeu_si128(plaintext + i, aes_decrypt_x1(_mm_loadu_si128(ciphertext + i), dec_round_keys, num_rounds));
+}
+
+/**
+ * @brief CTR mode with 256-bit VAES: 16 counters in flight, 2 per register.
+ *
+ * Counters are derived from a broadcast little-endian copy of the counter with
+ * 64-bit lane additions, then byte-swapped. A batch whose low 64 bits would wrap
+ * is delegated to the AES-NI path, which carries into the high half. The
+ * remainder is handled by the AES-NI path as well.
+ *
+ * @param input Array of num_blocks input blocks.
+ * @param output Output array of num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks.
+ * @param enc_round_keys AES encryption round keys.
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline AES_VAES256_TARGET void aes_ctr_blocks_vaes256(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i* enc_round_keys, int num_rounds)
+{
+	const __m128i bswap128 = aes_bswap_mask();
+	const __m256i bswap = _mm256_broadcastsi128_si256(bswap128);
+	const __m256i lane_offsets = _mm256_setr_epi64x(0, 0, 1, 0);
+	const __m256i step = _mm256_setr_epi64x(2, 0, 2, 0);
+	__m128i ctr = _mm_shuffle_epi8(_mm_loadu_si128(counter), bswap128);
+	__m256i rk[AES_256_NUM_ROUND_KEYS];
+	size_t i = 0;
+
+	// Broadcast every round key to all lanes once per call
+	for (int r = 0; r <= num_rounds; ++r)
+		rk[r] = _mm256_broadcastsi128_si256(enc_round_keys[r]);
+
+	for (; i + 16 <= num_blocks; i += 16)
+	{
+		if ((uint64_t)_mm_cvtsi128_si64(ctr) > UINT64_MAX - 16)
+		{
+			_mm_storeu_si128(counter, _mm_shuffle_epi8(ctr, bswap128));
+			aes_ctr_blocks_xn(input + i, output + i, 16, counter, enc_round_keys, num_rounds);
+			ctr = _mm_shuffle_epi8(_mm_loadu_si128(counter), bswap128);
+			continue;
+		}
+
+		__m256i c = _mm256_add_epi64(_mm256_broadcastsi128_si256(ctr), lane_offsets);
+		__m256i b[8];
+
+		for (int j = 0; j < 8; ++j)
+		{
+			b[j] = _mm256_xor_si256(_mm256_shuffle_epi8(c, bswap), rk[0]);
+			c = _mm256_add_epi64(c, step);
+		}
+
+		for (int r = 1; r < num_rounds; ++r)
+		{
+			for (int j = 0; j < 8; ++j)
+				b[j] = _mm256_aesenc_epi128(b[j], rk[r]);
+		}
+
+		for (int j = 0; j < 8; ++j)
+		{
+			__m256i data = _mm256_loadu_si256((const __m256i*)(input + i + 2 * j));
+			_mm256_storeu_si256((__m256i*)(output + i + 2 * j), _mm256_xor_si256(data, _mm256_aesenclast_epi128(b[j], rk[num_rounds])));
+		}
+
+		ctr = _mm_add_epi64(ctr, _mm_set_epi64x(0, 16));
+	}
+
+	_mm_storeu_si128(counter, _mm_shuffle_epi8(ctr, bswap128));
+	aes_ctr_blocks_xn(input + i, output + i, num_blocks - i, counter, enc_round_keys, num_rounds);
+}
+
+/**
+ * @brief CTR mode with 512-bit VAES: 32 counters in flight, 4 per register.
+ *
+ * Same scheme as aes_ctr_blocks_vaes256() on 512-bit registers.
+ *
+ * @param input Array of num_blocks input blocks.
+ * @param output Output array of num_blocks blocks (may alias input).
+ * @param num_blocks Number of blocks to process.
+ * @param counter [in/out] Big-endian counter block; advanced by num_blocks.
+ * @param enc_round_keys AES encryption round keys.
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static inline AES_VAES512_TARGET void aes_ctr_blocks_vaes512(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i* enc_round_keys, int num_rounds)
+{
+	const __m128i bswap128 = aes_bswap_mask();
+	const __m512i bswap = _mm512_broadcast_i32x4(bswap128);
+	const __m512i lane_offsets = _mm512_setr_epi64(0, 0, 1, 0, 2, 0, 3, 0);
+	const __m512i step = _mm512_setr_epi64(4, 0, 4, 0, 4, 0, 4, 0);
+	__m128i ctr = _mm_shuffle_epi8(_mm_loadu_si128(counter), bswap128);
+	__m512i rk[AES_256_NUM_ROUND_KEYS];
+	size_t i = 0;
+
+	// Broadcast every round key to all lanes once per call
+	for (int r = 0; r <= num_rounds; ++r)
+		rk[r] = _mm512_broadcast_i32x4(enc_round_keys[r]);
+
+	for (; i + 32 <= num_blocks; i += 32)
+	{
+		if ((uint64_t)_mm_cvtsi128_si64(ctr) > UINT64_MAX - 32)
+		{
+			_mm_storeu_si128(counter, _mm_shuffle_epi8(ctr, bswap128));
+			aes_ctr_blocks_xn(input + i, output + i, 32, counter, enc_round_keys, num_rounds);
+			ctr = _mm_shuffle_epi8(_mm_loadu_si128(counter), bswap128);
+			continue;
+		}
+
+		__m512i c = _mm512_add_epi64(_mm512_broadcast_i32x4(ctr), lane_offsets);
+		__m512i b[8];
+
+		for (int j = 0; j < 8; ++j)
+		{
+			b[j] = _mm512_xor_si512(_mm512_shuffle_epi8(c, bswap), rk[0]);
+			c = _mm512_add_epi64(c, step);
+		}
+
+		for (int r = 1; r < num_rounds; ++r)
+		{
+			for (int j = 0; j < 8; ++j)
+				b[j] = _mm512_aesenc_epi128(b[j], rk[r]);
+		}
+
+		for (int j = 0; j < 8; ++j)
+		{
+			__m512i data = _mm512_loadu_si512((const __m512i*)(input + i + 4 * j));
+			_mm512_storeu_si512((__m512i*)(output + i + 4 * j), _mm512_xor_si512(data, _mm512_aesenclast_epi128(b[j], rk[num_rounds])));
+		}
+
+		ctr = _mm_add_epi64(ctr, _mm_set_epi64x(0, 32));
+	}
+
+	_mm_storeu_si128(counter, _mm_shuffle_epi8(ctr, bswap128));
+	aes_ctr_blocks_xn(input + i, output + i, num_blocks - i, counter, enc_round_keys, num_rounds);
+}
+
+AES_VAES256_TARGET void aes128_encrypt_blocks_vaes256(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_vaes256(plaintext, ciphertext, num_blocks, enc_round_keys, AES_128_NUM_ROUNDS);
+}
+
+AES_VAES256_TARGET void aes192_encrypt_blocks_vaes256(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_vaes256(plaintext, ciphertext, num_blocks, enc_round_keys, AES_192_NUM_ROUNDS);
+}
+
+AES_VAES256_TARGET void aes256_encrypt_blocks_vaes256(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_vaes256(plaintext, ciphertext, num_blocks, enc_round_keys, AES_256_NUM_ROUNDS);
+}
+
+AES_VAES256_TARGET void aes128_decrypt_blocks_vaes256(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_vaes256(ciphertext, plaintext, num_blocks, dec_round_keys, AES_128_NUM_ROUNDS);
+}
+
+AES_VAES256_TARGET void aes192_decrypt_blocks_vaes256(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_vaes256(ciphertext, plaintext, num_blocks, dec_round_keys, AES_192_NUM_ROUNDS);
+}
+
+AES_VAES256_TARGET void aes256_decrypt_blocks_vaes256(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_vaes256(ciphertext, plaintext, num_blocks, dec_round_keys, AES_256_NUM_ROUNDS);
+}
+
+AES_VAES512_TARGET void aes128_encrypt_blocks_vaes512(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_vaes512(plaintext, ciphertext, num_blocks, enc_round_keys, AES_128_NUM_ROUNDS);
+}
+
+AES_VAES512_TARGET void aes192_encrypt_blocks_vaes512(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_vaes512(plaintext, ciphertext, num_blocks, enc_round_keys, AES_192_NUM_ROUNDS);
+}
+
+AES_VAES512_TARGET void aes256_encrypt_blocks_vaes512(const __m128i* plaintext, __m128i* ciphertext, size_t num_blocks, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_encrypt_blocks_vaes512(plaintext, ciphertext, num_blocks, enc_round_keys, AES_256_NUM_ROUNDS);
+}
+
+AES_VAES512_TARGET void aes128_decrypt_blocks_vaes512(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_vaes512(ciphertext, plaintext, num_blocks, dec_round_keys, AES_128_NUM_ROUNDS);
+}
+
+AES_VAES512_TARGET void aes192_decrypt_blocks_vaes512(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_vaes512(ciphertext, plaintext, num_blocks, dec_round_keys, AES_192_NUM_ROUNDS);
+}
+
+AES_VAES512_TARGET void aes256_decrypt_blocks_vaes512(const __m128i* ciphertext, __m128i* plaintext, size_t num_blocks, const __m128i dec_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_decrypt_blocks_vaes512(ciphertext, plaintext, num_blocks, dec_round_keys, AES_256_NUM_ROUNDS);
+}
+
+AES_VAES256_TARGET void aes128_ctr_blocks_vaes256(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_ctr_blocks_vaes256(input, output, num_blocks, counter, enc_round_keys, AES_128_NUM_ROUNDS);
+}
+
+AES_VAES256_TARGET void aes192_ctr_blocks_vaes256(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_ctr_blocks_vaes256(input, output, num_blocks, counter, enc_round_keys, AES_192_NUM_ROUNDS);
+}
+
+AES_VAES256_TARGET void aes256_ctr_blocks_vaes256(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_ctr_blocks_vaes256(input, output, num_blocks, counter, enc_round_keys, AES_256_NUM_ROUNDS);
+}
+
+AES_VAES512_TARGET void aes128_ctr_blocks_vaes512(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_128_NUM_ROUND_KEYS])
+{
+	aes_ctr_blocks_vaes512(input, output, num_blocks, counter, enc_round_keys, AES_128_NUM_ROUNDS);
+}
+
+AES_VAES512_TARGET void aes192_ctr_blocks_vaes512(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_192_NUM_ROUND_KEYS])
+{
+	aes_ctr_blocks_vaes512(input, output, num_blocks, counter, enc_round_keys, AES_192_NUM_ROUNDS);
+}
+
+AES_VAES512_TARGET void aes256_ctr_blocks_vaes512(const __m128i* input, __m128i* output, size_t num_blocks, __m128i* counter, const __m128i enc_round_keys[AES_256_NUM_ROUND_KEYS])
+{
+	aes_ctr_blocks_vaes512(input, output, num_blocks, counter, enc_round_keys, AES_256_NUM_ROUNDS);
+}
\ No newline at end of file
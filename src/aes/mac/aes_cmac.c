@@ -0,0 +1,283 @@
+#include "aes/mac/aes_cmac.h"
+#include "aes/core/aes_rounds.h"
+#include "aes/core/aes_ct.h"
+#include <string.h>
+
+/**
+ * @brief Builds the last block of a message, masked with its subkey.
+ *
+ * @param key CMAC key.
+ * @param data Last (possibly partial or empty) block of the message.
+ * @param len Number of bytes in the last block (0 to AES_BLOCK_SIZE).
+ * @return Last block XOR K1 if it is whole, padded last block XOR K2 otherwise.
+ */
+static inline __m128i aes_cmac_last_block(const aes_cmac_key_t* key, const uint8_t* data, size_t len)
+{
+	if (len == AES_BLOCK_SIZE)
+		return _mm_xor_si128(_mm_loadu_si128((const __m128i*)data), key->k1);
+
+	uint8_t block[AES_BLOCK_SIZE] = {0};
+	if (len > 0)
+		memcpy(block, data, len);
+	block[len] = 0x80;
+
+	return _mm_xor_si128(_mm_loadu_si128((const __m128i*)block), key->k2);
+}
+
+/**
+ * @brief CBC-MAC chain over whole blocks, specialized for one key size.
+ *
+ * @param num_rounds Number of AES rounds (compile-time constant at each call site).
+ * @param enc_round_keys Encryption round keys.
+ * @param mac Chain value, updated in place.
+ * @param data Blocks to authenticate.
+ * @param num_blocks Number of blocks.
+ */
+static AES_FORCE_INLINE void aes_cmac_chain(int num_rounds, const __m128i* enc_round_keys, __m128i* mac, const uint8_t* data, size_t num_blocks)
+{
+	__m128i round_keys[AES_256_NUM_ROUND_KEYS];
+	__m128i value = *mac;
+
+	aes_load_round_keys(round_keys, enc_round_keys, num_rounds);
+
+	for (size_t i = 0; i < num_blocks; ++i)
+		value = aes_encrypt_x1(_mm_xor_si128(value, _mm_loadu_si128((const __m128i*)(data + i * AES_BLOCK_SIZE))), round_keys, num_rounds);
+
+	*mac = value;
+}
+
+/**
+ * @brief Advances a CBC-MAC chain over whole blocks.
+ *
+ * @param key CMAC key.
+ * @param mac Chain value, updated in place.
+ * @param data Blocks to authenticate.
+ * @param num_blocks Number of blocks.
+ */
+static void aes_cmac_process(const aes_cmac_key_t* key, __m128i* mac, const uint8_t* data, size_t num_blocks)
+{
+	AES_KEY_SIZE_SWITCH(key->ctx->key_size, aes_cmac_chain, key->ctx->enc_round_keys, mac, data, num_blocks);
+}
+
+/**
+ * @brief Processes the masked last block and stores the MAC.
+ *
+ * @param key CMAC key.
+ * @param mac Chain value before the last block.
+ * @param last Last block, already masked by aes_cmac_last_block().
+ * @param tag Buffer receiving the AES_CMAC_SIZE-byte MAC.
+ */
+static void aes_cmac_finish(const aes_cmac_key_t* key, __m128i mac, __m128i last, uint8_t* tag)
+{
+	uint8_t block[AES_BLOCK_SIZE];
+
+	_mm_storeu_si128((__m128i*)block, last);
+	aes_cmac_process(key, &mac, block, 1);
+	_mm_storeu_si128((__m128i*)tag, mac);
+}
+
+/**
+ * @brief Runs up to lanes CBC-MAC chains side by side.
+ *
+ * Each step encrypts one block of every message. A message whose chain is
+ * already complete keeps its value; its lane still goes through the rounds so
+ * that the step stays a single aes_encrypt_x4/x8 call.
+ *
+ * @param num_rounds Number of AES rounds (compile-time constant at each call site).
+ * @param lanes 4 or 8 (compile-time constant at each call site).
+ * @param round_keys Encryption round keys (local copy).
+ * @param key CMAC key.
+ * @param messages Message pointers.
+ * @param lengths Message lengths in bytes.
+ * @param count Number of messages (at most lanes).
+ * @param tags Buffers receiving the MACs.
+ */
+static AES_FORCE_INLINE void aes_cmac_lanes(int num_rounds, int lanes, const __m128i* round_keys, const aes_cmac_key_t* key,
+	const uint8_t* const* messages, const size_t* lengths, size_t count, uint8_t (*tags)[AES_CMAC_SIZE])
+{
+	__m128i macs[AES_CMAC_BATCH_LANES];
+	__m128i lasts[AES_CMAC_BATCH_LANES];
+	__m128i blocks[AES_CMAC_BATCH_LANES];
+	size_t num_blocks[AES_CMAC_BATCH_LANES];
+	size_t max_blocks = 0;
+
+	for (int j = 0; j < lanes; ++j)
+	{
+		macs[j] = _mm_setzero_si128();
+		lasts[j] = _mm_setzero_si128();
+		num_blocks[j] = 0;
+
+		if ((size_t)j >= count)
+			continue;
+
+		// The empty message is one padded block
+		size_t len = lengths[j];
+		size_t n = len > 0 ? (len + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE : 1;
+		size_t last_offset = (n - 1) * AES_BLOCK_SIZE;
+
+		lasts[j] = aes_cmac_last_block(key, len > 0 ? messages[j] + last_offset : NULL, len - last_offset);
+		num_blocks[j] = n;
+		if (n > max_blocks)
+			max_blocks = n;
+	}
+
+	for (size_t s = 0; s < max_blocks; ++s)
+	{
+		for (int j = 0; j < lanes; ++j)
+		{
+			if (s + 1 < num_blocks[j])
+				blocks[j] = _mm_xor_si128(macs[j], _mm_loadu_si128((const __m128i*)(messages[j] + s * AES_BLOCK_SIZE)));
+			else if (s + 1 == num_blocks[j])
+				blocks[j] = _mm_xor_si128(macs[j], lasts[j]);
+			else
+				blocks[j] = macs[j];
+		}
+
+		if (lanes == 8)
+			aes_encrypt_x8(blocks, round_keys, num_rounds);
+		else
+			aes_encrypt_x4(blocks, round_keys, num_rounds);
+
+		for (int j = 0; j < lanes; ++j)
+			if (s < num_blocks[j])
+				macs[j] = blocks[j];
+	}
+
+	for (size_t j = 0; j < count; ++j)
+		_mm_storeu_si128((__m128i*)tags[j], macs[j]);
+}
+
+/**
+ * @brief Batch loop, specialized for one key size.
+ *
+ * @param num_rounds Number of AES rounds (compile-time constant at each call site).
+ * @param key CMAC key.
+ * @param messages Message pointers.
+ * @param lengths Message lengths in bytes.
+ * @param count Number of messages.
+ * @param tags Buffers receiving the MACs.
+ */
+static AES_FORCE_INLINE void aes_cmac_batch_loop(int num_rounds, const aes_cmac_key_t* key, const uint8_t* const* messages, const size_t* lengths, size_t count, uint8_t (*tags)[AES_CMAC_SIZE])
+{
+	__m128i round_keys[AES_256_NUM_ROUND_KEYS];
+	aes_load_round_keys(round_keys, key->ctx->enc_round_keys, num_rounds);
+
+	for (size_t i = 0; i < count; i += AES_CMAC_BATCH_LANES)
+	{
+		size_t group = count - i < AES_CMAC_BATCH_LANES ? count - i : AES_CMAC_BATCH_LANES;
+
+		if (group > 4)
+			aes_cmac_lanes(num_rounds, 8, round_keys, key, messages + i, lengths + i, group, tags + i);
+		else
+			aes_cmac_lanes(num_rounds, 4, round_keys, key, messages + i, lengths + i, group, tags + i);
+	}
+}
+
+int aes_cmac_key_init(aes_cmac_key_t* key, const aes_context_t* ctx)
+{
+	if (!key || !ctx)
+		return 1;
+
+	__m128i l;
+	ctx->dispatch->encrypt_block(_mm_setzero_si128(), &l, ctx->enc_round_keys);
+
+	key->ctx = ctx;
+	key->k1 = aes_gf128_double(l);
+	key->k2 = aes_gf128_double(key->k1);
+
+	return 0;
+}
+
+int aes_cmac_init(aes_cmac_t* cmac, const aes_cmac_key_t* key)
+{
+	if (!cmac || !key || !key->ctx)
+		return 1;
+
+	cmac->key = key;
+	cmac->mac = _mm_setzero_si128();
+	cmac->buffer_len = 0;
+
+	return 0;
+}
+
+int aes_cmac_update(aes_cmac_t* cmac, const uint8_t* data, size_t len)
+{
+	if (!cmac || !cmac->key || (len > 0 && !data))
+		return 1;
+
+	// The last block is masked differently: always keep one block pending
+	if (cmac->buffer_len + len <= AES_BLOCK_SIZE)
+	{
+		if (len > 0)
+			memcpy(cmac->buffer + cmac->buffer_len, data, len);
+		cmac->buffer_len += len;
+		return 0;
+	}
+
+	if (cmac->buffer_len > 0)
+	{
+		size_t take = AES_BLOCK_SIZE - cmac->buffer_len;
+
+		memcpy(cmac->buffer + cmac->buffer_len, data, take);
+		aes_cmac_process(cmac->key, &cmac->mac, cmac->buffer, 1);
+		data += take;
+		len -= take;
+	}
+
+	size_t num_blocks = (len - 1) / AES_BLOCK_SIZE;
+	aes_cmac_process(cmac->key, &cmac->mac, data, num_blocks);
+
+	cmac->buffer_len = len - num_blocks * AES_BLOCK_SIZE;
+	memcpy(cmac->buffer, data + num_blocks * AES_BLOCK_SIZE, cmac->buffer_len);
+
+	return 0;
+}
+
+int aes_cmac_final(aes_cmac_t* cmac, uint8_t* tag)
+{
+	if (!cmac || !cmac->key || !tag)
+		return 1;
+
+	aes_cmac_finish(cmac->key, cmac->mac, aes_cmac_last_block(cmac->key, cmac->buffer, cmac->buffer_len), tag);
+	return 0;
+}
+
+int aes_cmac(const aes_cmac_key_t* key, const uint8_t* data, size_t len, uint8_t* tag)
+{
+	if (!key || !key->ctx || !tag || (len > 0 && !data))
+		return 1;
+
+	size_t num_blocks = len > 0 ? (len - 1) / AES_BLOCK_SIZE : 0;
+	size_t last_offset = num_blocks * AES_BLOCK_SIZE;
+	__m128i mac = _mm_setzero_si128();
+
+	aes_cmac_process(key, &mac, data, num_blocks);
+	aes_cmac_finish(key, mac, aes_cmac_last_block(key, len > 0 ? data + last_offset : NULL, len - last_offset), tag);
+
+	return 0;
+}
+
+int aes_cmac_verify(const aes_cmac_key_t* key, const uint8_t* data, size_t len, const uint8_t* tag, size_t tag_len)
+{
+	if (!tag || tag_len < AES_CMAC_MIN_TAG_SIZE || tag_len > AES_CMAC_SIZE)
+		return 1;
+
+	uint8_t full_tag[AES_CMAC_SIZE];
+	if (aes_cmac(key, data, len, full_tag) != 0)
+		return 1;
+
+	return aes_ct_memcmp(full_tag, tag, tag_len);
+}
+
+int aes_cmac_batch(const aes_cmac_key_t* key, const uint8_t* const* messages, const size_t* lengths, size_t count, uint8_t (*tags)[AES_CMAC_SIZE])
+{
+	if (!key || !key->ctx || (count > 0 && (!messages || !lengths || !tags)))
+		return 1;
+
+	for (size_t i = 0; i < count; ++i)
+		if (lengths[i] > 0 && !messages[i])
+			return 1;
+
+	AES_KEY_SIZE_SWITCH(key->ctx->key_size, aes_cmac_batch_loop, key, messages, lengths, count, tags);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,202 @@
+#include "aes/mac/aes_ghash.h"
+#include "aes/core/aes_clmul.h"
+#include "aes/core/aes_rounds.h"
+#include "aes/core/aes_cpu.h"
+#include <immintrin.h>
+#include <string.h>
+
+/// Target attribute for the 256-bit VPCLMULQDQ kernel
+#define AES_GHASH_VPCLMUL_TARGET __attribute__((target("avx2,pclmul,vpclmulqdq")))
+
+/**
+ * @brief Hashes groups of 8 blocks with 256-bit VPCLMULQDQ, 2 blocks per register.
+ *
+ * Each group is multiplied by H^8..H^1 (4 registers of 2 powers), the three
+ * partial products are folded to 128 bits and reduced once.
+ *
+ * @param acc GHASH accumulator.
+ * @param data Blocks to hash.
+ * @param num_groups Number of 8-block groups.
+ * @param h_powers H^1..H^8.
+ * @return Updated accumulator.
+ */
+static AES_GHASH_VPCLMUL_TARGET __m128i aes_ghash_x8_vpclmul256(__m128i acc, const uint8_t* data, size_t num_groups, const __m128i h_powers[AES_GHASH_H_POWERS])
+{
+	const __m256i bswap = _mm256_broadcastsi128_si256(aes_bswap_mask());
+	const __m256i* blocks = (const __m256i*)data;
+	__m256i h[4];
+
+	// Register k pairs blocks 2k and 2k + 1 with H^(8-2k) and H^(7-2k)
+	for (int k = 0; k < 4; ++k)
+		h[k] = _mm256_set_m128i(h_powers[6 - 2 * k], h_powers[7 - 2 * k]);
+
+	for (size_t g = 0; g < num_groups; ++g)
+	{
+		__m256i lo = _mm256_setzero_si256(), mid = _mm256_setzero_si256(), hi = _mm256_setzero_si256();
+
+		for (int k = 0; k < 4; ++k)
+		{
+			__m256i x = _mm256_shuffle_epi8(_mm256_loadu_si256(blocks + 4 * g + k), bswap);
+			if (k == 0)
+				x = _mm256_xor_si256(x, _mm256_set_m128i(_mm_setzero_si128(), acc));
+
+			lo = _mm256_xor_si256(lo, _mm256_clmulepi64_epi128(x, h[k], 0x00));
+			hi = _mm256_xor_si256(hi, _mm256_clmulepi64_epi128(x, h[k], 0x11));
+			mid = _mm256_xor_si256(mid, _mm256_clmulepi64_epi128(x, h[k], 0x10));
+			mid = _mm256_xor_si256(mid, _mm256_clmulepi64_epi128(x, h[k], 0x01));
+		}
+
+		acc = aes_clmul_reduce(
+			_mm_xor_si128(_mm256_castsi256_si128(lo), _mm256_extracti128_si256(lo, 1)),
+			_mm_xor_si128(_mm256_castsi256_si128(mid), _mm256_extracti128_si256(mid, 1)),
+			_mm_xor_si128(_mm256_castsi256_si128(hi), _mm256_extracti128_si256(hi, 1)));
+	}
+
+	return acc;
+}
+
+/**
+ * @brief Hashes whole blocks, 8 per reduction, then the remainder one by one.
+ *
+ * @param acc GHASH accumulator.
+ * @param data Blocks to hash (big-endian, as in the message).
+ * @param num_blocks Number of blocks.
+ * @param key Hash key table.
+ * @return Updated accumulator.
+ */
+static __m128i aes_ghash_blocks(__m128i acc, const uint8_t* data, size_t num_blocks, const aes_ghash_key_t* key)
+{
+	const __m128i bswap = aes_bswap_mask();
+	const __m128i* blocks = (const __m128i*)data;
+	size_t i = 0;
+
+	if (key->vpclmulqdq)
+	{
+		i = num_blocks / 8 * 8;
+		acc = aes_ghash_x8_vpclmul256(acc, data, num_blocks / 8, key->h_powers);
+	}
+
+	for (; i + 8 <= num_blocks; i += 8)
+	{
+		__m128i x[8];
+
+		for (int j = 0; j < 8; ++j)
+			x[j] = _mm_shuffle_epi8(_mm_loadu_si128(blocks + i + j), bswap);
+
+		acc = aes_clmul_x8(acc, x, key->h_powers);
+	}
+
+	for (; i < num_blocks; ++i)
+		acc = aes_clmul_gfmul(_mm_xor_si128(acc, _mm_shuffle_epi8(_mm_loadu_si128(blocks + i), bswap)), key->h_powers[0]);
+
+	return acc;
+}
+
+int aes_ghash_key_init_raw(aes_ghash_key_t* key, const uint8_t* h)
+{
+	const aes_cpu_features_t* cpu = aes_cpu_get_features();
+
+	if (!key || !h || !cpu->pclmulqdq)
+		return 1;
+
+	key->h_powers[0] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)h), aes_bswap_mask());
+	for (int i = 1; i < AES_GHASH_H_POWERS; ++i)
+		key->h_powers[i] = aes_clmul_gfmul(key->h_powers[i - 1], key->h_powers[0]);
+
+	// Follow the dispatch selection, so that capping it also disables the wide kernel
+	key->vpclmulqdq = cpu->vpclmulqdq && cpu->avx2 && aes_dispatch_get_impl() >= AES_IMPL_VAES256;
+
+	return 0;
+}
+
+int aes_ghash_key_init(aes_ghash_key_t* key, const aes_context_t* ctx)
+{
+	if (!key || !ctx)
+		return 1;
+
+	uint8_t h[AES_BLOCK_SIZE];
+	__m128i encrypted;
+
+	ctx->dispatch->encrypt_block(_mm_setzero_si128(), &encrypted, ctx->enc_round_keys);
+	_mm_storeu_si128((__m128i*)h, encrypted);
+
+	return aes_ghash_key_init_raw(key, h);
+}
+
+int aes_ghash_init(aes_ghash_t* ghash, const aes_ghash_key_t* key)
+{
+	if (!ghash || !key)
+		return 1;
+
+	ghash->key = key;
+	ghash->acc = _mm_setzero_si128();
+	ghash->buffer_len = 0;
+
+	return 0;
+}
+
+int aes_ghash_update(aes_ghash_t* ghash, const uint8_t* data, size_t len)
+{
+	if (!ghash || !ghash->key || (len > 0 && !data))
+		return 1;
+
+	// Complete the buffered partial block first
+	if (ghash->buffer_len > 0)
+	{
+		size_t take = AES_BLOCK_SIZE - ghash->buffer_len < len ? AES_BLOCK_SIZE - ghash->buffer_len : len;
+		memcpy(ghash->buffer + ghash->buffer_len, data, take);
+		ghash->buffer_len += take;
+		data += take;
+		len -= take;
+
+		if (ghash->buffer_len < AES_BLOCK_SIZE)
+			return 0;
+
+		ghash->acc = aes_ghash_blocks(ghash->acc, ghash->buffer, 1, ghash->key);
+		ghash->buffer_len = 0;
+	}
+
+	ghash->acc = aes_ghash_blocks(ghash->acc, data, len / AES_BLOCK_SIZE, ghash->key);
+
+	// Keep the trailing bytes: more data may follow
+	ghash->buffer_len = len % AES_BLOCK_SIZE;
+	if (ghash->buffer_len > 0)
+		memcpy(ghash->buffer, data + len - ghash->buffer_len, ghash->buffer_len);
+
+	return 0;
+}
+
+int aes_ghash_pad(aes_ghash_t* ghash)
+{
+	if (!ghash || !ghash->key)
+		return 1;
+
+	if (ghash->buffer_len > 0)
+	{
+		memset(ghash->buffer + ghash->buffer_len, 0, AES_BLOCK_SIZE - ghash->buffer_len);
+		ghash->acc = aes_ghash_blocks(ghash->acc, ghash->buffer, 1, ghash->key);
+		ghash->buffer_len = 0;
+	}
+
+	return 0;
+}
+
+int aes_ghash_final(aes_ghash_t* ghash, uint8_t* digest)
+{
+	if (!digest || aes_ghash_pad(ghash) != 0)
+		return 1;
+
+	_mm_storeu_si128((__m128i*)digest, _mm_shuffle_epi8(ghash->acc, aes_bswap_mask()));
+
+	return 0;
+}
+
+int aes_ghash(const aes_ghash_key_t* key, const uint8_t* data, size_t len, uint8_t* digest)
+{
+	aes_ghash_t ghash;
+
+	if (aes_ghash_init(&ghash, key) != 0 || aes_ghash_update(&ghash, data, len) != 0)
+		return 1;
+
+	return aes_ghash_final(&ghash, digest);
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "aes/mac/aes_polyval.h"
+#include "aes/core/aes_clmul.h"
+#include "aes/core/aes_cpu.h"
+#include <string.h>
+
+/**
+ * @brief Hashes whole blocks, 8 per reduction, then the remainder one by one.
+ *
+ * @param acc POLYVAL accumulator.
+ * @param data Blocks to hash (used as loaded).
+ * @param num_blocks Number of blocks.
+ * @param key Hash key table.
+ * @return Updated accumulator.
+ */
+static __m128i aes_polyval_blocks(__m128i acc, const uint8_t* data, size_t num_blocks, const aes_polyval_key_t* key)
+{
+	const __m128i* blocks = (const __m128i*)data;
+	size_t i = 0;
+
+	for (; i + 8 <= num_blocks; i += 8)
+	{
+		__m128i x[8];
+
+		for (int j = 0; j < 8; ++j)
+			x[j] = _mm_loadu_si128(blocks + i + j);
+
+		acc = aes_clmul_x8(acc, x, key->h_powers);
+	}
+
+	for (; i < num_blocks; ++i)
+		acc = aes_clmul_gfmul(_mm_xor_si128(acc, _mm_loadu_si128(blocks + i)), key->h_powers[0]);
+
+	return acc;
+}
+
+int aes_polyval_key_init(aes_polyval_key_t* key, const uint8_t* h)
+{
+	if (!key || !h || !aes_cpu_get_features()->pclmulqdq)
+		return 1;
+
+	// mulX_GHASH(ByteReverse(H)) in the GHASH domain: H as loaded, shifted right by one bit
+	uint64_t lo, hi;
+	memcpy(&lo, h, sizeof(lo));
+	memcpy(&hi, h + 8, sizeof(hi));
+
+	uint64_t carry = lo & 1;
+	lo = (lo >> 1) | (hi << 63);
+	hi = (hi >> 1) ^ (carry ? 0xe100000000000000ULL : 0);
+
+	key->h_powers[0] = _mm_set_epi64x((long long)hi, (long long)lo);
+	for (int i = 1; i < AES_POLYVAL_H_POWERS; ++i)
+		key->h_powers[i] = aes_clmul_gfmul(key->h_powers[i - 1], key->h_powers[0]);
+
+	return 0;
+}
+
+int aes_polyval_init(aes_polyval_t* polyval, const aes_polyval_key_t* key)
+{
+	if (!polyval || !key)
+		return 1;
+
+	polyval->key = key;
+	polyval->acc = _mm_setzero_si128();
+	polyval->buffer_len = 0;
+
+	return 0;
+}
+
+int aes_polyval_update(aes_polyval_t* polyval, const uint8_t* data, size_t len)
+{
+	if (!polyval || !polyval->key || (len > 0 && !data))
+		return 1;
+
+	// Complete the buffered partial block first
+	if (polyval->buffer_len > 0)
+	{
+		size_t take = AES_BLOCK_SIZE - polyval->buffer_len < len ? AES_BLOCK_SIZE - polyval->buffer_len : len;
+		memcpy(polyval->buffer + polyval->buffer_len, data, take);
+		polyval->buffer_len += take;
+		data += take;
+		len -= take;
+
+		if (polyval->buffer_len < AES_BLOCK_SIZE)
+			return 0;
+
+		polyval->acc = aes_polyval_blocks(polyval->acc, polyval->buffer, 1, polyval->key);
+		polyval->buffer_len = 0;
+	}
+
+	polyval->acc = aes_polyval_blocks(polyval->acc, data, len / AES_BLOCK_SIZE, polyval->key);
+
+	// Keep the trailing bytes: more data may follow
+	polyval->buffer_len = len % AES_BLOCK_SIZE;
+	if (polyval->buffer_len > 0)
+		memcpy(polyval->buffer, data + len - polyval->buffer_len, polyval->buffer_len);
+
+	return 0;
+}
+
+int aes_polyval_pad(aes_polyval_t* polyval)
+{
+	if (!polyval || !polyval->key)
+		return 1;
+
+	if (polyval->buffer_len > 0)
+	{
+		memset(polyval->buffer + polyval->buffer_len, 0, AES_BLOCK_SIZE - polyval->buffer_len);
+		polyval->acc = aes_polyval_blocks(polyval->acc, polyval->buffer, 1, polyval->key);
+		polyval->buffer_len = 0;
+	}
+
+	return 0;
+}
+
+int aes_polyval_final(aes_polyval_t* polyval, uint8_t* digest)
+{
+	if (!digest || aes_polyval_pad(polyval) != 0)
+		return 1;
+
+	_mm_storeu_si128((__m128i*)digest, polyval->acc);
+
+	return 0;
+}
+
+int aes_polyval(const aes_polyval_key_t* key, const uint8_t* data, size_t len, uint8_t* digest)
+{
+	aes_polyval_t polyval;
+
+	if (aes_polyval_init(&polyval, key) != 0 || aes_polyval_update(&polyval, data, len) != 0)
+		return 1;
+
+	return aes_polyval_final(&polyval, digest);
+}
\ No newline at end of file
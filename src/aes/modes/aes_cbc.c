@@ -1,6 +1,39 @@
 #include "aes/modes/aes_cbc.h"
+#include "aes/core/aes_rounds.h"
 #include <string.h>
 
+/**
+ * @brief CBC encryption loop specialized for one key size.
+ *
+ * Each block depends on the previous ciphertext, so the blocks run one after
+ * the other; inlining the rounds with the round keys held in registers keeps
+ * the per-block cost down to the AES latency.
+ *
+ * @param num_rounds Number of AES rounds (compile-time constant at each call site).
+ * @param enc_round_keys Encryption round keys.
+ * @param previous IV, or last ciphertext block.
+ * @param input Plaintext blocks.
+ * @param num_blocks Number of blocks to encrypt.
+ * @param output Ciphertext blocks (may alias input).
+ */
+static AES_FORCE_INLINE void aes_cbc_encrypt_loop(int num_rounds, const __m128i* enc_round_keys, __m128i previous, const uint8_t* input, size_t num_blocks, uint8_t* output)
+{
+	__m128i round_keys[AES_256_NUM_ROUND_KEYS];
+	aes_load_round_keys(round_keys, enc_round_keys, num_rounds);
+
+	for (size_t i = 0; i < num_blocks; ++i)
+	{
+		// Load plaintext block into SSE register
+		__m128i plaintext = _mm_loadu_si128((const __m128i*)(input + i * AES_BLOCK_SIZE));
+
+		// XOR the plaintext with the previous ciphertext block (or IV for the first block) and encrypt
+		previous = aes_encrypt_x1(_mm_xor_si128(plaintext, previous), round_keys, num_rounds);
+
+		// Store the encrypted block into the output buffer
+		_mm_storeu_si128((__m128i*)(output + i * AES_BLOCK_SIZE), previous);
+	}
+}
+
 void aes_cbc_encrypt(const aes_context_t* ctx, const uint8_t iv[16], const uint8_t* input, size_t input_len, uint8_t* output)
 {
 	if (!ctx || !iv || !input || !output || input_len % AES_BLOCK_SIZE != 0)
@@ -9,58 +42,173 @@ void aes_cbc_encrypt(const aes_context_t* ctx, const uint8_t iv[16], const uint8
 	// Load the initialization vector (IV) as the starting "previous ciphertext block"
 	__m128i previous = _mm_loadu_si128((const __m128i*)iv);
 
-	for (size_t i = 0; i < input_len; i += AES_BLOCK_SIZE)
+	// Select the key-size specialized loop once for the whole message
+	AES_KEY_SIZE_SWITCH(ctx->key_size, aes_cbc_encrypt_loop, ctx->enc_round_keys, previous, input, input_len / AES_BLOCK_SIZE, output);
+}
+
+/**
+ * @brief State of one lane of the multi-buffer CBC encryption.
+ */
+typedef struct {
+	const __m128i* round_keys; ///< Encryption round keys of the message
+	const uint8_t* input; ///< Next plaintext block
+	uint8_t* output; ///< Next ciphertext block
+	size_t num_blocks; ///< Blocks left
+	__m128i previous; ///< Previous ciphertext block (or IV)
+} aes_cbc_lane_t;
+
+/**
+ * @brief Encrypts num_steps blocks of each lane, interleaving the lanes.
+ *
+ * Called with a constant num_lanes for the full case so that the lane states
+ * stay in registers.
+ *
+ * @param num_rounds Number of AES rounds (compile-time constant at each call site).
+ * @param lanes Active lanes.
+ * @param num_lanes Number of active lanes (at most AES_PARALLEL_BLOCKS).
+ * @param num_steps Number of blocks to encrypt per lane (at most the blocks left in any lane).
+ */
+static AES_FORCE_INLINE void aes_cbc_encrypt_lanes(int num_rounds, aes_cbc_lane_t* lanes, size_t num_lanes, size_t num_steps)
+{
+	__m128i x[AES_PARALLEL_BLOCKS];
+
+	for (size_t step = 0; step < num_steps; ++step)
 	{
-		// Get pointers to the current 16-byte input and output blocks
-		const uint8_t* block_in = input + i;
-		uint8_t* block_out = output + i;
+		for (size_t l = 0; l < num_lanes; ++l)
+		{
+			__m128i plaintext = _mm_loadu_si128((const __m128i*)lanes[l].input);
+			x[l] = _mm_xor_si128(_mm_xor_si128(plaintext, lanes[l].previous), lanes[l].round_keys[0]);
+		}
+
+		for (int r = 1; r < num_rounds; ++r)
+		{
+			for (size_t l = 0; l < num_lanes; ++l)
+				x[l] = _mm_aesenc_si128(x[l], lanes[l].round_keys[r]);
+		}
+
+		for (size_t l = 0; l < num_lanes; ++l)
+		{
+			lanes[l].previous = _mm_aesenclast_si128(x[l], lanes[l].round_keys[num_rounds]);
+			_mm_storeu_si128((__m128i*)lanes[l].output, lanes[l].previous);
+			lanes[l].input += AES_BLOCK_SIZE;
+			lanes[l].output += AES_BLOCK_SIZE;
+		}
+	}
 
-		// Load plaintext block into SSE register
-		__m128i plaintext = _mm_loadu_si128((const __m128i*)block_in);
+	for (size_t l = 0; l < num_lanes; ++l)
+		lanes[l].num_blocks -= num_steps;
+}
 
-		// XOR the plaintext with the previous ciphertext block (or IV for the first block)
-		__m128i xored = _mm_xor_si128(plaintext, previous);
-		__m128i ciphertext;
+/**
+ * @brief Multi-buffer CBC encryption of the jobs using one key size.
+ *
+ * @param num_rounds Number of AES rounds (compile-time constant at each call site).
+ * @param key_size Key size of the jobs to process; other jobs are left to other calls.
+ * @param jobs Array of valid jobs.
+ * @param num_jobs Number of jobs.
+ */
+static AES_FORCE_INLINE void aes_cbc_encrypt_multi_loop(int num_rounds, aes_key_size_t key_size, const aes_cbc_job_t* jobs, size_t num_jobs)
+{
+	aes_cbc_lane_t lanes[AES_PARALLEL_BLOCKS];
+	size_t num_lanes = 0;
+	size_t next_job = 0;
 
-		// Call the encryption function from context (128, 192, or 256)
-		ctx->encrypt_func(xored, &ciphertext, ctx->enc_round_keys);
+	for (;;)
+	{
+		// Fill the free lanes with the next pending jobs
+		while (num_lanes < AES_PARALLEL_BLOCKS && next_job < num_jobs)
+		{
+			const aes_cbc_job_t* job = &jobs[next_job++];
+
+			if (job->ctx->key_size != key_size || job->input_len == 0)
+				continue;
+
+			lanes[num_lanes].round_keys = job->ctx->enc_round_keys;
+			lanes[num_lanes].input = job->input;
+			lanes[num_lanes].output = job->output;
+			lanes[num_lanes].num_blocks = job->input_len / AES_BLOCK_SIZE;
+			lanes[num_lanes].previous = _mm_loadu_si128((const __m128i*)job->iv);
+			num_lanes++;
+		}
+
+		if (num_lanes == 0)
+			break;
+
+		// Run every lane until the shortest one finishes
+		size_t num_steps = lanes[0].num_blocks;
+		for (size_t l = 1; l < num_lanes; ++l)
+			num_steps = lanes[l].num_blocks < num_steps ? lanes[l].num_blocks : num_steps;
+
+		if (num_lanes == AES_PARALLEL_BLOCKS)
+			aes_cbc_encrypt_lanes(num_rounds, lanes, AES_PARALLEL_BLOCKS, num_steps);
+		else
+			aes_cbc_encrypt_lanes(num_rounds, lanes, num_lanes, num_steps);
+
+		// Release the finished lanes, moving the last active lane into the gap
+		for (size_t l = 0; l < num_lanes;)
+		{
+			if (lanes[l].num_blocks == 0)
+				lanes[l] = lanes[--num_lanes];
+			else
+				++l;
+		}
+	}
+}
 
-		// Store the encrypted block into the output buffer
-		_mm_storeu_si128((__m128i*)block_out, ciphertext);
+int aes_cbc_encrypt_multi(const aes_cbc_job_t* jobs, size_t num_jobs)
+{
+	if (!jobs)
+		return 1;
 
-		// Update the previous ciphertext block for the next iteration
-		previous = ciphertext;
+	for (size_t i = 0; i < num_jobs; ++i)
+	{
+		const aes_cbc_job_t* job = &jobs[i];
+
+		if (!job->ctx || !job->iv || !job->input || !job->output || job->input_len % AES_BLOCK_SIZE != 0)
+			return 1;
+
+		if (job->ctx->key_size != AES_128 && job->ctx->key_size != AES_192 && job->ctx->key_size != AES_256)
+			return 1;
 	}
+
+	// Lanes must share the number of rounds: one pass per key size
+	aes_cbc_encrypt_multi_loop(AES_128_NUM_ROUNDS, AES_128, jobs, num_jobs);
+	aes_cbc_encrypt_multi_loop(AES_192_NUM_ROUNDS, AES_192, jobs, num_jobs);
+	aes_cbc_encrypt_multi_loop(AES_256_NUM_ROUNDS, AES_256, jobs, num_jobs);
+	return 0;
 }
 
 void aes_cbc_decrypt(const aes_context_t* ctx, const uint8_t iv[16], const uint8_t* input, size_t input_len, uint8_t* output)
 {
-	if (!ctx || !iv || !input || !output || input_len % AES_BLOCK_SIZE != 0)
+	if (!ctx || !ctx->has_dec_round_keys || !iv || !input || !output || input_len % AES_BLOCK_SIZE != 0)
 		return;
 
 	// Load the initialization vector (IV) as the starting "previous ciphertext block"
 	__m128i previous = _mm_loadu_si128((const __m128i*)iv);
 
-	for (size_t i = 0; i < input_len; i += AES_BLOCK_SIZE)
-	{
-		// Get pointers to the current 16-byte input and output blocks
-		const uint8_t* block_in = input + i;
-		uint8_t* block_out = output + i;
+	size_t num_blocks = input_len / AES_BLOCK_SIZE;
+	__m128i ciphertext[AES_WIDE_BLOCKS];
+	__m128i decrypted[AES_WIDE_BLOCKS];
 
-		// Load ciphertext block into SSE register
-		__m128i ciphertext = _mm_loadu_si128((const __m128i*)block_in);
-		__m128i decrypted;
+	for (size_t i = 0; i < num_blocks; i += AES_WIDE_BLOCKS)
+	{
+		size_t chunk = num_blocks - i < AES_WIDE_BLOCKS ? num_blocks - i : AES_WIDE_BLOCKS;
+		const uint8_t* chunk_in = input + i * AES_BLOCK_SIZE;
+		uint8_t* chunk_out = output + i * AES_BLOCK_SIZE;
 
-		// Call the decryption function from context (128, 192, or 256)
-		ctx->decrypt_func(ciphertext, &decrypted, ctx->dec_round_keys);
+		// Keep a copy of the ciphertext blocks: output may alias input
+		for (size_t b = 0; b < chunk; ++b)
+			ciphertext[b] = _mm_loadu_si128((const __m128i*)(chunk_in + b * AES_BLOCK_SIZE));
 
-		// XOR the decrypted block with the previous ciphertext block (or IV for the first block)
-		__m128i plaintext = _mm_xor_si128(decrypted, previous);
+		// Block decryptions are independent: run them through the pipeline together
+		ctx->dispatch->decrypt_blocks(ciphertext, decrypted, chunk, ctx->dec_round_keys);
 
-		// Store the decrypted block into the output buffer
-		_mm_storeu_si128((__m128i*)block_out, plaintext);
+		// XOR each decrypted block with the previous ciphertext block (or IV for the first block)
+		_mm_storeu_si128((__m128i*)chunk_out, _mm_xor_si128(decrypted[0], previous));
+		for (size_t b = 1; b < chunk; ++b)
+			_mm_storeu_si128((__m128i*)(chunk_out + b * AES_BLOCK_SIZE), _mm_xor_si128(decrypted[b], ciphertext[b - 1]));
 
-		// Update the previous ciphertext block for the next iteration
-		previous = ciphertext;
+		// Update the previous ciphertext block for the next chunk
+		previous = ciphertext[chunk - 1];
 	}
 }
\ No newline at end of file
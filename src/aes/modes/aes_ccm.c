@@ -0,0 +1,298 @@
+#include "aes/modes/aes_ccm.h"
+#include "aes/core/aes_rounds.h"
+#include "aes/core/aes_ct.h"
+#include <string.h>
+
+/**
+ * @brief Encrypts two independent blocks with interleaved rounds.
+ *
+ * Used to pair each serial CBC-MAC step with one CTR block: the counter block
+ * does not depend on the MAC, so its rounds issue in the latency shadow of the
+ * MAC rounds.
+ *
+ * @param mac MAC chain block, replaced by its encryption.
+ * @param block Second block, replaced by its encryption.
+ * @param round_keys Encryption round keys.
+ * @param num_rounds Number of AES rounds (10, 12 or 14).
+ */
+static AES_FORCE_INLINE void aes_ccm_encrypt_x2(__m128i* mac, __m128i* block, const __m128i* round_keys, int num_rounds)
+{
+	__m128i b0 = _mm_xor_si128(*mac, round_keys[0]);
+	__m128i b1 = _mm_xor_si128(*block, round_keys[0]);
+
+	for (int r = 1; r < num_rounds; ++r)
+	{
+		b0 = _mm_aesenc_si128(b0, round_keys[r]);
+		b1 = _mm_aesenc_si128(b1, round_keys[r]);
+	}
+
+	*mac = _mm_aesenclast_si128(b0, round_keys[num_rounds]);
+	*block = _mm_aesenclast_si128(b1, round_keys[num_rounds]);
+}
+
+/**
+ * @brief Writes a length as a big-endian integer.
+ *
+ * @param dst Destination of len bytes.
+ * @param value Value to write (truncated to len bytes).
+ * @param len Number of bytes.
+ */
+static inline void aes_ccm_store_be(uint8_t* dst, uint64_t value, size_t len)
+{
+	for (size_t i = 0; i < len; ++i)
+		dst[len - 1 - i] = (uint8_t)(value >> (8 * i));
+}
+
+/**
+ * @brief Loads up to one block, zero-padded.
+ *
+ * @param src Source bytes.
+ * @param len Number of bytes to load (at most AES_BLOCK_SIZE).
+ * @return Zero-padded block.
+ */
+static inline __m128i aes_ccm_load_partial(const uint8_t* src, size_t len)
+{
+	uint8_t block[AES_BLOCK_SIZE] = {0};
+	memcpy(block, src, len);
+	return _mm_loadu_si128((const __m128i*)block);
+}
+
+/**
+ * @brief CBC-MAC over the additional data with its length prefix.
+ *
+ * @param num_rounds Number of AES rounds.
+ * @param mac Current MAC chain value.
+ * @param round_keys Encryption round keys.
+ * @param aad Additional data.
+ * @param aad_len Length of the additional data in bytes (non-zero).
+ * @return Updated MAC chain value.
+ */
+static AES_FORCE_INLINE __m128i aes_ccm_mac_aad(int num_rounds, __m128i mac, const __m128i* round_keys, const uint8_t* aad, size_t aad_len)
+{
+	uint8_t block[AES_BLOCK_SIZE] = {0};
+	size_t header_len;
+
+	// SP 800-38C A.2.2: 2, 6 or 10 bytes of length encoding
+	if (aad_len < 0xff00)
+	{
+		aes_ccm_store_be(block, aad_len, 2);
+		header_len = 2;
+	}
+	else if ((uint64_t)aad_len <= UINT32_MAX)
+	{
+		block[0] = 0xff;
+		block[1] = 0xfe;
+		aes_ccm_store_be(block + 2, aad_len, 4);
+		header_len = 6;
+	}
+	else
+	{
+		block[0] = 0xff;
+		block[1] = 0xff;
+		aes_ccm_store_be(block + 2, aad_len, 8);
+		header_len = 10;
+	}
+
+	size_t first = aad_len < AES_BLOCK_SIZE - header_len ? aad_len : AES_BLOCK_SIZE - header_len;
+	memcpy(block + header_len, aad, first);
+	mac = aes_encrypt_x1(_mm_xor_si128(mac, _mm_loadu_si128((const __m128i*)block)), round_keys, num_rounds);
+
+	aad += first;
+	aad_len -= first;
+
+	for (; aad_len >= AES_BLOCK_SIZE; aad += AES_BLOCK_SIZE, aad_len -= AES_BLOCK_SIZE)
+		mac = aes_encrypt_x1(_mm_xor_si128(mac, _mm_loadu_si128((const __m128i*)aad)), round_keys, num_rounds);
+
+	if (aad_len > 0)
+		mac = aes_encrypt_x1(_mm_xor_si128(mac, aes_ccm_load_partial(aad, aad_len)), round_keys, num_rounds);
+
+	return mac;
+}
+
+/**
+ * @brief Fused CCM kernel, specialized for one key size and direction.
+ *
+ * B0 is MACed together with the encryption of A0 (the tag mask), then the
+ * additional data is MACed. Each payload step pairs the MAC of one plaintext
+ * block with the encryption of one counter block: the counter of the same
+ * block when encrypting, the counter of the next block when decrypting (the
+ * plaintext must be recovered before it can be MACed).
+ *
+ * @param num_rounds Number of AES rounds (compile-time constant at each call site).
+ * @param decrypt 0 to encrypt, 1 to decrypt (compile-time constant at each call site).
+ * @param enc_round_keys Encryption round keys.
+ * @param b0 First CBC-MAC block (flags, nonce, payload length).
+ * @param counter Counter block A0 as a little-endian 128-bit integer.
+ * @param aad Additional data.
+ * @param aad_len Length of the additional data in bytes.
+ * @param input Input payload.
+ * @param input_len Length of the payload in bytes.
+ * @param output Output payload (may alias input).
+ * @param tag Receives the full 16-byte tag (MAC masked with E(A0)).
+ */
+static AES_FORCE_INLINE void aes_ccm_loop(int num_rounds, int decrypt, const __m128i* enc_round_keys, __m128i b0, __m128i counter,
+	const uint8_t* aad, size_t aad_len, const uint8_t* input, size_t input_len, uint8_t* output, __m128i* tag)
+{
+	const __m128i bswap = aes_bswap_mask();
+	__m128i round_keys[AES_256_NUM_ROUND_KEYS];
+	__m128i mac = b0;
+	__m128i tag_mask = _mm_shuffle_epi8(counter, bswap);
+
+	aes_load_round_keys(round_keys, enc_round_keys, num_rounds);
+	aes_ccm_encrypt_x2(&mac, &tag_mask, round_keys, num_rounds);
+
+	if (aad_len > 0)
+		mac = aes_ccm_mac_aad(num_rounds, mac, round_keys, aad, aad_len);
+
+	size_t num_blocks = (input_len + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+	__m128i keystream = _mm_setzero_si128();
+
+	// Decryption needs the first keystream block before the first MAC step
+	if (decrypt && num_blocks > 0)
+	{
+		counter = aes_ctr_add(counter, 1);
+		keystream = aes_encrypt_x1(_mm_shuffle_epi8(counter, bswap), round_keys, num_rounds);
+	}
+
+	for (size_t i = 0; i < num_blocks; ++i)
+	{
+		size_t offset = i * AES_BLOCK_SIZE;
+		size_t len = input_len - offset < AES_BLOCK_SIZE ? input_len - offset : AES_BLOCK_SIZE;
+		__m128i in = len == AES_BLOCK_SIZE ? _mm_loadu_si128((const __m128i*)(input + offset)) : aes_ccm_load_partial(input + offset, len);
+		__m128i plaintext;
+
+		if (decrypt)
+		{
+			uint8_t block[AES_BLOCK_SIZE];
+
+			plaintext = _mm_xor_si128(in, keystream);
+			if (len < AES_BLOCK_SIZE)
+			{
+				// The MAC covers the plaintext zero-padded, not the keystream tail
+				_mm_storeu_si128((__m128i*)block, plaintext);
+				memset(block + len, 0, AES_BLOCK_SIZE - len);
+				plaintext = _mm_loadu_si128((const __m128i*)block);
+			}
+
+			mac = _mm_xor_si128(mac, plaintext);
+			if (i + 1 < num_blocks)
+			{
+				counter = aes_ctr_add(counter, 1);
+				keystream = _mm_shuffle_epi8(counter, bswap);
+				aes_ccm_encrypt_x2(&mac, &keystream, round_keys, num_rounds);
+			}
+			else
+				mac = aes_encrypt_x1(mac, round_keys, num_rounds);
+
+			if (len == AES_BLOCK_SIZE)
+				_mm_storeu_si128((__m128i*)(output + offset), plaintext);
+			else
+				memcpy(output + offset, block, len);
+		}
+		else
+		{
+			plaintext = in;
+			mac = _mm_xor_si128(mac, plaintext);
+			counter = aes_ctr_add(counter, 1);
+			keystream = _mm_shuffle_epi8(counter, bswap);
+			aes_ccm_encrypt_x2(&mac, &keystream, round_keys, num_rounds);
+
+			__m128i out = _mm_xor_si128(plaintext, keystream);
+			if (len == AES_BLOCK_SIZE)
+				_mm_storeu_si128((__m128i*)(output + offset), out);
+			else
+			{
+				uint8_t block[AES_BLOCK_SIZE];
+				_mm_storeu_si128((__m128i*)block, out);
+				memcpy(output + offset, block, len);
+			}
+		}
+	}
+
+	*tag = _mm_xor_si128(mac, tag_mask);
+}
+
+/**
+ * @brief Checks the arguments, formats B0 and A0, and runs the kernel.
+ *
+ * @param ctx AES context.
+ * @param nonce Nonce.
+ * @param nonce_len Length of the nonce in bytes.
+ * @param aad Additional data.
+ * @param aad_len Length of the additional data in bytes.
+ * @param input Input payload.
+ * @param input_len Length of the payload in bytes.
+ * @param output Output payload (may alias input).
+ * @param tag_len Tag length in bytes.
+ * @param full_tag Receives the full 16-byte tag.
+ * @param decrypt 0 to encrypt, 1 to decrypt.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+static int aes_ccm_crypt(const aes_context_t* ctx, const uint8_t* nonce, size_t nonce_len, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, uint8_t* output, size_t tag_len, uint8_t full_tag[AES_BLOCK_SIZE], int decrypt)
+{
+	if (!ctx || !nonce || nonce_len < AES_CCM_MIN_NONCE_SIZE || nonce_len > AES_CCM_MAX_NONCE_SIZE)
+		return 1;
+
+	if (tag_len < AES_CCM_MIN_TAG_SIZE || tag_len > AES_CCM_MAX_TAG_SIZE || tag_len % 2 != 0)
+		return 1;
+
+	if ((aad_len > 0 && !aad) || (input_len > 0 && (!input || !output)))
+		return 1;
+
+	// The payload length must fit in the L bytes left by the nonce
+	size_t length_size = AES_BLOCK_SIZE - 1 - nonce_len;
+	if (length_size < 8 && (uint64_t)input_len >> (8 * length_size) != 0)
+		return 1;
+
+	uint8_t block[AES_BLOCK_SIZE];
+	__m128i b0, counter, tag = _mm_setzero_si128();
+
+	block[0] = (uint8_t)((aad_len > 0 ? 0x40 : 0) | ((tag_len - 2) / 2) << 3 | (length_size - 1));
+	memcpy(block + 1, nonce, nonce_len);
+	aes_ccm_store_be(block + 1 + nonce_len, input_len, length_size);
+	b0 = _mm_loadu_si128((const __m128i*)block);
+
+	block[0] = (uint8_t)(length_size - 1);
+	memset(block + 1 + nonce_len, 0, length_size);
+	counter = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)block), aes_bswap_mask());
+
+	if (decrypt)
+		AES_KEY_SIZE_SWITCH(ctx->key_size, aes_ccm_loop, 1, ctx->enc_round_keys, b0, counter, aad, aad_len, input, input_len, output, &tag);
+	else
+		AES_KEY_SIZE_SWITCH(ctx->key_size, aes_ccm_loop, 0, ctx->enc_round_keys, b0, counter, aad, aad_len, input, input_len, output, &tag);
+
+	_mm_storeu_si128((__m128i*)full_tag, tag);
+	return 0;
+}
+
+int aes_ccm_encrypt(const aes_context_t* ctx, const uint8_t* nonce, size_t nonce_len, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, uint8_t* output, uint8_t* tag, size_t tag_len)
+{
+	uint8_t full_tag[AES_BLOCK_SIZE];
+
+	if (!tag || aes_ccm_crypt(ctx, nonce, nonce_len, aad, aad_len, input, input_len, output, tag_len, full_tag, 0) != 0)
+		return 1;
+
+	memcpy(tag, full_tag, tag_len);
+	return 0;
+}
+
+int aes_ccm_decrypt(const aes_context_t* ctx, const uint8_t* nonce, size_t nonce_len, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, uint8_t* output, const uint8_t* tag, size_t tag_len)
+{
+	uint8_t full_tag[AES_BLOCK_SIZE];
+
+	if (!tag || aes_ccm_crypt(ctx, nonce, nonce_len, aad, aad_len, input, input_len, output, tag_len, full_tag, 1) != 0)
+		return 1;
+
+	// Do not release unauthenticated plaintext
+	if (aes_ct_memcmp(full_tag, tag, tag_len) != 0)
+	{
+		if (input_len > 0)
+			memset(output, 0, input_len);
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -1,50 +1,94 @@
 #include "aes/modes/aes_cfb.h"
+#include "aes/core/aes_rounds.h"
 #include <string.h>
 
-void aes_cfb_encrypt(const aes_context_t* ctx, const uint8_t iv[16], const uint8_t* input, size_t input_len, uint8_t* output)
+/**
+ * @brief Processes the final partial block and shifts its ciphertext into the register.
+ *
+ * @param shift_reg Shift register (last full ciphertext block, or IV).
+ * @param encrypted Encryption of shift_reg (keystream of the final block).
+ * @param last_in Remaining input bytes.
+ * @param last_out Remaining output bytes (may alias last_in).
+ * @param remaining Number of remaining bytes (1 to 15).
+ * @param decrypt 0 if last_in is plaintext, 1 if it is ciphertext.
+ * @return Updated shift register.
+ */
+static inline __m128i aes_cfb_final_block(__m128i shift_reg, __m128i encrypted, const uint8_t* last_in, uint8_t* last_out, size_t remaining, int decrypt)
 {
-	if (!ctx || !iv || !input || !output) return;
+	uint8_t keystream[AES_BLOCK_SIZE];
+	uint8_t shift_buffer[AES_BLOCK_SIZE];
+	uint8_t last_ciphertext[AES_BLOCK_SIZE];
+
+	// Keep the ciphertext bytes: output may alias input
+	memcpy(last_ciphertext, last_in, remaining);
+
+	_mm_storeu_si128((__m128i*)keystream, encrypted);
+
+	// XOR input with keystream for remaining bytes
+	for (size_t i = 0; i < remaining; ++i)
+		last_out[i] = last_in[i] ^ keystream[i];
+
+	if (!decrypt)
+		memcpy(last_ciphertext, last_out, remaining);
+
+	// Update shift register with new ciphertext bytes
+	_mm_storeu_si128((__m128i*)shift_buffer, shift_reg);
+	memmove(shift_buffer, shift_buffer + remaining, AES_BLOCK_SIZE - remaining);
+	memcpy(shift_buffer + AES_BLOCK_SIZE - remaining, last_ciphertext, remaining);
+	return _mm_loadu_si128((const __m128i*)shift_buffer);
+}
+
+/**
+ * @brief CFB encryption loop specialized for one key size.
+ *
+ * The shift register always holds the last ciphertext block, so each block
+ * depends on the previous one; the round keys stay in registers across blocks.
+ *
+ * @param num_rounds Number of AES rounds (compile-time constant at each call site).
+ * @param enc_round_keys Encryption round keys.
+ * @param shift_reg IV.
+ * @param input Plaintext buffer.
+ * @param input_len Length of the input in bytes.
+ * @param output Ciphertext buffer (may alias input).
+ */
+static AES_FORCE_INLINE void aes_cfb_encrypt_loop(int num_rounds, const __m128i* enc_round_keys, __m128i shift_reg, const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	__m128i round_keys[AES_256_NUM_ROUND_KEYS];
+	aes_load_round_keys(round_keys, enc_round_keys, num_rounds);
 
-	__m128i shift_reg = _mm_loadu_si128((const __m128i*)iv);
 	size_t full_blocks = input_len / AES_BLOCK_SIZE;
 	size_t remaining = input_len % AES_BLOCK_SIZE;
 
 	// Process full 16-byte blocks
 	for (size_t i = 0; i < full_blocks; ++i)
 	{
-		__m128i encrypted;
-		ctx->encrypt_func(shift_reg, &encrypted, ctx->enc_round_keys);
-
-		__m128i plaintext = _mm_loadu_si128((const __m128i*)(input + i*AES_BLOCK_SIZE));
+		__m128i encrypted = aes_encrypt_x1(shift_reg, round_keys, num_rounds);
+		__m128i plaintext = _mm_loadu_si128((const __m128i*)(input + i * AES_BLOCK_SIZE));
 		__m128i ciphertext = _mm_xor_si128(encrypted, plaintext);
 
-		_mm_storeu_si128((__m128i*)(output + i*AES_BLOCK_SIZE), ciphertext);
+		_mm_storeu_si128((__m128i*)(output + i * AES_BLOCK_SIZE), ciphertext);
 		shift_reg = ciphertext;
 	}
 
 	// Handle partial final block
 	if (remaining > 0)
 	{
-		__m128i encrypted;
-		uint8_t keystream[AES_BLOCK_SIZE];
-		uint8_t shift_buffer[AES_BLOCK_SIZE];
+		__m128i encrypted = aes_encrypt_x1(shift_reg, round_keys, num_rounds);
 		const uint8_t* last_in = input + full_blocks * AES_BLOCK_SIZE;
 		uint8_t* last_out = output + full_blocks * AES_BLOCK_SIZE;
 
-		// Generate keystream for final partial block
-		ctx->encrypt_func(shift_reg, &encrypted, ctx->enc_round_keys);
-		_mm_storeu_si128((__m128i*)keystream, encrypted);
+		shift_reg = aes_cfb_final_block(shift_reg, encrypted, last_in, last_out, remaining, 0);
+	}
+}
 
-		// XOR input with keystream for remaining bytes
-		for (size_t i = 0; i < remaining; ++i)
-			last_out[i] = last_in[i] ^ keystream[i];
+void aes_cfb_encrypt(const aes_context_t* ctx, const uint8_t iv[16], const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	if (!ctx || !iv || !input || !output) return;
 
-		// Update shift register with new ciphertext bytes
-		_mm_storeu_si128((__m128i*)shift_buffer, shift_reg);
-		memmove(shift_buffer, shift_buffer + remaining, AES_BLOCK_SIZE - remaining);
-		memcpy(shift_buffer + AES_BLOCK_SIZE - remaining, last_out, remaining);
-		shift_reg = _mm_loadu_si128((const __m128i*)shift_buffer);
-	}
+	__m128i shift_reg = _mm_loadu_si128((const __m128i*)iv);
+
+	// Select the key-size specialized loop once for the whole message
+	AES_KEY_SIZE_SWITCH(ctx->key_size, aes_cfb_encrypt_loop, ctx->enc_round_keys, shift_reg, input, input_len, output);
 }
 
 void aes_cfb_decrypt(const aes_context_t* ctx, const uint8_t iv[16],
@@ -56,40 +100,38 @@ void aes_cfb_decrypt(const aes_context_t* ctx, const uint8_t iv[16],
 	size_t full_blocks = input_len / AES_BLOCK_SIZE;
 	size_t remaining = input_len % AES_BLOCK_SIZE;
 
-	// Process full 16-byte blocks
-	for (size_t i = 0; i < full_blocks; ++i)
+	// Every keystream block is the encryption of the previous ciphertext block,
+	// which is already known: encrypt them together, AES_WIDE_BLOCKS at a time
+	__m128i feedback[AES_WIDE_BLOCKS];
+	__m128i keystream[AES_WIDE_BLOCKS];
+
+	for (size_t i = 0; i < full_blocks; i += AES_WIDE_BLOCKS)
 	{
-		__m128i encrypted;
-		ctx->encrypt_func(shift_reg, &encrypted, ctx->enc_round_keys);
+		size_t chunk = full_blocks - i < AES_WIDE_BLOCKS ? full_blocks - i : AES_WIDE_BLOCKS;
+		const __m128i* chunk_in = (const __m128i*)(input + i * AES_BLOCK_SIZE);
+		__m128i* chunk_out = (__m128i*)(output + i * AES_BLOCK_SIZE);
 
-		__m128i ciphertext = _mm_loadu_si128((const __m128i*)(input + i*AES_BLOCK_SIZE));
-		__m128i plaintext = _mm_xor_si128(encrypted, ciphertext);
+		// Gather the feedback blocks before any output is written: output may alias input
+		feedback[0] = shift_reg;
+		for (size_t b = 1; b < chunk; ++b)
+			feedback[b] = _mm_loadu_si128(chunk_in + b - 1);
+		shift_reg = _mm_loadu_si128(chunk_in + chunk - 1);
 
-		_mm_storeu_si128((__m128i*)(output + i*AES_BLOCK_SIZE), plaintext);
-		shift_reg = ciphertext; // CFB always uses ciphertext for next block
+		ctx->dispatch->encrypt_blocks(feedback, keystream, chunk, ctx->enc_round_keys);
+
+		// Block b of the output only overwrites ciphertext block b, read just before
+		for (size_t b = 0; b < chunk; ++b)
+			_mm_storeu_si128(chunk_out + b, _mm_xor_si128(_mm_loadu_si128(chunk_in + b), keystream[b]));
 	}
 
 	// Handle partial final block
 	if (remaining > 0)
 	{
 		__m128i encrypted;
-		uint8_t keystream[AES_BLOCK_SIZE];
-		uint8_t shift_buffer[AES_BLOCK_SIZE];
 		const uint8_t* last_in = input + full_blocks * AES_BLOCK_SIZE;
 		uint8_t* last_out = output + full_blocks * AES_BLOCK_SIZE;
 
-		// Generate keystream for final partial block
-		ctx->encrypt_func(shift_reg, &encrypted, ctx->enc_round_keys);
-		_mm_storeu_si128((__m128i*)keystream, encrypted);
-
-		// XOR ciphertext with keystream for remaining bytes
-		for (size_t i = 0; i < remaining; ++i)
-			last_out[i] = last_in[i] ^ keystream[i];
-
-		// Update shift register with ciphertext bytes (from input!)
-		_mm_storeu_si128((__m128i*)shift_buffer, shift_reg);
-		memmove(shift_buffer, shift_buffer + remaining, AES_BLOCK_SIZE - remaining);
-		memcpy(shift_buffer + AES_BLOCK_SIZE - remaining, last_in, remaining);
-		shift_reg = _mm_loadu_si128((const __m128i*)shift_buffer);
+		ctx->dispatch->encrypt_block(shift_reg, &encrypted, ctx->enc_round_keys);
+		shift_reg = aes_cfb_final_block(shift_reg, encrypted, last_in, last_out, remaining, 1);
 	}
 }
\ No newline at end of file
@@ -1,39 +1,73 @@
 #include "aes/modes/aes_ctr.h"
+#include "aes/core/aes_rounds.h"
 #include <string.h>
 
+/**
+ * @brief Processes a CTR stream from the start of the block of the given counter.
+ *
+ * @param ctx AES context.
+ * @param counter [in/out] Big-endian counter of the first block.
+ * @param input Input buffer.
+ * @param input_len Number of bytes to process.
+ * @param output Output buffer (may alias input).
+ */
+static void aes_ctr_crypt_blocks(const aes_context_t* ctx, __m128i* counter, const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	size_t full_blocks = input_len / AES_BLOCK_SIZE;
+	size_t remaining = input_len % AES_BLOCK_SIZE;
+
+	// Whole blocks: counters are generated, encrypted and XORed by the selected wide kernel
+	ctx->dispatch->ctr_blocks((const __m128i*)input, (__m128i*)output, full_blocks, counter, ctx->enc_round_keys);
+
+	// Single tail block: only the first remaining bytes are read and written
+	if (remaining > 0)
+	{
+		__m128i tail = _mm_setzero_si128();
+		size_t offset = full_blocks * AES_BLOCK_SIZE;
+
+		memcpy(&tail, input + offset, remaining);
+		ctx->dispatch->ctr_blocks(&tail, &tail, 1, counter, ctx->enc_round_keys);
+		memcpy(output + offset, &tail, remaining);
+	}
+}
+
 void aes_ctr_crypt(const aes_context_t* ctx, const uint8_t iv[16], const uint8_t* input, size_t input_len, uint8_t* output)
 {
 	if (!ctx || !iv || !input || !output)
 		return;
 
 	// Load the initialization vector (IV) into a counter
-	uint8_t counter[16];
-	memcpy(counter, iv, 16);
+	__m128i counter = _mm_loadu_si128((const __m128i*)iv);
+
+	aes_ctr_crypt_blocks(ctx, &counter, input, input_len, output);
+}
 
-	// Initialize the counter for AES CTR mode
-	uint8_t stream_block[16];
-	size_t block_offset = 0;
+void aes_ctr_crypt_at(const aes_context_t* ctx, const uint8_t iv[16], uint64_t offset, const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	if (!ctx || !iv || !input || !output)
+		return;
+
+	// Counter of the block containing the first byte: IV + offset / 16 on 128 bits
+	const __m128i bswap = aes_bswap_mask();
+	__m128i counter = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)iv), bswap);
+	counter = _mm_shuffle_epi8(aes_ctr_add(counter, offset / AES_BLOCK_SIZE), bswap);
 
-	for (size_t i = 0; i < input_len; ++i)
+	size_t skip = (size_t)(offset % AES_BLOCK_SIZE);
+
+	// Leading partial block: use its keystream from byte skip onwards
+	if (skip > 0 && input_len > 0)
 	{
-		// If we have consumed the current block, generate a new one
-		if (block_offset == 0)
-		{
-			// Encrypt the counter to produce the keystream block
-			ctx->encrypt_func(_mm_loadu_si128((const __m128i*)counter), (__m128i*)stream_block, ctx->enc_round_keys);
-
-			// Increment the counter
-			for (int j = 15; j >= 0; --j)
-			{
-				if (++counter[j] != 0)
-					break;
-			}
-		}
-
-		// XOR the input byte with the keystream byte
-		output[i] = input[i] ^ stream_block[block_offset];
-
-		// Update the block offset
-		block_offset = (block_offset + 1) % 16;
+		size_t head = AES_BLOCK_SIZE - skip < input_len ? AES_BLOCK_SIZE - skip : input_len;
+		uint8_t block[AES_BLOCK_SIZE] = {0};
+
+		memcpy(block + skip, input, head);
+		ctx->dispatch->ctr_blocks((const __m128i*)block, (__m128i*)block, 1, &counter, ctx->enc_round_keys);
+		memcpy(output, block + skip, head);
+
+		input += head;
+		output += head;
+		input_len -= head;
 	}
+
+	aes_ctr_crypt_blocks(ctx, &counter, input, input_len, output);
 }
\ No newline at end of file
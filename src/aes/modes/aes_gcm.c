@@ -0,0 +1,506 @@
+#include "aes/modes/aes_gcm.h"
+#include "aes/core/aes_clmul.h"
+#include "aes/core/aes_rounds.h"
+#include "aes/core/aes_ct.h"
+#include <string.h>
+
+/**
+ * @brief Advances a counter block by n (32-bit big-endian increment).
+ *
+ * @param counter Big-endian counter block.
+ * @param n Number of blocks to skip.
+ * @return counter with its last 32 bits incremented by n modulo 2^32.
+ */
+static inline __m128i aes_gcm_add32(__m128i counter, uint64_t n)
+{
+	const __m128i bswap = aes_bswap_mask();
+	return _mm_shuffle_epi8(_mm_add_epi32(_mm_shuffle_epi8(counter, bswap), _mm_setr_epi32((int)(uint32_t)n, 0, 0, 0)), bswap);
+}
+
+/**
+ * @brief Computes H^n from the precomputed powers (square-and-multiply on H^8).
+ *
+ * @param key Hash key table.
+ * @param n Exponent (non-zero).
+ * @return H^n, byte-reflected.
+ */
+static __m128i aes_gcm_h_power(const aes_ghash_key_t* key, uint64_t n)
+{
+	__m128i base = key->h_powers[AES_GHASH_H_POWERS - 1];
+	__m128i result = _mm_setzero_si128();
+	int has_result = 0;
+
+	// H^n = (H^8)^(n / 8) * H^(n % 8)
+	if (n % AES_GHASH_H_POWERS)
+	{
+		result = key->h_powers[n % AES_GHASH_H_POWERS - 1];
+		has_result = 1;
+	}
+
+	for (uint64_t q = n / AES_GHASH_H_POWERS; q > 0; q >>= 1)
+	{
+		if (q & 1)
+		{
+			result = has_result ? aes_clmul_gfmul(result, base) : base;
+			has_result = 1;
+		}
+
+		if (q > 1)
+			base = aes_clmul_gfmul(base, base);
+	}
+
+	return result;
+}
+
+/**
+ * @brief Stores a 64-bit value in big-endian byte order.
+ *
+ * @param dst Destination (8 bytes).
+ * @param value Value to store.
+ */
+static inline void aes_gcm_store_be64(uint8_t* dst, uint64_t value)
+{
+	for (int i = 7; i >= 0; --i, value >>= 8)
+		dst[i] = (uint8_t)value;
+}
+
+/**
+ * @brief Encrypts a single block with the context kernels.
+ *
+ * @param ctx AES context.
+ * @param block Block to encrypt.
+ * @return Encrypted block.
+ */
+static inline __m128i aes_gcm_encrypt_block(const aes_context_t* ctx, __m128i block)
+{
+	__m128i encrypted;
+	ctx->dispatch->encrypt_block(block, &encrypted, ctx->enc_round_keys);
+	return encrypted;
+}
+
+/**
+ * @brief Stitched CTR + GHASH over whole blocks, specialized for one key size and direction.
+ *
+ * Each iteration runs the AES rounds of 8 counter blocks interleaved with the
+ * carry-less multiplications of 8 ciphertext blocks, which are reduced once.
+ * When decrypting, the hashed blocks are the input blocks of the iteration;
+ * when encrypting, they are the ciphertext blocks of the previous iteration.
+ *
+ * @param num_rounds Number of AES rounds (compile-time constant at each call site).
+ * @param decrypt 0 to encrypt, 1 to decrypt (compile-time constant at each call site).
+ * @param gcm GCM state (counter and accumulator are updated).
+ * @param input Input blocks.
+ * @param num_blocks Number of blocks.
+ * @param output Output blocks (may alias input).
+ */
+static AES_FORCE_INLINE void aes_gcm_crypt_loop(int num_rounds, int decrypt, aes_gcm_context_t* gcm, const uint8_t* input, size_t num_blocks, uint8_t* output)
+{
+	const __m128i bswap = aes_bswap_mask();
+	const __m128i* in = (const __m128i*)input;
+	__m128i* out = (__m128i*)output;
+	__m128i round_keys[AES_256_NUM_ROUND_KEYS];
+	const __m128i* h_powers = gcm->ghash.key->h_powers;
+	__m128i counter = _mm_shuffle_epi8(gcm->counter, bswap);
+	__m128i acc = gcm->ghash.acc;
+	__m128i hashed[8];
+	int pending = 0;
+	size_t i = 0;
+
+	aes_load_round_keys(round_keys, gcm->ctx->enc_round_keys, num_rounds);
+
+	for (; i + 8 <= num_blocks; i += 8)
+	{
+		__m128i blocks[8];
+		__m128i lo = _mm_setzero_si128(), mid = _mm_setzero_si128(), hi = _mm_setzero_si128();
+
+		// Ciphertext is the input: hash the blocks of this iteration
+		if (decrypt)
+		{
+			for (int j = 0; j < 8; ++j)
+				hashed[j] = _mm_shuffle_epi8(_mm_loadu_si128(in + i + j), bswap);
+			hashed[0] = _mm_xor_si128(hashed[0], acc);
+			pending = 1;
+		}
+
+		for (int j = 0; j < 8; ++j)
+			blocks[j] = _mm_xor_si128(_mm_shuffle_epi8(_mm_add_epi32(counter, _mm_setr_epi32(j, 0, 0, 0)), bswap), round_keys[0]);
+		counter = _mm_add_epi32(counter, _mm_setr_epi32(8, 0, 0, 0));
+
+		// AES rounds, with one GHASH multiplication slotted into each of the first 8 rounds
+		for (int r = 1; r < num_rounds; ++r)
+		{
+			for (int j = 0; j < 8; ++j)
+				blocks[j] = _mm_aesenc_si128(blocks[j], round_keys[r]);
+
+			if (pending && r <= 8)
+				aes_clmul_acc(hashed[r - 1], h_powers[8 - r], &lo, &mid, &hi);
+		}
+
+		if (pending)
+			acc = aes_clmul_reduce(lo, mid, hi);
+
+		for (int j = 0; j < 8; ++j)
+		{
+			__m128i result = _mm_xor_si128(_mm_loadu_si128(in + i + j), _mm_aesenclast_si128(blocks[j], round_keys[num_rounds]));
+			_mm_storeu_si128(out + i + j, result);
+
+			// Ciphertext is the output: hash it during the next iteration
+			if (!decrypt)
+				hashed[j] = _mm_shuffle_epi8(result, bswap);
+		}
+
+		if (!decrypt)
+		{
+			hashed[0] = _mm_xor_si128(hashed[0], acc);
+			pending = 1;
+		}
+	}
+
+	// Hash the ciphertext of the last encrypted iteration (accumulator already folded in)
+	if (!decrypt && pending)
+		acc = aes_clmul_x8(_mm_setzero_si128(), hashed, h_powers);
+
+	for (; i < num_blocks; ++i)
+	{
+		__m128i data = _mm_loadu_si128(in + i);
+		__m128i result = _mm_xor_si128(data, aes_encrypt_x1(_mm_shuffle_epi8(counter, bswap), round_keys, num_rounds));
+		counter = _mm_add_epi32(counter, _mm_setr_epi32(1, 0, 0, 0));
+
+		_mm_storeu_si128(out + i, result);
+		acc = aes_clmul_gfmul(_mm_xor_si128(acc, _mm_shuffle_epi8(decrypt ? data : result, bswap)), h_powers[0]);
+	}
+
+	gcm->counter = _mm_shuffle_epi8(counter, bswap);
+	gcm->ghash.acc = acc;
+}
+
+/**
+ * @brief Encrypts or decrypts the next part of the text.
+ *
+ * @param gcm GCM state.
+ * @param input Input part.
+ * @param input_len Length of the part in bytes.
+ * @param output Output part (may alias input).
+ * @param decrypt 0 to encrypt, 1 to decrypt.
+ * @return 0 on success, non-zero on error.
+ */
+static int aes_gcm_update(aes_gcm_context_t* gcm, const uint8_t* input, size_t input_len, uint8_t* output, int decrypt)
+{
+	if (!gcm || !gcm->ctx || (input_len > 0 && (!input || !output)))
+		return 1;
+
+	if (input_len > AES_GCM_MAX_TEXT_SIZE - gcm->text_len)
+		return 1;
+
+	// First text call: close the AAD with its zero-padded partial block
+	if (!gcm->text_started)
+	{
+		aes_ghash_pad(&gcm->ghash);
+		gcm->text_started = 1;
+	}
+
+	gcm->text_len += input_len;
+
+	// Finish the partial block left by the previous call with its saved keystream
+	while (gcm->keystream_pos > 0 && input_len > 0)
+	{
+		uint8_t in_byte = *input++;
+		uint8_t out_byte = in_byte ^ gcm->keystream[gcm->keystream_pos];
+
+		*output++ = out_byte;
+		aes_ghash_update(&gcm->ghash, decrypt ? &in_byte : &out_byte, 1);
+		gcm->keystream_pos = (gcm->keystream_pos + 1) % AES_BLOCK_SIZE;
+		input_len--;
+	}
+
+	// Whole blocks through the stitched kernel (the GHASH buffer is empty here)
+	size_t num_blocks = input_len / AES_BLOCK_SIZE;
+	size_t remaining = input_len % AES_BLOCK_SIZE;
+
+	if (decrypt)
+		AES_KEY_SIZE_SWITCH(gcm->ctx->key_size, aes_gcm_crypt_loop, 1, gcm, input, num_blocks, output);
+	else
+		AES_KEY_SIZE_SWITCH(gcm->ctx->key_size, aes_gcm_crypt_loop, 0, gcm, input, num_blocks, output);
+
+	// Start a new partial block: keep its keystream, GHASH buffers its ciphertext bytes
+	if (remaining > 0)
+	{
+		const uint8_t* last_in = input + num_blocks * AES_BLOCK_SIZE;
+		uint8_t* last_out = output + num_blocks * AES_BLOCK_SIZE;
+		uint8_t ciphertext[AES_BLOCK_SIZE];
+
+		_mm_storeu_si128((__m128i*)gcm->keystream, aes_gcm_encrypt_block(gcm->ctx, gcm->counter));
+		gcm->counter = aes_gcm_add32(gcm->counter, 1);
+
+		for (size_t i = 0; i < remaining; ++i)
+		{
+			uint8_t in_byte = last_in[i];
+			uint8_t out_byte = in_byte ^ gcm->keystream[i];
+
+			last_out[i] = out_byte;
+			ciphertext[i] = decrypt ? in_byte : out_byte;
+		}
+
+		aes_ghash_update(&gcm->ghash, ciphertext, remaining);
+		gcm->keystream_pos = remaining;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Computes the full 16-byte tag and closes the state.
+ *
+ * @param gcm GCM state.
+ * @return Tag block.
+ */
+static __m128i aes_gcm_compute_tag(aes_gcm_context_t* gcm)
+{
+	uint8_t lengths[AES_BLOCK_SIZE];
+	uint8_t digest[AES_GHASH_SIZE];
+
+	// Length block: [len(A)]_64 || [len(C)]_64 in bits, big-endian
+	aes_gcm_store_be64(lengths, gcm->aad_len * 8);
+	aes_gcm_store_be64(lengths + 8, gcm->text_len * 8);
+
+	// Pending AAD or text partial block is padded first
+	aes_ghash_pad(&gcm->ghash);
+	aes_ghash_update(&gcm->ghash, lengths, sizeof(lengths));
+	aes_ghash_final(&gcm->ghash, digest);
+
+	gcm->keystream_pos = 0;
+	gcm->text_started = 1;
+
+	return _mm_xor_si128(_mm_loadu_si128((const __m128i*)digest), gcm->tag_mask);
+}
+
+int aes_gcm_init(aes_gcm_context_t* gcm, const aes_context_t* ctx, const aes_ghash_key_t* hkey, const uint8_t* iv, size_t iv_len)
+{
+	if (!gcm || !ctx || !hkey || !iv || iv_len == 0)
+		return 1;
+
+	memset(gcm, 0, sizeof(*gcm));
+	gcm->ctx = ctx;
+
+	// Pre-counter block J0
+	uint8_t j0[AES_BLOCK_SIZE] = {0};
+	if (iv_len == AES_GCM_IV_SIZE)
+	{
+		memcpy(j0, iv, AES_GCM_IV_SIZE);
+		j0[AES_BLOCK_SIZE - 1] = 1;
+	}
+	else
+	{
+		// J0 = GHASH(IV || 0-padding || [0]_64 || [len(IV)]_64)
+		uint8_t lengths[AES_BLOCK_SIZE] = {0};
+		aes_gcm_store_be64(lengths + 8, (uint64_t)iv_len * 8);
+
+		aes_ghash_init(&gcm->ghash, hkey);
+		aes_ghash_update(&gcm->ghash, iv, iv_len);
+		aes_ghash_pad(&gcm->ghash);
+		aes_ghash_update(&gcm->ghash, lengths, sizeof(lengths));
+		aes_ghash_final(&gcm->ghash, j0);
+	}
+
+	__m128i counter = _mm_loadu_si128((const __m128i*)j0);
+	gcm->tag_mask = aes_gcm_encrypt_block(ctx, counter);
+	gcm->counter = aes_gcm_add32(counter, 1);
+
+	return aes_ghash_init(&gcm->ghash, hkey);
+}
+
+int aes_gcm_update_aad(aes_gcm_context_t* gcm, const uint8_t* aad, size_t aad_len)
+{
+	if (!gcm || !gcm->ctx || gcm->text_started || (aad_len > 0 && !aad))
+		return 1;
+
+	gcm->aad_len += aad_len;
+
+	// More AAD may follow: GHASH keeps the trailing bytes
+	return aes_ghash_update(&gcm->ghash, aad, aad_len);
+}
+
+int aes_gcm_encrypt_update(aes_gcm_context_t* gcm, const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	return aes_gcm_update(gcm, input, input_len, output, 0);
+}
+
+int aes_gcm_decrypt_update(aes_gcm_context_t* gcm, const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	return aes_gcm_update(gcm, input, input_len, output, 1);
+}
+
+/**
+ * @brief Processes a text segment on a private copy of the state.
+ *
+ * @param gcm GCM state at a block-aligned text position.
+ * @param offset Offset of the segment in bytes (multiple of AES_BLOCK_SIZE).
+ * @param input Input segment.
+ * @param input_len Length of the segment in bytes.
+ * @param output Output segment (may alias input).
+ * @param decrypt 0 to encrypt, 1 to decrypt.
+ * @param segment Receives the partial GHASH and length.
+ * @return 0 on success, non-zero on error.
+ */
+static int aes_gcm_segment(const aes_gcm_context_t* gcm, uint64_t offset, const uint8_t* input, size_t input_len, uint8_t* output, int decrypt, aes_gcm_segment_t* segment)
+{
+	if (!gcm || !gcm->ctx || !segment || gcm->keystream_pos != 0 || offset % AES_BLOCK_SIZE != 0)
+		return 1;
+
+	if (offset > AES_GCM_MAX_TEXT_SIZE || input_len > AES_GCM_MAX_TEXT_SIZE - offset)
+		return 1;
+
+	// Start from a zero accumulator at the counter of the segment
+	aes_gcm_context_t local = *gcm;
+	local.counter = aes_gcm_add32(gcm->counter, offset / AES_BLOCK_SIZE);
+	local.text_started = 1;
+	local.text_len = 0;
+	aes_ghash_init(&local.ghash, gcm->ghash.key);
+
+	if (aes_gcm_update(&local, input, input_len, output, decrypt) != 0)
+		return 1;
+
+	aes_ghash_pad(&local.ghash);
+	segment->hash = local.ghash.acc;
+	segment->len = input_len;
+
+	return 0;
+}
+
+int aes_gcm_encrypt_segment(const aes_gcm_context_t* gcm, uint64_t offset, const uint8_t* input, size_t input_len, uint8_t* output, aes_gcm_segment_t* segment)
+{
+	return aes_gcm_segment(gcm, offset, input, input_len, output, 0, segment);
+}
+
+int aes_gcm_decrypt_segment(const aes_gcm_context_t* gcm, uint64_t offset, const uint8_t* input, size_t input_len, uint8_t* output, aes_gcm_segment_t* segment)
+{
+	return aes_gcm_segment(gcm, offset, input, input_len, output, 1, segment);
+}
+
+int aes_gcm_append_segments(aes_gcm_context_t* gcm, const aes_gcm_segment_t* segments, size_t num_segments)
+{
+	if (!gcm || !gcm->ctx || (num_segments > 0 && !segments) || gcm->keystream_pos != 0)
+		return 1;
+
+	uint64_t total_len = 0;
+	for (size_t i = 0; i < num_segments; ++i)
+	{
+		// Only the last segment may end with a partial block
+		if (i + 1 < num_segments && segments[i].len % AES_BLOCK_SIZE != 0)
+			return 1;
+
+		if (segments[i].len > AES_GCM_MAX_TEXT_SIZE - total_len)
+			return 1;
+
+		total_len += segments[i].len;
+	}
+
+	if (total_len > AES_GCM_MAX_TEXT_SIZE - gcm->text_len)
+		return 1;
+
+	// Close the AAD as the first text call would
+	if (!gcm->text_started)
+	{
+		aes_ghash_pad(&gcm->ghash);
+		gcm->text_started = 1;
+	}
+
+	for (size_t i = 0; i < num_segments; ++i)
+	{
+		uint64_t num_blocks = (segments[i].len + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+		if (num_blocks == 0)
+			continue;
+
+		// acc' = acc * H^n + hash: the hash of the segment already carries its own powers
+		gcm->ghash.acc = _mm_xor_si128(aes_clmul_gfmul(gcm->ghash.acc, aes_gcm_h_power(gcm->ghash.key, num_blocks)), segments[i].hash);
+		gcm->counter = aes_gcm_add32(gcm->counter, num_blocks);
+	}
+
+	gcm->text_len += total_len;
+
+	return 0;
+}
+
+int aes_gcm_finish(aes_gcm_context_t* gcm, uint8_t* tag, size_t tag_len)
+{
+	if (!gcm || !gcm->ctx || !tag || tag_len < AES_GCM_MIN_TAG_SIZE || tag_len > AES_GCM_TAG_SIZE)
+		return 1;
+
+	uint8_t full_tag[AES_GCM_TAG_SIZE];
+	_mm_storeu_si128((__m128i*)full_tag, aes_gcm_compute_tag(gcm));
+	memcpy(tag, full_tag, tag_len);
+
+	return 0;
+}
+
+int aes_gcm_verify(aes_gcm_context_t* gcm, const uint8_t* tag, size_t tag_len)
+{
+	if (!gcm || !gcm->ctx || !tag || tag_len < AES_GCM_MIN_TAG_SIZE || tag_len > AES_GCM_TAG_SIZE)
+		return 1;
+
+	uint8_t full_tag[AES_GCM_TAG_SIZE];
+	_mm_storeu_si128((__m128i*)full_tag, aes_gcm_compute_tag(gcm));
+
+	return aes_ct_memcmp(full_tag, tag, tag_len);
+}
+
+int aes_gcm_encrypt(const aes_context_t* ctx, const aes_ghash_key_t* hkey, const uint8_t* iv, size_t iv_len,
+	const uint8_t* aad, size_t aad_len, const uint8_t* input, size_t input_len, uint8_t* output, uint8_t* tag, size_t tag_len)
+{
+	aes_ghash_key_t local_hkey;
+	aes_gcm_context_t gcm;
+
+	int status = (!hkey && aes_ghash_key_init(&local_hkey, ctx) != 0)
+		|| aes_gcm_init(&gcm, ctx, hkey ? hkey : &local_hkey, iv, iv_len) != 0
+		|| aes_gcm_update_aad(&gcm, aad, aad_len) != 0
+		|| aes_gcm_encrypt_update(&gcm, input, input_len, output) != 0
+		|| aes_gcm_finish(&gcm, tag, tag_len) != 0;
+
+	// The powers of H are enough to forge tags; the state holds keystream and the tag mask
+	memset(&gcm, 0, sizeof(gcm));
+	if (!hkey)
+		memset(&local_hkey, 0, sizeof(local_hkey));
+	__asm__ volatile ("" : : "r"(&gcm), "r"(&local_hkey) : "memory");
+
+	return status;
+}
+
+int aes_gcm_decrypt(const aes_context_t* ctx, const aes_ghash_key_t* hkey, const uint8_t* iv, size_t iv_len,
+	const uint8_t* aad, size_t aad_len, const uint8_t* input, size_t input_len, uint8_t* output, const uint8_t* tag, size_t tag_len)
+{
+	aes_ghash_key_t local_hkey;
+	aes_gcm_context_t gcm;
+
+	int status = (!hkey && aes_ghash_key_init(&local_hkey, ctx) != 0)
+		|| aes_gcm_init(&gcm, ctx, hkey ? hkey : &local_hkey, iv, iv_len) != 0
+		|| aes_gcm_update_aad(&gcm, aad, aad_len) != 0
+		|| aes_gcm_decrypt_update(&gcm, input, input_len, output) != 0;
+
+	// Do not release unauthenticated plaintext
+	if (!status && aes_gcm_verify(&gcm, tag, tag_len) != 0)
+	{
+		if (input_len > 0)
+			memset(output, 0, input_len);
+		status = 1;
+	}
+
+	// The powers of H are enough to forge tags; the state holds keystream and the tag mask
+	memset(&gcm, 0, sizeof(gcm));
+	if (!hkey)
+		memset(&local_hkey, 0, sizeof(local_hkey));
+	__asm__ volatile ("" : : "r"(&gcm), "r"(&local_hkey) : "memory");
+
+	return status;
+}
+
+int aes_gmac(const aes_context_t* ctx, const aes_ghash_key_t* hkey, const uint8_t* iv, size_t iv_len,
+	const uint8_t* data, size_t len, uint8_t* tag, size_t tag_len)
+{
+	return aes_gcm_encrypt(ctx, hkey, iv, iv_len, data, len, NULL, 0, NULL, tag, tag_len);
+}
+
+int aes_gmac_verify(const aes_context_t* ctx, const aes_ghash_key_t* hkey, const uint8_t* iv, size_t iv_len,
+	const uint8_t* data, size_t len, const uint8_t* tag, size_t tag_len)
+{
+	return aes_gcm_decrypt(ctx, hkey, iv, iv_len, data, len, NULL, 0, NULL, tag, tag_len);
+}
\ No newline at end of file
@@ -0,0 +1,249 @@
+#include "aes/modes/aes_gcm_siv.h"
+#include "aes/mac/aes_polyval.h"
+#include "aes/core/aes_ct.h"
+#include <string.h>
+
+/// Counter blocks encrypted per multi-block call in the CTR pass (512 bytes)
+#define AES_GCM_SIV_CTR_BATCH 32
+
+/**
+ * @brief Per-nonce keys derived from the key-generating key.
+ */
+typedef struct {
+	aes_polyval_key_t auth_key; ///< POLYVAL key table of the message authentication key
+	aes_context_t enc_ctx; ///< AES context of the message encryption key
+} aes_gcm_siv_keys_t;
+
+/**
+ * @brief Derives the message authentication and encryption keys of a nonce.
+ *
+ * Blocks LE32(i) || nonce are encrypted with one multi-block call (4 blocks
+ * for AES-128, 6 for AES-256); the first 8 bytes of each form the keys.
+ *
+ * @param keys Receives the derived keys.
+ * @param ctx Context of the key-generating key.
+ * @param nonce AES_GCM_SIV_NONCE_SIZE-byte nonce.
+ * @return 0 on success (wipe the keys with aes_gcm_siv_wipe_keys() after use), non-zero on failure.
+ */
+static int aes_gcm_siv_derive_keys(aes_gcm_siv_keys_t* keys, const aes_context_t* ctx, const uint8_t* nonce)
+{
+	size_t num_blocks = ctx->key_size == AES_256 ? 6 : 4;
+	uint8_t block[AES_BLOCK_SIZE] = {0};
+	uint8_t key_material[AES_BLOCK_SIZE + AES_256_KEY_SIZE];
+	__m128i blocks[6];
+
+	memcpy(block + 4, nonce, AES_GCM_SIV_NONCE_SIZE);
+	__m128i base = _mm_loadu_si128((const __m128i*)block);
+
+	for (size_t i = 0; i < num_blocks; ++i)
+		blocks[i] = _mm_add_epi32(base, _mm_cvtsi32_si128((int)i));
+
+	ctx->dispatch->encrypt_blocks(blocks, blocks, num_blocks, ctx->enc_round_keys);
+
+	// Authentication key, then encryption key, 8 bytes per block
+	for (size_t i = 0; i < num_blocks; i += 2)
+		_mm_storeu_si128((__m128i*)(key_material + i * 8), _mm_unpacklo_epi64(blocks[i], blocks[i + 1]));
+
+	// Only the encryption direction of the message key is ever used
+	int status = aes_polyval_key_init(&keys->auth_key, key_material) != 0
+		|| aes_context_init_encrypt(&keys->enc_ctx, key_material + AES_BLOCK_SIZE, ctx->key_size) != 0;
+
+	// On failure the keys may be partly written: clear them all so callers need not wipe
+	if (status)
+		memset(keys, 0, sizeof(*keys));
+	memset(key_material, 0, sizeof(key_material));
+	memset(blocks, 0, sizeof(blocks));
+	__asm__ volatile ("" : : "r"(keys), "r"(key_material), "r"(blocks) : "memory");
+
+	return status;
+}
+
+/**
+ * @brief Erases per-nonce keys.
+ *
+ * @param keys Keys returned by aes_gcm_siv_derive_keys().
+ */
+static void aes_gcm_siv_wipe_keys(aes_gcm_siv_keys_t* keys)
+{
+	aes_context_wipe(&keys->enc_ctx);
+	memset(&keys->auth_key, 0, sizeof(keys->auth_key));
+	__asm__ volatile ("" : : "r"(keys) : "memory");
+}
+
+/**
+ * @brief CTR pass with the 32-bit little-endian counter of GCM-SIV.
+ *
+ * Counter blocks are generated AES_GCM_SIV_CTR_BATCH at a time and encrypted
+ * with the context's multi-block kernel. If polyval is set, each batch of
+ * output is hashed as soon as it is written (decryption hashes the plaintext).
+ *
+ * @param ctx Context of the message encryption key.
+ * @param counter Initial counter block.
+ * @param input Input data.
+ * @param len Length of the data in bytes.
+ * @param output Output data (may alias input).
+ * @param polyval POLYVAL state fed with the output, or NULL.
+ */
+static void aes_gcm_siv_ctr(const aes_context_t* ctx, __m128i counter, const uint8_t* input, size_t len, uint8_t* output, aes_polyval_t* polyval)
+{
+	const __m128i one = _mm_cvtsi32_si128(1);
+	__m128i keystream[AES_GCM_SIV_CTR_BATCH];
+
+	while (len > 0)
+	{
+		size_t chunk = len < sizeof(keystream) ? len : sizeof(keystream);
+		size_t num_blocks = (chunk + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+
+		// Only the first 32 bits are incremented, wrapping modulo 2^32
+		for (size_t i = 0; i < num_blocks; ++i)
+		{
+			keystream[i] = counter;
+			counter = _mm_add_epi32(counter, one);
+		}
+
+		ctx->dispatch->encrypt_blocks(keystream, keystream, num_blocks, ctx->enc_round_keys);
+
+		size_t whole = chunk / AES_BLOCK_SIZE;
+		for (size_t i = 0; i < whole; ++i)
+		{
+			__m128i block = _mm_loadu_si128((const __m128i*)input + i);
+			_mm_storeu_si128((__m128i*)output + i, _mm_xor_si128(block, keystream[i]));
+		}
+
+		const uint8_t* tail = (const uint8_t*)(keystream + whole);
+		for (size_t i = whole * AES_BLOCK_SIZE; i < chunk; ++i)
+			output[i] = input[i] ^ tail[i - whole * AES_BLOCK_SIZE];
+
+		if (polyval)
+			aes_polyval_update(polyval, output, chunk);
+
+		input += chunk;
+		output += chunk;
+		len -= chunk;
+	}
+}
+
+/**
+ * @brief Finishes POLYVAL with the length block and encrypts the result into the tag.
+ *
+ * @param keys Per-nonce keys.
+ * @param polyval POLYVAL state holding the padded AAD and plaintext.
+ * @param nonce Nonce.
+ * @param aad_len Length of the additional data in bytes.
+ * @param input_len Length of the plaintext in bytes.
+ * @return Tag.
+ */
+static __m128i aes_gcm_siv_tag(const aes_gcm_siv_keys_t* keys, aes_polyval_t* polyval, const uint8_t* nonce, uint64_t aad_len, uint64_t input_len)
+{
+	uint8_t block[AES_BLOCK_SIZE] = {0};
+	__m128i tag;
+
+	// Length block: LE64(AAD bits) || LE64(plaintext bits)
+	aes_polyval_pad(polyval);
+	_mm_storeu_si128((__m128i*)block, _mm_set_epi64x((long long)(input_len * 8), (long long)(aad_len * 8)));
+	aes_polyval_update(polyval, block, AES_BLOCK_SIZE);
+	aes_polyval_final(polyval, block);
+
+	// S_s xor nonce, with the top bit of the last byte cleared
+	for (size_t i = 0; i < AES_GCM_SIV_NONCE_SIZE; ++i)
+		block[i] ^= nonce[i];
+	block[AES_BLOCK_SIZE - 1] &= 0x7f;
+
+	keys->enc_ctx.dispatch->encrypt_block(_mm_loadu_si128((const __m128i*)block), &tag, keys->enc_ctx.enc_round_keys);
+	return tag;
+}
+
+/**
+ * @brief Checks the arguments shared by encryption and decryption.
+ *
+ * @param ctx Context of the key-generating key.
+ * @param nonce Nonce.
+ * @param aad Additional data.
+ * @param aad_len Length of the additional data in bytes.
+ * @param input Input data.
+ * @param input_len Length of the input in bytes.
+ * @param output Output buffer.
+ * @param tag Tag buffer.
+ * @return 0 if valid, non-zero otherwise.
+ */
+static int aes_gcm_siv_check(const aes_context_t* ctx, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, const uint8_t* output, const uint8_t* tag)
+{
+	if (!ctx || !nonce || !tag || (ctx->key_size != AES_128 && ctx->key_size != AES_256))
+		return 1;
+
+	if ((aad_len > 0 && !aad) || (input_len > 0 && (!input || !output)))
+		return 1;
+
+	return (uint64_t)aad_len > AES_GCM_SIV_MAX_INPUT_SIZE || (uint64_t)input_len > AES_GCM_SIV_MAX_INPUT_SIZE;
+}
+
+int aes_gcm_siv_encrypt(const aes_context_t* ctx, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, uint8_t* output, uint8_t* tag)
+{
+	aes_gcm_siv_keys_t keys;
+	aes_polyval_t polyval;
+
+	if (aes_gcm_siv_check(ctx, nonce, aad, aad_len, input, input_len, output, tag) != 0)
+		return 1;
+
+	if (aes_gcm_siv_derive_keys(&keys, ctx, nonce) != 0)
+		return 1;
+	if (aes_polyval_init(&polyval, &keys.auth_key) != 0)
+	{
+		aes_gcm_siv_wipe_keys(&keys);
+		return 1;
+	}
+
+	aes_polyval_update(&polyval, aad, aad_len);
+	aes_polyval_pad(&polyval);
+	aes_polyval_update(&polyval, input, input_len);
+
+	__m128i full_tag = aes_gcm_siv_tag(&keys, &polyval, nonce, aad_len, input_len);
+
+	// The initial counter is the tag with the top bit of the last byte set
+	aes_gcm_siv_ctr(&keys.enc_ctx, _mm_or_si128(full_tag, _mm_set_epi32((int)0x80000000, 0, 0, 0)), input, input_len, output, NULL);
+	aes_gcm_siv_wipe_keys(&keys);
+
+	_mm_storeu_si128((__m128i*)tag, full_tag);
+	return 0;
+}
+
+int aes_gcm_siv_decrypt(const aes_context_t* ctx, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, uint8_t* output, const uint8_t* tag)
+{
+	aes_gcm_siv_keys_t keys;
+	aes_polyval_t polyval;
+	uint8_t expected[AES_GCM_SIV_TAG_SIZE];
+
+	if (aes_gcm_siv_check(ctx, nonce, aad, aad_len, input, input_len, output, tag) != 0)
+		return 1;
+
+	if (aes_gcm_siv_derive_keys(&keys, ctx, nonce) != 0)
+		return 1;
+	if (aes_polyval_init(&polyval, &keys.auth_key) != 0)
+	{
+		aes_gcm_siv_wipe_keys(&keys);
+		return 1;
+	}
+
+	aes_polyval_update(&polyval, aad, aad_len);
+	aes_polyval_pad(&polyval);
+
+	// Decrypt and hash the plaintext in the same pass
+	__m128i counter = _mm_or_si128(_mm_loadu_si128((const __m128i*)tag), _mm_set_epi32((int)0x80000000, 0, 0, 0));
+	aes_gcm_siv_ctr(&keys.enc_ctx, counter, input, input_len, output, &polyval);
+
+	_mm_storeu_si128((__m128i*)expected, aes_gcm_siv_tag(&keys, &polyval, nonce, aad_len, input_len));
+	aes_gcm_siv_wipe_keys(&keys);
+
+	// Do not release unauthenticated plaintext
+	if (aes_ct_memcmp(expected, tag, AES_GCM_SIV_TAG_SIZE) != 0)
+	{
+		if (input_len > 0)
+			memset(output, 0, input_len);
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,245 @@
+#include "aes/modes/aes_hctr2.h"
+#include "aes/core/aes_clmul.h"
+#include "aes/core/aes_rounds.h"
+#include <string.h>
+
+/**
+ * @brief Loads a partial block padded with 0x01 and zeros, as hashed by HCTR2.
+ *
+ * @param data Bytes of the partial block.
+ * @param len Number of bytes (1 to AES_BLOCK_SIZE - 1).
+ * @return data || 0x01 || 0*.
+ */
+static inline __m128i aes_hctr2_load_padded(const uint8_t* data, size_t len)
+{
+	uint8_t block[AES_BLOCK_SIZE] = {0};
+
+	memcpy(block, data, len);
+	block[len] = 0x01;
+
+	return _mm_loadu_si128((const __m128i*)block);
+}
+
+/**
+ * @brief Hashes the tweak, preceded by its length block.
+ *
+ * The length block bin(2 * |T| + 2 + r), |T| in bits, also records whether the
+ * message tail ends with a partial block (r = 1). Both hashes of a message
+ * start from this state, so the tweak is hashed once per message.
+ *
+ * @param key HCTR2 key.
+ * @param tweak Tweak.
+ * @param tweak_len Length of the tweak in bytes.
+ * @param partial Non-zero if the message tail ends with a partial block.
+ * @return POLYVAL accumulator after the zero-padded tweak.
+ */
+static __m128i aes_hctr2_hash_tweak(const aes_hctr2_key_t* key, const uint8_t* tweak, size_t tweak_len, int partial)
+{
+	uint8_t block[AES_BLOCK_SIZE];
+	aes_polyval_t polyval;
+
+	uint64_t lo = ((uint64_t)tweak_len << 4) + 2 + (partial ? 1 : 0);
+	uint64_t hi = (uint64_t)tweak_len >> 60;
+	_mm_storeu_si128((__m128i*)block, _mm_set_epi64x((long long)hi, (long long)lo));
+
+	aes_polyval_init(&polyval, &key->hash_key);
+	aes_polyval_update(&polyval, block, AES_BLOCK_SIZE);
+	aes_polyval_update(&polyval, tweak, tweak_len);
+	aes_polyval_pad(&polyval);
+
+	return polyval.acc;
+}
+
+/**
+ * @brief Finishes a hash over the message tail, 8 blocks per reduction.
+ *
+ * @param key HCTR2 key.
+ * @param acc Accumulator returned by aes_hctr2_hash_tweak().
+ * @param data Message tail.
+ * @param len Length of the tail in bytes.
+ * @return H(T, data).
+ */
+static __m128i aes_hctr2_hash(const aes_hctr2_key_t* key, __m128i acc, const uint8_t* data, size_t len)
+{
+	const __m128i* blocks = (const __m128i*)data;
+	const __m128i* h_powers = key->hash_key.h_powers;
+	size_t num_blocks = len / AES_BLOCK_SIZE;
+	size_t remaining = len % AES_BLOCK_SIZE;
+	size_t i = 0;
+
+	for (; i + 8 <= num_blocks; i += 8)
+	{
+		__m128i x[8];
+
+		for (int j = 0; j < 8; ++j)
+			x[j] = _mm_loadu_si128(blocks + i + j);
+
+		acc = aes_clmul_x8(acc, x, h_powers);
+	}
+
+	for (; i < num_blocks; ++i)
+		acc = aes_clmul_gfmul(_mm_xor_si128(acc, _mm_loadu_si128(blocks + i)), h_powers[0]);
+
+	if (remaining > 0)
+		acc = aes_clmul_gfmul(_mm_xor_si128(acc, aes_hctr2_load_padded(data + len - remaining, remaining)), h_powers[0]);
+
+	return acc;
+}
+
+/**
+ * @brief XCTR pass over the message tail, hashing its output in the same pass.
+ *
+ * Keystream block i (from 1) is E_K(S xor bin(i)). Each group of 8 output
+ * blocks is absorbed with one reduction while still in registers.
+ *
+ * @param num_rounds Number of AES rounds (compile-time constant at each call site).
+ * @param key HCTR2 key.
+ * @param iv XCTR IV S.
+ * @param input Input tail.
+ * @param len Length of the tail in bytes.
+ * @param output Output tail (may alias input).
+ * @param acc Accumulator returned by aes_hctr2_hash_tweak(); receives H(T, output).
+ */
+static AES_FORCE_INLINE void aes_hctr2_xctr_loop(int num_rounds, const aes_hctr2_key_t* key, __m128i iv, const uint8_t* input, size_t len, uint8_t* output, __m128i* acc)
+{
+	const __m128i* in = (const __m128i*)input;
+	__m128i* out = (__m128i*)output;
+	const __m128i* h_powers = key->hash_key.h_powers;
+	const __m128i one = _mm_set_epi64x(0, 1);
+	__m128i round_keys[AES_256_NUM_ROUND_KEYS];
+	__m128i counter = one;
+	__m128i sum = *acc;
+	size_t num_blocks = len / AES_BLOCK_SIZE;
+	size_t remaining = len % AES_BLOCK_SIZE;
+	size_t i = 0;
+
+	aes_load_round_keys(round_keys, key->ctx->enc_round_keys, num_rounds);
+
+	for (; i + 8 <= num_blocks; i += 8)
+	{
+		__m128i blocks[8];
+
+		for (int j = 0; j < 8; ++j)
+		{
+			blocks[j] = _mm_xor_si128(iv, counter);
+			counter = _mm_add_epi64(counter, one);
+		}
+
+		aes_encrypt_x8(blocks, round_keys, num_rounds);
+
+		for (int j = 0; j < 8; ++j)
+		{
+			blocks[j] = _mm_xor_si128(blocks[j], _mm_loadu_si128(in + i + j));
+			_mm_storeu_si128(out + i + j, blocks[j]);
+		}
+
+		sum = aes_clmul_x8(sum, blocks, h_powers);
+	}
+
+	for (; i < num_blocks; ++i)
+	{
+		__m128i block = aes_encrypt_x1(_mm_xor_si128(iv, counter), round_keys, num_rounds);
+		counter = _mm_add_epi64(counter, one);
+
+		block = _mm_xor_si128(block, _mm_loadu_si128(in + i));
+		_mm_storeu_si128(out + i, block);
+		sum = aes_clmul_gfmul(_mm_xor_si128(sum, block), h_powers[0]);
+	}
+
+	if (remaining > 0)
+	{
+		uint8_t block[AES_BLOCK_SIZE] = {0};
+
+		// Work on a copy: output may alias input
+		memcpy(block, input + len - remaining, remaining);
+		__m128i keystream = aes_encrypt_x1(_mm_xor_si128(iv, counter), round_keys, num_rounds);
+		_mm_storeu_si128((__m128i*)block, _mm_xor_si128(_mm_loadu_si128((const __m128i*)block), keystream));
+		memcpy(output + len - remaining, block, remaining);
+
+		sum = aes_clmul_gfmul(_mm_xor_si128(sum, aes_hctr2_load_padded(block, remaining)), h_powers[0]);
+	}
+
+	*acc = sum;
+}
+
+/**
+ * @brief Encrypts or decrypts a message; both directions share the same structure.
+ *
+ * Encryption: MM = M xor H(T, N), UU = E_K(MM), S = MM xor UU xor L,
+ * V = N xor XCTR(S), U = UU xor H(T, V). Decryption swaps the roles of
+ * (M, N) and (U, V) and uses D_K for the first block.
+ *
+ * @param key HCTR2 key.
+ * @param tweak Tweak.
+ * @param tweak_len Length of the tweak in bytes.
+ * @param input Input message.
+ * @param len Length of the message in bytes.
+ * @param output Output message (may alias input).
+ * @param decrypt 0 to encrypt, 1 to decrypt.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+static int aes_hctr2_crypt(const aes_hctr2_key_t* key, const uint8_t* tweak, size_t tweak_len, const uint8_t* input, size_t len, uint8_t* output, int decrypt)
+{
+	if (!key || !key->ctx || (tweak_len > 0 && !tweak) || !input || !output || len < AES_HCTR2_MIN_INPUT_SIZE)
+		return 1;
+
+	if (decrypt && !key->ctx->has_dec_round_keys)
+		return 1;
+
+	const aes_context_t* ctx = key->ctx;
+	const uint8_t* tail_in = input + AES_BLOCK_SIZE;
+	uint8_t* tail_out = output + AES_BLOCK_SIZE;
+	size_t tail_len = len - AES_BLOCK_SIZE;
+
+	__m128i tweak_acc = aes_hctr2_hash_tweak(key, tweak, tweak_len, tail_len % AES_BLOCK_SIZE != 0);
+	__m128i first = _mm_loadu_si128((const __m128i*)input);
+	__m128i masked = _mm_xor_si128(first, aes_hctr2_hash(key, tweak_acc, tail_in, tail_len));
+	__m128i crypted;
+
+	if (decrypt)
+		ctx->dispatch->decrypt_block(masked, &crypted, ctx->dec_round_keys);
+	else
+		ctx->dispatch->encrypt_block(masked, &crypted, ctx->enc_round_keys);
+
+	// S = MM xor UU xor L
+	__m128i iv = _mm_xor_si128(_mm_xor_si128(masked, crypted), key->l);
+	__m128i acc = tweak_acc;
+
+	// A one-block message has no tail: the second hash is the tweak state
+	if (tail_len > 0)
+		AES_KEY_SIZE_SWITCH(ctx->key_size, aes_hctr2_xctr_loop, key, iv, tail_in, tail_len, tail_out, &acc);
+
+	_mm_storeu_si128((__m128i*)output, _mm_xor_si128(crypted, acc));
+	return 0;
+}
+
+int aes_hctr2_key_init(aes_hctr2_key_t* key, const aes_context_t* ctx)
+{
+	if (!key || !ctx)
+		return 1;
+
+	// h = E_K(bin(0)), L = E_K(bin(1))
+	__m128i blocks[2] = {_mm_setzero_si128(), _mm_set_epi64x(0, 1)};
+	uint8_t h[AES_BLOCK_SIZE];
+
+	ctx->dispatch->encrypt_blocks(blocks, blocks, 2, ctx->enc_round_keys);
+	_mm_storeu_si128((__m128i*)h, blocks[0]);
+
+	if (aes_polyval_key_init(&key->hash_key, h) != 0)
+		return 1;
+
+	key->l = blocks[1];
+	key->ctx = ctx;
+
+	return 0;
+}
+
+int aes_hctr2_encrypt(const aes_hctr2_key_t* key, const uint8_t* tweak, size_t tweak_len, const uint8_t* input, size_t len, uint8_t* output)
+{
+	return aes_hctr2_crypt(key, tweak, tweak_len, input, len, output, 0);
+}
+
+int aes_hctr2_decrypt(const aes_hctr2_key_t* key, const uint8_t* tweak, size_t tweak_len, const uint8_t* input, size_t len, uint8_t* output)
+{
+	return aes_hctr2_crypt(key, tweak, tweak_len, input, len, output, 1);
+}
\ No newline at end of file
@@ -0,0 +1,359 @@
+#include "aes/modes/aes_ocb.h"
+#include "aes/core/aes_rounds.h"
+#include "aes/core/aes_ct.h"
+#include <string.h>
+
+/**
+ * @brief Returns L_{ntz(index)}, the offset step of a (1-based) block number.
+ *
+ * @param key OCB key.
+ * @param index Block number (non-zero, below 2^AES_OCB_L_TABLE_SIZE).
+ * @return Offset step.
+ */
+static inline __m128i aes_ocb_l(const aes_ocb_key_t* key, uint64_t index)
+{
+	return key->l[__builtin_ctzll(index)];
+}
+
+/**
+ * @brief Loads a partial block padded with 10*.
+ *
+ * @param data Bytes of the partial block.
+ * @param len Number of bytes (1 to AES_BLOCK_SIZE - 1).
+ * @return data || 1 || 0*.
+ */
+static inline __m128i aes_ocb_load_padded(const uint8_t* data, size_t len)
+{
+	uint8_t block[AES_BLOCK_SIZE] = {0};
+
+	memcpy(block, data, len);
+	block[len] = 0x80;
+
+	return _mm_loadu_si128((const __m128i*)block);
+}
+
+/**
+ * @brief HASH(K, A) over the whole blocks of the additional data, 8 at a time.
+ *
+ * @param num_rounds Number of AES rounds (compile-time constant at each call site).
+ * @param key OCB key.
+ * @param aad Additional data.
+ * @param num_blocks Number of whole blocks.
+ * @param offset Offset, updated in place.
+ * @param result Receives the sum of the encrypted blocks.
+ */
+static AES_FORCE_INLINE void aes_ocb_hash_loop(int num_rounds, const aes_ocb_key_t* key, const uint8_t* aad, size_t num_blocks, __m128i* offset, __m128i* result)
+{
+	const __m128i* in = (const __m128i*)aad;
+	__m128i round_keys[AES_256_NUM_ROUND_KEYS];
+	__m128i sum = _mm_setzero_si128();
+	__m128i current = *offset;
+	size_t i = 0;
+
+	aes_load_round_keys(round_keys, key->ctx->enc_round_keys, num_rounds);
+
+	for (; i + 8 <= num_blocks; i += 8)
+	{
+		__m128i blocks[8];
+
+		for (int j = 0; j < 8; ++j)
+		{
+			current = _mm_xor_si128(current, aes_ocb_l(key, i + j + 1));
+			blocks[j] = _mm_xor_si128(_mm_loadu_si128(in + i + j), current);
+		}
+
+		aes_encrypt_x8(blocks, round_keys, num_rounds);
+
+		for (int j = 0; j < 8; ++j)
+			sum = _mm_xor_si128(sum, blocks[j]);
+	}
+
+	for (; i < num_blocks; ++i)
+	{
+		current = _mm_xor_si128(current, aes_ocb_l(key, i + 1));
+		sum = _mm_xor_si128(sum, aes_encrypt_x1(_mm_xor_si128(_mm_loadu_si128(in + i), current), round_keys, num_rounds));
+	}
+
+	*offset = current;
+	*result = sum;
+}
+
+/**
+ * @brief OCB pass over the whole blocks of the payload, 8 at a time.
+ *
+ * The plaintext checksum is accumulated in the same pass: from the input when
+ * encrypting, from the output when decrypting.
+ *
+ * @param num_rounds Number of AES rounds (compile-time constant at each call site).
+ * @param decrypt 0 to encrypt, 1 to decrypt (compile-time constant at each call site).
+ * @param key OCB key.
+ * @param input Input blocks.
+ * @param num_blocks Number of whole blocks.
+ * @param output Output blocks (may alias input).
+ * @param offset Offset, updated in place.
+ * @param checksum Plaintext checksum, updated in place.
+ */
+static AES_FORCE_INLINE void aes_ocb_loop(int num_rounds, int decrypt, const aes_ocb_key_t* key, const uint8_t* input, size_t num_blocks, uint8_t* output,
+	__m128i* offset, __m128i* checksum)
+{
+	const __m128i* in = (const __m128i*)input;
+	__m128i* out = (__m128i*)output;
+	__m128i round_keys[AES_256_NUM_ROUND_KEYS];
+	__m128i current = *offset;
+	__m128i sum = *checksum;
+	size_t i = 0;
+
+	aes_load_round_keys(round_keys, decrypt ? key->ctx->dec_round_keys : key->ctx->enc_round_keys, num_rounds);
+
+	for (; i + 8 <= num_blocks; i += 8)
+	{
+		__m128i blocks[8];
+		__m128i offsets[8];
+
+		for (int j = 0; j < 8; ++j)
+		{
+			__m128i block = _mm_loadu_si128(in + i + j);
+
+			if (!decrypt)
+				sum = _mm_xor_si128(sum, block);
+
+			current = _mm_xor_si128(current, aes_ocb_l(key, i + j + 1));
+			offsets[j] = current;
+			blocks[j] = _mm_xor_si128(block, current);
+		}
+
+		if (decrypt)
+			aes_decrypt_x8(blocks, round_keys, num_rounds);
+		else
+			aes_encrypt_x8(blocks, round_keys, num_rounds);
+
+		for (int j = 0; j < 8; ++j)
+		{
+			__m128i block = _mm_xor_si128(blocks[j], offsets[j]);
+
+			if (decrypt)
+				sum = _mm_xor_si128(sum, block);
+
+			_mm_storeu_si128(out + i + j, block);
+		}
+	}
+
+	for (; i < num_blocks; ++i)
+	{
+		__m128i block = _mm_loadu_si128(in + i);
+
+		if (!decrypt)
+			sum = _mm_xor_si128(sum, block);
+
+		current = _mm_xor_si128(current, aes_ocb_l(key, i + 1));
+		block = _mm_xor_si128(block, current);
+		block = decrypt ? aes_decrypt_x1(block, round_keys, num_rounds) : aes_encrypt_x1(block, round_keys, num_rounds);
+		block = _mm_xor_si128(block, current);
+
+		if (decrypt)
+			sum = _mm_xor_si128(sum, block);
+
+		_mm_storeu_si128(out + i, block);
+	}
+
+	*offset = current;
+	*checksum = sum;
+}
+
+/**
+ * @brief Computes HASH(K, A).
+ *
+ * @param key OCB key.
+ * @param aad Additional data.
+ * @param aad_len Length of the additional data in bytes.
+ * @return Hash value, XORed into the tag.
+ */
+static __m128i aes_ocb_hash(const aes_ocb_key_t* key, const uint8_t* aad, size_t aad_len)
+{
+	const aes_context_t* ctx = key->ctx;
+	size_t num_blocks = aad_len / AES_BLOCK_SIZE;
+	size_t remaining = aad_len % AES_BLOCK_SIZE;
+	__m128i offset = _mm_setzero_si128();
+	__m128i sum = _mm_setzero_si128();
+
+	if (num_blocks > 0)
+		AES_KEY_SIZE_SWITCH(ctx->key_size, aes_ocb_hash_loop, key, aad, num_blocks, &offset, &sum);
+
+	if (remaining > 0)
+	{
+		__m128i block;
+
+		offset = _mm_xor_si128(offset, key->l_star);
+		ctx->dispatch->encrypt_block(_mm_xor_si128(aes_ocb_load_padded(aad + num_blocks * AES_BLOCK_SIZE, remaining), offset), &block, ctx->enc_round_keys);
+		sum = _mm_xor_si128(sum, block);
+	}
+
+	return sum;
+}
+
+/**
+ * @brief Computes Offset_0 from the nonce and the tag length.
+ *
+ * @param ctx AES context.
+ * @param nonce Nonce.
+ * @param nonce_len Length of the nonce in bytes.
+ * @param tag_len Tag length in bytes.
+ * @return Initial offset.
+ */
+static __m128i aes_ocb_initial_offset(const aes_context_t* ctx, const uint8_t* nonce, size_t nonce_len, size_t tag_len)
+{
+	uint8_t block[AES_BLOCK_SIZE] = {0};
+	uint8_t stretch[AES_BLOCK_SIZE + 8 + 1];
+	uint8_t offset[AES_BLOCK_SIZE];
+	__m128i ktop;
+
+	// Nonce = num2str(TAGLEN mod 128, 7) || 0* || 1 || N
+	block[0] = (uint8_t)(((tag_len * 8) % 128) << 1);
+	block[AES_BLOCK_SIZE - 1 - nonce_len] |= 0x01;
+	memcpy(block + AES_BLOCK_SIZE - nonce_len, nonce, nonce_len);
+
+	// The 6 low bits select the window; Ktop only depends on the others
+	unsigned bottom = block[AES_BLOCK_SIZE - 1] & 0x3f;
+	block[AES_BLOCK_SIZE - 1] &= 0xc0;
+
+	ctx->dispatch->encrypt_block(_mm_loadu_si128((const __m128i*)block), &ktop, ctx->enc_round_keys);
+
+	// Stretch = Ktop || (Ktop[1..64] xor Ktop[9..72])
+	_mm_storeu_si128((__m128i*)stretch, ktop);
+	for (int i = 0; i < 8; ++i)
+		stretch[AES_BLOCK_SIZE + i] = stretch[i] ^ stretch[i + 1];
+	stretch[AES_BLOCK_SIZE + 8] = 0;
+
+	// Offset_0 = Stretch[1+bottom..128+bottom]
+	unsigned byte_shift = bottom / 8;
+	unsigned bit_shift = bottom % 8;
+	for (int i = 0; i < AES_BLOCK_SIZE; ++i)
+		offset[i] = (uint8_t)((stretch[i + byte_shift] << bit_shift) | (bit_shift ? stretch[i + byte_shift + 1] >> (8 - bit_shift) : 0));
+
+	return _mm_loadu_si128((const __m128i*)offset);
+}
+
+/**
+ * @brief Checks the arguments, encrypts or decrypts the payload and computes the full tag.
+ *
+ * @param key OCB key.
+ * @param nonce Nonce.
+ * @param nonce_len Length of the nonce in bytes.
+ * @param aad Additional data.
+ * @param aad_len Length of the additional data in bytes.
+ * @param input Input payload.
+ * @param input_len Length of the payload in bytes.
+ * @param output Output payload (may alias input).
+ * @param tag_len Tag length in bytes.
+ * @param full_tag Receives the full 16-byte tag.
+ * @param decrypt 0 to encrypt, 1 to decrypt.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+static int aes_ocb_crypt(const aes_ocb_key_t* key, const uint8_t* nonce, size_t nonce_len, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, uint8_t* output, size_t tag_len, uint8_t full_tag[AES_OCB_TAG_SIZE], int decrypt)
+{
+	if (!key || !key->ctx || !nonce || nonce_len == 0 || nonce_len > AES_OCB_MAX_NONCE_SIZE)
+		return 1;
+
+	if (decrypt && !key->ctx->has_dec_round_keys)
+		return 1;
+
+	if (tag_len < AES_OCB_MIN_TAG_SIZE || tag_len > AES_OCB_TAG_SIZE)
+		return 1;
+
+	if ((aad_len > 0 && !aad) || (input_len > 0 && (!input || !output)))
+		return 1;
+
+	// Block numbers must stay within the L table
+	if ((uint64_t)(input_len / AES_BLOCK_SIZE) >> AES_OCB_L_TABLE_SIZE != 0 || (uint64_t)(aad_len / AES_BLOCK_SIZE) >> AES_OCB_L_TABLE_SIZE != 0)
+		return 1;
+
+	const aes_context_t* ctx = key->ctx;
+	size_t num_blocks = input_len / AES_BLOCK_SIZE;
+	size_t remaining = input_len % AES_BLOCK_SIZE;
+	__m128i offset = aes_ocb_initial_offset(ctx, nonce, nonce_len, tag_len);
+	__m128i checksum = _mm_setzero_si128();
+	__m128i tag;
+
+	if (num_blocks > 0)
+	{
+		if (decrypt)
+			AES_KEY_SIZE_SWITCH(ctx->key_size, aes_ocb_loop, 1, key, input, num_blocks, output, &offset, &checksum);
+		else
+			AES_KEY_SIZE_SWITCH(ctx->key_size, aes_ocb_loop, 0, key, input, num_blocks, output, &offset, &checksum);
+	}
+
+	// Final partial block: XORed with Pad = E(Offset_*), checksummed padded with 10*
+	if (remaining > 0)
+	{
+		const uint8_t* last_in = input + num_blocks * AES_BLOCK_SIZE;
+		uint8_t* last_out = output + num_blocks * AES_BLOCK_SIZE;
+		uint8_t in_block[AES_BLOCK_SIZE] = {0};
+		uint8_t out_block[AES_BLOCK_SIZE];
+		__m128i pad;
+
+		offset = _mm_xor_si128(offset, key->l_star);
+		ctx->dispatch->encrypt_block(offset, &pad, ctx->enc_round_keys);
+
+		// Work on copies: output may alias input
+		memcpy(in_block, last_in, remaining);
+		_mm_storeu_si128((__m128i*)out_block, _mm_xor_si128(_mm_loadu_si128((const __m128i*)in_block), pad));
+		memcpy(last_out, out_block, remaining);
+
+		checksum = _mm_xor_si128(checksum, aes_ocb_load_padded(decrypt ? out_block : in_block, remaining));
+	}
+
+	// Tag = E(Checksum xor Offset xor L_$) xor HASH(K, A)
+	ctx->dispatch->encrypt_block(_mm_xor_si128(_mm_xor_si128(checksum, offset), key->l_dollar), &tag, ctx->enc_round_keys);
+	tag = _mm_xor_si128(tag, aes_ocb_hash(key, aad, aad_len));
+
+	_mm_storeu_si128((__m128i*)full_tag, tag);
+	return 0;
+}
+
+int aes_ocb_key_init(aes_ocb_key_t* key, const aes_context_t* ctx)
+{
+	if (!key || !ctx)
+		return 1;
+
+	key->ctx = ctx;
+	ctx->dispatch->encrypt_block(_mm_setzero_si128(), &key->l_star, ctx->enc_round_keys);
+	key->l_dollar = aes_gf128_double(key->l_star);
+
+	key->l[0] = aes_gf128_double(key->l_dollar);
+	for (int i = 1; i < AES_OCB_L_TABLE_SIZE; ++i)
+		key->l[i] = aes_gf128_double(key->l[i - 1]);
+
+	return 0;
+}
+
+int aes_ocb_encrypt(const aes_ocb_key_t* key, const uint8_t* nonce, size_t nonce_len, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, uint8_t* output, uint8_t* tag, size_t tag_len)
+{
+	uint8_t full_tag[AES_OCB_TAG_SIZE];
+
+	if (!tag || aes_ocb_crypt(key, nonce, nonce_len, aad, aad_len, input, input_len, output, tag_len, full_tag, 0) != 0)
+		return 1;
+
+	memcpy(tag, full_tag, tag_len);
+	return 0;
+}
+
+int aes_ocb_decrypt(const aes_ocb_key_t* key, const uint8_t* nonce, size_t nonce_len, const uint8_t* aad, size_t aad_len,
+	const uint8_t* input, size_t input_len, uint8_t* output, const uint8_t* tag, size_t tag_len)
+{
+	uint8_t full_tag[AES_OCB_TAG_SIZE];
+
+	if (!tag || aes_ocb_crypt(key, nonce, nonce_len, aad, aad_len, input, input_len, output, tag_len, full_tag, 1) != 0)
+		return 1;
+
+	// Do not release unauthenticated plaintext
+	if (aes_ct_memcmp(full_tag, tag, tag_len) != 0)
+	{
+		if (input_len > 0)
+			memset(output, 0, input_len);
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -1,31 +1,61 @@
 #include "aes/modes/aes_ofb.h"
+#include "aes/core/aes_rounds.h"
 #include <string.h>
 
-void aes_ofb_crypt(const aes_context_t* ctx, const uint8_t iv[16], const uint8_t* input, size_t input_len, uint8_t* output)
+/**
+ * @brief OFB loop specialized for one key size.
+ *
+ * The keystream is a chain of encryptions of the feedback register, so the
+ * blocks run one after the other with the round keys held in registers.
+ *
+ * @param num_rounds Number of AES rounds (compile-time constant at each call site).
+ * @param enc_round_keys Encryption round keys.
+ * @param feedback IV.
+ * @param input Input buffer.
+ * @param input_len Length of the input in bytes.
+ * @param output Output buffer (may alias input).
+ */
+static AES_FORCE_INLINE void aes_ofb_crypt_loop(int num_rounds, const __m128i* enc_round_keys, __m128i feedback, const uint8_t* input, size_t input_len, uint8_t* output)
 {
-	if (!ctx || !iv || !input || !output)
-		return;
+	__m128i round_keys[AES_256_NUM_ROUND_KEYS];
+	aes_load_round_keys(round_keys, enc_round_keys, num_rounds);
 
-	// Load the initialization vector (IV) into a feedback register
-	__m128i feedback = _mm_loadu_si128((const __m128i*)iv);
+	size_t full_blocks = input_len / AES_BLOCK_SIZE;
+	size_t remaining = input_len % AES_BLOCK_SIZE;
 
-	for (size_t offset = 0; offset < input_len; offset += AES_BLOCK_SIZE)
+	for (size_t i = 0; i < full_blocks; ++i)
 	{
 		// Encrypt the feedback register to produce the keystream block
-		__m128i keystream;
-		ctx->encrypt_func(feedback, &keystream, ctx->enc_round_keys);
-		_mm_storeu_si128(&feedback, keystream);
+		feedback = aes_encrypt_x1(feedback, round_keys, num_rounds);
 
-		// XOR the keystream with the plaintext to produce the ciphertext
-		uint8_t keystream_bytes[16];
-		_mm_storeu_si128((__m128i*)keystream_bytes, keystream);
+		// XOR the keystream with the whole input block
+		__m128i block = _mm_loadu_si128((const __m128i*)(input + i * AES_BLOCK_SIZE));
+		_mm_storeu_si128((__m128i*)(output + i * AES_BLOCK_SIZE), _mm_xor_si128(block, feedback));
+	}
+
+	// Handle the case where input_len is not a multiple of AES_BLOCK_SIZE
+	if (remaining > 0)
+	{
+		uint8_t keystream_bytes[AES_BLOCK_SIZE];
+		const uint8_t* last_in = input + full_blocks * AES_BLOCK_SIZE;
+		uint8_t* last_out = output + full_blocks * AES_BLOCK_SIZE;
 
-		// Handle the case where input_len is not a multiple of AES_BLOCK_SIZE
-		size_t remaining = input_len - offset;
-		size_t chunk = remaining >= AES_BLOCK_SIZE ? AES_BLOCK_SIZE : remaining;
+		feedback = aes_encrypt_x1(feedback, round_keys, num_rounds);
+		_mm_storeu_si128((__m128i*)keystream_bytes, feedback);
 
-		// XOR the keystream with the plaintext block
-		for (size_t i = 0; i < chunk; ++i)
-			output[offset + i] = input[offset + i] ^ keystream_bytes[i];
+		for (size_t i = 0; i < remaining; ++i)
+			last_out[i] = last_in[i] ^ keystream_bytes[i];
 	}
+}
+
+void aes_ofb_crypt(const aes_context_t* ctx, const uint8_t iv[16], const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	if (!ctx || !iv || !input || !output)
+		return;
+
+	// Load the initialization vector (IV) into a feedback register
+	__m128i feedback = _mm_loadu_si128((const __m128i*)iv);
+
+	// Select the key-size specialized loop once for the whole message
+	AES_KEY_SIZE_SWITCH(ctx->key_size, aes_ofb_crypt_loop, ctx->enc_round_keys, feedback, input, input_len, output);
 }
\ No newline at end of file
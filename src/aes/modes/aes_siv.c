@@ -0,0 +1,262 @@
+#include "aes/modes/aes_siv.h"
+#include "aes/modes/aes_ctr.h"
+#include "aes/core/aes_rounds.h"
+#include "aes/core/aes_ct.h"
+#include <string.h>
+
+/**
+ * @brief Builds the last S2V input T from the plaintext, for short plaintexts.
+ *
+ * @param d S2V value after the associated data.
+ * @param input Plaintext.
+ * @param len Length of the plaintext in bytes (below AES_BLOCK_SIZE).
+ * @return T = dbl(D) xor pad(plaintext).
+ */
+static inline __m128i aes_siv_short_input(__m128i d, const uint8_t* input, size_t len)
+{
+	uint8_t block[AES_BLOCK_SIZE] = {0};
+
+	if (len > 0)
+		memcpy(block, input, len);
+	block[len] = 0x80;
+
+	return _mm_xor_si128(aes_gf128_double(d), _mm_loadu_si128((const __m128i*)block));
+}
+
+/**
+ * @brief Last S2V step: CMAC of the plaintext combined with D.
+ *
+ * Plaintexts of at least one block are streamed, with D XORed into their last
+ * 16 bytes ("xorend"); shorter ones are doubled-and-padded into one block.
+ *
+ * @param key SIV key.
+ * @param d S2V value after the associated data.
+ * @param input Plaintext.
+ * @param len Length of the plaintext in bytes.
+ * @return Synthetic IV.
+ */
+static __m128i aes_siv_s2v_final(const aes_siv_key_t* key, __m128i d, const uint8_t* input, size_t len)
+{
+	uint8_t block[AES_BLOCK_SIZE];
+	aes_cmac_t cmac;
+
+	aes_cmac_init(&cmac, &key->mac_key);
+
+	if (len >= AES_BLOCK_SIZE)
+	{
+		aes_cmac_update(&cmac, input, len - AES_BLOCK_SIZE);
+		_mm_storeu_si128((__m128i*)block, _mm_xor_si128(_mm_loadu_si128((const __m128i*)(input + len - AES_BLOCK_SIZE)), d));
+	}
+	else
+		_mm_storeu_si128((__m128i*)block, aes_siv_short_input(d, input, len));
+
+	aes_cmac_update(&cmac, block, AES_BLOCK_SIZE);
+	aes_cmac_final(&cmac, block);
+
+	return _mm_loadu_si128((const __m128i*)block);
+}
+
+/**
+ * @brief S2V over the associated data components and the plaintext.
+ *
+ * @param key SIV key.
+ * @param aad Associated data components.
+ * @param aad_lens Component lengths in bytes.
+ * @param num_aad Number of components.
+ * @param input Plaintext.
+ * @param len Length of the plaintext in bytes.
+ * @return Synthetic IV.
+ */
+static __m128i aes_siv_s2v(const aes_siv_key_t* key, const uint8_t* const* aad, const size_t* aad_lens, size_t num_aad, const uint8_t* input, size_t len)
+{
+	__m128i d = key->zero_mac;
+	uint8_t mac[AES_CMAC_SIZE];
+
+	for (size_t i = 0; i < num_aad; ++i)
+	{
+		aes_cmac(&key->mac_key, aad[i], aad_lens[i], mac);
+		d = _mm_xor_si128(aes_gf128_double(d), _mm_loadu_si128((const __m128i*)mac));
+	}
+
+	return aes_siv_s2v_final(key, d, input, len);
+}
+
+/**
+ * @brief CTR pass under the synthetic IV, with bits 63 and 31 cleared.
+ *
+ * @param key SIV key.
+ * @param siv Synthetic IV.
+ * @param input Input data.
+ * @param len Length of the data in bytes.
+ * @param output Output data (may alias input).
+ */
+static void aes_siv_ctr(const aes_siv_key_t* key, __m128i siv, const uint8_t* input, size_t len, uint8_t* output)
+{
+	uint8_t counter[AES_BLOCK_SIZE];
+
+	if (len == 0)
+		return;
+
+	_mm_storeu_si128((__m128i*)counter, siv);
+	counter[8] &= 0x7f;
+	counter[12] &= 0x7f;
+
+	aes_ctr_crypt(key->ctr_ctx, counter, input, len, output);
+}
+
+/**
+ * @brief Checks the associated data vector and the payload buffers.
+ *
+ * @param aad Associated data components.
+ * @param aad_lens Component lengths in bytes.
+ * @param num_aad Number of components.
+ * @param input Input data.
+ * @param input_len Length of the input in bytes.
+ * @param output Output buffer.
+ * @return 0 if valid, non-zero otherwise.
+ */
+static int aes_siv_check(const uint8_t* const* aad, const size_t* aad_lens, size_t num_aad, const uint8_t* input, size_t input_len, const uint8_t* output)
+{
+	if (num_aad > AES_SIV_MAX_COMPONENTS || (num_aad > 0 && (!aad || !aad_lens)))
+		return 1;
+
+	for (size_t i = 0; i < num_aad; ++i)
+		if (aad_lens[i] > 0 && !aad[i])
+			return 1;
+
+	return input_len > 0 && (!input || !output);
+}
+
+int aes_siv_key_init(aes_siv_key_t* key, const aes_context_t* mac_ctx, const aes_context_t* ctr_ctx)
+{
+	if (!key || !mac_ctx || !ctr_ctx || mac_ctx->key_size != ctr_ctx->key_size)
+		return 1;
+
+	const uint8_t zero[AES_BLOCK_SIZE] = {0};
+	uint8_t mac[AES_CMAC_SIZE];
+
+	if (aes_cmac_key_init(&key->mac_key, mac_ctx) != 0 || aes_cmac(&key->mac_key, zero, AES_BLOCK_SIZE, mac) != 0)
+		return 1;
+
+	key->zero_mac = _mm_loadu_si128((const __m128i*)mac);
+	key->ctr_ctx = ctr_ctx;
+
+	return 0;
+}
+
+int aes_siv_encrypt(const aes_siv_key_t* key, const uint8_t* const* aad, const size_t* aad_lens, size_t num_aad,
+	const uint8_t* input, size_t input_len, uint8_t* output, uint8_t* siv)
+{
+	if (!key || !key->ctr_ctx || !siv || aes_siv_check(aad, aad_lens, num_aad, input, input_len, output) != 0)
+		return 1;
+
+	__m128i v = aes_siv_s2v(key, aad, aad_lens, num_aad, input, input_len);
+	aes_siv_ctr(key, v, input, input_len, output);
+
+	_mm_storeu_si128((__m128i*)siv, v);
+	return 0;
+}
+
+int aes_siv_decrypt(const aes_siv_key_t* key, const uint8_t* const* aad, const size_t* aad_lens, size_t num_aad,
+	const uint8_t* input, size_t input_len, uint8_t* output, const uint8_t* siv)
+{
+	if (!key || !key->ctr_ctx || !siv || aes_siv_check(aad, aad_lens, num_aad, input, input_len, output) != 0)
+		return 1;
+
+	uint8_t expected[AES_SIV_IV_SIZE];
+
+	aes_siv_ctr(key, _mm_loadu_si128((const __m128i*)siv), input, input_len, output);
+	_mm_storeu_si128((__m128i*)expected, aes_siv_s2v(key, aad, aad_lens, num_aad, output, input_len));
+
+	// Do not release unauthenticated plaintext
+	if (aes_ct_memcmp(expected, siv, AES_SIV_IV_SIZE) != 0)
+	{
+		if (input_len > 0)
+			memset(output, 0, input_len);
+		return 1;
+	}
+
+	return 0;
+}
+
+int aes_siv_encrypt_batch(const aes_siv_key_t* key, const aes_siv_record_t* records, size_t count)
+{
+	if (!key || !key->ctr_ctx || (count > 0 && !records))
+		return 1;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const aes_siv_record_t* record = &records[i];
+
+		if (!record->siv || aes_siv_check(&record->aad, &record->aad_len, 1, record->input, record->input_len, record->output) != 0)
+			return 1;
+	}
+
+	const __m128i first = aes_gf128_double(key->zero_mac);
+	uint8_t scratch[AES_CMAC_BATCH_LANES][AES_SIV_BATCH_INLINE_SIZE];
+	uint8_t macs[AES_CMAC_BATCH_LANES][AES_CMAC_SIZE];
+	const uint8_t* messages[AES_CMAC_BATCH_LANES];
+	size_t lengths[AES_CMAC_BATCH_LANES];
+	size_t lanes[AES_CMAC_BATCH_LANES];
+	__m128i d[AES_CMAC_BATCH_LANES];
+	__m128i v[AES_CMAC_BATCH_LANES];
+
+	for (size_t i = 0; i < count; i += AES_CMAC_BATCH_LANES)
+	{
+		const aes_siv_record_t* group = records + i;
+		size_t group_size = count - i < AES_CMAC_BATCH_LANES ? count - i : AES_CMAC_BATCH_LANES;
+		size_t num_inline = 0;
+
+		// CMAC of each record's associated data
+		for (size_t j = 0; j < group_size; ++j)
+		{
+			messages[j] = group[j].aad;
+			lengths[j] = group[j].aad_len;
+		}
+
+		aes_cmac_batch(&key->mac_key, messages, lengths, group_size, macs);
+
+		// Final S2V inputs: short records are rewritten into scratch and MACed together
+		for (size_t j = 0; j < group_size; ++j)
+		{
+			const uint8_t* input = group[j].input;
+			size_t len = group[j].input_len;
+
+			d[j] = _mm_xor_si128(first, _mm_loadu_si128((const __m128i*)macs[j]));
+
+			if (len > AES_SIV_BATCH_INLINE_SIZE)
+			{
+				v[j] = aes_siv_s2v_final(key, d[j], input, len);
+				continue;
+			}
+
+			if (len >= AES_BLOCK_SIZE)
+			{
+				memcpy(scratch[num_inline], input, len);
+				__m128i* end = (__m128i*)(scratch[num_inline] + len - AES_BLOCK_SIZE);
+				_mm_storeu_si128(end, _mm_xor_si128(_mm_loadu_si128(end), d[j]));
+			}
+			else
+			{
+				_mm_storeu_si128((__m128i*)scratch[num_inline], aes_siv_short_input(d[j], input, len));
+				len = AES_BLOCK_SIZE;
+			}
+
+			messages[num_inline] = scratch[num_inline];
+			lengths[num_inline] = len;
+			lanes[num_inline++] = j;
+		}
+
+		aes_cmac_batch(&key->mac_key, messages, lengths, num_inline, macs);
+		for (size_t k = 0; k < num_inline; ++k)
+			v[lanes[k]] = _mm_loadu_si128((const __m128i*)macs[k]);
+
+		for (size_t j = 0; j < group_size; ++j)
+		{
+			aes_siv_ctr(key, v[j], group[j].input, group[j].input_len, group[j].output);
+			_mm_storeu_si128((__m128i*)group[j].siv, v[j]);
+		}
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include "aes/modes/aes_xts.h"
+#include "aes/core/aes_rounds.h"
+#include <string.h>
+
+/**
+ * @brief Multiplies a tweak by alpha in GF(2^128) (shift left by one bit, little-endian).
+ *
+ * Each 32-bit lane is shifted on its own; the bits shifted out are moved to the
+ * next lane, and the bit shifted out of the block is reduced as 0x87.
+ *
+ * @param tweak Tweak (128-bit little-endian).
+ * @return tweak * alpha.
+ */
+static inline __m128i aes_xts_double(__m128i tweak)
+{
+	__m128i carries = _mm_shuffle_epi32(_mm_srai_epi32(tweak, 31), 0x93);
+	return _mm_xor_si128(_mm_slli_epi32(tweak, 1), _mm_and_si128(carries, _mm_set_epi32(1, 1, 1, 0x87)));
+}
+
+/**
+ * @brief Multiplies a tweak by alpha^8 in GF(2^128).
+ *
+ * Shifts the block left by one byte and folds the byte shifted out back in with
+ * one carry-less multiplication by 0x87. Used to advance 8 independent tweaks
+ * by 8 blocks at once.
+ *
+ * @param tweak Tweak (128-bit little-endian).
+ * @return tweak * alpha^8.
+ */
+static inline __m128i aes_xts_mul_alpha8(__m128i tweak)
+{
+	__m128i overflow = _mm_clmulepi64_si128(_mm_srli_si128(tweak, 15), _mm_cvtsi32_si128(0x87), 0x00);
+	return _mm_xor_si128(_mm_slli_si128(tweak, 1), overflow);
+}
+
+/**
+ * @brief Encrypts or decrypts one block masked with its tweak.
+ *
+ * @param num_rounds Number of AES rounds.
+ * @param decrypt 0 to encrypt, 1 to decrypt.
+ * @param block Input block.
+ * @param tweak Tweak of the block.
+ * @param round_keys Round keys of the direction.
+ * @return Output block.
+ */
+static AES_FORCE_INLINE __m128i aes_xts_block(int num_rounds, int decrypt, __m128i block, __m128i tweak, const __m128i* round_keys)
+{
+	block = _mm_xor_si128(block, tweak);
+	block = decrypt ? aes_decrypt_x1(block, round_keys, num_rounds) : aes_encrypt_x1(block, round_keys, num_rounds);
+	return _mm_xor_si128(block, tweak);
+}
+
+/**
+ * @brief XTS loop over one data unit, specialized for one key size and direction.
+ *
+ * Whole blocks are processed 8 at a time with 8 tweaks advanced together by
+ * alpha^8. A final partial block is handled with ciphertext stealing: the last
+ * whole block and the partial one swap their tails, and decryption uses their
+ * tweaks in reverse order.
+ *
+ * @param num_rounds Number of AES rounds (compile-time constant at each call site).
+ * @param decrypt 0 to encrypt, 1 to decrypt (compile-time constant at each call site).
+ * @param data_round_keys Encryption or decryption round keys of the data key.
+ * @param tweak Encrypted tweak of the data unit (tweak of block 0).
+ * @param input Input data unit.
+ * @param input_len Length of the data unit in bytes (at least AES_BLOCK_SIZE).
+ * @param output Output data unit (may alias input).
+ */
+static AES_FORCE_INLINE void aes_xts_loop(int num_rounds, int decrypt, const __m128i* data_round_keys, __m128i tweak, const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	const __m128i* in = (const __m128i*)input;
+	__m128i* out = (__m128i*)output;
+	__m128i round_keys[AES_256_NUM_ROUND_KEYS];
+	__m128i tweaks[8];
+
+	aes_load_round_keys(round_keys, data_round_keys, num_rounds);
+
+	size_t remaining = input_len % AES_BLOCK_SIZE;
+	size_t num_blocks = input_len / AES_BLOCK_SIZE - (remaining ? 1 : 0);
+	size_t i = 0;
+
+	tweaks[0] = tweak;
+	for (int j = 1; j < 8; ++j)
+		tweaks[j] = aes_xts_double(tweaks[j - 1]);
+
+	for (; i + 8 <= num_blocks; i += 8)
+	{
+		__m128i blocks[8];
+
+		for (int j = 0; j < 8; ++j)
+			blocks[j] = _mm_xor_si128(_mm_loadu_si128(in + i + j), tweaks[j]);
+
+		if (decrypt)
+			aes_decrypt_x8(blocks, round_keys, num_rounds);
+		else
+			aes_encrypt_x8(blocks, round_keys, num_rounds);
+
+		for (int j = 0; j < 8; ++j)
+		{
+			_mm_storeu_si128(out + i + j, _mm_xor_si128(blocks[j], tweaks[j]));
+			tweaks[j] = aes_xts_mul_alpha8(tweaks[j]);
+		}
+	}
+
+	tweak = tweaks[0];
+	for (; i < num_blocks; ++i)
+	{
+		_mm_storeu_si128(out + i, aes_xts_block(num_rounds, decrypt, _mm_loadu_si128(in + i), tweak, round_keys));
+		tweak = aes_xts_double(tweak);
+	}
+
+	// Ciphertext stealing over the last whole block and the partial one
+	if (remaining > 0)
+	{
+		const uint8_t* last_in = input + num_blocks * AES_BLOCK_SIZE;
+		uint8_t* last_out = output + num_blocks * AES_BLOCK_SIZE;
+		__m128i next_tweak = aes_xts_double(tweak);
+		uint8_t block[AES_BLOCK_SIZE];
+		uint8_t stolen[AES_BLOCK_SIZE];
+
+		_mm_storeu_si128((__m128i*)block, aes_xts_block(num_rounds, decrypt, _mm_loadu_si128((const __m128i*)last_in), decrypt ? next_tweak : tweak, round_keys));
+
+		// Read the partial block before writing over it (output may alias input)
+		memcpy(stolen, last_in + AES_BLOCK_SIZE, remaining);
+		memcpy(stolen + remaining, block + remaining, AES_BLOCK_SIZE - remaining);
+		memcpy(last_out + AES_BLOCK_SIZE, block, remaining);
+
+		_mm_storeu_si128((__m128i*)last_out, aes_xts_block(num_rounds, decrypt, _mm_loadu_si128((const __m128i*)stolen), decrypt ? tweak : next_tweak, round_keys));
+	}
+}
+
+/**
+ * @brief Checks a pair of XTS contexts.
+ *
+ * @param data_ctx AES context of the data key.
+ * @param tweak_ctx AES context of the tweak key.
+ * @return 0 if both are set, of the same key size, and hold different keys.
+ */
+static int aes_xts_check_keys(const aes_context_t* data_ctx, const aes_context_t* tweak_ctx)
+{
+	if (!data_ctx || !tweak_ctx || data_ctx->key_size != tweak_ctx->key_size)
+		return 1;
+
+	// The first two round keys contain the whole key for every key size
+	return memcmp(data_ctx->enc_round_keys, tweak_ctx->enc_round_keys, 2 * sizeof(__m128i)) == 0;
+}
+
+/**
+ * @brief Processes one data unit with an already encrypted tweak.
+ *
+ * @param data_ctx AES context of the data key.
+ * @param tweak Encrypted tweak.
+ * @param input Input data unit.
+ * @param input_len Length of the data unit in bytes.
+ * @param output Output data unit (may alias input).
+ * @param decrypt 0 to encrypt, 1 to decrypt.
+ */
+static void aes_xts_crypt_unit(const aes_context_t* data_ctx, __m128i tweak, const uint8_t* input, size_t input_len, uint8_t* output, int decrypt)
+{
+	if (decrypt)
+		AES_KEY_SIZE_SWITCH(data_ctx->key_size, aes_xts_loop, 1, data_ctx->dec_round_keys, tweak, input, input_len, output);
+	else
+		AES_KEY_SIZE_SWITCH(data_ctx->key_size, aes_xts_loop, 0, data_ctx->enc_round_keys, tweak, input, input_len, output);
+}
+
+/**
+ * @brief Encrypts the tweak and processes one data unit.
+ *
+ * @param data_ctx AES context of the data key.
+ * @param tweak_ctx AES context of the tweak key.
+ * @param tweak Tweak of the data unit.
+ * @param input Input data unit.
+ * @param input_len Length of the data unit in bytes.
+ * @param output Output data unit (may alias input).
+ * @param decrypt 0 to encrypt, 1 to decrypt.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+static int aes_xts_crypt(const aes_context_t* data_ctx, const aes_context_t* tweak_ctx, const uint8_t tweak[16], const uint8_t* input, size_t input_len, uint8_t* output, int decrypt)
+{
+	if (aes_xts_check_keys(data_ctx, tweak_ctx) != 0 || !tweak || !input || !output)
+		return 1;
+
+	if (decrypt && !data_ctx->has_dec_round_keys)
+		return 1;
+
+	if (input_len < AES_BLOCK_SIZE || input_len > AES_XTS_MAX_DATA_UNIT_SIZE)
+		return 1;
+
+	__m128i encrypted_tweak;
+	tweak_ctx->dispatch->encrypt_block(_mm_loadu_si128((const __m128i*)tweak), &encrypted_tweak, tweak_ctx->enc_round_keys);
+
+	aes_xts_crypt_unit(data_ctx, encrypted_tweak, input, input_len, output, decrypt);
+	return 0;
+}
+
+/**
+ * @brief Processes consecutive sectors, encrypting their tweaks 8 at a time.
+ *
+ * @param data_ctx AES context of the data key.
+ * @param tweak_ctx AES context of the tweak key.
+ * @param first_sector Number of the first sector.
+ * @param sector_size Data unit size in bytes.
+ * @param input Input sectors.
+ * @param input_len Length of the input in bytes.
+ * @param output Output sectors (may alias input).
+ * @param decrypt 0 to encrypt, 1 to decrypt.
+ * @return 0 on success, non-zero on invalid argument.
+ */
+static int aes_xts_crypt_sectors(const aes_context_t* data_ctx, const aes_context_t* tweak_ctx, uint64_t first_sector, size_t sector_size,
+	const uint8_t* input, size_t input_len, uint8_t* output, int decrypt)
+{
+	if (aes_xts_check_keys(data_ctx, tweak_ctx) != 0 || (input_len > 0 && (!input || !output)))
+		return 1;
+
+	if (decrypt && !data_ctx->has_dec_round_keys)
+		return 1;
+
+	if (sector_size < AES_BLOCK_SIZE || sector_size > AES_XTS_MAX_DATA_UNIT_SIZE || input_len % sector_size != 0)
+		return 1;
+
+	size_t num_sectors = input_len / sector_size;
+	const __m128i first = _mm_set_epi64x(0, (long long)first_sector);
+	__m128i tweaks[AES_PARALLEL_BLOCKS];
+
+	for (size_t s = 0; s < num_sectors; s += AES_PARALLEL_BLOCKS)
+	{
+		size_t count = num_sectors - s < AES_PARALLEL_BLOCKS ? num_sectors - s : AES_PARALLEL_BLOCKS;
+
+		// Tweak = sector number as a 128-bit little-endian integer
+		for (size_t j = 0; j < count; ++j)
+			tweaks[j] = aes_ctr_add(first, s + j);
+
+		tweak_ctx->dispatch->encrypt_blocks(tweaks, tweaks, count, tweak_ctx->enc_round_keys);
+
+		for (size_t j = 0; j < count; ++j)
+		{
+			size_t offset = (s + j) * sector_size;
+			aes_xts_crypt_unit(data_ctx, tweaks[j], input + offset, sector_size, output + offset, decrypt);
+		}
+	}
+
+	return 0;
+}
+
+int aes_xts_encrypt(const aes_context_t* data_ctx, const aes_context_t* tweak_ctx, const uint8_t tweak[16], const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	return aes_xts_crypt(data_ctx, tweak_ctx, tweak, input, input_len, output, 0);
+}
+
+int aes_xts_decrypt(const aes_context_t* data_ctx, const aes_context_t* tweak_ctx, const uint8_t tweak[16], const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	return aes_xts_crypt(data_ctx, tweak_ctx, tweak, input, input_len, output, 1);
+}
+
+int aes_xts_encrypt_sectors(const aes_context_t* data_ctx, const aes_context_t* tweak_ctx, uint64_t first_sector, size_t sector_size,
+	const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	return aes_xts_crypt_sectors(data_ctx, tweak_ctx, first_sector, sector_size, input, input_len, output, 0);
+}
+
+int aes_xts_decrypt_sectors(const aes_context_t* data_ctx, const aes_context_t* tweak_ctx, uint64_t first_sector, size_t sector_size,
+	const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	return aes_xts_crypt_sectors(data_ctx, tweak_ctx, first_sector, sector_size, input, input_len, output, 1);
+}
\ No newline at end of file
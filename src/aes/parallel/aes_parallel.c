@@ -0,0 +1,216 @@
+#include "aes/parallel/aes_parallel.h"
+#include "aes/modes/aes_ecb.h"
+#include "aes/modes/aes_ctr.h"
+#include "aes/modes/aes_cfb.h"
+#include "aes/modes/aes_gcm.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Supported parallel operations.
+ */
+typedef enum {
+	AES_PARALLEL_ECB_ENCRYPT,
+	AES_PARALLEL_ECB_DECRYPT,
+	AES_PARALLEL_CTR,
+	AES_PARALLEL_CFB_DECRYPT,
+	AES_PARALLEL_GCM_ENCRYPT,
+	AES_PARALLEL_GCM_DECRYPT
+} aes_parallel_op_t;
+
+/**
+ * @brief Shared description of a parallel operation, read by every task.
+ */
+typedef struct {
+	aes_parallel_op_t op; ///< Operation to run on each chunk
+	const aes_context_t* ctx; ///< AES context
+	const uint8_t* iv; ///< CTR or CFB initialization vector
+	const uint8_t* chunk_ivs; ///< CFB: last ciphertext block preceding each chunk (chunk 0 uses iv)
+	const uint8_t* input; ///< Whole input buffer
+	size_t input_len; ///< Whole input length
+	uint8_t* output; ///< Whole output buffer
+	const aes_gcm_context_t* gcm; ///< GCM: state after the AAD, shared read-only by the tasks
+	aes_gcm_segment_t* segments; ///< GCM: partial hash of each chunk
+} aes_parallel_job_t;
+
+/**
+ * @brief Processes one chunk of a parallel operation.
+ *
+ * @param arg Parallel job (aes_parallel_job_t).
+ * @param task_index Index of the chunk.
+ */
+static void aes_parallel_task(void* arg, size_t task_index)
+{
+	const aes_parallel_job_t* job = (const aes_parallel_job_t*)arg;
+	size_t offset = task_index * AES_PARALLEL_CHUNK_SIZE;
+	size_t len = job->input_len - offset < AES_PARALLEL_CHUNK_SIZE ? job->input_len - offset : AES_PARALLEL_CHUNK_SIZE;
+
+	switch (job->op)
+	{
+		case AES_PARALLEL_ECB_ENCRYPT:
+			aes_ecb_encrypt(job->ctx, job->input + offset, len, job->output + offset);
+			break;
+		case AES_PARALLEL_ECB_DECRYPT:
+			aes_ecb_decrypt(job->ctx, job->input + offset, len, job->output + offset);
+			break;
+		case AES_PARALLEL_CTR:
+			// Chunks are block aligned: the chunk starts at counter IV + offset / 16
+			aes_ctr_crypt_at(job->ctx, job->iv, offset, job->input + offset, len, job->output + offset);
+			break;
+		case AES_PARALLEL_CFB_DECRYPT:
+			// The feedback of a chunk is the ciphertext block preceding it, saved before any output is written
+			aes_cfb_decrypt(job->ctx, task_index ? job->chunk_ivs + task_index * AES_BLOCK_SIZE : job->iv, job->input + offset, len, job->output + offset);
+			break;
+		case AES_PARALLEL_GCM_ENCRYPT:
+			aes_gcm_encrypt_segment(job->gcm, offset, job->input + offset, len, job->output + offset, &job->segments[task_index]);
+			break;
+		case AES_PARALLEL_GCM_DECRYPT:
+			aes_gcm_decrypt_segment(job->gcm, offset, job->input + offset, len, job->output + offset, &job->segments[task_index]);
+			break;
+	}
+}
+
+/**
+ * @brief Splits an operation into chunks and runs them on the pool.
+ *
+ * @param pool Thread pool (may be NULL).
+ * @param job Operation to run.
+ */
+static void aes_parallel_run(aes_thread_pool_t* pool, const aes_parallel_job_t* job)
+{
+	size_t num_chunks = (job->input_len + AES_PARALLEL_CHUNK_SIZE - 1) / AES_PARALLEL_CHUNK_SIZE;
+	aes_thread_pool_run(pool, aes_parallel_task, (void*)job, num_chunks);
+}
+
+void aes_ecb_encrypt_parallel(aes_thread_pool_t* pool, const aes_context_t* ctx, const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	if (!ctx || !input || !output || input_len % AES_BLOCK_SIZE != 0) return;
+
+	aes_parallel_job_t job = { AES_PARALLEL_ECB_ENCRYPT, ctx, NULL, NULL, input, input_len, output, NULL, NULL };
+	aes_parallel_run(pool, &job);
+}
+
+void aes_ecb_decrypt_parallel(aes_thread_pool_t* pool, const aes_context_t* ctx, const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	if (!ctx || !ctx->has_dec_round_keys || !input || !output || input_len % AES_BLOCK_SIZE != 0) return;
+
+	aes_parallel_job_t job = { AES_PARALLEL_ECB_DECRYPT, ctx, NULL, NULL, input, input_len, output, NULL, NULL };
+	aes_parallel_run(pool, &job);
+}
+
+void aes_ctr_crypt_parallel(aes_thread_pool_t* pool, const aes_context_t* ctx, const uint8_t iv[16], const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	if (!ctx || !iv || !input || !output) return;
+
+	aes_parallel_job_t job = { AES_PARALLEL_CTR, ctx, iv, NULL, input, input_len, output, NULL, NULL };
+	aes_parallel_run(pool, &job);
+}
+
+void aes_cfb_decrypt_parallel(aes_thread_pool_t* pool, const aes_context_t* ctx, const uint8_t iv[16], const uint8_t* input, size_t input_len, uint8_t* output)
+{
+	if (!ctx || !iv || !input || !output) return;
+
+	size_t num_chunks = (input_len + AES_PARALLEL_CHUNK_SIZE - 1) / AES_PARALLEL_CHUNK_SIZE;
+	uint8_t* chunk_ivs = num_chunks > 1 && aes_thread_pool_size(pool) > 1 ? (uint8_t*)malloc(num_chunks * AES_BLOCK_SIZE) : NULL;
+
+	// Single chunk, single thread or out of memory: decrypt on the calling thread
+	if (!chunk_ivs)
+	{
+		aes_cfb_decrypt(ctx, iv, input, input_len, output);
+		return;
+	}
+
+	// Save the ciphertext block preceding each chunk: in place, it is overwritten by another task
+	for (size_t c = 1; c < num_chunks; ++c)
+		memcpy(chunk_ivs + c * AES_BLOCK_SIZE, input + c * AES_PARALLEL_CHUNK_SIZE - AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+
+	aes_parallel_job_t job = { AES_PARALLEL_CFB_DECRYPT, ctx, iv, chunk_ivs, input, input_len, output, NULL, NULL };
+	aes_parallel_run(pool, &job);
+
+	free(chunk_ivs);
+}
+
+/**
+ * @brief Runs the text of a GCM operation on the pool and folds the chunk hashes into the state.
+ *
+ * Falls back to the serial update for a single chunk, a single thread or when
+ * the chunk table cannot be allocated.
+ *
+ * @param pool Thread pool (may be NULL).
+ * @param gcm GCM state after the AAD.
+ * @param input Input text.
+ * @param input_len Length of the text in bytes.
+ * @param output Output text (may alias input).
+ * @param decrypt 0 to encrypt, 1 to decrypt.
+ * @return 0 on success, non-zero on error.
+ */
+static int aes_gcm_crypt_parallel(aes_thread_pool_t* pool, aes_gcm_context_t* gcm, const uint8_t* input, size_t input_len, uint8_t* output, int decrypt)
+{
+	size_t num_chunks = (input_len + AES_PARALLEL_CHUNK_SIZE - 1) / AES_PARALLEL_CHUNK_SIZE;
+	aes_gcm_segment_t* segments = num_chunks > 1 && aes_thread_pool_size(pool) > 1 ? (aes_gcm_segment_t*)malloc(num_chunks * sizeof(aes_gcm_segment_t)) : NULL;
+
+	if (!segments)
+		return decrypt ? aes_gcm_decrypt_update(gcm, input, input_len, output) : aes_gcm_encrypt_update(gcm, input, input_len, output);
+
+	aes_parallel_job_t job = { decrypt ? AES_PARALLEL_GCM_DECRYPT : AES_PARALLEL_GCM_ENCRYPT, gcm->ctx, NULL, NULL, input, input_len, output, gcm, segments };
+	aes_parallel_run(pool, &job);
+
+	int result = aes_gcm_append_segments(gcm, segments, num_chunks);
+	free(segments);
+
+	return result;
+}
+
+int aes_gcm_encrypt_parallel(aes_thread_pool_t* pool, const aes_context_t* ctx, const aes_ghash_key_t* hkey, const uint8_t* iv, size_t iv_len,
+	const uint8_t* aad, size_t aad_len, const uint8_t* input, size_t input_len, uint8_t* output, uint8_t* tag, size_t tag_len)
+{
+	aes_ghash_key_t local_hkey;
+	aes_gcm_context_t gcm;
+
+	if (input_len > AES_GCM_MAX_TEXT_SIZE || (input_len > 0 && (!input || !output)))
+		return 1;
+
+	int status = (!hkey && aes_ghash_key_init(&local_hkey, ctx) != 0)
+		|| aes_gcm_init(&gcm, ctx, hkey ? hkey : &local_hkey, iv, iv_len) != 0
+		|| aes_gcm_update_aad(&gcm, aad, aad_len) != 0
+		|| aes_gcm_crypt_parallel(pool, &gcm, input, input_len, output, 0) != 0
+		|| aes_gcm_finish(&gcm, tag, tag_len) != 0;
+
+	// The powers of H are enough to forge tags; the state holds keystream and the tag mask
+	memset(&gcm, 0, sizeof(gcm));
+	if (!hkey)
+		memset(&local_hkey, 0, sizeof(local_hkey));
+	__asm__ volatile ("" : : "r"(&gcm), "r"(&local_hkey) : "memory");
+
+	return status;
+}
+
+int aes_gcm_decrypt_parallel(aes_thread_pool_t* pool, const aes_context_t* ctx, const aes_ghash_key_t* hkey, const uint8_t* iv, size_t iv_len,
+	const uint8_t* aad, size_t aad_len, const uint8_t* input, size_t input_len, uint8_t* output, const uint8_t* tag, size_t tag_len)
+{
+	aes_ghash_key_t local_hkey;
+	aes_gcm_context_t gcm;
+
+	if (input_len > AES_GCM_MAX_TEXT_SIZE || (input_len > 0 && (!input || !output)))
+		return 1;
+
+	int status = (!hkey && aes_ghash_key_init(&local_hkey, ctx) != 0)
+		|| aes_gcm_init(&gcm, ctx, hkey ? hkey : &local_hkey, iv, iv_len) != 0
+		|| aes_gcm_update_aad(&gcm, aad, aad_len) != 0;
+
+	// Do not release unauthenticated plaintext, even if some segments were decrypted before an error
+	if (!status && (aes_gcm_crypt_parallel(pool, &gcm, input, input_len, output, 1) != 0 || aes_gcm_verify(&gcm, tag, tag_len) != 0))
+	{
+		if (input_len > 0)
+			memset(output, 0, input_len);
+		status = 1;
+	}
+
+	// The powers of H are enough to forge tags; the state holds keystream and the tag mask
+	memset(&gcm, 0, sizeof(gcm));
+	if (!hkey)
+		memset(&local_hkey, 0, sizeof(local_hkey));
+	__asm__ volatile ("" : : "r"(&gcm), "r"(&local_hkey) : "memory");
+
+	return status;
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "aes/parallel/aes_thread_pool.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+struct aes_thread_pool {
+	pthread_t* workers; ///< Worker threads
+	size_t num_workers; ///< Number of worker threads (pool size - 1)
+	pthread_mutex_t submit_mutex; ///< Serializes aes_thread_pool_run() callers
+	pthread_mutex_t mutex; ///< Protects the fields below
+	pthread_cond_t work_cond; ///< Signaled when a submission starts or on shutdown
+	pthread_cond_t done_cond; ///< Signaled when the last task of a submission completes
+	aes_task_func_t func; ///< Task function of the current submission
+	void* arg; ///< Task argument of the current submission
+	size_t num_tasks; ///< Number of tasks of the current submission
+	size_t next_task; ///< Next task index to hand out
+	size_t done_tasks; ///< Number of completed tasks
+	unsigned long generation; ///< Submission counter, wakes the workers
+	int shutdown; ///< Set by aes_thread_pool_destroy()
+};
+
+/**
+ * @brief Executes tasks of the current submission until none is left.
+ *
+ * Must be called with pool->mutex held; the mutex is released while a task runs.
+ *
+ * @param pool Thread pool.
+ */
+static void aes_thread_pool_drain(aes_thread_pool_t* pool)
+{
+	while (pool->next_task < pool->num_tasks)
+	{
+		size_t task = pool->next_task++;
+
+		pthread_mutex_unlock(&pool->mutex);
+		pool->func(pool->arg, task);
+		pthread_mutex_lock(&pool->mutex);
+
+		if (++pool->done_tasks == pool->num_tasks)
+			pthread_cond_signal(&pool->done_cond);
+	}
+}
+
+/**
+ * @brief Worker thread main loop.
+ *
+ * @param arg Thread pool.
+ * @return NULL.
+ */
+static void* aes_thread_pool_worker(void* arg)
+{
+	aes_thread_pool_t* pool = (aes_thread_pool_t*)arg;
+	unsigned long seen = 0;
+
+	pthread_mutex_lock(&pool->mutex);
+
+	for (;;)
+	{
+		while (!pool->shutdown && pool->generation == seen)
+			pthread_cond_wait(&pool->work_cond, &pool->mutex);
+
+		if (pool->shutdown)
+			break;
+
+		seen = pool->generation;
+		aes_thread_pool_drain(pool);
+	}
+
+	pthread_mutex_unlock(&pool->mutex);
+	return NULL;
+}
+
+aes_thread_pool_t* aes_thread_pool_create(size_t num_threads)
+{
+	if (num_threads == 0)
+		return NULL;
+
+	aes_thread_pool_t* pool = (aes_thread_pool_t*)calloc(1, sizeof(aes_thread_pool_t));
+	if (!pool)
+		return NULL;
+
+	pool->workers = (pthread_t*)calloc(num_threads, sizeof(pthread_t));
+	if (!pool->workers)
+	{
+		free(pool);
+		return NULL;
+	}
+
+	pthread_mutex_init(&pool->submit_mutex, NULL);
+	pthread_mutex_init(&pool->mutex, NULL);
+	pthread_cond_init(&pool->work_cond, NULL);
+	pthread_cond_init(&pool->done_cond, NULL);
+
+	for (size_t i = 0; i < num_threads - 1; ++i)
+	{
+		if (pthread_create(&pool->workers[i], NULL, aes_thread_pool_worker, pool) != 0)
+		{
+			aes_thread_pool_destroy(pool);
+			return NULL;
+		}
+
+		pool->num_workers++;
+	}
+
+	return pool;
+}
+
+void aes_thread_pool_destroy(aes_thread_pool_t* pool)
+{
+	if (!pool)
+		return;
+
+	pthread_mutex_lock(&pool->mutex);
+	pool->shutdown = 1;
+	pthread_cond_broadcast(&pool->work_cond);
+	pthread_mutex_unlock(&pool->mutex);
+
+	for (size_t i = 0; i < pool->num_workers; ++i)
+		pthread_join(pool->workers[i], NULL);
+
+	pthread_cond_destroy(&pool->done_cond);
+	pthread_cond_destroy(&pool->work_cond);
+	pthread_mutex_destroy(&pool->mutex);
+	pthread_mutex_destroy(&pool->submit_mutex);
+
+	free(pool->workers);
+	free(pool);
+}
+
+size_t aes_thread_pool_size(const aes_thread_pool_t* pool)
+{
+	return pool ? pool->num_workers + 1 : 1;
+}
+
+void aes_thread_pool_run(aes_thread_pool_t* pool, aes_task_func_t func, void* arg, size_t num_tasks)
+{
+	if (!func || num_tasks == 0)
+		return;
+
+	// No workers: run everything on the calling thread
+	if (!pool || pool->num_workers == 0 || num_tasks == 1)
+	{
+		for (size_t i = 0; i < num_tasks; ++i)
+			func(arg, i);
+		return;
+	}
+
+	pthread_mutex_lock(&pool->submit_mutex);
+	pthread_mutex_lock(&pool->mutex);
+
+	pool->func = func;
+	pool->arg = arg;
+	pool->num_tasks = num_tasks;
+	pool->next_task = 0;
+	pool->done_tasks = 0;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->work_cond);
+
+	// The caller takes tasks too, then waits for those still running on workers
+	aes_thread_pool_drain(pool);
+
+	while (pool->done_tasks < pool->num_tasks)
+		pthread_cond_wait(&pool->done_cond, &pool->mutex);
+
+	pthread_mutex_unlock(&pool->mutex);
+	pthread_mutex_unlock(&pool->submit_mutex);
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "unity/unity.h"
+#include "aes/core/aes_avx2.h"
+#include "aes/core/aes_encrypt.h"
+#include "aes/core/aes_decrypt.h"
+#include "aes/core/aes_key_expansion.h"
+#include "aes/core/aes_dispatch.h"
+
+// 8 + 4 + 3 blocks exercise every path of the bulk kernel
+#define AVX2_TEST_BLOCKS 15
+
+void test_aes128_blocks_avx2(void)
+{
+	if (!aes_dispatch_is_supported(AES_IMPL_AESNI_AVX2))
+		TEST_IGNORE_MESSAGE("AVX2 not supported by this CPU");
+
+	const __m128i key = _mm_setr_epi8(
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f
+	);
+
+	__m128i enc_round_keys[AES_128_NUM_ROUND_KEYS];
+	__m128i dec_round_keys[AES_128_NUM_ROUND_KEYS];
+	aes128_key_expansion(key, enc_round_keys);
+	aes128_invert_round_keys(enc_round_keys, dec_round_keys);
+
+	__m128i input[AVX2_TEST_BLOCKS], expected[AVX2_TEST_BLOCKS], output[AVX2_TEST_BLOCKS];
+	for (int i = 0; i < AVX2_TEST_BLOCKS; ++i)
+		input[i] = _mm_set1_epi8((char)(0x11 * i));
+
+	aes128_encrypt_blocks(input, expected, AVX2_TEST_BLOCKS, enc_round_keys);
+	aes128_encrypt_blocks_avx2(input, output, AVX2_TEST_BLOCKS, enc_round_keys);
+	TEST_ASSERT_EQUAL_MEMORY(expected, output, sizeof(expected));
+
+	aes128_decrypt_blocks(input, expected, AVX2_TEST_BLOCKS, dec_round_keys);
+	aes128_decrypt_blocks_avx2(input, output, AVX2_TEST_BLOCKS, dec_round_keys);
+	TEST_ASSERT_EQUAL_MEMORY(expected, output, sizeof(expected));
+}
+
+void test_aes256_blocks_avx2(void)
+{
+	if (!aes_dispatch_is_supported(AES_IMPL_AESNI_AVX2))
+		TEST_IGNORE_MESSAGE("AVX2 not supported by this CPU");
+
+	const __m128i user_key[2] = {
+		_mm_setr_epi8(0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f),
+		_mm_setr_epi8(0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f)
+	};
+
+	__m128i enc_round_keys[AES_256_NUM_ROUND_KEYS];
+	__m128i dec_round_keys[AES_256_NUM_ROUND_KEYS];
+	aes256_key_expansion(user_key, enc_round_keys);
+	aes256_invert_round_keys(enc_round_keys, dec_round_keys);
+
+	__m128i input[AVX2_TEST_BLOCKS], expected[AVX2_TEST_BLOCKS], output[AVX2_TEST_BLOCKS];
+	for (int i = 0; i < AVX2_TEST_BLOCKS; ++i)
+		input[i] = _mm_set1_epi8((char)(0x11 * i));
+
+	aes256_encrypt_blocks(input, expected, AVX2_TEST_BLOCKS, enc_round_keys);
+	aes256_encrypt_blocks_avx2(input, output, AVX2_TEST_BLOCKS, enc_round_keys);
+	TEST_ASSERT_EQUAL_MEMORY(expected, output, sizeof(expected));
+
+	aes256_decrypt_blocks(input, expected, AVX2_TEST_BLOCKS, dec_round_keys);
+	aes256_decrypt_blocks_avx2(input, output, AVX2_TEST_BLOCKS, dec_round_keys);
+	TEST_ASSERT_EQUAL_MEMORY(expected, output, sizeof(expected));
+}
+
+void register_aes_avx2_tests(void)
+{
+	RUN_TEST(test_aes128_blocks_avx2);
+	RUN_TEST(test_aes256_blocks_avx2);
+}
\ No newline at end of file
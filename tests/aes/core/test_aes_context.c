@@ -1,5 +1,8 @@
 #include "unity/unity.h"
 #include "aes/core/aes_context.h"
+#include "aes/modes/aes_ecb.h"
+#include "aes/modes/aes_xts.h"
+#include <string.h>
 
 void test_aes_context_init_128(void)
 {
@@ -60,10 +63,121 @@ void test_aes_context_init_invalid_size(void)
 	TEST_ASSERT_NOT_EQUAL(0, result);
 }
 
+void test_aes_context_init_batch(void)
+{
+	// 6 keys: one full group of lanes and a partial one
+	enum { COUNT = 6 };
+	static const size_t sizes[3] = {AES_128, AES_192, AES_256};
+	uint8_t material[COUNT][AES_256];
+	const uint8_t* keys[COUNT];
+	aes_context_t batch[COUNT];
+	aes_context_t single;
+
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		for (size_t j = 0; j < AES_256; ++j)
+			material[i][j] = (uint8_t)(i * 37 + j * 11 + 1);
+		keys[i] = material[i];
+	}
+
+	for (size_t s = 0; s < 3; ++s)
+	{
+		size_t num_round_keys = sizes[s] == AES_128 ? AES_128_NUM_ROUND_KEYS : sizes[s] == AES_192 ? AES_192_NUM_ROUND_KEYS : AES_256_NUM_ROUND_KEYS;
+
+		TEST_ASSERT_EQUAL_INT(0, aes_context_init_batch(batch, keys, sizes[s], COUNT));
+
+		for (size_t i = 0; i < COUNT; ++i)
+		{
+			TEST_ASSERT_EQUAL_INT(0, aes_context_init(&single, keys[i], sizes[s]));
+			TEST_ASSERT_EQUAL_UINT32(sizes[s], batch[i].key_size);
+			TEST_ASSERT_EQUAL_PTR(single.dispatch, batch[i].dispatch);
+			TEST_ASSERT_EQUAL_MEMORY(single.enc_round_keys, batch[i].enc_round_keys, num_round_keys * sizeof(__m128i));
+			TEST_ASSERT_EQUAL_MEMORY(single.dec_round_keys, batch[i].dec_round_keys, num_round_keys * sizeof(__m128i));
+		}
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init_batch(NULL, NULL, AES_128, 0));
+	TEST_ASSERT_NOT_EQUAL(0, aes_context_init_batch(batch, keys, 10, COUNT));
+	keys[4] = NULL;
+	TEST_ASSERT_NOT_EQUAL(0, aes_context_init_batch(batch, keys, AES_128, COUNT));
+}
+
+void test_aes_context_init_encrypt(void)
+{
+	uint8_t key[AES_256];
+	uint8_t plaintext[64];
+	uint8_t ciphertext[64];
+	uint8_t buffer[64];
+	const uint8_t tweak[16] = {0};
+	aes_context_t full;
+	aes_context_t enc_only;
+	aes_context_t tweak_ctx;
+
+	for (size_t i = 0; i < sizeof(key); ++i)
+		key[i] = (uint8_t)(i * 5 + 3);
+	for (size_t i = 0; i < sizeof(plaintext); ++i)
+		plaintext[i] = (uint8_t)i;
+
+	// The decryption schedule is the tail of the context
+	TEST_ASSERT_TRUE(AES_CONTEXT_ENCRYPT_SIZE + sizeof(full.dec_round_keys) == sizeof(aes_context_t));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&full, key, AES_256));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init_encrypt(&enc_only, key, AES_256));
+	TEST_ASSERT_NOT_EQUAL(0, full.has_dec_round_keys);
+	TEST_ASSERT_EQUAL_INT(0, enc_only.has_dec_round_keys);
+	TEST_ASSERT_EQUAL_MEMORY(full.enc_round_keys, enc_only.enc_round_keys, AES_256_NUM_ROUND_KEYS * sizeof(__m128i));
+
+	aes_ecb_encrypt(&enc_only, plaintext, sizeof(plaintext), ciphertext);
+
+	// Decryption is refused until the schedule is prepared
+	memset(buffer, 0xaa, sizeof(buffer));
+	aes_ecb_decrypt(&enc_only, ciphertext, sizeof(ciphertext), buffer);
+	TEST_ASSERT_EACH_EQUAL_UINT8(0xaa, buffer, sizeof(buffer));
+
+	key[0] ^= 1;
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&tweak_ctx, key, AES_256));
+	TEST_ASSERT_EQUAL_INT(0, aes_xts_encrypt(&enc_only, &tweak_ctx, tweak, plaintext, sizeof(plaintext), buffer));
+	TEST_ASSERT_NOT_EQUAL(0, aes_xts_decrypt(&enc_only, &tweak_ctx, tweak, buffer, sizeof(buffer), buffer));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_prepare_decrypt(&enc_only));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_prepare_decrypt(&enc_only));
+	TEST_ASSERT_EQUAL_MEMORY(full.dec_round_keys, enc_only.dec_round_keys, AES_256_NUM_ROUND_KEYS * sizeof(__m128i));
+
+	aes_ecb_decrypt(&enc_only, ciphertext, sizeof(ciphertext), buffer);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, buffer, sizeof(plaintext));
+
+	TEST_ASSERT_NOT_EQUAL(0, aes_context_init_encrypt(&enc_only, key, 20));
+	TEST_ASSERT_NOT_EQUAL(0, aes_context_prepare_decrypt(NULL));
+}
+
+void test_aes_context_wipe(void)
+{
+	uint8_t key[32] = {0x42};
+	aes_context_t ctx;
+	aes_context_t zero;
+	memset(&zero, 0, sizeof(zero));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+	aes_context_wipe(&ctx);
+	TEST_ASSERT_EQUAL_MEMORY(&zero, &ctx, sizeof(ctx));
+
+	// A full context reused as encrypt-only still holds the old decryption schedule
+	const uint8_t other_key[16] = {0xAA};
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init_encrypt(&ctx, other_key, AES_128));
+	aes_context_wipe(&ctx);
+	TEST_ASSERT_EQUAL_MEMORY(&zero, &ctx, sizeof(ctx));
+
+	aes_context_wipe(NULL);
+}
+
 void register_aes_context_tests(void)
 {
 	RUN_TEST(test_aes_context_init_128);
 	RUN_TEST(test_aes_context_init_192);
 	RUN_TEST(test_aes_context_init_256);
 	RUN_TEST(test_aes_context_init_invalid_size);
+	RUN_TEST(test_aes_context_init_batch);
+	RUN_TEST(test_aes_context_init_encrypt);
+	RUN_TEST(test_aes_context_wipe);
 }
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "unity/unity.h"
+#include "aes/core/aes_context_arena.h"
+#include "aes/core/aes_constants.h"
+#include "aes/modes/aes_ecb.h"
+#include <string.h>
+
+#define ARENA_TEST_CONTEXTS 300 // Spans several slabs of every slot size
+
+/**
+ * @brief Fills a key derived from an index.
+ */
+static void arena_test_key(uint8_t* key, size_t key_size, size_t index)
+{
+	for (size_t i = 0; i < key_size; ++i)
+		key[i] = (uint8_t)(index * 31 + i);
+}
+
+void test_context_arena_create_invalid(void)
+{
+	TEST_ASSERT_NULL(aes_context_arena_create(0, 0));
+	TEST_ASSERT_NULL(aes_context_arena_create(AES_CONTEXT_ARENA_MAX_CAPACITY + 1, 0));
+	TEST_ASSERT_NULL(aes_context_arena_create(16, 0x80));
+	TEST_ASSERT_EQUAL_size_t(0, aes_context_arena_count(NULL));
+	TEST_ASSERT_NULL(aes_context_arena_get(NULL, 1));
+	TEST_ASSERT_NOT_EQUAL(0, aes_context_arena_free(NULL, 1));
+	aes_context_arena_destroy(NULL);
+}
+
+/**
+ * @brief Checks that every context of an arena is aligned and matches a heap context.
+ */
+static void check_arena_contexts(unsigned flags)
+{
+	aes_context_arena_t* arena = aes_context_arena_create(ARENA_TEST_CONTEXTS, flags);
+	TEST_ASSERT_NOT_NULL(arena);
+
+	static const size_t key_sizes[] = {AES_128, AES_192, AES_256};
+	static const size_t num_round_keys[] = {AES_128_NUM_ROUND_KEYS, AES_192_NUM_ROUND_KEYS, AES_256_NUM_ROUND_KEYS};
+	aes_context_handle_t handles[ARENA_TEST_CONTEXTS];
+	uint8_t key[32];
+
+	for (size_t i = 0; i < ARENA_TEST_CONTEXTS; ++i)
+	{
+		arena_test_key(key, sizeof(key), i);
+		handles[i] = aes_context_arena_alloc(arena, key, key_sizes[i % 3]);
+		TEST_ASSERT_NOT_EQUAL(AES_CONTEXT_HANDLE_INVALID, handles[i]);
+	}
+	TEST_ASSERT_EQUAL_size_t(ARENA_TEST_CONTEXTS, aes_context_arena_count(arena));
+
+	// Full arena
+	TEST_ASSERT_EQUAL_UINT32(AES_CONTEXT_HANDLE_INVALID, aes_context_arena_alloc(arena, key, AES_128));
+
+	for (size_t i = 0; i < ARENA_TEST_CONTEXTS; ++i)
+	{
+		const aes_context_t* ctx = aes_context_arena_get(arena, handles[i]);
+		TEST_ASSERT_NOT_NULL(ctx);
+		TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)ctx % AES_CACHE_LINE_SIZE);
+
+		aes_context_t expected;
+		arena_test_key(key, sizeof(key), i);
+		TEST_ASSERT_EQUAL_INT(0, aes_context_init_encrypt(&expected, key, key_sizes[i % 3]));
+		TEST_ASSERT_EQUAL_INT(expected.key_size, ctx->key_size);
+		TEST_ASSERT_EQUAL_PTR(expected.dispatch, ctx->dispatch);
+		TEST_ASSERT_EQUAL_MEMORY(expected.enc_round_keys, ctx->enc_round_keys, num_round_keys[i % 3] * sizeof(__m128i));
+
+		if (flags & AES_CONTEXT_ARENA_ENCRYPT_ONLY)
+		{
+			TEST_ASSERT_EQUAL_INT(0, ctx->has_dec_round_keys);
+		}
+		else
+		{
+			TEST_ASSERT_EQUAL_INT(0, aes_context_prepare_decrypt(&expected));
+			TEST_ASSERT_EQUAL_INT(1, ctx->has_dec_round_keys);
+			TEST_ASSERT_EQUAL_MEMORY(expected.dec_round_keys, ctx->dec_round_keys, num_round_keys[i % 3] * sizeof(__m128i));
+		}
+	}
+
+	aes_context_arena_destroy(arena);
+}
+
+void test_context_arena_contexts(void)
+{
+	check_arena_contexts(0);
+}
+
+void test_context_arena_encrypt_only(void)
+{
+	check_arena_contexts(AES_CONTEXT_ARENA_ENCRYPT_ONLY);
+}
+
+void test_context_arena_huge_pages(void)
+{
+	// Falls back to regular pages when the system has no huge pages
+	check_arena_contexts(AES_CONTEXT_ARENA_HUGE_PAGES);
+	check_arena_contexts(AES_CONTEXT_ARENA_HUGE_PAGES | AES_CONTEXT_ARENA_ENCRYPT_ONLY);
+}
+
+void test_context_arena_free_reuses_slots(void)
+{
+	aes_context_arena_t* arena = aes_context_arena_create(4, 0);
+	TEST_ASSERT_NOT_NULL(arena);
+
+	uint8_t key[32] = {0};
+	aes_context_handle_t handles[4];
+	for (size_t i = 0; i < 4; ++i)
+	{
+		key[0] = (uint8_t)i;
+		handles[i] = aes_context_arena_alloc(arena, key, AES_256);
+		TEST_ASSERT_NOT_EQUAL(AES_CONTEXT_HANDLE_INVALID, handles[i]);
+	}
+
+	const aes_context_t* freed = aes_context_arena_get(arena, handles[1]);
+	TEST_ASSERT_EQUAL_INT(0, aes_context_arena_free(arena, handles[1]));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_arena_free(arena, handles[2]));
+	TEST_ASSERT_EQUAL_size_t(2, aes_context_arena_count(arena));
+
+	// Released contexts are wiped and their handles rejected
+	TEST_ASSERT_EQUAL_INT(0, freed->key_size);
+	TEST_ASSERT_EACH_EQUAL_UINT8(0, (const uint8_t*)freed->dec_round_keys, sizeof(freed->dec_round_keys));
+	TEST_ASSERT_NULL(aes_context_arena_get(arena, handles[1]));
+	TEST_ASSERT_NOT_EQUAL(0, aes_context_arena_free(arena, handles[1]));
+	TEST_ASSERT_NOT_EQUAL(0, aes_context_arena_free(arena, AES_CONTEXT_HANDLE_INVALID));
+	TEST_ASSERT_NOT_EQUAL(0, aes_context_arena_free(arena, 99));
+
+	// Invalid keys do not consume a slot
+	TEST_ASSERT_EQUAL_UINT32(AES_CONTEXT_HANDLE_INVALID, aes_context_arena_alloc(arena, key, 20));
+	TEST_ASSERT_EQUAL_UINT32(AES_CONTEXT_HANDLE_INVALID, aes_context_arena_alloc(arena, NULL, AES_128));
+
+	// Freed slots are handed out again, most recent first, under new handles
+	key[0] = 0x77;
+	aes_context_handle_t reused[2];
+	reused[0] = aes_context_arena_alloc(arena, key, AES_128);
+	reused[1] = aes_context_arena_alloc(arena, key, AES_128);
+	TEST_ASSERT_EQUAL_UINT32(AES_CONTEXT_HANDLE_INVALID, aes_context_arena_alloc(arena, key, AES_128));
+	TEST_ASSERT_EQUAL_size_t(aes_context_handle_index(handles[2]), aes_context_handle_index(reused[0]));
+	TEST_ASSERT_EQUAL_size_t(aes_context_handle_index(handles[1]), aes_context_handle_index(reused[1]));
+	TEST_ASSERT_EQUAL_PTR(freed, aes_context_arena_get(arena, reused[1]));
+
+	// Stale handles neither reach nor release the new contexts of their slots
+	TEST_ASSERT_NULL(aes_context_arena_get(arena, handles[1]));
+	TEST_ASSERT_NULL(aes_context_arena_get(arena, handles[2]));
+	TEST_ASSERT_NOT_EQUAL(0, aes_context_arena_free(arena, handles[1]));
+	TEST_ASSERT_EQUAL_INT(AES_128, freed->key_size);
+
+	// A reused slot holds a working context
+	const uint8_t plaintext[AES_BLOCK_SIZE] = {1, 2, 3};
+	uint8_t expected[AES_BLOCK_SIZE];
+	uint8_t actual[AES_BLOCK_SIZE];
+	aes_context_t ctx;
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	aes_ecb_encrypt(&ctx, plaintext, sizeof(plaintext), expected);
+	aes_ecb_encrypt(aes_context_arena_get(arena, reused[1]), plaintext, sizeof(plaintext), actual);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, sizeof(expected));
+
+	aes_context_arena_destroy(arena);
+}
+
+void register_aes_context_arena_tests(void)
+{
+	RUN_TEST(test_context_arena_create_invalid);
+	RUN_TEST(test_context_arena_contexts);
+	RUN_TEST(test_context_arena_encrypt_only);
+	RUN_TEST(test_context_arena_huge_pages);
+	RUN_TEST(test_context_arena_free_reuses_slots);
+}
\ No newline at end of file
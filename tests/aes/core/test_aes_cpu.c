@@ -0,0 +1,33 @@
+#include "unity/unity.h"
+#include "aes/core/aes_cpu.h"
+
+void test_aes_cpu_features_cached(void)
+{
+	const aes_cpu_features_t* first = aes_cpu_get_features();
+	const aes_cpu_features_t* second = aes_cpu_get_features();
+
+	TEST_ASSERT_NOT_NULL(first);
+	TEST_ASSERT_EQUAL_PTR(first, second);
+}
+
+void test_aes_cpu_features_consistent(void)
+{
+	const aes_cpu_features_t* cpu = aes_cpu_get_features();
+
+	// The test binary itself is built with AES-NI and SSE4.1
+	TEST_ASSERT_EQUAL_INT(1, cpu->aesni);
+	TEST_ASSERT_EQUAL_INT(1, cpu->sse41);
+
+	// Wider extensions imply the narrower ones they build on
+	if (cpu->avx2) TEST_ASSERT_EQUAL_INT(1, cpu->avx);
+	if (cpu->vaes) TEST_ASSERT_EQUAL_INT(1, cpu->aesni && cpu->avx);
+	if (cpu->vpclmulqdq) TEST_ASSERT_EQUAL_INT(1, cpu->pclmulqdq && cpu->avx);
+	if (cpu->avx512bw) TEST_ASSERT_EQUAL_INT(1, cpu->avx512f);
+	if (cpu->avx512vl) TEST_ASSERT_EQUAL_INT(1, cpu->avx512f);
+}
+
+void register_aes_cpu_tests(void)
+{
+	RUN_TEST(test_aes_cpu_features_cached);
+	RUN_TEST(test_aes_cpu_features_consistent);
+}
\ No newline at end of file
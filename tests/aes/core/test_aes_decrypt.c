@@ -126,9 +126,99 @@ void test_aes256_decrypt_block(void)
 	}
 }
 
+void test_aes128_decrypt_blocks4(void)
+{
+	const __m128i key = _mm_setr_epi8(
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f
+	);
+
+	__m128i enc_round_keys[AES_128_NUM_ROUND_KEYS];
+	aes128_key_expansion(key, enc_round_keys);
+
+	__m128i dec_round_keys[AES_128_NUM_ROUND_KEYS];
+	aes128_invert_round_keys(enc_round_keys, dec_round_keys);
+
+	__m128i ciphertext[4];
+	for (int i = 0; i < 4; ++i)
+		ciphertext[i] = _mm_set1_epi8((char)(0x11 * i));
+
+	__m128i plaintext[4];
+	aes128_decrypt_blocks4(ciphertext, plaintext, dec_round_keys);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		__m128i expected;
+		aes128_decrypt_block(ciphertext[i], &expected, dec_round_keys);
+		TEST_ASSERT_EQUAL_MEMORY(&expected, &plaintext[i], AES_BLOCK_SIZE);
+	}
+}
+
+void test_aes192_decrypt_blocks8(void)
+{
+	const __m128i user_key[2] = {
+		_mm_setr_epi8(0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f),
+		_mm_setr_epi8(0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 )
+	};
+
+	__m128i enc_round_keys[AES_192_NUM_ROUND_KEYS];
+	aes192_key_expansion(user_key, enc_round_keys);
+
+	__m128i dec_round_keys[AES_192_NUM_ROUND_KEYS];
+	aes192_invert_round_keys(enc_round_keys, dec_round_keys);
+
+	__m128i ciphertext[8];
+	for (int i = 0; i < 8; ++i)
+		ciphertext[i] = _mm_set1_epi8((char)(0x11 * i));
+
+	__m128i plaintext[8];
+	aes192_decrypt_blocks8(ciphertext, plaintext, dec_round_keys);
+
+	for (int i = 0; i < 8; ++i)
+	{
+		__m128i expected;
+		aes192_decrypt_block(ciphertext[i], &expected, dec_round_keys);
+		TEST_ASSERT_EQUAL_MEMORY(&expected, &plaintext[i], AES_BLOCK_SIZE);
+	}
+}
+
+void test_aes256_decrypt_blocks(void)
+{
+	const __m128i user_key[2] = {
+		_mm_setr_epi8(0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f),
+		_mm_setr_epi8(0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f)
+	};
+
+	__m128i enc_round_keys[AES_256_NUM_ROUND_KEYS];
+	aes256_key_expansion(user_key, enc_round_keys);
+
+	__m128i dec_round_keys[AES_256_NUM_ROUND_KEYS];
+	aes256_invert_round_keys(enc_round_keys, dec_round_keys);
+
+	// 8 + 4 + 3 blocks exercise every path of the bulk kernel
+	__m128i ciphertext[15];
+	for (int i = 0; i < 15; ++i)
+		ciphertext[i] = _mm_set1_epi8((char)(0x11 * i));
+
+	__m128i plaintext[15];
+	aes256_decrypt_blocks(ciphertext, plaintext, 15, dec_round_keys);
+
+	for (int i = 0; i < 15; ++i)
+	{
+		__m128i expected;
+		aes256_decrypt_block(ciphertext[i], &expected, dec_round_keys);
+		TEST_ASSERT_EQUAL_MEMORY(&expected, &plaintext[i], AES_BLOCK_SIZE);
+	}
+}
+
 void register_aes_decrypt_tests(void)
 {
 	RUN_TEST(test_aes128_decrypt_block);
 	RUN_TEST(test_aes192_decrypt_block);
 	RUN_TEST(test_aes256_decrypt_block);
+	RUN_TEST(test_aes128_decrypt_blocks4);
+	RUN_TEST(test_aes192_decrypt_blocks8);
+	RUN_TEST(test_aes256_decrypt_blocks);
 }
\ No newline at end of file
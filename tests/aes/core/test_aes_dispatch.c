@@ -0,0 +1,99 @@
+#include "unity/unity.h"
+#include "aes/core/aes_dispatch.h"
+#include "aes/core/aes_context.h"
+#include "aes/modes/aes_ecb.h"
+#include "aes/modes/aes_cbc.h"
+#include "aes/modes/aes_ctr.h"
+#include <string.h>
+
+void test_aes_dispatch_impl_names(void)
+{
+	TEST_ASSERT_EQUAL_STRING("aesni", aes_dispatch_impl_name(AES_IMPL_AESNI));
+	TEST_ASSERT_EQUAL_STRING("aesni-avx2", aes_dispatch_impl_name(AES_IMPL_AESNI_AVX2));
+	TEST_ASSERT_EQUAL_STRING("vaes256", aes_dispatch_impl_name(AES_IMPL_VAES256));
+	TEST_ASSERT_EQUAL_STRING("vaes512", aes_dispatch_impl_name(AES_IMPL_VAES512));
+	TEST_ASSERT_EQUAL_STRING("unknown", aes_dispatch_impl_name(AES_IMPL_COUNT));
+}
+
+void test_aes_dispatch_get(void)
+{
+	aes_impl_t impl = aes_dispatch_get_impl();
+	TEST_ASSERT_TRUE(aes_dispatch_is_supported(impl));
+
+	const aes_dispatch_t* dispatch = aes_dispatch_get(AES_192);
+	TEST_ASSERT_NOT_NULL(dispatch);
+	TEST_ASSERT_EQUAL_INT(impl, dispatch->impl);
+	TEST_ASSERT_EQUAL_STRING(aes_dispatch_impl_name(impl), dispatch->name);
+
+	TEST_ASSERT_NULL(aes_dispatch_get(10));
+}
+
+void test_aes_dispatch_context_uses_selected_impl(void)
+{
+	const uint8_t key[16] = {0};
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_dispatch_set_impl(AES_IMPL_AESNI));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_STRING("aesni", ctx.dispatch->name);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_dispatch_set_impl(AES_IMPL_COUNT));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(aes_dispatch_get_impl(), ctx.dispatch->impl);
+}
+
+void test_aes_dispatch_all_impls_agree(void)
+{
+	const uint8_t key[32] = {
+		0x60, 0x3d, 0xeb, 0x10,
+		0x15, 0xca, 0x71, 0xbe,
+		0x2b, 0x73, 0xae, 0xf0,
+		0x85, 0x7d, 0x77, 0x81,
+		0x1f, 0x35, 0x2c, 0x07,
+		0x3b, 0x61, 0x08, 0xd7,
+		0x2d, 0x98, 0x10, 0xa3,
+		0x09, 0x14, 0xdf, 0xf4
+	};
+
+	const uint8_t iv[16] = {0};
+
+	// 45 blocks: not a multiple of any kernel width
+	uint8_t input[45 * AES_BLOCK_SIZE];
+	for (size_t i = 0; i < sizeof(input); ++i)
+		input[i] = (uint8_t)(i * 7);
+
+	uint8_t ecb_ref[sizeof(input)], cbc_ref[sizeof(input)], ctr_ref[sizeof(input)];
+	uint8_t ecb_out[sizeof(input)], cbc_out[sizeof(input)], ctr_out[sizeof(input)];
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_dispatch_set_impl(AES_IMPL_AESNI));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+	aes_ecb_encrypt(&ctx, input, sizeof(input), ecb_ref);
+	aes_cbc_decrypt(&ctx, iv, input, sizeof(input), cbc_ref);
+	aes_ctr_crypt(&ctx, iv, input, sizeof(input) - 3, ctr_ref);
+
+	for (int impl = AES_IMPL_AESNI_AVX2; impl < AES_IMPL_COUNT; ++impl)
+	{
+		if (aes_dispatch_set_impl((aes_impl_t)impl) != 0)
+			continue;
+
+		TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+		aes_ecb_encrypt(&ctx, input, sizeof(input), ecb_out);
+		aes_cbc_decrypt(&ctx, iv, input, sizeof(input), cbc_out);
+		aes_ctr_crypt(&ctx, iv, input, sizeof(input) - 3, ctr_out);
+
+		TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(ecb_ref, ecb_out, sizeof(input), aes_dispatch_impl_name((aes_impl_t)impl));
+		TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(cbc_ref, cbc_out, sizeof(input), aes_dispatch_impl_name((aes_impl_t)impl));
+		TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(ctr_ref, ctr_out, sizeof(input) - 3, aes_dispatch_impl_name((aes_impl_t)impl));
+	}
+
+	aes_dispatch_set_impl(AES_IMPL_COUNT);
+}
+
+void register_aes_dispatch_tests(void)
+{
+	RUN_TEST(test_aes_dispatch_impl_names);
+	RUN_TEST(test_aes_dispatch_get);
+	RUN_TEST(test_aes_dispatch_context_uses_selected_impl);
+	RUN_TEST(test_aes_dispatch_all_impls_agree);
+}
\ No newline at end of file
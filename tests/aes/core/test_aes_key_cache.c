@@ -0,0 +1,198 @@
+#include "unity/unity.h"
+#include "aes/core/aes_key_cache.h"
+#include "aes/core/aes_context_arena.h"
+#include <pthread.h>
+#include <string.h>
+
+#define KEY_CACHE_TEST_THREADS 4
+#define KEY_CACHE_TEST_KEYS 64
+#define KEY_CACHE_TEST_LOOKUPS 2000
+
+/**
+ * @brief Fills a key derived from an identifier.
+ */
+static void key_cache_test_key(uint8_t* key, size_t key_size, uint64_t key_id)
+{
+	for (size_t i = 0; i < key_size; ++i)
+		key[i] = (uint8_t)(key_id * 13 + i);
+}
+
+/**
+ * @brief Checks that a context holds the schedule of a key.
+ */
+static void check_key_cache_context(const aes_context_t* ctx, const uint8_t* key, size_t key_size)
+{
+	aes_context_t expected;
+	size_t num_round_keys = key_size / 4 + 7;
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&expected, key, key_size));
+	TEST_ASSERT_EQUAL_INT(expected.key_size, ctx->key_size);
+	TEST_ASSERT_EQUAL_INT(1, ctx->has_dec_round_keys);
+	TEST_ASSERT_EQUAL_MEMORY(expected.enc_round_keys, ctx->enc_round_keys, num_round_keys * sizeof(__m128i));
+	TEST_ASSERT_EQUAL_MEMORY(expected.dec_round_keys, ctx->dec_round_keys, num_round_keys * sizeof(__m128i));
+}
+
+void test_key_cache_create_invalid(void)
+{
+	aes_context_t ctx;
+	uint8_t key[16] = {0};
+
+	TEST_ASSERT_NULL(aes_key_cache_create(16, 0, 0));
+	TEST_ASSERT_NULL(aes_key_cache_create(3, 4, 0));
+	TEST_ASSERT_NULL(aes_key_cache_create(16, 4, 0x80));
+	TEST_ASSERT_NOT_EQUAL(0, aes_key_cache_get(NULL, 1, key, sizeof(key), &ctx));
+	TEST_ASSERT_NOT_EQUAL(0, aes_key_cache_remove(NULL, 1));
+	aes_key_cache_destroy(NULL);
+
+	aes_key_cache_t* cache = aes_key_cache_create(16, 4, 0);
+	TEST_ASSERT_NOT_NULL(cache);
+	TEST_ASSERT_NOT_EQUAL(0, aes_key_cache_get(cache, 1, key, 20, &ctx));
+	TEST_ASSERT_NOT_EQUAL(0, aes_key_cache_get(cache, 1, key, sizeof(key), NULL));
+	aes_key_cache_destroy(cache);
+}
+
+void test_key_cache_hits_and_misses(void)
+{
+	aes_key_cache_t* cache = aes_key_cache_create(8, 2, 0);
+	TEST_ASSERT_NOT_NULL(cache);
+
+	aes_context_t ctx;
+	aes_key_cache_stats_t stats;
+	uint8_t key[32];
+	key_cache_test_key(key, sizeof(key), 7);
+
+	// Lookups without key never insert
+	TEST_ASSERT_NOT_EQUAL(0, aes_key_cache_get(cache, 7, NULL, 0, &ctx));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_key_cache_get(cache, 7, key, AES_256, &ctx));
+	check_key_cache_context(&ctx, key, AES_256);
+	memset(&ctx, 0, sizeof(ctx));
+	TEST_ASSERT_EQUAL_INT(0, aes_key_cache_get(cache, 7, key, AES_256, &ctx));
+	check_key_cache_context(&ctx, key, AES_256);
+	memset(&ctx, 0, sizeof(ctx));
+	TEST_ASSERT_EQUAL_INT(0, aes_key_cache_get(cache, 7, NULL, 0, &ctx));
+	check_key_cache_context(&ctx, key, AES_256);
+
+	aes_key_cache_stats(cache, &stats);
+	TEST_ASSERT_EQUAL_UINT64(2, stats.hits);
+	TEST_ASSERT_EQUAL_UINT64(2, stats.misses);
+	TEST_ASSERT_EQUAL_UINT64(0, stats.evictions);
+	TEST_ASSERT_EQUAL_size_t(1, stats.count);
+
+	// Same identifier, other key: the stale schedule is replaced
+	uint8_t other[16];
+	key_cache_test_key(other, sizeof(other), 8);
+	TEST_ASSERT_EQUAL_INT(0, aes_key_cache_get(cache, 7, other, AES_128, &ctx));
+	check_key_cache_context(&ctx, other, AES_128);
+	TEST_ASSERT_EQUAL_INT(0, aes_key_cache_get(cache, 7, other, AES_128, &ctx));
+
+	aes_key_cache_stats(cache, &stats);
+	TEST_ASSERT_EQUAL_UINT64(3, stats.hits);
+	TEST_ASSERT_EQUAL_UINT64(3, stats.misses);
+	TEST_ASSERT_EQUAL_size_t(1, stats.count);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_key_cache_remove(cache, 7));
+	TEST_ASSERT_NOT_EQUAL(0, aes_key_cache_remove(cache, 7));
+	TEST_ASSERT_NOT_EQUAL(0, aes_key_cache_get(cache, 7, NULL, 0, &ctx));
+
+	aes_key_cache_stats(cache, &stats);
+	TEST_ASSERT_EQUAL_size_t(0, stats.count);
+
+	aes_key_cache_destroy(cache);
+}
+
+void test_key_cache_evicts_least_recently_used(void)
+{
+	// A single shard makes the eviction order predictable
+	aes_key_cache_t* cache = aes_key_cache_create(3, 1, AES_CONTEXT_ARENA_ENCRYPT_ONLY);
+	TEST_ASSERT_NOT_NULL(cache);
+
+	aes_context_t ctx;
+	aes_key_cache_stats_t stats;
+	uint8_t key[16];
+
+	for (uint64_t id = 1; id <= 3; ++id)
+	{
+		key_cache_test_key(key, sizeof(key), id);
+		TEST_ASSERT_EQUAL_INT(0, aes_key_cache_get(cache, id, key, AES_128, &ctx));
+		TEST_ASSERT_EQUAL_INT(0, ctx.has_dec_round_keys);
+	}
+
+	// Touch 1, so that 2 becomes the least recently used key
+	TEST_ASSERT_EQUAL_INT(0, aes_key_cache_get(cache, 1, NULL, 0, &ctx));
+
+	key_cache_test_key(key, sizeof(key), 4);
+	TEST_ASSERT_EQUAL_INT(0, aes_key_cache_get(cache, 4, key, AES_128, &ctx));
+
+	TEST_ASSERT_NOT_EQUAL(0, aes_key_cache_get(cache, 2, NULL, 0, &ctx));
+	TEST_ASSERT_EQUAL_INT(0, aes_key_cache_get(cache, 1, NULL, 0, &ctx));
+	TEST_ASSERT_EQUAL_INT(0, aes_key_cache_get(cache, 3, NULL, 0, &ctx));
+	TEST_ASSERT_EQUAL_INT(0, aes_key_cache_get(cache, 4, NULL, 0, &ctx));
+
+	aes_context_t expected;
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init_encrypt(&expected, key, AES_128));
+	TEST_ASSERT_EQUAL_MEMORY(expected.enc_round_keys, ctx.enc_round_keys, AES_128_NUM_ROUND_KEYS * sizeof(__m128i));
+
+	aes_key_cache_stats(cache, &stats);
+	TEST_ASSERT_EQUAL_UINT64(1, stats.evictions);
+	TEST_ASSERT_EQUAL_size_t(3, stats.count);
+
+	aes_key_cache_destroy(cache);
+}
+
+/**
+ * @brief Worker looking up a shared set of keys larger than the cache.
+ */
+static void* key_cache_test_worker(void* arg)
+{
+	aes_key_cache_t* cache = (aes_key_cache_t*)arg;
+	uint8_t key[32];
+	aes_context_t ctx;
+	aes_context_t expected;
+	uintptr_t failures = 0;
+
+	for (unsigned i = 0; i < KEY_CACHE_TEST_LOOKUPS; ++i)
+	{
+		uint64_t id = (i * 7919u) % KEY_CACHE_TEST_KEYS;
+		key_cache_test_key(key, sizeof(key), id);
+		aes_context_init(&expected, key, AES_256);
+
+		if (aes_key_cache_get(cache, id, key, AES_256, &ctx) != 0
+			|| memcmp(expected.enc_round_keys, ctx.enc_round_keys, sizeof(ctx.enc_round_keys)) != 0
+			|| memcmp(expected.dec_round_keys, ctx.dec_round_keys, sizeof(ctx.dec_round_keys)) != 0)
+			failures++;
+	}
+
+	return (void*)failures;
+}
+
+void test_key_cache_concurrent_lookups(void)
+{
+	aes_key_cache_t* cache = aes_key_cache_create(KEY_CACHE_TEST_KEYS / 2, 4, 0);
+	TEST_ASSERT_NOT_NULL(cache);
+
+	pthread_t threads[KEY_CACHE_TEST_THREADS];
+	for (int i = 0; i < KEY_CACHE_TEST_THREADS; ++i)
+		TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, key_cache_test_worker, cache));
+
+	for (int i = 0; i < KEY_CACHE_TEST_THREADS; ++i)
+	{
+		void* failures;
+		pthread_join(threads[i], &failures);
+		TEST_ASSERT_EQUAL_UINT((uintptr_t)0, (uintptr_t)failures);
+	}
+
+	aes_key_cache_stats_t stats;
+	aes_key_cache_stats(cache, &stats);
+	TEST_ASSERT_EQUAL_UINT64(KEY_CACHE_TEST_THREADS * KEY_CACHE_TEST_LOOKUPS, stats.hits + stats.misses);
+	TEST_ASSERT_TRUE(stats.count <= KEY_CACHE_TEST_KEYS / 2);
+
+	aes_key_cache_destroy(cache);
+}
+
+void register_aes_key_cache_tests(void)
+{
+	RUN_TEST(test_key_cache_create_invalid);
+	RUN_TEST(test_key_cache_hits_and_misses);
+	RUN_TEST(test_key_cache_evicts_least_recently_used);
+	RUN_TEST(test_key_cache_concurrent_lookups);
+}
\ No newline at end of file
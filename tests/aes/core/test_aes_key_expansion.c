@@ -232,6 +232,45 @@ void test_aes256_invert_round_keys(void)
 	}
 }
 
+void test_key_expansion_x4_matches_single(void)
+{
+	// Four different keys per size; every lane must match the single-key schedule
+	__m128i user_keys[AES_KEY_EXPANSION_LANES][2];
+	__m128i schedules[AES_KEY_EXPANSION_LANES][AES_256_NUM_ROUND_KEYS];
+	__m128i* outputs[AES_KEY_EXPANSION_LANES];
+	__m128i keys128[AES_KEY_EXPANSION_LANES];
+	__m128i expected[AES_256_NUM_ROUND_KEYS];
+
+	for (int j = 0; j < AES_KEY_EXPANSION_LANES; ++j)
+	{
+		user_keys[j][0] = _mm_set_epi32(0x01234567 * (j + 1), 0x3c4fcf09 ^ j, 0x7f6e5d4c + j, 0x2b7e1516 * (j + 3));
+		user_keys[j][1] = _mm_set_epi32(0x0f1e2d3c - j, 0x55aa55aa ^ (j << 8), 0x13579bdf + j, 0x8e73b0f7 * (j + 5));
+		keys128[j] = user_keys[j][0];
+		outputs[j] = schedules[j];
+	}
+
+	aes128_key_expansion_x4(keys128, outputs);
+	for (int j = 0; j < AES_KEY_EXPANSION_LANES; ++j)
+	{
+		aes128_key_expansion(keys128[j], expected);
+		TEST_ASSERT_EQUAL_MEMORY(expected, schedules[j], AES_128_NUM_ROUND_KEYS * sizeof(__m128i));
+	}
+
+	aes192_key_expansion_x4(user_keys, outputs);
+	for (int j = 0; j < AES_KEY_EXPANSION_LANES; ++j)
+	{
+		aes192_key_expansion(user_keys[j], expected);
+		TEST_ASSERT_EQUAL_MEMORY(expected, schedules[j], AES_192_NUM_ROUND_KEYS * sizeof(__m128i));
+	}
+
+	aes256_key_expansion_x4(user_keys, outputs);
+	for (int j = 0; j < AES_KEY_EXPANSION_LANES; ++j)
+	{
+		aes256_key_expansion(user_keys[j], expected);
+		TEST_ASSERT_EQUAL_MEMORY(expected, schedules[j], AES_256_NUM_ROUND_KEYS * sizeof(__m128i));
+	}
+}
+
 void register_aes_key_expansion_tests(void)
 {
 	RUN_TEST(test_aes128_key_expansion);
@@ -240,4 +279,5 @@ void register_aes_key_expansion_tests(void)
 	RUN_TEST(test_aes128_invert_round_keys);
 	RUN_TEST(test_aes192_invert_round_keys);
 	RUN_TEST(test_aes256_invert_round_keys);
+	RUN_TEST(test_key_expansion_x4_matches_single);
 }
\ No newline at end of file
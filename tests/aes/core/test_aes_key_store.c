@@ -0,0 +1,229 @@
+#include "unity/unity.h"
+#include "aes/core/aes_key_store.h"
+#include "aes/modes/aes_ecb.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#endif
+
+#define KEY_STORE_TEST_PATH "test_aes_key_store.tmp"
+#define KEY_STORE_TEST_KEYS 40
+
+/**
+ * @brief Initializes test contexts of every key size, some of them encrypt-only.
+ */
+static void key_store_test_contexts(aes_context_t* ctxs)
+{
+	static const size_t key_sizes[] = {AES_128, AES_192, AES_256};
+	uint8_t key[32];
+
+	for (size_t i = 0; i < KEY_STORE_TEST_KEYS; ++i)
+	{
+		for (size_t j = 0; j < sizeof(key); ++j)
+			key[j] = (uint8_t)(i * 17 + j);
+
+		if (i % 2)
+			TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctxs[i], key, key_sizes[i % 3]));
+		else
+			TEST_ASSERT_EQUAL_INT(0, aes_context_init_encrypt(&ctxs[i], key, key_sizes[i % 3]));
+	}
+}
+
+/**
+ * @brief Checks that a stored context encrypts (and decrypts) like the original.
+ */
+static void check_stored_context(const aes_context_t* stored, aes_context_t* original, int encrypt_only)
+{
+	uint8_t plaintext[4 * AES_BLOCK_SIZE];
+	uint8_t expected[sizeof(plaintext)];
+	uint8_t actual[sizeof(plaintext)];
+
+	for (size_t i = 0; i < sizeof(plaintext); ++i)
+		plaintext[i] = (uint8_t)i;
+
+	TEST_ASSERT_NOT_NULL(stored);
+	TEST_ASSERT_EQUAL_INT(original->key_size, stored->key_size);
+
+	aes_ecb_encrypt(original, plaintext, sizeof(plaintext), expected);
+	aes_ecb_encrypt(stored, plaintext, sizeof(plaintext), actual);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, actual, sizeof(expected));
+
+	if (encrypt_only)
+	{
+		TEST_ASSERT_EQUAL_INT(0, stored->has_dec_round_keys);
+		return;
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_prepare_decrypt(original));
+	aes_ecb_decrypt(stored, expected, sizeof(expected), actual);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, actual, sizeof(plaintext));
+}
+
+void test_key_store_round_trip(void)
+{
+	aes_context_t ctxs[KEY_STORE_TEST_KEYS];
+	key_store_test_contexts(ctxs);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_key_store_write(KEY_STORE_TEST_PATH, ctxs, KEY_STORE_TEST_KEYS, 0));
+
+	aes_key_store_t* store = aes_key_store_open(KEY_STORE_TEST_PATH, AES_KEY_STORE_VERIFY);
+	TEST_ASSERT_NOT_NULL(store);
+	TEST_ASSERT_EQUAL_size_t(KEY_STORE_TEST_KEYS, aes_key_store_count(store));
+
+	for (size_t i = 0; i < KEY_STORE_TEST_KEYS; ++i)
+	{
+		const aes_context_t* stored = aes_key_store_get(store, i);
+		TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)stored % 64);
+		check_stored_context(stored, &ctxs[i], 0);
+
+		// Later lookups return the same context
+		TEST_ASSERT_EQUAL_PTR(stored, aes_key_store_get(store, i));
+	}
+	TEST_ASSERT_NULL(aes_key_store_get(store, KEY_STORE_TEST_KEYS));
+
+	aes_key_store_close(store);
+	remove(KEY_STORE_TEST_PATH);
+}
+
+void test_key_store_encrypt_only(void)
+{
+	aes_context_t ctxs[KEY_STORE_TEST_KEYS];
+	key_store_test_contexts(ctxs);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_key_store_write(KEY_STORE_TEST_PATH, ctxs, KEY_STORE_TEST_KEYS, AES_KEY_STORE_ENCRYPT_ONLY));
+
+	aes_key_store_t* store = aes_key_store_open(KEY_STORE_TEST_PATH, 0);
+	TEST_ASSERT_NOT_NULL(store);
+	TEST_ASSERT_EQUAL_size_t(KEY_STORE_TEST_KEYS, aes_key_store_count(store));
+
+	for (size_t i = 0; i < KEY_STORE_TEST_KEYS; ++i)
+		check_stored_context(aes_key_store_get(store, i), &ctxs[i], 1);
+
+	// Stores hold encryption schedules only
+	const uint8_t input[AES_BLOCK_SIZE] = {1};
+	uint8_t output[AES_BLOCK_SIZE] = {0};
+	aes_ecb_decrypt(aes_key_store_get(store, 1), input, sizeof(input), output);
+	TEST_ASSERT_EACH_EQUAL_UINT8(0, output, sizeof(output));
+
+	aes_key_store_close(store);
+	remove(KEY_STORE_TEST_PATH);
+}
+
+void test_key_store_rejects_corruption(void)
+{
+	aes_context_t ctxs[KEY_STORE_TEST_KEYS];
+	key_store_test_contexts(ctxs);
+
+	TEST_ASSERT_NOT_EQUAL(0, aes_key_store_write(NULL, ctxs, 1, 0));
+	TEST_ASSERT_NOT_EQUAL(0, aes_key_store_write(KEY_STORE_TEST_PATH, NULL, 1, 0));
+	TEST_ASSERT_NOT_EQUAL(0, aes_key_store_write(KEY_STORE_TEST_PATH, ctxs, 1, 0x80));
+	TEST_ASSERT_NULL(aes_key_store_open("missing_aes_key_store.tmp", 0));
+	TEST_ASSERT_NULL(aes_key_store_open(KEY_STORE_TEST_PATH, 0x80));
+	TEST_ASSERT_EQUAL_size_t(0, aes_key_store_count(NULL));
+	TEST_ASSERT_NULL(aes_key_store_get(NULL, 0));
+	aes_key_store_close(NULL);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_key_store_write(KEY_STORE_TEST_PATH, ctxs, KEY_STORE_TEST_KEYS, 0));
+
+	FILE* file = fopen(KEY_STORE_TEST_PATH, "r+b");
+	TEST_ASSERT_NOT_NULL(file);
+
+	// A flipped record bit is only caught by full verification
+	uint8_t byte;
+	TEST_ASSERT_EQUAL_INT(0, fseek(file, 64 + 100, SEEK_SET));
+	TEST_ASSERT_EQUAL_size_t(1, fread(&byte, 1, 1, file));
+	byte ^= 1;
+	TEST_ASSERT_EQUAL_INT(0, fseek(file, 64 + 100, SEEK_SET));
+	TEST_ASSERT_EQUAL_size_t(1, fwrite(&byte, 1, 1, file));
+	fflush(file);
+
+	aes_key_store_t* store = aes_key_store_open(KEY_STORE_TEST_PATH, 0);
+	TEST_ASSERT_NOT_NULL(store);
+	aes_key_store_close(store);
+	TEST_ASSERT_NULL(aes_key_store_open(KEY_STORE_TEST_PATH, AES_KEY_STORE_VERIFY));
+
+	// A flipped header bit is always caught
+	TEST_ASSERT_EQUAL_INT(0, fseek(file, 24, SEEK_SET));
+	TEST_ASSERT_EQUAL_size_t(1, fread(&byte, 1, 1, file));
+	byte ^= 1;
+	TEST_ASSERT_EQUAL_INT(0, fseek(file, 24, SEEK_SET));
+	TEST_ASSERT_EQUAL_size_t(1, fwrite(&byte, 1, 1, file));
+	fclose(file);
+
+	TEST_ASSERT_NULL(aes_key_store_open(KEY_STORE_TEST_PATH, 0));
+	remove(KEY_STORE_TEST_PATH);
+
+	// Truncated file
+	TEST_ASSERT_EQUAL_INT(0, aes_key_store_write(KEY_STORE_TEST_PATH, ctxs, KEY_STORE_TEST_KEYS, 0));
+	file = fopen(KEY_STORE_TEST_PATH, "rb");
+	TEST_ASSERT_NOT_NULL(file);
+	static uint8_t contents[64 + KEY_STORE_TEST_KEYS * 512];
+	size_t size = fread(contents, 1, sizeof(contents), file);
+	fclose(file);
+	TEST_ASSERT_EQUAL_size_t(sizeof(contents), size);
+
+	file = fopen(KEY_STORE_TEST_PATH, "wb");
+	TEST_ASSERT_NOT_NULL(file);
+	TEST_ASSERT_EQUAL_size_t(1, fwrite(contents, size - 512, 1, file));
+	fclose(file);
+
+	TEST_ASSERT_NULL(aes_key_store_open(KEY_STORE_TEST_PATH, 0));
+	remove(KEY_STORE_TEST_PATH);
+}
+
+void test_key_store_empty(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, aes_key_store_write(KEY_STORE_TEST_PATH, NULL, 0, 0));
+
+	aes_key_store_t* store = aes_key_store_open(KEY_STORE_TEST_PATH, AES_KEY_STORE_VERIFY);
+	TEST_ASSERT_NOT_NULL(store);
+	TEST_ASSERT_EQUAL_size_t(0, aes_key_store_count(store));
+	TEST_ASSERT_NULL(aes_key_store_get(store, 0));
+
+	aes_key_store_close(store);
+	remove(KEY_STORE_TEST_PATH);
+}
+
+void test_key_store_replace_while_open(void)
+{
+	aes_context_t ctxs[KEY_STORE_TEST_KEYS];
+	key_store_test_contexts(ctxs);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_key_store_write(KEY_STORE_TEST_PATH, ctxs, KEY_STORE_TEST_KEYS, 0));
+	aes_key_store_t* old_store = aes_key_store_open(KEY_STORE_TEST_PATH, 0);
+	TEST_ASSERT_NOT_NULL(old_store);
+
+#if defined(__unix__) || defined(__APPLE__)
+	// Schedules start with the raw keys
+	struct stat info;
+	TEST_ASSERT_EQUAL_INT(0, stat(KEY_STORE_TEST_PATH, &info));
+	TEST_ASSERT_EQUAL_INT(0, info.st_mode & 077);
+#endif
+
+	// A smaller store replaces the file; the pages of the old one were never touched
+	TEST_ASSERT_EQUAL_INT(0, aes_key_store_write(KEY_STORE_TEST_PATH, ctxs + 1, 2, AES_KEY_STORE_ENCRYPT_ONLY));
+
+	for (size_t i = 0; i < KEY_STORE_TEST_KEYS; ++i)
+		check_stored_context(aes_key_store_get(old_store, i), &ctxs[i], 0);
+	aes_key_store_close(old_store);
+
+	aes_key_store_t* new_store = aes_key_store_open(KEY_STORE_TEST_PATH, AES_KEY_STORE_VERIFY);
+	TEST_ASSERT_NOT_NULL(new_store);
+	TEST_ASSERT_EQUAL_size_t(2, aes_key_store_count(new_store));
+	check_stored_context(aes_key_store_get(new_store, 0), &ctxs[1], 1);
+	check_stored_context(aes_key_store_get(new_store, 1), &ctxs[2], 1);
+
+	aes_key_store_close(new_store);
+	remove(KEY_STORE_TEST_PATH);
+}
+
+void register_aes_key_store_tests(void)
+{
+	RUN_TEST(test_key_store_round_trip);
+	RUN_TEST(test_key_store_encrypt_only);
+	RUN_TEST(test_key_store_rejects_corruption);
+	RUN_TEST(test_key_store_empty);
+	RUN_TEST(test_key_store_replace_while_open);
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "unity/unity.h"
+#include "aes/core/aes_vaes.h"
+#include "aes/core/aes_encrypt.h"
+#include "aes/core/aes_decrypt.h"
+#include "aes/core/aes_key_expansion.h"
+#include "aes/core/aes_dispatch.h"
+
+// 77 blocks = 2 full 32-block iterations + 3 registers + 1 single block (VAES-512)
+#define VAES_TEST_BLOCKS 77
+
+static int cpu_has_vaes256(void)
+{
+	return aes_dispatch_is_supported(AES_IMPL_VAES256);
+}
+
+static int cpu_has_vaes512(void)
+{
+	return aes_dispatch_is_supported(AES_IMPL_VAES512);
+}
+
+static void fill_blocks(__m128i* blocks, size_t num_blocks)
+{
+	for (size_t i = 0; i < num_blocks; ++i)
+		blocks[i] = _mm_set_epi32((int)i, (int)(i * 3), (int)(i * 7), (int)(i ^ 0x5a5a5a5a));
+}
+
+void test_aes128_blocks_vaes256(void)
+{
+	if (!cpu_has_vaes256())
+		TEST_IGNORE_MESSAGE("VAES-256 not supported by this CPU");
+
+	const __m128i key = _mm_setr_epi8(
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f
+	);
+
+	__m128i enc_round_keys[AES_128_NUM_ROUND_KEYS];
+	__m128i dec_round_keys[AES_128_NUM_ROUND_KEYS];
+	aes128_key_expansion(key, enc_round_keys);
+	aes128_invert_round_keys(enc_round_keys, dec_round_keys);
+
+	__m128i input[VAES_TEST_BLOCKS], expected[VAES_TEST_BLOCKS], output[VAES_TEST_BLOCKS];
+	fill_blocks(input, VAES_TEST_BLOCKS);
+
+	aes128_encrypt_blocks(input, expected, VAES_TEST_BLOCKS, enc_round_keys);
+	aes128_encrypt_blocks_vaes256(input, output, VAES_TEST_BLOCKS, enc_round_keys);
+	TEST_ASSERT_EQUAL_MEMORY(expected, output, sizeof(expected));
+
+	aes128_decrypt_blocks(input, expected, VAES_TEST_BLOCKS, dec_round_keys);
+	aes128_decrypt_blocks_vaes256(input, output, VAES_TEST_BLOCKS, dec_round_keys);
+	TEST_ASSERT_EQUAL_MEMORY(expected, output, sizeof(expected));
+}
+
+void test_aes192_blocks_vaes512(void)
+{
+	if (!cpu_has_vaes512())
+		TEST_IGNORE_MESSAGE("VAES-512 not supported by this CPU");
+
+	const __m128i user_key[2] = {
+		_mm_setr_epi8(0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f),
+		_mm_setr_epi8(0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 )
+	};
+
+	__m128i enc_round_keys[AES_192_NUM_ROUND_KEYS];
+	__m128i dec_round_keys[AES_192_NUM_ROUND_KEYS];
+	aes192_key_expansion(user_key, enc_round_keys);
+	aes192_invert_round_keys(enc_round_keys, dec_round_keys);
+
+	__m128i input[VAES_TEST_BLOCKS], expected[VAES_TEST_BLOCKS], output[VAES_TEST_BLOCKS];
+	fill_blocks(input, VAES_TEST_BLOCKS);
+
+	aes192_encrypt_blocks(input, expected, VAES_TEST_BLOCKS, enc_round_keys);
+	aes192_encrypt_blocks_vaes512(input, output, VAES_TEST_BLOCKS, enc_round_keys);
+	TEST_ASSERT_EQUAL_MEMORY(expected, output, sizeof(expected));
+
+	aes192_decrypt_blocks(input, expected, VAES_TEST_BLOCKS, dec_round_keys);
+	aes192_decrypt_blocks_vaes512(input, output, VAES_TEST_BLOCKS, dec_round_keys);
+	TEST_ASSERT_EQUAL_MEMORY(expected, output, sizeof(expected));
+}
+
+void test_aes256_blocks_vaes512(void)
+{
+	if (!cpu_has_vaes512())
+		TEST_IGNORE_MESSAGE("VAES-512 not supported by this CPU");
+
+	const __m128i user_key[2] = {
+		_mm_setr_epi8(0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f),
+		_mm_setr_epi8(0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f)
+	};
+
+	__m128i enc_round_keys[AES_256_NUM_ROUND_KEYS];
+	__m128i dec_round_keys[AES_256_NUM_ROUND_KEYS];
+	aes256_key_expansion(user_key, enc_round_keys);
+	aes256_invert_round_keys(enc_round_keys, dec_round_keys);
+
+	__m128i input[VAES_TEST_BLOCKS], expected[VAES_TEST_BLOCKS], output[VAES_TEST_BLOCKS];
+	fill_blocks(input, VAES_TEST_BLOCKS);
+
+	aes256_encrypt_blocks(input, expected, VAES_TEST_BLOCKS, enc_round_keys);
+	aes256_encrypt_blocks_vaes512(input, output, VAES_TEST_BLOCKS, enc_round_keys);
+	TEST_ASSERT_EQUAL_MEMORY(expected, output, sizeof(expected));
+
+	// In place
+	aes256_decrypt_blocks(input, expected, VAES_TEST_BLOCKS, dec_round_keys);
+	aes256_decrypt_blocks_vaes512(input, input, VAES_TEST_BLOCKS, dec_round_keys);
+	TEST_ASSERT_EQUAL_MEMORY(expected, input, sizeof(expected));
+}
+
+void register_aes_vaes_tests(void)
+{
+	RUN_TEST(test_aes128_blocks_vaes256);
+	RUN_TEST(test_aes192_blocks_vaes512);
+	RUN_TEST(test_aes256_blocks_vaes512);
+}
\ No newline at end of file
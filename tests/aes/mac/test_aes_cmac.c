@@ -0,0 +1,247 @@
+#include "unity/unity.h"
+#include "aes/mac/aes_cmac.h"
+#include <string.h>
+
+// RFC 4493 example message (64 bytes)
+static const uint8_t rfc4493_message[64] = {
+	0x6b, 0xc1, 0xbe, 0xe2,
+	0x2e, 0x40, 0x9f, 0x96,
+	0xe9, 0x3d, 0x7e, 0x11,
+	0x73, 0x93, 0x17, 0x2a,
+	0xae, 0x2d, 0x8a, 0x57,
+	0x1e, 0x03, 0xac, 0x9c,
+	0x9e, 0xb7, 0x6f, 0xac,
+	0x45, 0xaf, 0x8e, 0x51,
+	0x30, 0xc8, 0x1c, 0x46,
+	0xa3, 0x5c, 0xe4, 0x11,
+	0xe5, 0xfb, 0xc1, 0x19,
+	0x1a, 0x0a, 0x52, 0xef,
+	0xf6, 0x9f, 0x24, 0x45,
+	0xdf, 0x4f, 0x9b, 0x17,
+	0xad, 0x2b, 0x41, 0x7b,
+	0xe6, 0x6c, 0x37, 0x10
+};
+
+static void fill_message(uint8_t* data, size_t len, size_t seed)
+{
+	for (size_t i = 0; i < len; ++i)
+		data[i] = (uint8_t)(i * 29 + seed * 7 + 1);
+}
+
+void test_cmac_rfc4493(void)
+{
+	// RFC 4493 section 4: subkeys and examples 1 to 4
+	const uint8_t key[16] = {
+		0x2b, 0x7e, 0x15, 0x16,
+		0x28, 0xae, 0xd2, 0xa6,
+		0xab, 0xf7, 0x15, 0x88,
+		0x09, 0xcf, 0x4f, 0x3c
+	};
+
+	const uint8_t expected_k1[16] = {
+		0xfb, 0xee, 0xd6, 0x18,
+		0x35, 0x71, 0x33, 0x66,
+		0x7c, 0x85, 0xe0, 0x8f,
+		0x72, 0x36, 0xa8, 0xde
+	};
+
+	const uint8_t expected_k2[16] = {
+		0xf7, 0xdd, 0xac, 0x30,
+		0x6a, 0xe2, 0x66, 0xcc,
+		0xf9, 0x0b, 0xc1, 0x1e,
+		0xe4, 0x6d, 0x51, 0x3b
+	};
+
+	const uint8_t expected[4][16] = {
+		{0xbb, 0x1d, 0x69, 0x29, 0xe9, 0x59, 0x37, 0x28, 0x7f, 0xa3, 0x7d, 0x12, 0x9b, 0x75, 0x67, 0x46},
+		{0x07, 0x0a, 0x16, 0xb4, 0x6b, 0x4d, 0x41, 0x44, 0xf7, 0x9b, 0xdd, 0x9d, 0xd0, 0x4a, 0x28, 0x7c},
+		{0xdf, 0xa6, 0x67, 0x47, 0xde, 0x9a, 0xe6, 0x30, 0x30, 0xca, 0x32, 0x61, 0x14, 0x97, 0xc8, 0x27},
+		{0x51, 0xf0, 0xbe, 0xbf, 0x7e, 0x3b, 0x9d, 0x92, 0xfc, 0x49, 0x74, 0x17, 0x79, 0x36, 0x3c, 0xfe}
+	};
+
+	const size_t lengths[4] = {0, 16, 40, 64};
+	uint8_t subkey[16];
+	uint8_t tag[16];
+	aes_context_t ctx;
+	aes_cmac_key_t cmac_key;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_cmac_key_init(&cmac_key, &ctx));
+
+	_mm_storeu_si128((__m128i*)subkey, cmac_key.k1);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_k1, subkey, 16);
+	_mm_storeu_si128((__m128i*)subkey, cmac_key.k2);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_k2, subkey, 16);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		TEST_ASSERT_EQUAL_INT(0, aes_cmac(&cmac_key, rfc4493_message, lengths[i], tag));
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(expected[i], tag, 16);
+	}
+}
+
+void test_cmac_256(void)
+{
+	// NIST SP 800-38B appendix D.3, examples 9 and 12
+	const uint8_t key[32] = {
+		0x60, 0x3d, 0xeb, 0x10,
+		0x15, 0xca, 0x71, 0xbe,
+		0x2b, 0x73, 0xae, 0xf0,
+		0x85, 0x7d, 0x77, 0x81,
+		0x1f, 0x35, 0x2c, 0x07,
+		0x3b, 0x61, 0x08, 0xd7,
+		0x2d, 0x98, 0x10, 0xa3,
+		0x09, 0x14, 0xdf, 0xf4
+	};
+
+	const uint8_t expected_empty[16] = {
+		0x02, 0x89, 0x62, 0xf6,
+		0x1b, 0x7b, 0xf8, 0x9e,
+		0xfc, 0x6b, 0x55, 0x1f,
+		0x46, 0x67, 0xd9, 0x83
+	};
+
+	const uint8_t expected_64[16] = {
+		0xe1, 0x99, 0x21, 0x90,
+		0x54, 0x9f, 0x6e, 0xd5,
+		0x69, 0x6a, 0x2c, 0x05,
+		0x6c, 0x31, 0x54, 0x10
+	};
+
+	uint8_t tag[16];
+	aes_context_t ctx;
+	aes_cmac_key_t cmac_key;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+	TEST_ASSERT_EQUAL_INT(0, aes_cmac_key_init(&cmac_key, &ctx));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_cmac(&cmac_key, NULL, 0, tag));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_empty, tag, 16);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_cmac(&cmac_key, rfc4493_message, 64, tag));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_64, tag, 16);
+}
+
+void test_cmac_incremental(void)
+{
+	const uint8_t key[16] = {
+		0x2b, 0x7e, 0x15, 0x16,
+		0x28, 0xae, 0xd2, 0xa6,
+		0xab, 0xf7, 0x15, 0x88,
+		0x09, 0xcf, 0x4f, 0x3c
+	};
+
+	uint8_t message[100];
+	uint8_t expected[16];
+	uint8_t tag[16];
+	aes_context_t ctx;
+	aes_cmac_key_t cmac_key;
+	aes_cmac_t cmac;
+
+	fill_message(message, sizeof(message), 0);
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_cmac_key_init(&cmac_key, &ctx));
+
+	// Part sizes that end exactly on, just before and just after block boundaries
+	const size_t lengths[] = {0, 16, 32, 33, 48, 100};
+	const size_t part_sizes[] = {1, 7, 15, 16, 17, 50};
+	for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l)
+	{
+		TEST_ASSERT_EQUAL_INT(0, aes_cmac(&cmac_key, message, lengths[l], expected));
+
+		for (size_t p = 0; p < sizeof(part_sizes) / sizeof(part_sizes[0]); ++p)
+		{
+			TEST_ASSERT_EQUAL_INT(0, aes_cmac_init(&cmac, &cmac_key));
+			for (size_t offset = 0; offset < lengths[l]; offset += part_sizes[p])
+			{
+				size_t len = lengths[l] - offset < part_sizes[p] ? lengths[l] - offset : part_sizes[p];
+				TEST_ASSERT_EQUAL_INT(0, aes_cmac_update(&cmac, message + offset, len));
+			}
+			TEST_ASSERT_EQUAL_INT(0, aes_cmac_final(&cmac, tag));
+			TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, tag, 16);
+		}
+	}
+}
+
+void test_cmac_batch_matches_single(void)
+{
+	const uint8_t key[24] = {
+		0x8e, 0x73, 0xb0, 0xf7,
+		0xda, 0x0e, 0x64, 0x52,
+		0xc8, 0x10, 0xf3, 0x2b,
+		0x80, 0x90, 0x79, 0xe5,
+		0x62, 0xf8, 0xea, 0xd2,
+		0x52, 0x2c, 0x6b, 0x7b
+	};
+
+	// 13 messages: one group of 8 lanes, then one of 4 lanes with one idle lane
+	enum { COUNT = 13, MAX_LEN = 80 };
+	const size_t lengths[COUNT] = {0, 1, 16, 17, 32, 80, 5, 48, 64, 15, 0, 33, 79};
+	uint8_t messages[COUNT][MAX_LEN];
+	const uint8_t* pointers[COUNT];
+	uint8_t tags[COUNT][AES_CMAC_SIZE];
+	uint8_t expected[AES_CMAC_SIZE];
+	aes_context_t ctx;
+	aes_cmac_key_t cmac_key;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_192));
+	TEST_ASSERT_EQUAL_INT(0, aes_cmac_key_init(&cmac_key, &ctx));
+
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		fill_message(messages[i], MAX_LEN, i);
+		pointers[i] = messages[i];
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, aes_cmac_batch(&cmac_key, pointers, lengths, COUNT, tags));
+
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		TEST_ASSERT_EQUAL_INT(0, aes_cmac(&cmac_key, messages[i], lengths[i], expected));
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, tags[i], AES_CMAC_SIZE);
+	}
+
+	// Single message and empty batch
+	TEST_ASSERT_EQUAL_INT(0, aes_cmac_batch(&cmac_key, pointers + 5, lengths + 5, 1, tags));
+	TEST_ASSERT_EQUAL_INT(0, aes_cmac(&cmac_key, messages[5], lengths[5], expected));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, tags[0], AES_CMAC_SIZE);
+	TEST_ASSERT_EQUAL_INT(0, aes_cmac_batch(&cmac_key, NULL, NULL, 0, NULL));
+}
+
+void test_cmac_verify(void)
+{
+	const uint8_t key[16] = {
+		0x2b, 0x7e, 0x15, 0x16,
+		0x28, 0xae, 0xd2, 0xa6,
+		0xab, 0xf7, 0x15, 0x88,
+		0x09, 0xcf, 0x4f, 0x3c
+	};
+
+	uint8_t tag[16];
+	aes_context_t ctx;
+	aes_cmac_key_t cmac_key;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_cmac_key_init(&cmac_key, &ctx));
+	TEST_ASSERT_EQUAL_INT(0, aes_cmac(&cmac_key, rfc4493_message, 40, tag));
+
+	// Full and truncated tags
+	TEST_ASSERT_EQUAL_INT(0, aes_cmac_verify(&cmac_key, rfc4493_message, 40, tag, 16));
+	TEST_ASSERT_EQUAL_INT(0, aes_cmac_verify(&cmac_key, rfc4493_message, 40, tag, 8));
+
+	// Wrong message, wrong tag, invalid tag length
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_cmac_verify(&cmac_key, rfc4493_message, 39, tag, 16));
+	tag[7] ^= 1;
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_cmac_verify(&cmac_key, rfc4493_message, 40, tag, 8));
+	tag[7] ^= 1;
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_cmac_verify(&cmac_key, rfc4493_message, 40, tag, 2));
+}
+
+void register_aes_cmac_tests(void)
+{
+	RUN_TEST(test_cmac_rfc4493);
+	RUN_TEST(test_cmac_256);
+	RUN_TEST(test_cmac_incremental);
+	RUN_TEST(test_cmac_batch_matches_single);
+	RUN_TEST(test_cmac_verify);
+}
\ No newline at end of file
@@ -0,0 +1,262 @@
+#include "unity/unity.h"
+#include "aes/mac/aes_ghash.h"
+#include "aes/modes/aes_gcm.h"
+#include "aes/core/aes_dispatch.h"
+#include <string.h>
+
+// 203 bytes = 3 groups of 8 blocks, 1 block and an 11-byte tail
+#define GHASH_TEST_SIZE 203
+
+static void fill_message(uint8_t* data, size_t len)
+{
+	for (size_t i = 0; i < len; ++i)
+		data[i] = (uint8_t)(i * 13 + 5);
+}
+
+void test_ghash_spec_vector(void)
+{
+	// GCM specification test case 2: GHASH(H, {}, C)
+	const uint8_t h[16] = {
+		0x66, 0xe9, 0x4b, 0xd4,
+		0xef, 0x8a, 0x2c, 0x3b,
+		0x88, 0x4c, 0xfa, 0x59,
+		0xca, 0x34, 0x2b, 0x2e
+	};
+
+	const uint8_t data[32] = {
+		0x03, 0x88, 0xda, 0xce,
+		0x60, 0xb6, 0xa3, 0x92,
+		0xf3, 0x28, 0xc2, 0xb9,
+		0x71, 0xb2, 0xfe, 0x78,
+		0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x80
+	};
+
+	const uint8_t expected[16] = {
+		0xf3, 0x8c, 0xbb, 0x1a,
+		0xd6, 0x92, 0x23, 0xdc,
+		0xc3, 0x45, 0x7a, 0xe5,
+		0xb6, 0xb0, 0xf8, 0x85
+	};
+
+	uint8_t digest[AES_GHASH_SIZE];
+	aes_ghash_key_t key;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash_key_init_raw(&key, h));
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash(&key, data, sizeof(data), digest));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, AES_GHASH_SIZE);
+}
+
+void test_ghash_key_from_context(void)
+{
+	const uint8_t aes_key[16] = {0};
+	const uint8_t h[16] = {
+		0x66, 0xe9, 0x4b, 0xd4,
+		0xef, 0x8a, 0x2c, 0x3b,
+		0x88, 0x4c, 0xfa, 0x59,
+		0xca, 0x34, 0x2b, 0x2e
+	};
+
+	uint8_t data[GHASH_TEST_SIZE], expected[AES_GHASH_SIZE], digest[AES_GHASH_SIZE];
+	aes_ghash_key_t raw_key, ctx_key;
+	aes_context_t ctx;
+
+	fill_message(data, sizeof(data));
+
+	// H = E(0^128, 0^128)
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, aes_key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash_key_init(&ctx_key, &ctx));
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash_key_init_raw(&raw_key, h));
+	TEST_ASSERT_EQUAL_MEMORY(raw_key.h_powers, ctx_key.h_powers, sizeof(raw_key.h_powers));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash(&raw_key, data, sizeof(data), expected));
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash(&ctx_key, data, sizeof(data), digest));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, AES_GHASH_SIZE);
+}
+
+void test_ghash_multi_block(void)
+{
+	const uint8_t h[16] = {
+		0x66, 0xe9, 0x4b, 0xd4,
+		0xef, 0x8a, 0x2c, 0x3b,
+		0x88, 0x4c, 0xfa, 0x59,
+		0xca, 0x34, 0x2b, 0x2e
+	};
+
+	const uint8_t expected[16] = {
+		0x42, 0xcb, 0x2d, 0xe0,
+		0x5a, 0xd6, 0x98, 0xde,
+		0x94, 0x12, 0x5c, 0x7f,
+		0xcb, 0xe6, 0xe9, 0xdb
+	};
+
+	uint8_t data[GHASH_TEST_SIZE], digest[AES_GHASH_SIZE];
+	aes_ghash_key_t key;
+
+	fill_message(data, sizeof(data));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash_key_init_raw(&key, h));
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash(&key, data, sizeof(data), digest));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, AES_GHASH_SIZE);
+}
+
+void test_ghash_incremental(void)
+{
+	const uint8_t h[16] = {
+		0x66, 0xe9, 0x4b, 0xd4,
+		0xef, 0x8a, 0x2c, 0x3b,
+		0x88, 0x4c, 0xfa, 0x59,
+		0xca, 0x34, 0x2b, 0x2e
+	};
+
+	// Uneven parts crossing block and 8-block group boundaries
+	const size_t parts[] = {3, 0, 13, 130, 1, 56};
+
+	uint8_t data[GHASH_TEST_SIZE], expected[AES_GHASH_SIZE], digest[AES_GHASH_SIZE];
+	aes_ghash_key_t key;
+	aes_ghash_t ghash;
+
+	fill_message(data, sizeof(data));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash_key_init_raw(&key, h));
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash(&key, data, sizeof(data), expected));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash_init(&ghash, &key));
+
+	size_t offset = 0;
+	for (size_t i = 0; i < sizeof(parts) / sizeof(parts[0]); ++i)
+	{
+		TEST_ASSERT_EQUAL_INT(0, aes_ghash_update(&ghash, data + offset, parts[i]));
+		offset += parts[i];
+	}
+	TEST_ASSERT_EQUAL_size_t(sizeof(data), offset);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash_final(&ghash, digest));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, AES_GHASH_SIZE);
+}
+
+void test_ghash_vpclmulqdq_matches_pclmulqdq(void)
+{
+	if (!aes_dispatch_is_supported(AES_IMPL_VAES256))
+		TEST_IGNORE_MESSAGE("VAES-256 not supported by this CPU");
+
+	const uint8_t h[16] = {
+		0x66, 0xe9, 0x4b, 0xd4,
+		0xef, 0x8a, 0x2c, 0x3b,
+		0x88, 0x4c, 0xfa, 0x59,
+		0xca, 0x34, 0x2b, 0x2e
+	};
+
+	uint8_t data[GHASH_TEST_SIZE], expected[AES_GHASH_SIZE], digest[AES_GHASH_SIZE];
+	aes_ghash_key_t narrow_key, wide_key;
+
+	fill_message(data, sizeof(data));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_dispatch_set_impl(AES_IMPL_AESNI));
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash_key_init_raw(&narrow_key, h));
+	TEST_ASSERT_EQUAL_INT(0, aes_dispatch_set_impl(AES_IMPL_VAES256));
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash_key_init_raw(&wide_key, h));
+	aes_dispatch_set_impl(AES_IMPL_COUNT);
+
+	TEST_ASSERT_EQUAL_INT(0, narrow_key.vpclmulqdq);
+	if (!wide_key.vpclmulqdq)
+		TEST_IGNORE_MESSAGE("VPCLMULQDQ not supported by this CPU");
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash(&narrow_key, data, sizeof(data), expected));
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash(&wide_key, data, sizeof(data), digest));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, AES_GHASH_SIZE);
+}
+
+void test_gmac(void)
+{
+	const uint8_t key[16] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f
+	};
+
+	const uint8_t iv[12] = {
+		0x10, 0x11, 0x12, 0x13,
+		0x14, 0x15, 0x16, 0x17,
+		0x18, 0x19, 0x1a, 0x1b
+	};
+
+	const uint8_t expected_tag[16] = {
+		0x1b, 0x86, 0x48, 0xe1,
+		0x29, 0x57, 0x3a, 0xbc,
+		0xa5, 0x36, 0xde, 0x5c,
+		0x6c, 0xbb, 0x38, 0x73
+	};
+
+	uint8_t data[GHASH_TEST_SIZE], tag[16];
+	aes_ghash_key_t hkey;
+	aes_context_t ctx;
+
+	fill_message(data, sizeof(data));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash_key_init(&hkey, &ctx));
+	TEST_ASSERT_EQUAL_INT(0, aes_gmac(&ctx, &hkey, iv, sizeof(iv), data, sizeof(data), tag, 16));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, 16);
+	TEST_ASSERT_EQUAL_INT(0, aes_gmac_verify(&ctx, &hkey, iv, sizeof(iv), data, sizeof(data), expected_tag, 16));
+
+	data[100] ^= 0x04;
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_gmac_verify(&ctx, &hkey, iv, sizeof(iv), data, sizeof(data), expected_tag, 16));
+}
+
+void test_gmac_incremental(void)
+{
+	const uint8_t key[16] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f
+	};
+
+	const uint8_t iv[12] = {
+		0x10, 0x11, 0x12, 0x13,
+		0x14, 0x15, 0x16, 0x17,
+		0x18, 0x19, 0x1a, 0x1b
+	};
+
+	const uint8_t expected_tag[16] = {
+		0x1b, 0x86, 0x48, 0xe1,
+		0x29, 0x57, 0x3a, 0xbc,
+		0xa5, 0x36, 0xde, 0x5c,
+		0x6c, 0xbb, 0x38, 0x73
+	};
+
+	uint8_t data[GHASH_TEST_SIZE];
+	aes_gcm_context_t gmac;
+	aes_ghash_key_t hkey;
+	aes_context_t ctx;
+
+	fill_message(data, sizeof(data));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash_key_init(&hkey, &ctx));
+
+	// Stream the message as AAD, in parts
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_init(&gmac, &ctx, &hkey, iv, sizeof(iv)));
+	for (size_t offset = 0; offset < sizeof(data); offset += 50)
+	{
+		size_t len = sizeof(data) - offset < 50 ? sizeof(data) - offset : 50;
+		TEST_ASSERT_EQUAL_INT(0, aes_gcm_update_aad(&gmac, data + offset, len));
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_verify(&gmac, expected_tag, 16));
+}
+
+void register_aes_ghash_tests(void)
+{
+	RUN_TEST(test_ghash_spec_vector);
+	RUN_TEST(test_ghash_key_from_context);
+	RUN_TEST(test_ghash_multi_block);
+	RUN_TEST(test_ghash_incremental);
+	RUN_TEST(test_ghash_vpclmulqdq_matches_pclmulqdq);
+	RUN_TEST(test_gmac);
+	RUN_TEST(test_gmac_incremental);
+}
\ No newline at end of file
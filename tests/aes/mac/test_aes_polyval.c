@@ -0,0 +1,114 @@
+#include "unity/unity.h"
+#include "aes/mac/aes_polyval.h"
+#include <string.h>
+
+// 203 bytes = 3 groups of 8 blocks, 1 block and an 11-byte tail
+#define POLYVAL_TEST_SIZE 203
+
+static void fill_message(uint8_t* data, size_t len)
+{
+	for (size_t i = 0; i < len; ++i)
+		data[i] = (uint8_t)(i * 13 + 5);
+}
+
+void test_polyval_rfc8452(void)
+{
+	// RFC 8452 appendix A
+	const uint8_t h[16] = {
+		0x25, 0x62, 0x93, 0x47,
+		0x58, 0x92, 0x42, 0x76,
+		0x1d, 0x31, 0xf8, 0x26,
+		0xba, 0x4b, 0x75, 0x7b
+	};
+
+	const uint8_t data[32] = {
+		0x4f, 0x4f, 0x95, 0x66,
+		0x8c, 0x83, 0xdf, 0xb6,
+		0x40, 0x17, 0x62, 0xbb,
+		0x2d, 0x01, 0xa2, 0x62,
+		0xd1, 0xa2, 0x4d, 0xdd,
+		0x27, 0x21, 0xd0, 0x06,
+		0xbb, 0xe4, 0x5f, 0x20,
+		0xd3, 0xc9, 0xf3, 0x62
+	};
+
+	const uint8_t expected[16] = {
+		0xf7, 0xa3, 0xb4, 0x7b,
+		0x84, 0x61, 0x19, 0xfa,
+		0xe5, 0xb7, 0x86, 0x6c,
+		0xf5, 0xe5, 0xb7, 0x7e
+	};
+
+	uint8_t digest[16];
+	aes_polyval_key_t key;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_polyval_key_init(&key, h));
+	TEST_ASSERT_EQUAL_INT(0, aes_polyval(&key, data, sizeof(data), digest));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, 16);
+}
+
+void test_polyval_multi_block(void)
+{
+	const uint8_t h[16] = {
+		0x07, 0x12, 0x1d, 0x28,
+		0x33, 0x3e, 0x49, 0x54,
+		0x5f, 0x6a, 0x75, 0x80,
+		0x8b, 0x96, 0xa1, 0xac
+	};
+
+	const uint8_t expected[16] = {
+		0x3b, 0xc3, 0x79, 0x40,
+		0x68, 0xed, 0x8b, 0xeb,
+		0x4d, 0xbd, 0x9f, 0xb3,
+		0xef, 0x72, 0x3c, 0xd5
+	};
+
+	uint8_t data[POLYVAL_TEST_SIZE];
+	uint8_t digest[16];
+	aes_polyval_key_t key;
+
+	fill_message(data, sizeof(data));
+	TEST_ASSERT_EQUAL_INT(0, aes_polyval_key_init(&key, h));
+	TEST_ASSERT_EQUAL_INT(0, aes_polyval(&key, data, sizeof(data), digest));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, 16);
+}
+
+void test_polyval_incremental(void)
+{
+	const uint8_t h[16] = {
+		0x25, 0x62, 0x93, 0x47,
+		0x58, 0x92, 0x42, 0x76,
+		0x1d, 0x31, 0xf8, 0x26,
+		0xba, 0x4b, 0x75, 0x7b
+	};
+
+	const size_t part_sizes[] = {1, 5, 16, 17, 64, 130};
+	uint8_t data[POLYVAL_TEST_SIZE];
+	uint8_t expected[16];
+	uint8_t digest[16];
+	aes_polyval_key_t key;
+	aes_polyval_t polyval;
+
+	fill_message(data, sizeof(data));
+	TEST_ASSERT_EQUAL_INT(0, aes_polyval_key_init(&key, h));
+	TEST_ASSERT_EQUAL_INT(0, aes_polyval(&key, data, sizeof(data), expected));
+
+	for (size_t p = 0; p < sizeof(part_sizes) / sizeof(part_sizes[0]); ++p)
+	{
+		TEST_ASSERT_EQUAL_INT(0, aes_polyval_init(&polyval, &key));
+		for (size_t offset = 0; offset < sizeof(data); offset += part_sizes[p])
+		{
+			size_t len = sizeof(data) - offset < part_sizes[p] ? sizeof(data) - offset : part_sizes[p];
+			TEST_ASSERT_EQUAL_INT(0, aes_polyval_update(&polyval, data + offset, len));
+		}
+		TEST_ASSERT_EQUAL_INT(0, aes_polyval_final(&polyval, digest));
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, digest, 16);
+	}
+}
+
+void register_aes_polyval_tests(void)
+{
+	RUN_TEST(test_polyval_rfc8452);
+	RUN_TEST(test_polyval_multi_block);
+	RUN_TEST(test_polyval_incremental);
+}
\ No newline at end of file
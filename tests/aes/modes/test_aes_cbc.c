@@ -1,6 +1,7 @@
 #include "unity/unity.h"
 #include "aes/modes/aes_cbc.h"
 #include "aes/core/aes_context.h"
+#include <string.h>
 
 void test_cbc_encrypt_128(void)
 {
@@ -290,6 +291,131 @@ void test_cbc_decrypt_256(void)
 	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(expected));
 }
 
+void test_cbc_decrypt_256_multi_block(void)
+{
+	const uint8_t key[32] = {
+		0x60, 0x3d, 0xeb, 0x10,
+		0x15, 0xca, 0x71, 0xbe,
+		0x2b, 0x73, 0xae, 0xf0,
+		0x85, 0x7d, 0x77, 0x81,
+		0x1f, 0x35, 0x2c, 0x07,
+		0x3b, 0x61, 0x08, 0xd7,
+		0x2d, 0x98, 0x10, 0xa3,
+		0x09, 0x14, 0xdf, 0xf4
+	};
+
+	const uint8_t iv[16] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f
+	};
+
+	// 11 blocks: one full 8-block chunk followed by a 3-block chunk
+	const uint8_t ciphertext[176] = {
+		0xe5, 0x68, 0xf6, 0x81, 0x94, 0xcf, 0x76, 0xd6,
+		0x17, 0x4d, 0x4c, 0xc0, 0x43, 0x10, 0xa8, 0x54,
+		0xd0, 0x9e, 0xf9, 0x32, 0xb9, 0xff, 0x12, 0x44,
+		0xec, 0x7a, 0x1d, 0xc1, 0xcc, 0xb1, 0xc6, 0x37,
+		0x57, 0x3b, 0xd2, 0x9f, 0xbd, 0x6f, 0xb3, 0x17,
+		0x98, 0x97, 0xaa, 0x76, 0xa7, 0x0b, 0x55, 0x19,
+		0x28, 0x4f, 0x13, 0x39, 0xbe, 0xc2, 0x00, 0x4d,
+		0xf1, 0xc5, 0x1b, 0x33, 0xb5, 0x6d, 0x39, 0xb4,
+		0xbd, 0xef, 0x8d, 0x50, 0x88, 0x1d, 0x97, 0x79,
+		0x14, 0xe6, 0xc5, 0x7d, 0xd4, 0xc8, 0xc3, 0x41,
+		0x67, 0xd3, 0xc1, 0xc6, 0x9c, 0xc0, 0xcd, 0x1b,
+		0xc7, 0xda, 0xdf, 0x9a, 0x45, 0xac, 0xcc, 0x6d,
+		0xbf, 0x69, 0xe3, 0x22, 0xad, 0x69, 0xdf, 0x01,
+		0x66, 0x7a, 0x13, 0x86, 0xf2, 0x70, 0xea, 0xb4,
+		0xcd, 0xa4, 0x5b, 0x98, 0x6c, 0x91, 0xe9, 0xf7,
+		0xc5, 0xd5, 0xac, 0x9f, 0x61, 0x03, 0xbc, 0x96,
+		0xf9, 0xbd, 0xf4, 0x0d, 0xe5, 0x42, 0x96, 0x11,
+		0x4b, 0x2a, 0x13, 0xed, 0x5e, 0x70, 0x22, 0x6e,
+		0xc5, 0x43, 0x09, 0xc9, 0x36, 0x25, 0x11, 0x09,
+		0x3f, 0x99, 0x79, 0x85, 0x7e, 0x39, 0x53, 0x01,
+		0xa3, 0x36, 0x7e, 0xca, 0x76, 0x95, 0x3c, 0xc0,
+		0x79, 0x43, 0xca, 0x09, 0x1f, 0xf4, 0xc2, 0x33
+	};
+
+	uint8_t expected[176];
+	for (size_t i = 0; i < sizeof(expected); ++i)
+		expected[i] = (uint8_t)i;
+
+	uint8_t output[176] = {0};
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+	aes_cbc_decrypt(&ctx, iv, ciphertext, sizeof(ciphertext), output);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(expected));
+
+	// Decrypt in place
+	memcpy(output, ciphertext, sizeof(ciphertext));
+	aes_cbc_decrypt(&ctx, iv, output, sizeof(output), output);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(expected));
+
+	// Encrypt back
+	aes_cbc_encrypt(&ctx, iv, expected, sizeof(expected), output);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(ciphertext, output, sizeof(ciphertext));
+}
+
+void test_cbc_encrypt_multi(void)
+{
+	// Mixed key sizes and uneven lengths (in blocks), more jobs than lanes
+	enum { NUM_JOBS = 13 };
+	const size_t num_blocks[NUM_JOBS] = { 5, 0, 40, 1, 17, 3, 64, 8, 9, 2, 33, 7, 16 };
+	const size_t key_sizes[NUM_JOBS] = { AES_128, AES_256, AES_128, AES_192, AES_128, AES_256, AES_128, AES_128, AES_192, AES_128, AES_256, AES_128, AES_128 };
+
+	static uint8_t plaintext[NUM_JOBS][64 * 16];
+	static uint8_t expected[NUM_JOBS][64 * 16];
+	static uint8_t output[NUM_JOBS][64 * 16];
+	aes_context_t ctx[NUM_JOBS];
+	uint8_t iv[NUM_JOBS][16];
+	aes_cbc_job_t jobs[NUM_JOBS + 1];
+
+	for (size_t j = 0; j < NUM_JOBS; ++j)
+	{
+		uint8_t key[32];
+		for (size_t i = 0; i < sizeof(key); ++i)
+			key[i] = (uint8_t)(j * 37 + i);
+		for (size_t i = 0; i < sizeof(iv[j]); ++i)
+			iv[j][i] = (uint8_t)(j * 53 + i * 3);
+		for (size_t i = 0; i < sizeof(plaintext[j]); ++i)
+			plaintext[j][i] = (uint8_t)(j * 7 + i * 13);
+
+		TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx[j], key, key_sizes[j]));
+		aes_cbc_encrypt(&ctx[j], iv[j], plaintext[j], num_blocks[j] * 16, expected[j]);
+
+		// Job 4 is encrypted in place
+		if (j == 4)
+			memcpy(output[j], plaintext[j], sizeof(output[j]));
+
+		jobs[j] = (aes_cbc_job_t){ &ctx[j], iv[j], j == 4 ? output[j] : plaintext[j], num_blocks[j] * 16, output[j] };
+	}
+
+	// One invalid job (length not a multiple of 16, then a NULL pointer) fails the whole call
+	uint8_t untouched[32] = {0};
+	jobs[NUM_JOBS] = (aes_cbc_job_t){ &ctx[0], iv[0], plaintext[0], 20, untouched };
+	TEST_ASSERT_NOT_EQUAL(0, aes_cbc_encrypt_multi(jobs, NUM_JOBS + 1));
+	jobs[NUM_JOBS] = (aes_cbc_job_t){ &ctx[0], NULL, plaintext[0], 16, untouched };
+	TEST_ASSERT_NOT_EQUAL(0, aes_cbc_encrypt_multi(jobs, NUM_JOBS + 1));
+	TEST_ASSERT_NOT_EQUAL(0, aes_cbc_encrypt_multi(NULL, NUM_JOBS));
+
+	TEST_ASSERT_EACH_EQUAL_UINT8(0, untouched, sizeof(untouched));
+	for (size_t j = 0; j < NUM_JOBS; ++j)
+	{
+		if (j != 4)
+			TEST_ASSERT_EACH_EQUAL_UINT8(0, output[j], sizeof(output[j]));
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, aes_cbc_encrypt_multi(jobs, NUM_JOBS));
+
+	for (size_t j = 0; j < NUM_JOBS; ++j)
+	{
+		if (num_blocks[j] > 0)
+			TEST_ASSERT_EQUAL_UINT8_ARRAY(expected[j], output[j], num_blocks[j] * 16);
+	}
+}
+
 void register_aes_cbc_tests(void)
 {
 	RUN_TEST(test_cbc_encrypt_128);
@@ -298,4 +424,6 @@ void register_aes_cbc_tests(void)
 	RUN_TEST(test_cbc_decrypt_192);
 	RUN_TEST(test_cbc_encrypt_256);
 	RUN_TEST(test_cbc_decrypt_256);
+	RUN_TEST(test_cbc_decrypt_256_multi_block);
+	RUN_TEST(test_cbc_encrypt_multi);
 }
\ No newline at end of file
@@ -0,0 +1,394 @@
+#include "unity/unity.h"
+#include "aes/modes/aes_ccm.h"
+#include <string.h>
+#include <stdlib.h>
+
+void test_ccm_example_1(void)
+{
+	// NIST SP 800-38C example 1 (7-byte nonce, 4-byte tag)
+	const uint8_t key[16] = {
+		0x40, 0x41, 0x42, 0x43,
+		0x44, 0x45, 0x46, 0x47,
+		0x48, 0x49, 0x4a, 0x4b,
+		0x4c, 0x4d, 0x4e, 0x4f
+	};
+
+	const uint8_t nonce[7] = {
+		0x10, 0x11, 0x12, 0x13,
+		0x14, 0x15, 0x16
+	};
+
+	const uint8_t aad[8] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07
+	};
+
+	const uint8_t plaintext[4] = {
+		0x20, 0x21, 0x22, 0x23
+	};
+
+	const uint8_t expected[4] = {
+		0x71, 0x62, 0x01, 0x5b
+	};
+
+	const uint8_t expected_tag[4] = {
+		0x4d, 0xac, 0x25, 0x5d
+	};
+
+	uint8_t output[4] = {0};
+	uint8_t decrypted[4] = {0};
+	uint8_t tag[4] = {0};
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ccm_encrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad), plaintext, sizeof(plaintext), output, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(expected));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, sizeof(expected_tag));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ccm_decrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad), output, sizeof(output), decrypted, expected_tag, sizeof(expected_tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, sizeof(plaintext));
+}
+
+void test_ccm_example_2(void)
+{
+	// NIST SP 800-38C example 2 (8-byte nonce, 6-byte tag)
+	const uint8_t key[16] = {
+		0x40, 0x41, 0x42, 0x43,
+		0x44, 0x45, 0x46, 0x47,
+		0x48, 0x49, 0x4a, 0x4b,
+		0x4c, 0x4d, 0x4e, 0x4f
+	};
+
+	const uint8_t nonce[8] = {
+		0x10, 0x11, 0x12, 0x13,
+		0x14, 0x15, 0x16, 0x17
+	};
+
+	const uint8_t aad[16] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f
+	};
+
+	const uint8_t plaintext[16] = {
+		0x20, 0x21, 0x22, 0x23,
+		0x24, 0x25, 0x26, 0x27,
+		0x28, 0x29, 0x2a, 0x2b,
+		0x2c, 0x2d, 0x2e, 0x2f
+	};
+
+	const uint8_t expected[16] = {
+		0xd2, 0xa1, 0xf0, 0xe0,
+		0x51, 0xea, 0x5f, 0x62,
+		0x08, 0x1a, 0x77, 0x92,
+		0x07, 0x3d, 0x59, 0x3d
+	};
+
+	const uint8_t expected_tag[6] = {
+		0x1f, 0xc6, 0x4f, 0xbf,
+		0xac, 0xcd
+	};
+
+	uint8_t output[16] = {0};
+	uint8_t decrypted[16] = {0};
+	uint8_t tag[6] = {0};
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ccm_encrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad), plaintext, sizeof(plaintext), output, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(expected));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, sizeof(expected_tag));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ccm_decrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad), output, sizeof(output), decrypted, expected_tag, sizeof(expected_tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, sizeof(plaintext));
+}
+
+void test_ccm_example_3(void)
+{
+	// NIST SP 800-38C example 3 (12-byte nonce, 8-byte tag, partial last block)
+	const uint8_t key[16] = {
+		0x40, 0x41, 0x42, 0x43,
+		0x44, 0x45, 0x46, 0x47,
+		0x48, 0x49, 0x4a, 0x4b,
+		0x4c, 0x4d, 0x4e, 0x4f
+	};
+
+	const uint8_t nonce[12] = {
+		0x10, 0x11, 0x12, 0x13,
+		0x14, 0x15, 0x16, 0x17,
+		0x18, 0x19, 0x1a, 0x1b
+	};
+
+	const uint8_t aad[20] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f,
+		0x10, 0x11, 0x12, 0x13
+	};
+
+	const uint8_t plaintext[24] = {
+		0x20, 0x21, 0x22, 0x23,
+		0x24, 0x25, 0x26, 0x27,
+		0x28, 0x29, 0x2a, 0x2b,
+		0x2c, 0x2d, 0x2e, 0x2f,
+		0x30, 0x31, 0x32, 0x33,
+		0x34, 0x35, 0x36, 0x37
+	};
+
+	const uint8_t expected[24] = {
+		0xe3, 0xb2, 0x01, 0xa9,
+		0xf5, 0xb7, 0x1a, 0x7a,
+		0x9b, 0x1c, 0xea, 0xec,
+		0xcd, 0x97, 0xe7, 0x0b,
+		0x61, 0x76, 0xaa, 0xd9,
+		0xa4, 0x42, 0x8a, 0xa5
+	};
+
+	const uint8_t expected_tag[8] = {
+		0x48, 0x43, 0x92, 0xfb,
+		0xc1, 0xb0, 0x99, 0x51
+	};
+
+	uint8_t output[24] = {0};
+	uint8_t decrypted[24] = {0};
+	uint8_t tag[8] = {0};
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ccm_encrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad), plaintext, sizeof(plaintext), output, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(expected));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, sizeof(expected_tag));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ccm_decrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad), output, sizeof(output), decrypted, expected_tag, sizeof(expected_tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, sizeof(plaintext));
+}
+
+void test_ccm_encrypt_256(void)
+{
+	// AES-256, 13-byte nonce, 16-byte tag, two blocks and a partial one
+	const uint8_t key[32] = {
+		0x60, 0x3d, 0xeb, 0x10,
+		0x15, 0xca, 0x71, 0xbe,
+		0x2b, 0x73, 0xae, 0xf0,
+		0x85, 0x7d, 0x77, 0x81,
+		0x1f, 0x35, 0x2c, 0x07,
+		0x3b, 0x61, 0x08, 0xd7,
+		0x2d, 0x98, 0x10, 0xa3,
+		0x09, 0x14, 0xdf, 0xf4
+	};
+
+	const uint8_t nonce[13] = {
+		0x00, 0x11, 0x22, 0x33,
+		0x44, 0x55, 0x66, 0x77,
+		0x88, 0x99, 0xaa, 0xbb,
+		0xcc
+	};
+
+	const uint8_t aad[8] = {
+		0xfe, 0xed, 0xfa, 0xce,
+		0xde, 0xad, 0xbe, 0xef
+	};
+
+	const uint8_t plaintext[37] = {
+		0x30, 0x31, 0x32, 0x33,
+		0x34, 0x35, 0x36, 0x37,
+		0x38, 0x39, 0x3a, 0x3b,
+		0x3c, 0x3d, 0x3e, 0x3f,
+		0x40, 0x41, 0x42, 0x43,
+		0x44, 0x45, 0x46, 0x47,
+		0x48, 0x49, 0x4a, 0x4b,
+		0x4c, 0x4d, 0x4e, 0x4f,
+		0x50, 0x51, 0x52, 0x53,
+		0x54
+	};
+
+	const uint8_t expected[37] = {
+		0x39, 0x01, 0xae, 0x3a,
+		0xc5, 0x37, 0xc8, 0x93,
+		0x47, 0x4d, 0x49, 0x1f,
+		0x91, 0x55, 0x52, 0x06,
+		0xb3, 0xd8, 0x49, 0xdf,
+		0xae, 0x12, 0x48, 0xf4,
+		0xd1, 0x8b, 0xd2, 0xff,
+		0x5a, 0xbd, 0xd7, 0x52,
+		0x7f, 0xd3, 0x39, 0x42,
+		0xed
+	};
+
+	const uint8_t expected_tag[16] = {
+		0xa7, 0xcd, 0x65, 0xed,
+		0xef, 0x3e, 0xc6, 0x87,
+		0x21, 0x61, 0xa2, 0xe0,
+		0xfe, 0xc9, 0x5a, 0x16
+	};
+
+	uint8_t output[37] = {0};
+	uint8_t decrypted[37] = {0};
+	uint8_t tag[16] = {0};
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ccm_encrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad), plaintext, sizeof(plaintext), output, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(expected));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, sizeof(expected_tag));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ccm_decrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad), output, sizeof(output), decrypted, expected_tag, sizeof(expected_tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, sizeof(plaintext));
+}
+
+void test_ccm_long_aad(void)
+{
+	// 65300 bytes of AAD use the 6-byte (0xfffe) length encoding
+	const uint8_t key[16] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f
+	};
+
+	const uint8_t nonce[7] = {
+		0x20, 0x21, 0x22, 0x23,
+		0x24, 0x25, 0x26
+	};
+
+	const uint8_t plaintext[4] = {
+		0x00, 0x11, 0x22, 0x33
+	};
+
+	const uint8_t expected[4] = {
+		0x8c, 0x3a, 0x4f, 0x52
+	};
+
+	const uint8_t expected_tag[10] = {
+		0xe8, 0xba, 0xdd, 0x6c,
+		0x47, 0x83, 0x45, 0xe9,
+		0xe8, 0x42
+	};
+
+	const size_t aad_len = 65300;
+	uint8_t* aad = malloc(aad_len);
+	uint8_t output[4] = {0};
+	uint8_t tag[10] = {0};
+	aes_context_t ctx;
+
+	TEST_ASSERT_NOT_NULL(aad);
+	for (size_t i = 0; i < aad_len; ++i)
+		aad[i] = (uint8_t)i;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ccm_encrypt(&ctx, nonce, sizeof(nonce), aad, aad_len, plaintext, sizeof(plaintext), output, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(expected));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, sizeof(expected_tag));
+
+	free(aad);
+}
+
+void test_ccm_roundtrip_and_tamper(void)
+{
+	const uint8_t key[32] = {
+		0x60, 0x3d, 0xeb, 0x10,
+		0x15, 0xca, 0x71, 0xbe,
+		0x2b, 0x73, 0xae, 0xf0,
+		0x85, 0x7d, 0x77, 0x81,
+		0x1f, 0x35, 0x2c, 0x07,
+		0x3b, 0x61, 0x08, 0xd7,
+		0x2d, 0x98, 0x10, 0xa3,
+		0x09, 0x14, 0xdf, 0xf4
+	};
+
+	const uint8_t nonce[12] = {
+		0xca, 0xfe, 0xba, 0xbe,
+		0xfa, 0xce, 0xdb, 0xad,
+		0xde, 0xca, 0xf8, 0x88
+	};
+
+	const uint8_t aad[5] = {0x01, 0x02, 0x03, 0x04, 0x05};
+	enum { MAX_LEN = 300 };
+	uint8_t plaintext[MAX_LEN];
+	uint8_t buffer[MAX_LEN];
+	uint8_t tag[16];
+	aes_context_t ctx;
+
+	for (size_t i = 0; i < MAX_LEN; ++i)
+		plaintext[i] = (uint8_t)(i * 7 + 3);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+
+	// Empty, partial, whole and multi-block payloads, processed in place
+	const size_t lengths[] = {0, 1, 15, 16, 17, 64, 129, MAX_LEN};
+	for (size_t n = 0; n < sizeof(lengths) / sizeof(lengths[0]); ++n)
+	{
+		size_t len = lengths[n];
+
+		memcpy(buffer, plaintext, len);
+		TEST_ASSERT_EQUAL_INT(0, aes_ccm_encrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad), buffer, len, buffer, tag, sizeof(tag)));
+		TEST_ASSERT_EQUAL_INT(0, aes_ccm_decrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad), buffer, len, buffer, tag, sizeof(tag)));
+		if (len > 0)
+			TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, buffer, len);
+	}
+
+	uint8_t ciphertext[MAX_LEN];
+	uint8_t zeros[MAX_LEN] = {0};
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ccm_encrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad), plaintext, MAX_LEN, ciphertext, tag, sizeof(tag)));
+
+	// Modified ciphertext: rejected and the output is zeroed
+	ciphertext[MAX_LEN - 1] ^= 0x80;
+	memset(buffer, 0xaa, MAX_LEN);
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ccm_decrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad), ciphertext, MAX_LEN, buffer, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(zeros, buffer, MAX_LEN);
+	ciphertext[MAX_LEN - 1] ^= 0x80;
+
+	// Modified tag and AAD
+	tag[0] ^= 1;
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ccm_decrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad), ciphertext, MAX_LEN, buffer, tag, sizeof(tag)));
+	tag[0] ^= 1;
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ccm_decrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad) - 1, ciphertext, MAX_LEN, buffer, tag, sizeof(tag)));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ccm_decrypt(&ctx, nonce, sizeof(nonce), aad, sizeof(aad), ciphertext, MAX_LEN, buffer, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, buffer, MAX_LEN);
+}
+
+void test_ccm_invalid_arguments(void)
+{
+	const uint8_t key[16] = {0};
+	const uint8_t nonce[14] = {0};
+	uint8_t buffer[32] = {0};
+	uint8_t tag[16] = {0};
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+
+	// Nonce lengths outside 7..13
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ccm_encrypt(&ctx, nonce, 6, NULL, 0, buffer, sizeof(buffer), buffer, tag, 16));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ccm_encrypt(&ctx, nonce, 14, NULL, 0, buffer, sizeof(buffer), buffer, tag, 16));
+
+	// Odd, too short and too long tags
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ccm_encrypt(&ctx, nonce, 13, NULL, 0, buffer, sizeof(buffer), buffer, tag, 5));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ccm_encrypt(&ctx, nonce, 13, NULL, 0, buffer, sizeof(buffer), buffer, tag, 2));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ccm_encrypt(&ctx, nonce, 13, NULL, 0, buffer, sizeof(buffer), buffer, tag, 18));
+
+	// Payload too long for the 2 length bytes left by a 13-byte nonce
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ccm_encrypt(&ctx, nonce, 13, NULL, 0, buffer, (size_t)1 << 16, buffer, tag, 16));
+
+	// Missing AAD
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ccm_encrypt(&ctx, nonce, 13, NULL, 4, buffer, sizeof(buffer), buffer, tag, 16));
+}
+
+void register_aes_ccm_tests(void)
+{
+	RUN_TEST(test_ccm_example_1);
+	RUN_TEST(test_ccm_example_2);
+	RUN_TEST(test_ccm_example_3);
+	RUN_TEST(test_ccm_encrypt_256);
+	RUN_TEST(test_ccm_long_aad);
+	RUN_TEST(test_ccm_roundtrip_and_tamper);
+	RUN_TEST(test_ccm_invalid_arguments);
+}
\ No newline at end of file
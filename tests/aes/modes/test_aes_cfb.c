@@ -1,6 +1,7 @@
 #include "unity/unity.h"
 #include "aes/modes/aes_cfb.h"
 #include "aes/core/aes_key_expansion.h"
+#include <string.h>
 
 void test_cfb_encrypt_128(void)
 {
@@ -228,6 +229,104 @@ void test_cfb_decrypt_256(void)
 	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, 16);
 }
 
+void test_cfb_192_partial_block_in_place(void)
+{
+	const uint8_t key[24] = {
+		0x8e, 0x73, 0xb0, 0xf7,
+		0xda, 0x0e, 0x64, 0x52,
+		0xc8, 0x10, 0xf3, 0x2b,
+		0x80, 0x90, 0x79, 0xe5,
+		0x62, 0xf8, 0xea, 0xd2,
+		0x52, 0x2c, 0x6b, 0x7b
+	};
+
+	const uint8_t iv[16] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f
+	};
+
+	const uint8_t plaintext[37] = {
+		0x05, 0x12, 0x1f, 0x2c,
+		0x39, 0x46, 0x53, 0x60,
+		0x6d, 0x7a, 0x87, 0x94,
+		0xa1, 0xae, 0xbb, 0xc8,
+		0xd5, 0xe2, 0xef, 0xfc,
+		0x09, 0x16, 0x23, 0x30,
+		0x3d, 0x4a, 0x57, 0x64,
+		0x71, 0x7e, 0x8b, 0x98,
+		0xa5, 0xb2, 0xbf, 0xcc,
+		0xd9
+	};
+
+	const uint8_t expected[37] = {
+		0xa3, 0x1b, 0xac, 0xa1,
+		0xca, 0xf7, 0x40, 0x5d,
+		0xb0, 0x85, 0xa0, 0x8c,
+		0x1b, 0xa7, 0xed, 0x96,
+		0x20, 0x25, 0x85, 0xd9,
+		0x57, 0x32, 0x9b, 0x02,
+		0x14, 0x8c, 0xea, 0xcf,
+		0x32, 0x2d, 0x3c, 0x16,
+		0x1e, 0x40, 0x56, 0x9f,
+		0x6b
+	};
+
+	// 2 full blocks and a 5-byte tail, processed in place
+	uint8_t buffer[37];
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_192));
+
+	memcpy(buffer, plaintext, sizeof(buffer));
+	aes_cfb_encrypt(&ctx, iv, buffer, sizeof(buffer), buffer);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buffer, sizeof(buffer));
+
+	aes_cfb_decrypt(&ctx, iv, buffer, sizeof(buffer), buffer);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, buffer, sizeof(buffer));
+}
+
+void test_cfb_decrypt_256_multi_block(void)
+{
+	const uint8_t key[32] = {
+		0x60, 0x3d, 0xeb, 0x10,
+		0x15, 0xca, 0x71, 0xbe,
+		0x2b, 0x73, 0xae, 0xf0,
+		0x85, 0x7d, 0x77, 0x81,
+		0x1f, 0x35, 0x2c, 0x07,
+		0x3b, 0x61, 0x08, 0xd7,
+		0x2d, 0x98, 0x10, 0xa3,
+		0x09, 0x14, 0xdf, 0xf4
+	};
+
+	const uint8_t iv[16] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f
+	};
+
+	// 45 full blocks (a wide batch and a remainder) and a 9-byte tail
+	uint8_t plaintext[45 * 16 + 9], ciphertext[sizeof(plaintext)], output[sizeof(plaintext)];
+	aes_context_t ctx;
+
+	for (size_t i = 0; i < sizeof(plaintext); ++i)
+		plaintext[i] = (uint8_t)(i * 11 + 3);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+
+	// Encryption is the serial reference
+	aes_cfb_encrypt(&ctx, iv, plaintext, sizeof(plaintext), ciphertext);
+
+	aes_cfb_decrypt(&ctx, iv, ciphertext, sizeof(ciphertext), output);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, output, sizeof(plaintext));
+
+	memcpy(output, ciphertext, sizeof(ciphertext));
+	aes_cfb_decrypt(&ctx, iv, output, sizeof(output), output);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, output, sizeof(plaintext));
+}
+
 void register_aes_cfb_tests(void)
 {
 	RUN_TEST(test_cfb_encrypt_128);
@@ -236,4 +335,6 @@ void register_aes_cfb_tests(void)
 	RUN_TEST(test_cfb_decrypt_192);
 	RUN_TEST(test_cfb_encrypt_256);
 	RUN_TEST(test_cfb_decrypt_256);
+	RUN_TEST(test_cfb_192_partial_block_in_place);
+	RUN_TEST(test_cfb_decrypt_256_multi_block);
 }
\ No newline at end of file
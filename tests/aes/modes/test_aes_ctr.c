@@ -1,6 +1,8 @@
 #include "unity/unity.h"
 #include "aes/modes/aes_ctr.h"
+#include "aes/modes/aes_ecb.h"
 #include "aes/core/aes_key_expansion.h"
+#include <string.h>
 
 void test_ctr_crypt_128(void)
 {
@@ -122,9 +124,210 @@ void test_ctr_crypt_256(void)
 	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, 16);
 }
 
+void test_ctr_crypt_128_multi_block(void)
+{
+	const uint8_t key[16] = {
+		0x2b, 0x7e, 0x15, 0x16,
+		0x28, 0xae, 0xd2, 0xa6,
+		0xab, 0xf7, 0x15, 0x88,
+		0x09, 0xcf, 0x4f, 0x3c
+	};
+
+	// Low 32 bits of the counter wrap after two blocks
+	const uint8_t iv[16] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0xff, 0xff, 0xff, 0xfe
+	};
+
+	// 9 full blocks and a 6-byte partial block
+	const uint8_t expected[150] = {
+		0x08, 0xfe, 0x83, 0x40, 0x1a, 0x8f, 0xfe, 0x86,
+		0x15, 0x9a, 0x14, 0x70, 0xe3, 0x2a, 0x11, 0xcb,
+		0xad, 0xa6, 0xd2, 0xfc, 0x5d, 0x64, 0x6f, 0x55,
+		0xe4, 0x71, 0xf4, 0xaa, 0x6a, 0x8f, 0xe2, 0xeb,
+		0xce, 0xd9, 0xbc, 0xb7, 0xb0, 0xe4, 0x2e, 0x0d,
+		0x9a, 0x54, 0x67, 0xbb, 0xb9, 0xd3, 0xd1, 0x4f,
+		0xd4, 0xf4, 0x6c, 0x31, 0x79, 0xc6, 0xc4, 0x52,
+		0xdc, 0x0f, 0x91, 0xac, 0x1c, 0xaf, 0x25, 0x8b,
+		0xa3, 0x03, 0xb4, 0xd1, 0xc6, 0xfe, 0x65, 0x2f,
+		0xb1, 0xaa, 0xef, 0x88, 0x2a, 0x4d, 0x42, 0xf4,
+		0x4d, 0x96, 0x7d, 0x07, 0xcc, 0x3b, 0xc2, 0xee,
+		0xe9, 0x19, 0x8c, 0xe9, 0xcd, 0xf9, 0xc7, 0x36,
+		0xb4, 0xa0, 0xae, 0xb4, 0x45, 0xed, 0x8a, 0x30,
+		0xd2, 0xc4, 0xa2, 0xe9, 0x6d, 0xa8, 0xb0, 0xbb,
+		0x1f, 0x1d, 0x8a, 0x0b, 0x30, 0x70, 0x38, 0xeb,
+		0xd3, 0x0e, 0x74, 0xc0, 0x88, 0x0b, 0xc7, 0x70,
+		0x65, 0xae, 0xb9, 0x61, 0xd0, 0xcf, 0xc5, 0xb5,
+		0xb4, 0xb3, 0x7e, 0x76, 0x7c, 0x0d, 0xaa, 0x66,
+		0xde, 0x77, 0x2c, 0xd3, 0x7e, 0x5c
+	};
+
+	uint8_t plaintext[150];
+	for (size_t i = 0; i < sizeof(plaintext); ++i)
+		plaintext[i] = (uint8_t)i;
+
+	uint8_t output[150] = {0};
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	aes_ctr_crypt(&ctx, iv, plaintext, sizeof(plaintext), output);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(expected));
+
+	// Decrypt in place
+	aes_ctr_crypt(&ctx, iv, output, sizeof(output), output);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, output, sizeof(plaintext));
+}
+
+void test_ctr_crypt_256_counter_carry(void)
+{
+	const uint8_t key[32] = {
+		0x60, 0x3d, 0xeb, 0x10,
+		0x15, 0xca, 0x71, 0xbe,
+		0x2b, 0x73, 0xae, 0xf0,
+		0x85, 0x7d, 0x77, 0x81,
+		0x1f, 0x35, 0x2c, 0x07,
+		0x3b, 0x61, 0x08, 0xd7,
+		0x2d, 0x98, 0x10, 0xa3,
+		0x09, 0x14, 0xdf, 0xf4
+	};
+
+	// The low 64 bits wrap after 20 blocks, in the middle of a wide batch
+	const uint8_t iv[16] = {
+		0xf0, 0xf1, 0xf2, 0xf3,
+		0xf4, 0xf5, 0xf6, 0xf7,
+		0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xec
+	};
+
+	// 70 whole blocks and a 5-byte tail
+	enum { NUM_BLOCKS = 71, LEN = 70 * 16 + 5 };
+	uint8_t counters[NUM_BLOCKS * 16];
+	uint8_t keystream[NUM_BLOCKS * 16];
+	uint8_t input[LEN], expected[LEN], output[LEN];
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+
+	// Reference keystream: ECB encryption of the counters incremented byte by byte
+	memcpy(counters, iv, 16);
+	for (int b = 1; b < NUM_BLOCKS; ++b)
+	{
+		memcpy(counters + b * 16, counters + (b - 1) * 16, 16);
+		for (int j = 15; j >= 0 && ++counters[b * 16 + j] == 0; --j);
+	}
+	aes_ecb_encrypt(&ctx, counters, sizeof(counters), keystream);
+
+	for (int i = 0; i < LEN; ++i)
+	{
+		input[i] = (uint8_t)(i * 31 + 7);
+		expected[i] = input[i] ^ keystream[i];
+	}
+
+	aes_ctr_crypt(&ctx, iv, input, LEN, output);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, LEN);
+
+	// In place
+	aes_ctr_crypt(&ctx, iv, output, LEN, output);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(input, output, LEN);
+}
+
+void test_ctr_crypt_at_matches_stream(void)
+{
+	const uint8_t key[16] = {
+		0x2b, 0x7e, 0x15, 0x16,
+		0x28, 0xae, 0xd2, 0xa6,
+		0xab, 0xf7, 0x15, 0x88,
+		0x09, 0xcf, 0x4f, 0x3c
+	};
+
+	const uint8_t iv[16] = {
+		0xf0, 0xf1, 0xf2, 0xf3,
+		0xf4, 0xf5, 0xf6, 0xf7,
+		0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xfa
+	};
+
+	// { offset, length } ranges: aligned, mid-block, within one block, crossing the 64-bit carry
+	const size_t ranges[][2] = {
+		{ 0, 300 }, { 16, 100 }, { 5, 7 }, { 3, 13 }, { 37, 200 }, { 95, 1 }, { 299, 1 }, { 150, 0 }
+	};
+
+	uint8_t input[300], stream[300], output[300];
+	aes_context_t ctx;
+
+	for (size_t i = 0; i < sizeof(input); ++i)
+		input[i] = (uint8_t)(i * 13 + 1);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	aes_ctr_crypt(&ctx, iv, input, sizeof(input), stream);
+
+	for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); ++r)
+	{
+		size_t offset = ranges[r][0], len = ranges[r][1];
+
+		memset(output, 0, sizeof(output));
+		aes_ctr_crypt_at(&ctx, iv, offset, input + offset, len, output);
+
+		// Bytes past the range must be left untouched
+		if (len > 0)
+			TEST_ASSERT_EQUAL_UINT8_ARRAY(stream + offset, output, len);
+		if (len < sizeof(output))
+			TEST_ASSERT_EACH_EQUAL_UINT8(0, output + len, sizeof(output) - len);
+	}
+}
+
+void test_ctr_crypt_at_large_offset(void)
+{
+	const uint8_t key[16] = {
+		0x2b, 0x7e, 0x15, 0x16,
+		0x28, 0xae, 0xd2, 0xa6,
+		0xab, 0xf7, 0x15, 0x88,
+		0x09, 0xcf, 0x4f, 0x3c
+	};
+
+	const uint8_t iv[16] = {
+		0x00, 0x11, 0x22, 0x33,
+		0x44, 0x55, 0x66, 0x77,
+		0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xf0
+	};
+
+	// Block 2^36 + 0x20 of the stream, byte 9: the low 64 bits of the counter wrap
+	const uint64_t offset = ((1ULL << 36) + 0x20) * 16 + 9;
+
+	const uint8_t shifted_iv[16] = {
+		0x00, 0x11, 0x22, 0x33,
+		0x44, 0x55, 0x66, 0x78,
+		0x00, 0x00, 0x00, 0x10,
+		0x00, 0x00, 0x00, 0x10
+	};
+
+	uint8_t input[64], expected[9 + 64], output[64];
+	aes_context_t ctx;
+
+	for (size_t i = 0; i < sizeof(input); ++i)
+		input[i] = (uint8_t)(i + 1);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+
+	// Same bytes, produced from a stream that starts at the target block
+	memset(expected, 0, 9);
+	memcpy(expected + 9, input, sizeof(input));
+	aes_ctr_crypt(&ctx, shifted_iv, expected, sizeof(expected), expected);
+
+	aes_ctr_crypt_at(&ctx, iv, offset, input, sizeof(input), output);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected + 9, output, sizeof(input));
+}
+
 void register_aes_ctr_tests(void)
 {
 	RUN_TEST(test_ctr_crypt_128);
 	RUN_TEST(test_ctr_crypt_192);
 	RUN_TEST(test_ctr_crypt_256);
+	RUN_TEST(test_ctr_crypt_128_multi_block);
+	RUN_TEST(test_ctr_crypt_256_counter_carry);
+	RUN_TEST(test_ctr_crypt_at_matches_stream);
+	RUN_TEST(test_ctr_crypt_at_large_offset);
 }
\ No newline at end of file
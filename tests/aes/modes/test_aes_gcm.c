@@ -0,0 +1,572 @@
+#include "unity/unity.h"
+#include "aes/modes/aes_gcm.h"
+#include <string.h>
+
+void test_gcm_encrypt_128_zero(void)
+{
+	const uint8_t key[16] = {0};
+	const uint8_t iv[12] = {0};
+	const uint8_t plaintext[16] = {0};
+
+	const uint8_t expected[16] = {
+		0x03, 0x88, 0xda, 0xce,
+		0x60, 0xb6, 0xa3, 0x92,
+		0xf3, 0x28, 0xc2, 0xb9,
+		0x71, 0xb2, 0xfe, 0x78
+	};
+
+	const uint8_t expected_tag[16] = {
+		0xab, 0x6e, 0x47, 0xd4,
+		0x2c, 0xec, 0x13, 0xbd,
+		0xf5, 0x3a, 0x67, 0xb2,
+		0x12, 0x57, 0xbd, 0xdf
+	};
+
+	uint8_t output[16] = {0};
+	uint8_t tag[16] = {0};
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_encrypt(&ctx, NULL, iv, sizeof(iv), NULL, 0, plaintext, 16, output, tag, 16));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, 16);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, 16);
+}
+
+void test_gcm_encrypt_128_aad(void)
+{
+	const uint8_t key[16] = {
+		0xfe, 0xff, 0xe9, 0x92,
+		0x86, 0x65, 0x73, 0x1c,
+		0x6d, 0x6a, 0x8f, 0x94,
+		0x67, 0x30, 0x83, 0x08
+	};
+	const uint8_t iv[12] = {
+		0xca, 0xfe, 0xba, 0xbe,
+		0xfa, 0xce, 0xdb, 0xad,
+		0xde, 0xca, 0xf8, 0x88
+	};
+	const uint8_t aad[20] = {
+		0xfe, 0xed, 0xfa, 0xce,
+		0xde, 0xad, 0xbe, 0xef,
+		0xfe, 0xed, 0xfa, 0xce,
+		0xde, 0xad, 0xbe, 0xef,
+		0xab, 0xad, 0xda, 0xd2
+	};
+	const uint8_t plaintext[60] = {
+		0xd9, 0x31, 0x32, 0x25,
+		0xf8, 0x84, 0x06, 0xe5,
+		0xa5, 0x59, 0x09, 0xc5,
+		0xaf, 0xf5, 0x26, 0x9a,
+		0x86, 0xa7, 0xa9, 0x53,
+		0x15, 0x34, 0xf7, 0xda,
+		0x2e, 0x4c, 0x30, 0x3d,
+		0x8a, 0x31, 0x8a, 0x72,
+		0x1c, 0x3c, 0x0c, 0x95,
+		0x95, 0x68, 0x09, 0x53,
+		0x2f, 0xcf, 0x0e, 0x24,
+		0x49, 0xa6, 0xb5, 0x25,
+		0xb1, 0x6a, 0xed, 0xf5,
+		0xaa, 0x0d, 0xe6, 0x57,
+		0xba, 0x63, 0x7b, 0x39
+	};
+	const uint8_t expected[60] = {
+		0x42, 0x83, 0x1e, 0xc2,
+		0x21, 0x77, 0x74, 0x24,
+		0x4b, 0x72, 0x21, 0xb7,
+		0x84, 0xd0, 0xd4, 0x9c,
+		0xe3, 0xaa, 0x21, 0x2f,
+		0x2c, 0x02, 0xa4, 0xe0,
+		0x35, 0xc1, 0x7e, 0x23,
+		0x29, 0xac, 0xa1, 0x2e,
+		0x21, 0xd5, 0x14, 0xb2,
+		0x54, 0x66, 0x93, 0x1c,
+		0x7d, 0x8f, 0x6a, 0x5a,
+		0xac, 0x84, 0xaa, 0x05,
+		0x1b, 0xa3, 0x0b, 0x39,
+		0x6a, 0x0a, 0xac, 0x97,
+		0x3d, 0x58, 0xe0, 0x91
+	};
+	const uint8_t expected_tag[16] = {
+		0x5b, 0xc9, 0x4f, 0xbc,
+		0x32, 0x21, 0xa5, 0xdb,
+		0x94, 0xfa, 0xe9, 0x5a,
+		0xe7, 0x12, 0x1a, 0x47
+	};
+
+	uint8_t output[60] = {0};
+	uint8_t tag[16] = {0};
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_encrypt(&ctx, NULL, iv, sizeof(iv), aad, sizeof(aad), plaintext, 60, output, tag, 16));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, 60);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, 16);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_decrypt(&ctx, NULL, iv, sizeof(iv), aad, sizeof(aad), expected, 60, output, tag, 16));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, output, 60);
+}
+
+void test_gcm_encrypt_192_long_iv(void)
+{
+	const uint8_t key[24] = {
+		0xfe, 0xff, 0xe9, 0x92,
+		0x86, 0x65, 0x73, 0x1c,
+		0x6d, 0x6a, 0x8f, 0x94,
+		0x67, 0x30, 0x83, 0x08,
+		0xfe, 0xff, 0xe9, 0x92,
+		0x86, 0x65, 0x73, 0x1c
+	};
+
+	// 16-byte IV: J0 is derived through GHASH
+	const uint8_t iv[16] = {
+		0xfe, 0xff, 0xe9, 0x92,
+		0x86, 0x65, 0x73, 0x1c,
+		0x6d, 0x6a, 0x8f, 0x94,
+		0x67, 0x30, 0x83, 0x08
+	};
+
+	const uint8_t plaintext[60] = {
+		0x93, 0x13, 0x22, 0x5d,
+		0xf8, 0x84, 0x06, 0xe5,
+		0x55, 0x90, 0x9c, 0x5a,
+		0xff, 0x52, 0x69, 0xaa,
+		0x6a, 0x7a, 0x95, 0x38,
+		0x53, 0x4f, 0x7d, 0xa1,
+		0xe4, 0xc3, 0x03, 0xd2,
+		0xa3, 0x18, 0xa7, 0x28,
+		0xc3, 0xc0, 0xc9, 0x51,
+		0x56, 0x80, 0x95, 0x39,
+		0xfc, 0xf0, 0xe2, 0x42,
+		0x9a, 0x6b, 0x52, 0x54,
+		0x16, 0xae, 0xdb, 0xf5,
+		0xa0, 0xde, 0x6a, 0x57,
+		0xa6, 0x37, 0xb3, 0x9b
+	};
+
+	const uint8_t expected[60] = {
+		0x93, 0x8d, 0x16, 0xd0,
+		0xc2, 0x2b, 0xcd, 0x81,
+		0x4f, 0x37, 0xc6, 0xa2,
+		0x87, 0x1a, 0x3f, 0x03,
+		0xdf, 0xda, 0xbf, 0xca,
+		0x09, 0x94, 0x48, 0xde,
+		0xec, 0x1f, 0x80, 0xff,
+		0x9d, 0xf9, 0x84, 0xbc,
+		0x19, 0x38, 0x9a, 0x2d,
+		0x64, 0x95, 0xec, 0x00,
+		0x0a, 0xc1, 0xe7, 0x0f,
+		0x21, 0x8b, 0xe4, 0x4f,
+		0x8a, 0x2d, 0x62, 0x39,
+		0xd1, 0x14, 0x47, 0x76,
+		0x40, 0x07, 0x54, 0x61
+	};
+
+	const uint8_t expected_tag[16] = {
+		0xc8, 0x6b, 0x2b, 0xf6,
+		0x6d, 0x84, 0xe1, 0x36,
+		0xca, 0x55, 0x34, 0x66,
+		0xb5, 0x3d, 0x5a, 0xe5
+	};
+
+	uint8_t output[60] = {0};
+	uint8_t tag[16] = {0};
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_192));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_encrypt(&ctx, NULL, iv, sizeof(iv), NULL, 0, plaintext, 60, output, tag, 16));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, 60);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, 16);
+}
+
+void test_gcm_encrypt_256_long_iv_aad(void)
+{
+	const uint8_t key[32] = {
+		0xfe, 0xff, 0xe9, 0x92,
+		0x86, 0x65, 0x73, 0x1c,
+		0x6d, 0x6a, 0x8f, 0x94,
+		0x67, 0x30, 0x83, 0x08,
+		0xfe, 0xff, 0xe9, 0x92,
+		0x86, 0x65, 0x73, 0x1c,
+		0x6d, 0x6a, 0x8f, 0x94,
+		0x67, 0x30, 0x83, 0x08
+	};
+
+	// 60-byte IV
+	const uint8_t iv[60] = {
+		0x93, 0x13, 0x22, 0x5d,
+		0xf8, 0x84, 0x06, 0xe5,
+		0x55, 0x90, 0x9c, 0x5a,
+		0xff, 0x52, 0x69, 0xaa,
+		0x6a, 0x7a, 0x95, 0x38,
+		0x53, 0x4f, 0x7d, 0xa1,
+		0xe4, 0xc3, 0x03, 0xd2,
+		0xa3, 0x18, 0xa7, 0x28,
+		0xc3, 0xc0, 0xc9, 0x51,
+		0x56, 0x80, 0x95, 0x39,
+		0xfc, 0xf0, 0xe2, 0x42,
+		0x9a, 0x6b, 0x52, 0x54,
+		0x16, 0xae, 0xdb, 0xf5,
+		0xa0, 0xde, 0x6a, 0x57,
+		0xa6, 0x37, 0xb3, 0x9b
+	};
+
+	const uint8_t aad[20] = {
+		0xfe, 0xed, 0xfa, 0xce,
+		0xde, 0xad, 0xbe, 0xef,
+		0xfe, 0xed, 0xfa, 0xce,
+		0xde, 0xad, 0xbe, 0xef,
+		0xab, 0xad, 0xda, 0xd2
+	};
+
+	const uint8_t plaintext[60] = {
+		0xd9, 0x31, 0x32, 0x25,
+		0xf8, 0x84, 0x06, 0xe5,
+		0xa5, 0x59, 0x09, 0xc5,
+		0xaf, 0xf5, 0x26, 0x9a,
+		0x86, 0xa7, 0xa9, 0x53,
+		0x15, 0x34, 0xf7, 0xda,
+		0x2e, 0x4c, 0x30, 0x3d,
+		0x8a, 0x31, 0x8a, 0x72,
+		0x1c, 0x3c, 0x0c, 0x95,
+		0x95, 0x68, 0x09, 0x53,
+		0x2f, 0xcf, 0x0e, 0x24,
+		0x49, 0xa6, 0xb5, 0x25,
+		0xb1, 0x6a, 0xed, 0xf5,
+		0xaa, 0x0d, 0xe6, 0x57,
+		0xba, 0x63, 0x7b, 0x39
+	};
+
+	const uint8_t expected[60] = {
+		0x5a, 0x8d, 0xef, 0x2f,
+		0x0c, 0x9e, 0x53, 0xf1,
+		0xf7, 0x5d, 0x78, 0x53,
+		0x65, 0x9e, 0x2a, 0x20,
+		0xee, 0xb2, 0xb2, 0x2a,
+		0xaf, 0xde, 0x64, 0x19,
+		0xa0, 0x58, 0xab, 0x4f,
+		0x6f, 0x74, 0x6b, 0xf4,
+		0x0f, 0xc0, 0xc3, 0xb7,
+		0x80, 0xf2, 0x44, 0x45,
+		0x2d, 0xa3, 0xeb, 0xf1,
+		0xc5, 0xd8, 0x2c, 0xde,
+		0xa2, 0x41, 0x89, 0x97,
+		0x20, 0x0e, 0xf8, 0x2e,
+		0x44, 0xae, 0x7e, 0x3f
+	};
+
+	const uint8_t expected_tag[16] = {
+		0xa4, 0x4a, 0x82, 0x66,
+		0xee, 0x1c, 0x8e, 0xb0,
+		0xc8, 0xb5, 0xd4, 0xcf,
+		0x5a, 0xe9, 0xf1, 0x9a
+	};
+
+	uint8_t output[60] = {0};
+	uint8_t tag[16] = {0};
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_encrypt(&ctx, NULL, iv, sizeof(iv), aad, sizeof(aad), plaintext, 60, output, tag, 16));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, 60);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, 16);
+}
+
+void test_gcm_incremental_matches_one_shot(void)
+{
+	const uint8_t key[16] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f
+	};
+
+	const uint8_t iv[12] = {
+		0x10, 0x11, 0x12, 0x13,
+		0x14, 0x15, 0x16, 0x17,
+		0x18, 0x19, 0x1a, 0x1b
+	};
+
+	const uint8_t aad[20] = {
+		0xfe, 0xed, 0xfa, 0xce,
+		0xde, 0xad, 0xbe, 0xef,
+		0xfe, 0xed, 0xfa, 0xce,
+		0xde, 0xad, 0xbe, 0xef,
+		0xab, 0xad, 0xda, 0xd2
+	};
+
+	// Tag of the 300-byte message below (18 whole blocks and a 12-byte tail)
+	const uint8_t expected_tag[16] = {
+		0xe8, 0xab, 0xf2, 0x9a,
+		0xa5, 0xfa, 0x27, 0x8b,
+		0x9c, 0xa1, 0x4c, 0x10,
+		0xfa, 0x2e, 0xb1, 0x7b
+	};
+
+	// Uneven chunks crossing block and 8-block batch boundaries
+	const size_t chunks[] = {1, 15, 17, 0, 130, 3, 100, 34};
+
+	uint8_t plaintext[300], expected[300], output[300], tag[16];
+	aes_gcm_context_t gcm;
+	aes_ghash_key_t hkey;
+	aes_context_t ctx;
+
+	for (size_t i = 0; i < sizeof(plaintext); ++i)
+		plaintext[i] = (uint8_t)(i * 7 + 3);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash_key_init(&hkey, &ctx));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_encrypt(&ctx, &hkey, iv, sizeof(iv), aad, sizeof(aad), plaintext, sizeof(plaintext), expected, tag, 16));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, 16);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_init(&gcm, &ctx, &hkey, iv, sizeof(iv)));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_update_aad(&gcm, aad, 7));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_update_aad(&gcm, aad + 7, sizeof(aad) - 7));
+
+	size_t offset = 0;
+	for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); ++i)
+	{
+		TEST_ASSERT_EQUAL_INT(0, aes_gcm_encrypt_update(&gcm, plaintext + offset, chunks[i], output + offset));
+		offset += chunks[i];
+	}
+	TEST_ASSERT_EQUAL_size_t(sizeof(plaintext), offset);
+
+	// AAD is rejected once text has been processed
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_gcm_update_aad(&gcm, aad, 1));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_finish(&gcm, tag, 16));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(output));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, 16);
+
+	// Incremental in-place decryption with the same chunks
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_init(&gcm, &ctx, &hkey, iv, sizeof(iv)));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_update_aad(&gcm, aad, sizeof(aad)));
+
+	offset = 0;
+	for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); ++i)
+	{
+		TEST_ASSERT_EQUAL_INT(0, aes_gcm_decrypt_update(&gcm, output + offset, chunks[i], output + offset));
+		offset += chunks[i];
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_verify(&gcm, expected_tag, 16));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, output, sizeof(output));
+}
+
+void test_gcm_decrypt_rejects_forgery(void)
+{
+	const uint8_t key[16] = {
+		0xfe, 0xff, 0xe9, 0x92,
+		0x86, 0x65, 0x73, 0x1c,
+		0x6d, 0x6a, 0x8f, 0x94,
+		0x67, 0x30, 0x83, 0x08
+	};
+	const uint8_t iv[12] = {
+		0xca, 0xfe, 0xba, 0xbe,
+		0xfa, 0xce, 0xdb, 0xad,
+		0xde, 0xca, 0xf8, 0x88
+	};
+	const uint8_t aad[20] = {
+		0xfe, 0xed, 0xfa, 0xce,
+		0xde, 0xad, 0xbe, 0xef,
+		0xfe, 0xed, 0xfa, 0xce,
+		0xde, 0xad, 0xbe, 0xef,
+		0xab, 0xad, 0xda, 0xd2
+	};
+	const uint8_t expected[60] = {
+		0x42, 0x83, 0x1e, 0xc2,
+		0x21, 0x77, 0x74, 0x24,
+		0x4b, 0x72, 0x21, 0xb7,
+		0x84, 0xd0, 0xd4, 0x9c,
+		0xe3, 0xaa, 0x21, 0x2f,
+		0x2c, 0x02, 0xa4, 0xe0,
+		0x35, 0xc1, 0x7e, 0x23,
+		0x29, 0xac, 0xa1, 0x2e,
+		0x21, 0xd5, 0x14, 0xb2,
+		0x54, 0x66, 0x93, 0x1c,
+		0x7d, 0x8f, 0x6a, 0x5a,
+		0xac, 0x84, 0xaa, 0x05,
+		0x1b, 0xa3, 0x0b, 0x39,
+		0x6a, 0x0a, 0xac, 0x97,
+		0x3d, 0x58, 0xe0, 0x91
+	};
+	const uint8_t expected_tag[16] = {
+		0x5b, 0xc9, 0x4f, 0xbc,
+		0x32, 0x21, 0xa5, 0xdb,
+		0x94, 0xfa, 0xe9, 0x5a,
+		0xe7, 0x12, 0x1a, 0x47
+	};
+
+	uint8_t ciphertext[60];
+	uint8_t output[60];
+	uint8_t tag[16];
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+
+	// Tampered ciphertext
+	memcpy(ciphertext, expected, 60);
+	ciphertext[59] ^= 0x01;
+	memset(output, 0xaa, sizeof(output));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_gcm_decrypt(&ctx, NULL, iv, sizeof(iv), aad, sizeof(aad), ciphertext, 60, output, expected_tag, 16));
+	TEST_ASSERT_EACH_EQUAL_UINT8(0, output, sizeof(output));
+
+	// Tampered AAD
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_gcm_decrypt(&ctx, NULL, iv, sizeof(iv), aad, sizeof(aad) - 1, expected, 60, output, expected_tag, 16));
+
+	// Tampered tag
+	memcpy(tag, expected_tag, 16);
+	tag[0] ^= 0x80;
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_gcm_decrypt(&ctx, NULL, iv, sizeof(iv), aad, sizeof(aad), expected, 60, output, tag, 16));
+}
+
+void test_gcm_truncated_tag(void)
+{
+	const uint8_t key[16] = {
+		0xfe, 0xff, 0xe9, 0x92,
+		0x86, 0x65, 0x73, 0x1c,
+		0x6d, 0x6a, 0x8f, 0x94,
+		0x67, 0x30, 0x83, 0x08
+	};
+	const uint8_t iv[12] = {
+		0xca, 0xfe, 0xba, 0xbe,
+		0xfa, 0xce, 0xdb, 0xad,
+		0xde, 0xca, 0xf8, 0x88
+	};
+	const uint8_t aad[20] = {
+		0xfe, 0xed, 0xfa, 0xce,
+		0xde, 0xad, 0xbe, 0xef,
+		0xfe, 0xed, 0xfa, 0xce,
+		0xde, 0xad, 0xbe, 0xef,
+		0xab, 0xad, 0xda, 0xd2
+	};
+	const uint8_t plaintext[60] = {
+		0xd9, 0x31, 0x32, 0x25,
+		0xf8, 0x84, 0x06, 0xe5,
+		0xa5, 0x59, 0x09, 0xc5,
+		0xaf, 0xf5, 0x26, 0x9a,
+		0x86, 0xa7, 0xa9, 0x53,
+		0x15, 0x34, 0xf7, 0xda,
+		0x2e, 0x4c, 0x30, 0x3d,
+		0x8a, 0x31, 0x8a, 0x72,
+		0x1c, 0x3c, 0x0c, 0x95,
+		0x95, 0x68, 0x09, 0x53,
+		0x2f, 0xcf, 0x0e, 0x24,
+		0x49, 0xa6, 0xb5, 0x25,
+		0xb1, 0x6a, 0xed, 0xf5,
+		0xaa, 0x0d, 0xe6, 0x57,
+		0xba, 0x63, 0x7b, 0x39
+	};
+	const uint8_t expected[60] = {
+		0x42, 0x83, 0x1e, 0xc2,
+		0x21, 0x77, 0x74, 0x24,
+		0x4b, 0x72, 0x21, 0xb7,
+		0x84, 0xd0, 0xd4, 0x9c,
+		0xe3, 0xaa, 0x21, 0x2f,
+		0x2c, 0x02, 0xa4, 0xe0,
+		0x35, 0xc1, 0x7e, 0x23,
+		0x29, 0xac, 0xa1, 0x2e,
+		0x21, 0xd5, 0x14, 0xb2,
+		0x54, 0x66, 0x93, 0x1c,
+		0x7d, 0x8f, 0x6a, 0x5a,
+		0xac, 0x84, 0xaa, 0x05,
+		0x1b, 0xa3, 0x0b, 0x39,
+		0x6a, 0x0a, 0xac, 0x97,
+		0x3d, 0x58, 0xe0, 0x91
+	};
+	const uint8_t expected_tag[16] = {
+		0x5b, 0xc9, 0x4f, 0xbc,
+		0x32, 0x21, 0xa5, 0xdb,
+		0x94, 0xfa, 0xe9, 0x5a,
+		0xe7, 0x12, 0x1a, 0x47
+	};
+
+	uint8_t output[60];
+	uint8_t tag[12];
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+
+	// A truncated tag is the prefix of the full tag
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_encrypt(&ctx, NULL, iv, sizeof(iv), aad, sizeof(aad), plaintext, 60, output, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, sizeof(tag));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_decrypt(&ctx, NULL, iv, sizeof(iv), aad, sizeof(aad), expected, 60, output, tag, sizeof(tag)));
+
+	// Out-of-range tag lengths are rejected
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_gcm_encrypt(&ctx, NULL, iv, sizeof(iv), aad, sizeof(aad), plaintext, 60, output, tag, 3));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_gcm_encrypt(&ctx, NULL, iv, sizeof(iv), aad, sizeof(aad), plaintext, 60, output, tag, 17));
+}
+
+void test_gcm_segments_match_serial(void)
+{
+	const uint8_t key[32] = {
+		0x60, 0x3d, 0xeb, 0x10,
+		0x15, 0xca, 0x71, 0xbe,
+		0x2b, 0x73, 0xae, 0xf0,
+		0x85, 0x7d, 0x77, 0x81,
+		0x1f, 0x35, 0x2c, 0x07,
+		0x3b, 0x61, 0x08, 0xd7,
+		0x2d, 0x98, 0x10, 0xa3,
+		0x09, 0x14, 0xdf, 0xf4
+	};
+
+	const uint8_t iv[12] = {
+		0xca, 0xfe, 0xba, 0xbe,
+		0xfa, 0xce, 0xdb, 0xad,
+		0xde, 0xca, 0xf8, 0x88
+	};
+
+	const uint8_t aad[5] = { 0x01, 0x02, 0x03, 0x04, 0x05 };
+
+	// Segments of 21, 3 and 1 blocks, then 7 bytes, processed out of order
+	const size_t bounds[] = {0, 336, 384, 400, 407};
+
+	uint8_t plaintext[407], expected[407], output[407], expected_tag[16], tag[16];
+	aes_gcm_segment_t segments[4];
+	aes_gcm_context_t gcm;
+	aes_ghash_key_t hkey;
+	aes_context_t ctx;
+
+	for (size_t i = 0; i < sizeof(plaintext); ++i)
+		plaintext[i] = (uint8_t)(i * 31 + 1);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash_key_init(&hkey, &ctx));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_encrypt(&ctx, &hkey, iv, sizeof(iv), aad, sizeof(aad), plaintext, sizeof(plaintext), expected, expected_tag, 16));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_init(&gcm, &ctx, &hkey, iv, sizeof(iv)));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_update_aad(&gcm, aad, sizeof(aad)));
+
+	for (size_t i = 4; i-- > 0;)
+		TEST_ASSERT_EQUAL_INT(0, aes_gcm_encrypt_segment(&gcm, bounds[i], plaintext + bounds[i], bounds[i + 1] - bounds[i], output + bounds[i], &segments[i]));
+
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(output));
+
+	// A partial block is only allowed at the end
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_gcm_append_segments(&gcm, segments + 3, 2));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_append_segments(&gcm, segments, 4));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_finish(&gcm, tag, 16));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, 16);
+
+	// Serial text, then segments: decrypt 4 blocks, then the rest in two segments
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_init(&gcm, &ctx, &hkey, iv, sizeof(iv)));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_update_aad(&gcm, aad, sizeof(aad)));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_decrypt_update(&gcm, expected, 64, output));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_decrypt_segment(&gcm, 0, expected + 64, 160, output + 64, &segments[0]));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_decrypt_segment(&gcm, 160, expected + 224, 183, output + 224, &segments[1]));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_append_segments(&gcm, segments, 2));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_verify(&gcm, expected_tag, 16));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, output, sizeof(output));
+}
+
+void register_aes_gcm_tests(void)
+{
+	RUN_TEST(test_gcm_encrypt_128_zero);
+	RUN_TEST(test_gcm_encrypt_128_aad);
+	RUN_TEST(test_gcm_encrypt_192_long_iv);
+	RUN_TEST(test_gcm_encrypt_256_long_iv_aad);
+	RUN_TEST(test_gcm_incremental_matches_one_shot);
+	RUN_TEST(test_gcm_decrypt_rejects_forgery);
+	RUN_TEST(test_gcm_truncated_tag);
+	RUN_TEST(test_gcm_segments_match_serial);
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "unity/unity.h"
+#include "aes/modes/aes_gcm_siv.h"
+#include <string.h>
+
+void test_gcm_siv_rfc8452_128(void)
+{
+	// RFC 8452 appendix C.1: empty message, 8-byte plaintext, and 1-byte AAD
+	const uint8_t key[16] = {
+		0x01, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00
+	};
+
+	const uint8_t nonce[12] = {
+		0x03, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00
+	};
+
+	const uint8_t aad[1] = {0x01};
+	const uint8_t plaintext_1[8] = {0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+	const uint8_t plaintext_2[8] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+	const uint8_t expected_tag_empty[16] = {0xdc, 0x20, 0xe2, 0xd8, 0x3f, 0x25, 0x70, 0x5b, 0xb4, 0x9e, 0x43, 0x9e, 0xca, 0x56, 0xde, 0x25};
+	const uint8_t expected_1[8] = {0xb5, 0xd8, 0x39, 0x33, 0x0a, 0xc7, 0xb7, 0x86};
+	const uint8_t expected_tag_1[16] = {0x57, 0x87, 0x82, 0xff, 0xf6, 0x01, 0x3b, 0x81, 0x5b, 0x28, 0x7c, 0x22, 0x49, 0x3a, 0x36, 0x4c};
+	const uint8_t expected_2[8] = {0x1e, 0x6d, 0xab, 0xa3, 0x56, 0x69, 0xf4, 0x27};
+	const uint8_t expected_tag_2[16] = {0x3b, 0x0a, 0x1a, 0x25, 0x60, 0x96, 0x9c, 0xdf, 0x79, 0x0d, 0x99, 0x75, 0x9a, 0xbd, 0x15, 0x08};
+
+	uint8_t output[8];
+	uint8_t decrypted[8];
+	uint8_t tag[16];
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_siv_encrypt(&ctx, nonce, NULL, 0, NULL, 0, NULL, tag));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag_empty, tag, 16);
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_siv_decrypt(&ctx, nonce, NULL, 0, NULL, 0, NULL, tag));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_siv_encrypt(&ctx, nonce, NULL, 0, plaintext_1, 8, output, tag));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_1, output, 8);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag_1, tag, 16);
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_siv_decrypt(&ctx, nonce, NULL, 0, output, 8, decrypted, tag));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext_1, decrypted, 8);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_siv_encrypt(&ctx, nonce, aad, 1, plaintext_2, 8, output, tag));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_2, output, 8);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag_2, tag, 16);
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_siv_decrypt(&ctx, nonce, aad, 1, output, 8, decrypted, tag));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext_2, decrypted, 8);
+}
+
+void test_gcm_siv_rfc8452_256(void)
+{
+	// RFC 8452 appendix C.2: empty message and 8-byte plaintext
+	uint8_t key[32] = {0};
+	key[0] = 0x01;
+
+	const uint8_t nonce[12] = {
+		0x03, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00
+	};
+
+	const uint8_t plaintext[8] = {0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+	const uint8_t expected_tag_empty[16] = {0x07, 0xf5, 0xf4, 0x16, 0x9b, 0xbf, 0x55, 0xa8, 0x40, 0x0c, 0xd4, 0x7e, 0xa6, 0xfd, 0x40, 0x0f};
+	const uint8_t expected[8] = {0xc2, 0xef, 0x32, 0x8e, 0x5c, 0x71, 0xc8, 0x3b};
+	const uint8_t expected_tag[16] = {0x84, 0x31, 0x22, 0x13, 0x0f, 0x73, 0x64, 0xb7, 0x61, 0xe0, 0xb9, 0x74, 0x27, 0xe3, 0xdf, 0x28};
+
+	uint8_t output[8];
+	uint8_t tag[16];
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_siv_encrypt(&ctx, nonce, NULL, 0, NULL, 0, NULL, tag));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag_empty, tag, 16);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_siv_encrypt(&ctx, nonce, NULL, 0, plaintext, 8, output, tag));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, 8);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, 16);
+}
+
+void test_gcm_siv_multi_batch(void)
+{
+	// 600 bytes: more than one keystream batch, and a partial last block
+	const uint8_t key[32] = {
+		0x03, 0x0a, 0x11, 0x18,
+		0x1f, 0x26, 0x2d, 0x34,
+		0x3b, 0x42, 0x49, 0x50,
+		0x57, 0x5e, 0x65, 0x6c,
+		0x73, 0x7a, 0x81, 0x88,
+		0x8f, 0x96, 0x9d, 0xa4,
+		0xab, 0xb2, 0xb9, 0xc0,
+		0xc7, 0xce, 0xd5, 0xdc
+	};
+
+	const uint8_t nonce[12] = {
+		0x01, 0x06, 0x0b, 0x10,
+		0x15, 0x1a, 0x1f, 0x24,
+		0x29, 0x2e, 0x33, 0x38
+	};
+
+	const uint8_t expected_first[16] = {0x51, 0x31, 0x7b, 0xbc, 0xfe, 0xf9, 0x19, 0xa6, 0x54, 0x89, 0x23, 0x49, 0xbb, 0x26, 0x3b, 0x79};
+	const uint8_t expected_last[16] = {0xd2, 0x56, 0xaf, 0x4c, 0x30, 0x84, 0x31, 0xcf, 0x2b, 0xe1, 0x81, 0x2f, 0x3a, 0x6e, 0x8e, 0xc1};
+	const uint8_t expected_tag[16] = {0x55, 0xb5, 0x63, 0xec, 0xf3, 0xb9, 0x1a, 0xb1, 0x17, 0x98, 0xd9, 0xc1, 0x4f, 0xc2, 0x4f, 0x39};
+
+	enum { LEN = 600, AAD_LEN = 40 };
+	uint8_t plaintext[LEN];
+	uint8_t buffer[LEN];
+	uint8_t aad[AAD_LEN];
+	uint8_t tag[16];
+	aes_context_t ctx;
+
+	for (size_t i = 0; i < LEN; ++i)
+		plaintext[i] = (uint8_t)(i * 13 + 5);
+	for (size_t i = 0; i < AAD_LEN; ++i)
+		aad[i] = (uint8_t)(i * 3);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+
+	// In place
+	memcpy(buffer, plaintext, LEN);
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_siv_encrypt(&ctx, nonce, aad, AAD_LEN, buffer, LEN, buffer, tag));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_first, buffer, 16);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_last, buffer + LEN - 16, 16);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, 16);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_siv_decrypt(&ctx, nonce, aad, AAD_LEN, buffer, LEN, buffer, tag));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, buffer, LEN);
+}
+
+void test_gcm_siv_tamper_and_invalid(void)
+{
+	const uint8_t key[24] = {0};
+	const uint8_t nonce[12] = {0};
+	uint8_t plaintext[40];
+	uint8_t ciphertext[40];
+	uint8_t buffer[40];
+	uint8_t zeros[40] = {0};
+	uint8_t tag[16];
+	aes_context_t ctx;
+
+	for (size_t i = 0; i < sizeof(plaintext); ++i)
+		plaintext[i] = (uint8_t)i;
+
+	// AES-192 is not defined for GCM-SIV
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_192));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_gcm_siv_encrypt(&ctx, nonce, NULL, 0, plaintext, sizeof(plaintext), ciphertext, tag));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_gcm_siv_encrypt(&ctx, NULL, NULL, 0, plaintext, sizeof(plaintext), ciphertext, tag));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_gcm_siv_encrypt(&ctx, nonce, NULL, 3, plaintext, sizeof(plaintext), ciphertext, tag));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_siv_encrypt(&ctx, nonce, NULL, 0, plaintext, sizeof(plaintext), ciphertext, tag));
+
+	// Modified ciphertext: rejected and the output is zeroed
+	ciphertext[20] ^= 0x04;
+	memset(buffer, 0xaa, sizeof(buffer));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_gcm_siv_decrypt(&ctx, nonce, NULL, 0, ciphertext, sizeof(ciphertext), buffer, tag));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(zeros, buffer, sizeof(buffer));
+	ciphertext[20] ^= 0x04;
+
+	tag[15] ^= 0x80;
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_gcm_siv_decrypt(&ctx, nonce, NULL, 0, ciphertext, sizeof(ciphertext), buffer, tag));
+	tag[15] ^= 0x80;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_siv_decrypt(&ctx, nonce, NULL, 0, ciphertext, sizeof(ciphertext), buffer, tag));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, buffer, sizeof(plaintext));
+}
+
+void register_aes_gcm_siv_tests(void)
+{
+	RUN_TEST(test_gcm_siv_rfc8452_128);
+	RUN_TEST(test_gcm_siv_rfc8452_256);
+	RUN_TEST(test_gcm_siv_multi_batch);
+	RUN_TEST(test_gcm_siv_tamper_and_invalid);
+}
\ No newline at end of file
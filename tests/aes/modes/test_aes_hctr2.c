@@ -0,0 +1,218 @@
+#include "unity/unity.h"
+#include "aes/modes/aes_hctr2.h"
+#include "aes/modes/aes_ecb.h"
+#include "aes/mac/aes_polyval.h"
+#include <string.h>
+
+/**
+ * @brief Hash of HCTR2 (Crowley, Huckleberry, Biggers, "Length-preserving
+ *        encryption with HCTR2", IACR ePrint 2021/1441, section 3), written
+ *        directly from its definition.
+ */
+static void hctr2_reference_hash(const aes_polyval_key_t* hash_key, const uint8_t* tweak, size_t tweak_len, const uint8_t* data, size_t len, uint8_t* digest)
+{
+	uint8_t block[AES_BLOCK_SIZE] = {0};
+	uint64_t encoding = 2 * 8 * (uint64_t)tweak_len + (len % AES_BLOCK_SIZE ? 3 : 2);
+	const uint8_t one = 1;
+	aes_polyval_t polyval;
+
+	for (size_t i = 0; i < 8; ++i)
+		block[i] = (uint8_t)(encoding >> (8 * i));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_polyval_init(&polyval, hash_key));
+	TEST_ASSERT_EQUAL_INT(0, aes_polyval_update(&polyval, block, sizeof(block)));
+	TEST_ASSERT_EQUAL_INT(0, aes_polyval_update(&polyval, tweak, tweak_len));
+	TEST_ASSERT_EQUAL_INT(0, aes_polyval_pad(&polyval));
+	TEST_ASSERT_EQUAL_INT(0, aes_polyval_update(&polyval, data, len));
+	if (len % AES_BLOCK_SIZE)
+		TEST_ASSERT_EQUAL_INT(0, aes_polyval_update(&polyval, &one, 1));
+	TEST_ASSERT_EQUAL_INT(0, aes_polyval_final(&polyval, digest));
+}
+
+/**
+ * @brief HCTR2 encryption written directly from its definition, one block at
+ *        a time, on top of AES-ECB and POLYVAL (both checked against FIPS-197
+ *        and RFC 8452 vectors).
+ */
+static void hctr2_reference_encrypt(const aes_context_t* ctx, const uint8_t* tweak, size_t tweak_len, const uint8_t* input, size_t len, uint8_t* output)
+{
+	uint8_t h[AES_BLOCK_SIZE] = {0};
+	uint8_t l[AES_BLOCK_SIZE] = {1};
+	uint8_t digest[AES_BLOCK_SIZE];
+	uint8_t mm[AES_BLOCK_SIZE];
+	uint8_t uu[AES_BLOCK_SIZE];
+	uint8_t s[AES_BLOCK_SIZE];
+	aes_polyval_key_t hash_key;
+
+	aes_ecb_encrypt(ctx, h, sizeof(h), h);
+	aes_ecb_encrypt(ctx, l, sizeof(l), l);
+	TEST_ASSERT_EQUAL_INT(0, aes_polyval_key_init(&hash_key, h));
+
+	// MM = M ^ H(T, N), UU = E(MM), S = MM ^ UU ^ L
+	hctr2_reference_hash(&hash_key, tweak, tweak_len, input + AES_BLOCK_SIZE, len - AES_BLOCK_SIZE, digest);
+	for (size_t i = 0; i < AES_BLOCK_SIZE; ++i)
+		mm[i] = input[i] ^ digest[i];
+	aes_ecb_encrypt(ctx, mm, sizeof(mm), uu);
+	for (size_t i = 0; i < AES_BLOCK_SIZE; ++i)
+		s[i] = mm[i] ^ uu[i] ^ l[i];
+
+	// V = N ^ XCTR(S), with counters S ^ LE(1), S ^ LE(2), ...
+	for (size_t offset = AES_BLOCK_SIZE; offset < len; offset += AES_BLOCK_SIZE)
+	{
+		uint8_t keystream[AES_BLOCK_SIZE];
+		uint64_t counter = offset / AES_BLOCK_SIZE;
+
+		memcpy(keystream, s, sizeof(keystream));
+		for (size_t i = 0; i < 8; ++i)
+			keystream[i] ^= (uint8_t)(counter >> (8 * i));
+		aes_ecb_encrypt(ctx, keystream, sizeof(keystream), keystream);
+
+		for (size_t i = 0; i < AES_BLOCK_SIZE && offset + i < len; ++i)
+			output[offset + i] = input[offset + i] ^ keystream[i];
+	}
+
+	// U = UU ^ H(T, V)
+	hctr2_reference_hash(&hash_key, tweak, tweak_len, output + AES_BLOCK_SIZE, len - AES_BLOCK_SIZE, digest);
+	for (size_t i = 0; i < AES_BLOCK_SIZE; ++i)
+		output[i] = uu[i] ^ digest[i];
+}
+
+void test_hctr2_reference(void)
+{
+	// Every key size, tweak lengths around a block, whole and partial final blocks
+	static const size_t key_sizes[] = {AES_128, AES_192, AES_256};
+	static const size_t tweak_lens[] = {0, 5, 16, 32};
+	static const size_t lens[] = {16, 17, 31, 32, 40, 128, 143, 255};
+	uint8_t key[32];
+	uint8_t tweak[32];
+	uint8_t plaintext[255];
+	uint8_t expected[255];
+	uint8_t output[255];
+	uint8_t decrypted[255];
+	aes_context_t ctx;
+	aes_hctr2_key_t hctr2_key;
+
+	for (size_t i = 0; i < sizeof(key); ++i)
+		key[i] = (uint8_t)i;
+	for (size_t i = 0; i < sizeof(tweak); ++i)
+		tweak[i] = (uint8_t)(0x20 + i);
+	for (size_t i = 0; i < sizeof(plaintext); ++i)
+		plaintext[i] = (uint8_t)(i * 7 + 3);
+
+	for (size_t k = 0; k < sizeof(key_sizes) / sizeof(key_sizes[0]); ++k)
+	{
+		TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, key_sizes[k]));
+		TEST_ASSERT_EQUAL_INT(0, aes_hctr2_key_init(&hctr2_key, &ctx));
+
+		for (size_t t = 0; t < sizeof(tweak_lens) / sizeof(tweak_lens[0]); ++t)
+		{
+			for (size_t m = 0; m < sizeof(lens) / sizeof(lens[0]); ++m)
+			{
+				hctr2_reference_encrypt(&ctx, tweak, tweak_lens[t], plaintext, lens[m], expected);
+
+				TEST_ASSERT_EQUAL_INT(0, aes_hctr2_encrypt(&hctr2_key, tweak, tweak_lens[t], plaintext, lens[m], output));
+				TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, lens[m]);
+				TEST_ASSERT_EQUAL_INT(0, aes_hctr2_decrypt(&hctr2_key, tweak, tweak_lens[t], output, lens[m], decrypted));
+				TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, lens[m]);
+			}
+		}
+	}
+}
+
+void test_hctr2_4096_in_place(void)
+{
+	// A full page: several 8-block groups, AES-128, short tweak
+	const uint8_t key[16] = {
+		0x01, 0x08, 0x0f, 0x16,
+		0x1d, 0x24, 0x2b, 0x32,
+		0x39, 0x40, 0x47, 0x4e,
+		0x55, 0x5c, 0x63, 0x6a
+	};
+
+	const uint8_t tweak[5] = {0x01, 0x02, 0x03, 0x04, 0x05};
+
+	enum { LEN = 4096 };
+	static uint8_t plaintext[LEN];
+	static uint8_t expected[LEN];
+	static uint8_t buffer[LEN];
+	aes_context_t ctx;
+	aes_hctr2_key_t hctr2_key;
+
+	for (size_t i = 0; i < LEN; ++i)
+		plaintext[i] = (uint8_t)(i * 13 + 5);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_hctr2_key_init(&hctr2_key, &ctx));
+	hctr2_reference_encrypt(&ctx, tweak, sizeof(tweak), plaintext, LEN, expected);
+
+	memcpy(buffer, plaintext, LEN);
+	TEST_ASSERT_EQUAL_INT(0, aes_hctr2_encrypt(&hctr2_key, tweak, sizeof(tweak), buffer, LEN, buffer));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buffer, LEN);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_hctr2_decrypt(&hctr2_key, tweak, sizeof(tweak), buffer, LEN, buffer));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, buffer, LEN);
+}
+
+void test_hctr2_lengths_and_diffusion(void)
+{
+	const uint8_t key[24] = {0x42};
+	const uint8_t tweak[16] = {0x07};
+	uint8_t plaintext[300];
+	uint8_t ciphertext[300];
+	uint8_t modified[300];
+	uint8_t buffer[300];
+	aes_context_t ctx;
+	aes_hctr2_key_t hctr2_key;
+
+	for (size_t i = 0; i < sizeof(plaintext); ++i)
+		plaintext[i] = (uint8_t)(i * 3 + 1);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_192));
+	TEST_ASSERT_EQUAL_INT(0, aes_hctr2_key_init(&hctr2_key, &ctx));
+
+	for (size_t len = AES_HCTR2_MIN_INPUT_SIZE; len <= sizeof(plaintext); len += 7)
+	{
+		TEST_ASSERT_EQUAL_INT(0, aes_hctr2_encrypt(&hctr2_key, tweak, sizeof(tweak), plaintext, len, ciphertext));
+		TEST_ASSERT_EQUAL_INT(0, aes_hctr2_decrypt(&hctr2_key, tweak, sizeof(tweak), ciphertext, len, buffer));
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, buffer, len);
+
+		// Flipping the last plaintext bit changes the first and the last ciphertext blocks
+		memcpy(modified, plaintext, len);
+		modified[len - 1] ^= 0x80;
+		TEST_ASSERT_EQUAL_INT(0, aes_hctr2_encrypt(&hctr2_key, tweak, sizeof(tweak), modified, len, buffer));
+		TEST_ASSERT_NOT_EQUAL(0, memcmp(buffer, ciphertext, AES_BLOCK_SIZE));
+		if (len >= 2 * AES_BLOCK_SIZE)
+			TEST_ASSERT_NOT_EQUAL(0, memcmp(buffer + len - AES_BLOCK_SIZE, ciphertext + len - AES_BLOCK_SIZE, AES_BLOCK_SIZE));
+
+		// So does a different tweak, or none
+		TEST_ASSERT_EQUAL_INT(0, aes_hctr2_encrypt(&hctr2_key, NULL, 0, plaintext, len, buffer));
+		TEST_ASSERT_NOT_EQUAL(0, memcmp(buffer, ciphertext, AES_BLOCK_SIZE));
+	}
+}
+
+void test_hctr2_invalid(void)
+{
+	const uint8_t key[16] = {0};
+	uint8_t buffer[32] = {0};
+	aes_context_t ctx;
+	aes_hctr2_key_t hctr2_key;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_hctr2_key_init(&hctr2_key, NULL));
+	TEST_ASSERT_EQUAL_INT(0, aes_hctr2_key_init(&hctr2_key, &ctx));
+
+	// Shorter than one block: no room for the wide-block construction
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_hctr2_encrypt(&hctr2_key, NULL, 0, buffer, AES_HCTR2_MIN_INPUT_SIZE - 1, buffer));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_hctr2_decrypt(&hctr2_key, NULL, 0, buffer, 0, buffer));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_hctr2_encrypt(&hctr2_key, NULL, 4, buffer, sizeof(buffer), buffer));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_hctr2_encrypt(&hctr2_key, NULL, 0, NULL, sizeof(buffer), buffer));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_hctr2_encrypt(NULL, NULL, 0, buffer, sizeof(buffer), buffer));
+}
+
+void register_aes_hctr2_tests(void)
+{
+	RUN_TEST(test_hctr2_reference);
+	RUN_TEST(test_hctr2_4096_in_place);
+	RUN_TEST(test_hctr2_lengths_and_diffusion);
+	RUN_TEST(test_hctr2_invalid);
+}
\ No newline at end of file
@@ -0,0 +1,278 @@
+#include "unity/unity.h"
+#include "aes/modes/aes_ocb.h"
+#include <string.h>
+#include <stdlib.h>
+
+void test_ocb_rfc7253_sample(void)
+{
+	// RFC 7253 appendix A, nonce BBAA99887766554433221101
+	const uint8_t key[16] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f
+	};
+
+	const uint8_t nonce[12] = {
+		0xbb, 0xaa, 0x99, 0x88,
+		0x77, 0x66, 0x55, 0x44,
+		0x33, 0x22, 0x11, 0x01
+	};
+
+	const uint8_t data[8] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07
+	};
+
+	const uint8_t expected[8] = {
+		0x68, 0x20, 0xb3, 0x65,
+		0x7b, 0x6f, 0x61, 0x5a
+	};
+
+	const uint8_t expected_tag[16] = {
+		0x57, 0x25, 0xbd, 0xa0,
+		0xd3, 0xb4, 0xeb, 0x3a,
+		0x25, 0x7c, 0x9a, 0xf1,
+		0xf8, 0xf0, 0x30, 0x09
+	};
+
+	uint8_t output[8] = {0};
+	uint8_t decrypted[8] = {0};
+	uint8_t tag[16] = {0};
+	aes_context_t ctx;
+	aes_ocb_key_t ocb_key;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_ocb_key_init(&ocb_key, &ctx));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ocb_encrypt(&ocb_key, nonce, sizeof(nonce), data, sizeof(data), data, sizeof(data), output, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(expected));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, sizeof(expected_tag));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ocb_decrypt(&ocb_key, nonce, sizeof(nonce), data, sizeof(data), output, sizeof(output), decrypted, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(data, decrypted, sizeof(data));
+}
+
+void test_ocb_rfc7253_96_bit_tag(void)
+{
+	// RFC 7253 appendix A, 96-bit tag, partial last block
+	const uint8_t key[16] = {
+		0x0f, 0x0e, 0x0d, 0x0c,
+		0x0b, 0x0a, 0x09, 0x08,
+		0x07, 0x06, 0x05, 0x04,
+		0x03, 0x02, 0x01, 0x00
+	};
+
+	const uint8_t nonce[12] = {
+		0xbb, 0xaa, 0x99, 0x88,
+		0x77, 0x66, 0x55, 0x44,
+		0x33, 0x22, 0x11, 0x0d
+	};
+
+	const uint8_t data[40] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f,
+		0x10, 0x11, 0x12, 0x13,
+		0x14, 0x15, 0x16, 0x17,
+		0x18, 0x19, 0x1a, 0x1b,
+		0x1c, 0x1d, 0x1e, 0x1f,
+		0x20, 0x21, 0x22, 0x23,
+		0x24, 0x25, 0x26, 0x27
+	};
+
+	const uint8_t expected[40] = {
+		0x17, 0x92, 0xa4, 0xe3,
+		0x1e, 0x07, 0x55, 0xfb,
+		0x03, 0xe3, 0x1b, 0x22,
+		0x11, 0x6e, 0x6c, 0x2d,
+		0xdf, 0x9e, 0xfd, 0x6e,
+		0x33, 0xd5, 0x36, 0xf1,
+		0xa0, 0x12, 0x4b, 0x0a,
+		0x55, 0xba, 0xe8, 0x84,
+		0xed, 0x93, 0x48, 0x15,
+		0x29, 0xc7, 0x6b, 0x6a
+	};
+
+	const uint8_t expected_tag[12] = {
+		0xd0, 0xc5, 0x15, 0xf4,
+		0xd1, 0xcd, 0xd4, 0xfd,
+		0xac, 0x4f, 0x02, 0xaa
+	};
+
+	uint8_t buffer[40];
+	uint8_t tag[12] = {0};
+	aes_context_t ctx;
+	aes_ocb_key_t ocb_key;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_ocb_key_init(&ocb_key, &ctx));
+
+	// In place
+	memcpy(buffer, data, sizeof(data));
+	TEST_ASSERT_EQUAL_INT(0, aes_ocb_encrypt(&ocb_key, nonce, sizeof(nonce), data, sizeof(data), buffer, sizeof(buffer), buffer, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buffer, sizeof(expected));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, sizeof(expected_tag));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ocb_decrypt(&ocb_key, nonce, sizeof(nonce), data, sizeof(data), buffer, sizeof(buffer), buffer, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(data, buffer, sizeof(data));
+}
+
+void test_ocb_rfc7253_iterated(void)
+{
+	// RFC 7253 appendix A: tag over 384 encryptions of 0..127-byte messages, for every key and tag length
+	const uint8_t expected[3][3][16] = {
+		{
+			{0x67, 0xe9, 0x44, 0xd2, 0x32, 0x56, 0xc5, 0xe0, 0xb6, 0xc6, 0x1f, 0xa2, 0x2f, 0xdf, 0x1e, 0xa2},
+			{0x77, 0xa3, 0xd8, 0xe7, 0x35, 0x89, 0x15, 0x8d, 0x25, 0xd0, 0x12, 0x09},
+			{0x19, 0x2c, 0x9b, 0x7b, 0xd9, 0x0b, 0xa0, 0x6a}
+		},
+		{
+			{0xf6, 0x73, 0xf2, 0xc3, 0xe7, 0x17, 0x4a, 0xae, 0x7b, 0xae, 0x98, 0x6c, 0xa9, 0xf2, 0x9e, 0x17},
+			{0x05, 0xd5, 0x6e, 0xad, 0x27, 0x52, 0xc8, 0x6b, 0xe6, 0x93, 0x2c, 0x5e},
+			{0x00, 0x66, 0xbc, 0x6e, 0x0e, 0xf3, 0x4e, 0x24}
+		},
+		{
+			{0xd9, 0x0e, 0xb8, 0xe9, 0xc9, 0x77, 0xc8, 0x8b, 0x79, 0xdd, 0x79, 0x3d, 0x7f, 0xfa, 0x16, 0x1c},
+			{0x54, 0x58, 0x35, 0x9a, 0xc2, 0x3b, 0x0c, 0xba, 0x9e, 0x63, 0x30, 0xdd},
+			{0x7d, 0x4e, 0xa5, 0xd4, 0x45, 0x50, 0x1c, 0xbe}
+		}
+	};
+
+	const size_t key_sizes[3] = {AES_128, AES_192, AES_256};
+	const size_t tag_sizes[3] = {16, 12, 8};
+	const uint8_t zeros[128] = {0};
+	uint8_t* output = malloc(3 * 128 * (128 + 16));
+
+	TEST_ASSERT_NOT_NULL(output);
+
+	for (int k = 0; k < 3; ++k)
+	{
+		for (int t = 0; t < 3; ++t)
+		{
+			size_t tag_len = tag_sizes[t];
+			uint8_t key[32] = {0};
+			uint8_t nonce[12] = {0};
+			uint8_t tag[16];
+			size_t len = 0;
+			aes_context_t ctx;
+			aes_ocb_key_t ocb_key;
+
+			key[key_sizes[k] - 1] = (uint8_t)(tag_len * 8);
+			TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, key_sizes[k]));
+			TEST_ASSERT_EQUAL_INT(0, aes_ocb_key_init(&ocb_key, &ctx));
+
+			for (size_t i = 0; i < 128; ++i)
+			{
+				// N = num2str(3i+1, 96): both, N = num2str(3i+2, 96): plaintext only, N = num2str(3i+3, 96): AAD only
+				nonce[10] = (uint8_t)((3 * i + 1) >> 8);
+				nonce[11] = (uint8_t)(3 * i + 1);
+				TEST_ASSERT_EQUAL_INT(0, aes_ocb_encrypt(&ocb_key, nonce, sizeof(nonce), zeros, i, zeros, i, output + len, output + len + i, tag_len));
+				len += i + tag_len;
+
+				nonce[10] = (uint8_t)((3 * i + 2) >> 8);
+				nonce[11] = (uint8_t)(3 * i + 2);
+				TEST_ASSERT_EQUAL_INT(0, aes_ocb_encrypt(&ocb_key, nonce, sizeof(nonce), NULL, 0, zeros, i, output + len, output + len + i, tag_len));
+				len += i + tag_len;
+
+				nonce[10] = (uint8_t)((3 * i + 3) >> 8);
+				nonce[11] = (uint8_t)(3 * i + 3);
+				TEST_ASSERT_EQUAL_INT(0, aes_ocb_encrypt(&ocb_key, nonce, sizeof(nonce), zeros, i, NULL, 0, NULL, output + len, tag_len));
+				len += tag_len;
+			}
+
+			nonce[10] = (uint8_t)(385 >> 8);
+			nonce[11] = (uint8_t)385;
+			TEST_ASSERT_EQUAL_INT(0, aes_ocb_encrypt(&ocb_key, nonce, sizeof(nonce), output, len, NULL, 0, NULL, tag, tag_len));
+			TEST_ASSERT_EQUAL_UINT8_ARRAY(expected[k][t], tag, tag_len);
+		}
+	}
+
+	free(output);
+}
+
+void test_ocb_roundtrip_and_tamper(void)
+{
+	const uint8_t key[32] = {
+		0x60, 0x3d, 0xeb, 0x10,
+		0x15, 0xca, 0x71, 0xbe,
+		0x2b, 0x73, 0xae, 0xf0,
+		0x85, 0x7d, 0x77, 0x81,
+		0x1f, 0x35, 0x2c, 0x07,
+		0x3b, 0x61, 0x08, 0xd7,
+		0x2d, 0x98, 0x10, 0xa3,
+		0x09, 0x14, 0xdf, 0xf4
+	};
+
+	const uint8_t nonce[12] = {
+		0xca, 0xfe, 0xba, 0xbe,
+		0xfa, 0xce, 0xdb, 0xad,
+		0xde, 0xca, 0xf8, 0x88
+	};
+
+	// 8-block groups, single blocks and a partial tail
+	enum { LEN = 300 };
+	uint8_t plaintext[LEN];
+	uint8_t ciphertext[LEN];
+	uint8_t buffer[LEN];
+	uint8_t zeros[LEN] = {0};
+	uint8_t tag[16];
+	aes_context_t ctx;
+	aes_ocb_key_t ocb_key;
+
+	for (size_t i = 0; i < LEN; ++i)
+		plaintext[i] = (uint8_t)(i * 11 + 1);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_256));
+	TEST_ASSERT_EQUAL_INT(0, aes_ocb_key_init(&ocb_key, &ctx));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_ocb_encrypt(&ocb_key, nonce, sizeof(nonce), plaintext, 150, plaintext, LEN, ciphertext, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_INT(0, aes_ocb_decrypt(&ocb_key, nonce, sizeof(nonce), plaintext, 150, ciphertext, LEN, buffer, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, buffer, LEN);
+
+	// Modified ciphertext: rejected and the output is zeroed
+	ciphertext[100] ^= 0x01;
+	memset(buffer, 0xaa, LEN);
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ocb_decrypt(&ocb_key, nonce, sizeof(nonce), plaintext, 150, ciphertext, LEN, buffer, tag, sizeof(tag)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(zeros, buffer, LEN);
+	ciphertext[100] ^= 0x01;
+
+	// Modified AAD, wrong tag length
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ocb_decrypt(&ocb_key, nonce, sizeof(nonce), plaintext, 149, ciphertext, LEN, buffer, tag, sizeof(tag)));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ocb_decrypt(&ocb_key, nonce, sizeof(nonce), plaintext, 150, ciphertext, LEN, buffer, tag, 12));
+}
+
+void test_ocb_invalid_arguments(void)
+{
+	const uint8_t key[16] = {0};
+	const uint8_t nonce[16] = {0};
+	uint8_t buffer[32] = {0};
+	uint8_t tag[16] = {0};
+	aes_context_t ctx;
+	aes_ocb_key_t ocb_key;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_ocb_key_init(&ocb_key, &ctx));
+
+	// Nonce lengths outside 1..15
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ocb_encrypt(&ocb_key, nonce, 0, NULL, 0, buffer, sizeof(buffer), buffer, tag, 16));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ocb_encrypt(&ocb_key, nonce, 16, NULL, 0, buffer, sizeof(buffer), buffer, tag, 16));
+
+	// Tag lengths
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ocb_encrypt(&ocb_key, nonce, 12, NULL, 0, buffer, sizeof(buffer), buffer, tag, 3));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ocb_encrypt(&ocb_key, nonce, 12, NULL, 0, buffer, sizeof(buffer), buffer, tag, 17));
+
+	// Missing buffers
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ocb_encrypt(&ocb_key, nonce, 12, NULL, 4, buffer, sizeof(buffer), buffer, tag, 16));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_ocb_encrypt(&ocb_key, nonce, 12, NULL, 0, buffer, sizeof(buffer), NULL, tag, 16));
+}
+
+void register_aes_ocb_tests(void)
+{
+	RUN_TEST(test_ocb_rfc7253_sample);
+	RUN_TEST(test_ocb_rfc7253_96_bit_tag);
+	RUN_TEST(test_ocb_rfc7253_iterated);
+	RUN_TEST(test_ocb_roundtrip_and_tamper);
+	RUN_TEST(test_ocb_invalid_arguments);
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "unity/unity.h"
 #include "aes/modes/aes_ofb.h"
 #include "aes/core/aes_key_expansion.h"
+#include <string.h>
 
 void test_ofb_crypt_128(void)
 {
@@ -122,9 +123,68 @@ void test_ofb_crypt_256(void)
 	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, 16);
 }
 
+void test_ofb_crypt_192_partial_block_in_place(void)
+{
+	const uint8_t key[24] = {
+		0x8e, 0x73, 0xb0, 0xf7,
+		0xda, 0x0e, 0x64, 0x52,
+		0xc8, 0x10, 0xf3, 0x2b,
+		0x80, 0x90, 0x79, 0xe5,
+		0x62, 0xf8, 0xea, 0xd2,
+		0x52, 0x2c, 0x6b, 0x7b
+	};
+
+	const uint8_t iv[16] = {
+		0x00, 0x01, 0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0a, 0x0b,
+		0x0c, 0x0d, 0x0e, 0x0f
+	};
+
+	const uint8_t plaintext[37] = {
+		0x05, 0x12, 0x1f, 0x2c,
+		0x39, 0x46, 0x53, 0x60,
+		0x6d, 0x7a, 0x87, 0x94,
+		0xa1, 0xae, 0xbb, 0xc8,
+		0xd5, 0xe2, 0xef, 0xfc,
+		0x09, 0x16, 0x23, 0x30,
+		0x3d, 0x4a, 0x57, 0x64,
+		0x71, 0x7e, 0x8b, 0x98,
+		0xa5, 0xb2, 0xbf, 0xcc,
+		0xd9
+	};
+
+	const uint8_t expected[37] = {
+		0xa3, 0x1b, 0xac, 0xa1,
+		0xca, 0xf7, 0x40, 0x5d,
+		0xb0, 0x85, 0xa0, 0x8c,
+		0x1b, 0xa7, 0xed, 0x96,
+		0x87, 0x0d, 0xee, 0x26,
+		0x5b, 0x76, 0x0c, 0xd0,
+		0xaa, 0x15, 0x2f, 0xc8,
+		0xf5, 0xc1, 0x01, 0xc8,
+		0x18, 0xe0, 0x39, 0x60,
+		0xba
+	};
+
+	// 2 full blocks and a 5-byte tail, processed in place
+	uint8_t buffer[37];
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, key, AES_192));
+
+	memcpy(buffer, plaintext, sizeof(buffer));
+	aes_ofb_crypt(&ctx, iv, buffer, sizeof(buffer), buffer);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buffer, sizeof(buffer));
+
+	aes_ofb_crypt(&ctx, iv, buffer, sizeof(buffer), buffer);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, buffer, sizeof(buffer));
+}
+
 void register_aes_ofb_tests(void)
 {
 	RUN_TEST(test_ofb_crypt_128);
 	RUN_TEST(test_ofb_crypt_192);
 	RUN_TEST(test_ofb_crypt_256);
+	RUN_TEST(test_ofb_crypt_192_partial_block_in_place);
 }
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "unity/unity.h"
+#include "aes/modes/aes_siv.h"
+#include <string.h>
+
+void test_siv_rfc5297_deterministic(void)
+{
+	// RFC 5297 appendix A.1: one associated data component, no nonce
+	const uint8_t key[32] = {
+		0xff, 0xfe, 0xfd, 0xfc,
+		0xfb, 0xfa, 0xf9, 0xf8,
+		0xf7, 0xf6, 0xf5, 0xf4,
+		0xf3, 0xf2, 0xf1, 0xf0,
+		0xf0, 0xf1, 0xf2, 0xf3,
+		0xf4, 0xf5, 0xf6, 0xf7,
+		0xf8, 0xf9, 0xfa, 0xfb,
+		0xfc, 0xfd, 0xfe, 0xff
+	};
+
+	const uint8_t aad[24] = {
+		0x10, 0x11, 0x12, 0x13,
+		0x14, 0x15, 0x16, 0x17,
+		0x18, 0x19, 0x1a, 0x1b,
+		0x1c, 0x1d, 0x1e, 0x1f,
+		0x20, 0x21, 0x22, 0x23,
+		0x24, 0x25, 0x26, 0x27
+	};
+
+	const uint8_t plaintext[14] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee};
+	const uint8_t expected_siv[16] = {0x85, 0x63, 0x2d, 0x07, 0xc6, 0xe8, 0xf3, 0x7f, 0x95, 0x0a, 0xcd, 0x32, 0x0a, 0x2e, 0xcc, 0x93};
+	const uint8_t expected[14] = {0x40, 0xc0, 0x2b, 0x96, 0x90, 0xc4, 0xdc, 0x04, 0xda, 0xef, 0x7f, 0x6a, 0xfe, 0x5c};
+
+	const uint8_t* components[1] = {aad};
+	const size_t lengths[1] = {sizeof(aad)};
+	uint8_t output[14];
+	uint8_t decrypted[14];
+	uint8_t siv[16];
+	aes_context_t mac_ctx;
+	aes_context_t ctr_ctx;
+	aes_siv_key_t siv_key;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&mac_ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctr_ctx, key + 16, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_siv_key_init(&siv_key, &mac_ctx, &ctr_ctx));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_siv_encrypt(&siv_key, components, lengths, 1, plaintext, sizeof(plaintext), output, siv));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_siv, siv, 16);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(expected));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_siv_decrypt(&siv_key, components, lengths, 1, output, sizeof(output), decrypted, siv));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, decrypted, sizeof(plaintext));
+}
+
+void test_siv_rfc5297_nonce_based(void)
+{
+	// RFC 5297 appendix A.2: two associated data components followed by a nonce
+	const uint8_t key[32] = {
+		0x7f, 0x7e, 0x7d, 0x7c,
+		0x7b, 0x7a, 0x79, 0x78,
+		0x77, 0x76, 0x75, 0x74,
+		0x73, 0x72, 0x71, 0x70,
+		0x40, 0x41, 0x42, 0x43,
+		0x44, 0x45, 0x46, 0x47,
+		0x48, 0x49, 0x4a, 0x4b,
+		0x4c, 0x4d, 0x4e, 0x4f
+	};
+
+	const uint8_t aad_1[40] = {
+		0x00, 0x11, 0x22, 0x33,
+		0x44, 0x55, 0x66, 0x77,
+		0x88, 0x99, 0xaa, 0xbb,
+		0xcc, 0xdd, 0xee, 0xff,
+		0xde, 0xad, 0xda, 0xda,
+		0xde, 0xad, 0xda, 0xda,
+		0xff, 0xee, 0xdd, 0xcc,
+		0xbb, 0xaa, 0x99, 0x88,
+		0x77, 0x66, 0x55, 0x44,
+		0x33, 0x22, 0x11, 0x00
+	};
+
+	const uint8_t aad_2[10] = {0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80, 0x90, 0xa0};
+
+	const uint8_t nonce[16] = {
+		0x09, 0xf9, 0x11, 0x02,
+		0x9d, 0x74, 0xe3, 0x5b,
+		0xd8, 0x41, 0x56, 0xc5,
+		0x63, 0x56, 0x88, 0xc0
+	};
+
+	const uint8_t plaintext[47] = {
+		0x74, 0x68, 0x69, 0x73,
+		0x20, 0x69, 0x73, 0x20,
+		0x73, 0x6f, 0x6d, 0x65,
+		0x20, 0x70, 0x6c, 0x61,
+		0x69, 0x6e, 0x74, 0x65,
+		0x78, 0x74, 0x20, 0x74,
+		0x6f, 0x20, 0x65, 0x6e,
+		0x63, 0x72, 0x79, 0x70,
+		0x74, 0x20, 0x75, 0x73,
+		0x69, 0x6e, 0x67, 0x20,
+		0x53, 0x49, 0x56, 0x2d,
+		0x41, 0x45, 0x53
+	};
+
+	const uint8_t expected_siv[16] = {0x7b, 0xdb, 0x6e, 0x3b, 0x43, 0x26, 0x67, 0xeb, 0x06, 0xf4, 0xd1, 0x4b, 0xff, 0x2f, 0xbd, 0x0f};
+
+	const uint8_t expected[47] = {
+		0xcb, 0x90, 0x0f, 0x2f,
+		0xdd, 0xbe, 0x40, 0x43,
+		0x26, 0x60, 0x19, 0x65,
+		0xc8, 0x89, 0xbf, 0x17,
+		0xdb, 0xa7, 0x7c, 0xeb,
+		0x09, 0x4f, 0xa6, 0x63,
+		0xb7, 0xa3, 0xf7, 0x48,
+		0xba, 0x8a, 0xf8, 0x29,
+		0xea, 0x64, 0xad, 0x54,
+		0x4a, 0x27, 0x2e, 0x9c,
+		0x48, 0x5b, 0x62, 0xa3,
+		0xfd, 0x5c, 0x0d
+	};
+
+	const uint8_t* components[3] = {aad_1, aad_2, nonce};
+	const size_t lengths[3] = {sizeof(aad_1), sizeof(aad_2), sizeof(nonce)};
+	uint8_t buffer[sizeof(plaintext)];
+	uint8_t siv[16];
+	aes_context_t mac_ctx;
+	aes_context_t ctr_ctx;
+	aes_siv_key_t siv_key;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&mac_ctx, key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctr_ctx, key + 16, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_siv_key_init(&siv_key, &mac_ctx, &ctr_ctx));
+
+	// In place
+	memcpy(buffer, plaintext, sizeof(plaintext));
+	TEST_ASSERT_EQUAL_INT(0, aes_siv_encrypt(&siv_key, components, lengths, 3, buffer, sizeof(buffer), buffer, siv));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_siv, siv, 16);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buffer, sizeof(expected));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_siv_decrypt(&siv_key, components, lengths, 3, buffer, sizeof(buffer), buffer, siv));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, buffer, sizeof(plaintext));
+}
+
+void test_siv_batch_matches_single(void)
+{
+	// More records than CMAC lanes, on both sides of AES_SIV_BATCH_INLINE_SIZE
+	static const size_t input_lens[11] = {0, 1, 15, 16, 17, 64, 255, 256, 257, 600, 33};
+	static const size_t aad_lens[11] = {0, 16, 3, 40, 0, 1, 32, 17, 8, 64, 100};
+	enum { COUNT = 11, MAX_LEN = 600, MAX_AAD = 100 };
+
+	uint8_t key[64];
+	uint8_t plaintext[MAX_LEN];
+	uint8_t aad[MAX_AAD];
+	uint8_t expected[MAX_LEN];
+	uint8_t expected_siv[16];
+	static uint8_t outputs[COUNT][MAX_LEN];
+	uint8_t sivs[COUNT][16];
+	aes_siv_record_t records[COUNT];
+	aes_context_t mac_ctx;
+	aes_context_t ctr_ctx;
+	aes_siv_key_t siv_key;
+
+	for (size_t i = 0; i < sizeof(key); ++i)
+		key[i] = (uint8_t)(i * 7 + 1);
+	for (size_t i = 0; i < MAX_LEN; ++i)
+		plaintext[i] = (uint8_t)(i * 11 + 3);
+	for (size_t i = 0; i < MAX_AAD; ++i)
+		aad[i] = (uint8_t)(i * 5);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&mac_ctx, key, AES_256));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctr_ctx, key + 32, AES_256));
+	TEST_ASSERT_EQUAL_INT(0, aes_siv_key_init(&siv_key, &mac_ctx, &ctr_ctx));
+
+	for (size_t r = 0; r < COUNT; ++r)
+	{
+		// Record r starts at a different offset of the shared buffers
+		records[r].aad = aad + (MAX_AAD - aad_lens[r]);
+		records[r].aad_len = aad_lens[r];
+		records[r].input = plaintext + (MAX_LEN - input_lens[r]);
+		records[r].input_len = input_lens[r];
+		records[r].output = outputs[r];
+		records[r].siv = sivs[r];
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, aes_siv_encrypt_batch(&siv_key, records, COUNT));
+
+	for (size_t r = 0; r < COUNT; ++r)
+	{
+		const uint8_t* component = records[r].aad;
+		TEST_ASSERT_EQUAL_INT(0, aes_siv_encrypt(&siv_key, &component, &records[r].aad_len, 1,
+			records[r].input, records[r].input_len, expected, expected_siv));
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_siv, sivs[r], 16);
+		if (input_lens[r] > 0)
+			TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, outputs[r], input_lens[r]);
+	}
+}
+
+void test_siv_tamper_and_invalid(void)
+{
+	const uint8_t key[48] = {0};
+	const uint8_t aad[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+	const uint8_t* components[1] = {aad};
+	const size_t lengths[1] = {sizeof(aad)};
+	uint8_t plaintext[40];
+	uint8_t ciphertext[40];
+	uint8_t buffer[40];
+	uint8_t zeros[40] = {0};
+	uint8_t siv[16];
+	aes_context_t mac_ctx;
+	aes_context_t ctr_ctx;
+	aes_siv_key_t siv_key;
+
+	for (size_t i = 0; i < sizeof(plaintext); ++i)
+		plaintext[i] = (uint8_t)i;
+
+	// Both halves must have the same key size
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&mac_ctx, key, AES_192));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctr_ctx, key + 24, AES_128));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_siv_key_init(&siv_key, &mac_ctx, &ctr_ctx));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctr_ctx, key + 24, AES_192));
+	TEST_ASSERT_EQUAL_INT(0, aes_siv_key_init(&siv_key, &mac_ctx, &ctr_ctx));
+
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_siv_encrypt(&siv_key, components, lengths, AES_SIV_MAX_COMPONENTS + 1, plaintext, sizeof(plaintext), ciphertext, siv));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_siv_encrypt(&siv_key, NULL, lengths, 1, plaintext, sizeof(plaintext), ciphertext, siv));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_siv_encrypt(&siv_key, components, lengths, 1, plaintext, sizeof(plaintext), ciphertext, NULL));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_siv_encrypt(&siv_key, components, lengths, 1, plaintext, sizeof(plaintext), ciphertext, siv));
+
+	// Modified ciphertext: rejected and the output is zeroed
+	ciphertext[33] ^= 0x10;
+	memset(buffer, 0xaa, sizeof(buffer));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_siv_decrypt(&siv_key, components, lengths, 1, ciphertext, sizeof(ciphertext), buffer, siv));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(zeros, buffer, sizeof(buffer));
+	ciphertext[33] ^= 0x10;
+
+	// Associated data is bound to the synthetic IV, and so is its split into components
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_siv_decrypt(&siv_key, components, lengths, 0, ciphertext, sizeof(ciphertext), buffer, siv));
+
+	siv[0] ^= 0x01;
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_siv_decrypt(&siv_key, components, lengths, 1, ciphertext, sizeof(ciphertext), buffer, siv));
+	siv[0] ^= 0x01;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_siv_decrypt(&siv_key, components, lengths, 1, ciphertext, sizeof(ciphertext), buffer, siv));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, buffer, sizeof(plaintext));
+}
+
+void register_aes_siv_tests(void)
+{
+	RUN_TEST(test_siv_rfc5297_deterministic);
+	RUN_TEST(test_siv_rfc5297_nonce_based);
+	RUN_TEST(test_siv_batch_matches_single);
+	RUN_TEST(test_siv_tamper_and_invalid);
+}
\ No newline at end of file
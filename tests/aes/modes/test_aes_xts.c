@@ -0,0 +1,318 @@
+#include "unity/unity.h"
+#include "aes/modes/aes_xts.h"
+#include <string.h>
+#include <stdlib.h>
+
+void test_xts_encrypt_128(void)
+{
+	// IEEE 1619 XTS-AES-128 vector 2
+	const uint8_t data_key[16] = {
+		0x11, 0x11, 0x11, 0x11,
+		0x11, 0x11, 0x11, 0x11,
+		0x11, 0x11, 0x11, 0x11,
+		0x11, 0x11, 0x11, 0x11
+	};
+
+	const uint8_t tweak_key[16] = {
+		0x22, 0x22, 0x22, 0x22,
+		0x22, 0x22, 0x22, 0x22,
+		0x22, 0x22, 0x22, 0x22,
+		0x22, 0x22, 0x22, 0x22
+	};
+
+	const uint8_t tweak[16] = {
+		0x33, 0x33, 0x33, 0x33,
+		0x33, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00
+	};
+
+	const uint8_t plaintext[32] = {
+		0x44, 0x44, 0x44, 0x44,
+		0x44, 0x44, 0x44, 0x44,
+		0x44, 0x44, 0x44, 0x44,
+		0x44, 0x44, 0x44, 0x44,
+		0x44, 0x44, 0x44, 0x44,
+		0x44, 0x44, 0x44, 0x44,
+		0x44, 0x44, 0x44, 0x44,
+		0x44, 0x44, 0x44, 0x44
+	};
+
+	const uint8_t expected[32] = {
+		0xc4, 0x54, 0x18, 0x5e,
+		0x6a, 0x16, 0x93, 0x6e,
+		0x39, 0x33, 0x40, 0x38,
+		0xac, 0xef, 0x83, 0x8b,
+		0xfb, 0x18, 0x6f, 0xff,
+		0x74, 0x80, 0xad, 0xc4,
+		0x28, 0x93, 0x82, 0xec,
+		0xd6, 0xd3, 0x94, 0xf0
+	};
+
+	uint8_t output[32] = {0};
+	aes_context_t data_ctx, tweak_ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&data_ctx, data_key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&tweak_ctx, tweak_key, AES_128));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_xts_encrypt(&data_ctx, &tweak_ctx, tweak, plaintext, 32, output));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, 32);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_xts_decrypt(&data_ctx, &tweak_ctx, tweak, expected, 32, output));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, output, 32);
+}
+
+void test_xts_ciphertext_stealing_256(void)
+{
+	const uint8_t data_key[32] = {
+		0x27, 0x18, 0x28, 0x18,
+		0x28, 0x45, 0x90, 0x45,
+		0x23, 0x53, 0x60, 0x28,
+		0x74, 0x71, 0x35, 0x26,
+		0x62, 0x49, 0x77, 0x57,
+		0x24, 0x70, 0x93, 0x69,
+		0x99, 0x59, 0x57, 0x49,
+		0x66, 0x96, 0x76, 0x27
+	};
+
+	const uint8_t tweak_key[32] = {
+		0x31, 0x41, 0x59, 0x26,
+		0x53, 0x58, 0x97, 0x93,
+		0x23, 0x84, 0x62, 0x64,
+		0x33, 0x83, 0x27, 0x95,
+		0x02, 0x88, 0x41, 0x97,
+		0x16, 0x93, 0x99, 0x37,
+		0x51, 0x05, 0x82, 0x09,
+		0x74, 0x94, 0x45, 0x92
+	};
+
+	const uint8_t tweak[16] = {
+		0x0f, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00
+	};
+
+	// 37 bytes: 2 whole blocks and a 5-byte partial block
+	const uint8_t expected[37] = {
+		0xde, 0x95, 0x60, 0x09,
+		0xfa, 0x50, 0x6e, 0x69,
+		0xeb, 0xdb, 0x99, 0x7b,
+		0x29, 0xeb, 0x90, 0x3b,
+		0xdb, 0x00, 0x5e, 0x91,
+		0xd6, 0xd5, 0x12, 0xaf,
+		0x1f, 0xf3, 0x10, 0x56,
+		0x6c, 0xb7, 0xec, 0x09,
+		0x41, 0x22, 0x59, 0x3e,
+		0x14
+	};
+
+	uint8_t plaintext[37], output[37];
+	aes_context_t data_ctx, tweak_ctx;
+
+	for (size_t i = 0; i < sizeof(plaintext); ++i)
+		plaintext[i] = (uint8_t)(i * 5 + 1);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&data_ctx, data_key, AES_256));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&tweak_ctx, tweak_key, AES_256));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_xts_encrypt(&data_ctx, &tweak_ctx, tweak, plaintext, sizeof(plaintext), output));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, output, sizeof(output));
+
+	// In place
+	TEST_ASSERT_EQUAL_INT(0, aes_xts_decrypt(&data_ctx, &tweak_ctx, tweak, output, sizeof(output), output));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, output, sizeof(output));
+}
+
+void test_xts_ciphertext_stealing_128(void)
+{
+	// IEEE 1619 XTS-AES-128 vectors 15 to 18: 17 to 20 bytes, one to four stolen bytes
+	const uint8_t data_key[16] = {
+		0xff, 0xfe, 0xfd, 0xfc,
+		0xfb, 0xfa, 0xf9, 0xf8,
+		0xf7, 0xf6, 0xf5, 0xf4,
+		0xf3, 0xf2, 0xf1, 0xf0
+	};
+
+	const uint8_t tweak_key[16] = {
+		0xbf, 0xbe, 0xbd, 0xbc,
+		0xbb, 0xba, 0xb9, 0xb8,
+		0xb7, 0xb6, 0xb5, 0xb4,
+		0xb3, 0xb2, 0xb1, 0xb0
+	};
+
+	// Data unit sequence number 0x9a78563412
+	const uint8_t tweak[16] = {
+		0x9a, 0x78, 0x56, 0x34,
+		0x12, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00
+	};
+
+	const uint8_t expected[4][20] = {
+		{
+			0x6c, 0x16, 0x25, 0xdb,
+			0x46, 0x71, 0x52, 0x2d,
+			0x3d, 0x75, 0x99, 0x60,
+			0x1d, 0xe7, 0xca, 0x09,
+			0xed
+		},
+		{
+			0xd0, 0x69, 0x44, 0x4b,
+			0x7a, 0x7e, 0x0c, 0xab,
+			0x09, 0xe2, 0x44, 0x47,
+			0xd2, 0x4d, 0xeb, 0x1f,
+			0xed, 0xbf
+		},
+		{
+			0xe5, 0xdf, 0x13, 0x51,
+			0xc0, 0x54, 0x4b, 0xa1,
+			0x35, 0x0b, 0x33, 0x63,
+			0xcd, 0x8e, 0xf4, 0xbe,
+			0xed, 0xbf, 0x9d
+		},
+		{
+			0x9d, 0x84, 0xc8, 0x13,
+			0xf7, 0x19, 0xaa, 0x2c,
+			0x7b, 0xe3, 0xf6, 0x61,
+			0x71, 0xc7, 0xc5, 0xc2,
+			0xed, 0xbf, 0x9d, 0xac
+		}
+	};
+
+	uint8_t plaintext[20], output[20];
+	aes_context_t data_ctx, tweak_ctx;
+
+	for (size_t i = 0; i < sizeof(plaintext); ++i)
+		plaintext[i] = (uint8_t)i;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&data_ctx, data_key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&tweak_ctx, tweak_key, AES_128));
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		size_t len = 17 + i;
+
+		TEST_ASSERT_EQUAL_INT(0, aes_xts_encrypt(&data_ctx, &tweak_ctx, tweak, plaintext, len, output));
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(expected[i], output, len);
+
+		TEST_ASSERT_EQUAL_INT(0, aes_xts_decrypt(&data_ctx, &tweak_ctx, tweak, expected[i], len, output));
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(plaintext, output, len);
+	}
+}
+
+void test_xts_sectors_match_units(void)
+{
+	const uint8_t data_key[32] = {
+		0x27, 0x18, 0x28, 0x18,
+		0x28, 0x45, 0x90, 0x45,
+		0x23, 0x53, 0x60, 0x28,
+		0x74, 0x71, 0x35, 0x26,
+		0x62, 0x49, 0x77, 0x57,
+		0x24, 0x70, 0x93, 0x69,
+		0x99, 0x59, 0x57, 0x49,
+		0x66, 0x96, 0x76, 0x27
+	};
+
+	const uint8_t tweak_key[32] = {
+		0x31, 0x41, 0x59, 0x26,
+		0x53, 0x58, 0x97, 0x93,
+		0x23, 0x84, 0x62, 0x64,
+		0x33, 0x83, 0x27, 0x95,
+		0x02, 0x88, 0x41, 0x97,
+		0x16, 0x93, 0x99, 0x37,
+		0x51, 0x05, 0x82, 0x09,
+		0x74, 0x94, 0x45, 0x92
+	};
+
+	// 11 sectors: one batch of 8 tweaks and 3 more; sector numbers cross 2^64
+	const uint64_t first_sector = 0xfffffffffffffffbULL;
+	const size_t sector_sizes[] = {512, 520};
+
+	aes_context_t data_ctx, tweak_ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&data_ctx, data_key, AES_256));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&tweak_ctx, tweak_key, AES_256));
+
+	for (size_t k = 0; k < sizeof(sector_sizes) / sizeof(sector_sizes[0]); ++k)
+	{
+		const size_t sector_size = sector_sizes[k];
+		const size_t len = 11 * sector_size;
+		uint8_t* plaintext = (uint8_t*)malloc(len);
+		uint8_t* expected = (uint8_t*)malloc(len);
+		uint8_t* output = (uint8_t*)malloc(len);
+		TEST_ASSERT_NOT_NULL(plaintext);
+		TEST_ASSERT_NOT_NULL(expected);
+		TEST_ASSERT_NOT_NULL(output);
+
+		for (size_t i = 0; i < len; ++i)
+			plaintext[i] = (uint8_t)(i * 3 + (i >> 9));
+
+		// Sector by sector, with the tweak as a 128-bit little-endian sector number
+		for (size_t s = 0; s < 11; ++s)
+		{
+			uint8_t tweak[AES_XTS_TWEAK_SIZE] = {0};
+			uint64_t sector = first_sector + s;
+
+			for (int i = 0; i < 8; ++i)
+				tweak[i] = (uint8_t)(sector >> (8 * i));
+			tweak[8] = sector < first_sector;
+
+			TEST_ASSERT_EQUAL_INT(0, aes_xts_encrypt(&data_ctx, &tweak_ctx, tweak, plaintext + s * sector_size, sector_size, expected + s * sector_size));
+		}
+
+		TEST_ASSERT_EQUAL_INT(0, aes_xts_encrypt_sectors(&data_ctx, &tweak_ctx, first_sector, sector_size, plaintext, len, output));
+		TEST_ASSERT_EQUAL_MEMORY(expected, output, len);
+
+		TEST_ASSERT_EQUAL_INT(0, aes_xts_decrypt_sectors(&data_ctx, &tweak_ctx, first_sector, sector_size, output, len, output));
+		TEST_ASSERT_EQUAL_MEMORY(plaintext, output, len);
+
+		free(plaintext);
+		free(expected);
+		free(output);
+	}
+}
+
+void test_xts_invalid_arguments(void)
+{
+	const uint8_t data_key[16] = {
+		0x11, 0x11, 0x11, 0x11,
+		0x11, 0x11, 0x11, 0x11,
+		0x11, 0x11, 0x11, 0x11,
+		0x11, 0x11, 0x11, 0x11
+	};
+
+	const uint8_t tweak_key[16] = {
+		0x22, 0x22, 0x22, 0x22,
+		0x22, 0x22, 0x22, 0x22,
+		0x22, 0x22, 0x22, 0x22,
+		0x22, 0x22, 0x22, 0x22
+	};
+
+	const uint8_t tweak[16] = {0};
+	uint8_t buffer[64] = {0};
+	aes_context_t data_ctx, tweak_ctx, other_ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&data_ctx, data_key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&tweak_ctx, tweak_key, AES_128));
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&other_ctx, data_key, AES_128));
+
+	// Identical keys
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_xts_encrypt(&data_ctx, &other_ctx, tweak, buffer, sizeof(buffer), buffer));
+
+	// Data unit shorter than a block
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_xts_encrypt(&data_ctx, &tweak_ctx, tweak, buffer, 15, buffer));
+
+	// Length not a multiple of the sector size, sector smaller than a block
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_xts_encrypt_sectors(&data_ctx, &tweak_ctx, 0, 32, buffer, 48, buffer));
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_xts_encrypt_sectors(&data_ctx, &tweak_ctx, 0, 8, buffer, 64, buffer));
+}
+
+void register_aes_xts_tests(void)
+{
+	RUN_TEST(test_xts_encrypt_128);
+	RUN_TEST(test_xts_ciphertext_stealing_256);
+	RUN_TEST(test_xts_ciphertext_stealing_128);
+	RUN_TEST(test_xts_sectors_match_units);
+	RUN_TEST(test_xts_invalid_arguments);
+}
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "unity/unity.h"
+#include "aes/parallel/aes_parallel.h"
+#include "aes/modes/aes_ecb.h"
+#include "aes/modes/aes_ctr.h"
+#include "aes/modes/aes_cfb.h"
+#include "aes/modes/aes_gcm.h"
+#include <string.h>
+#include <stdlib.h>
+
+// 3 full chunks and a partial one ending with a partial block
+#define PARALLEL_TEST_LEN (3 * AES_PARALLEL_CHUNK_SIZE + 1000 * AES_BLOCK_SIZE + 11)
+
+static const uint8_t parallel_key[24] = {
+	0x8e, 0x73, 0xb0, 0xf7,
+	0xda, 0x0e, 0x64, 0x52,
+	0xc8, 0x10, 0xf3, 0x2b,
+	0x80, 0x90, 0x79, 0xe5,
+	0x62, 0xf8, 0xea, 0xd2,
+	0x52, 0x2c, 0x6b, 0x7b
+};
+
+// The low 32 bits of the counter wrap inside the second chunk
+static const uint8_t parallel_iv[16] = {
+	0xf0, 0xf1, 0xf2, 0xf3,
+	0xf4, 0xf5, 0xf6, 0xf7,
+	0xf8, 0xf9, 0xfa, 0xfb,
+	0xff, 0xff, 0xc0, 0x00
+};
+
+/**
+ * @brief Allocates a buffer filled with a deterministic pattern.
+ */
+static uint8_t* parallel_test_buffer(size_t len)
+{
+	uint8_t* buffer = (uint8_t*)malloc(len);
+	TEST_ASSERT_NOT_NULL(buffer);
+
+	for (size_t i = 0; i < len; ++i)
+		buffer[i] = (uint8_t)(i * 7 + (i >> 11));
+
+	return buffer;
+}
+
+void test_parallel_ctr_matches_serial(void)
+{
+	aes_context_t ctx;
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, parallel_key, AES_192));
+
+	aes_thread_pool_t* pool = aes_thread_pool_create(4);
+	TEST_ASSERT_NOT_NULL(pool);
+
+	uint8_t* input = parallel_test_buffer(PARALLEL_TEST_LEN);
+	uint8_t* expected = (uint8_t*)malloc(PARALLEL_TEST_LEN);
+	uint8_t* output = (uint8_t*)malloc(PARALLEL_TEST_LEN);
+	TEST_ASSERT_NOT_NULL(expected);
+	TEST_ASSERT_NOT_NULL(output);
+
+	aes_ctr_crypt(&ctx, parallel_iv, input, PARALLEL_TEST_LEN, expected);
+
+	aes_ctr_crypt_parallel(pool, &ctx, parallel_iv, input, PARALLEL_TEST_LEN, output);
+	TEST_ASSERT_EQUAL_MEMORY(expected, output, PARALLEL_TEST_LEN);
+
+	// In place, then back to the plaintext without a pool
+	aes_ctr_crypt_parallel(pool, &ctx, parallel_iv, output, PARALLEL_TEST_LEN, output);
+	TEST_ASSERT_EQUAL_MEMORY(input, output, PARALLEL_TEST_LEN);
+
+	aes_ctr_crypt_parallel(NULL, &ctx, parallel_iv, input, PARALLEL_TEST_LEN, output);
+	TEST_ASSERT_EQUAL_MEMORY(expected, output, PARALLEL_TEST_LEN);
+
+	free(input);
+	free(expected);
+	free(output);
+	aes_thread_pool_destroy(pool);
+}
+
+void test_parallel_ecb_matches_serial(void)
+{
+	const size_t len = PARALLEL_TEST_LEN - PARALLEL_TEST_LEN % AES_BLOCK_SIZE;
+	aes_context_t ctx;
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, parallel_key, AES_192));
+
+	aes_thread_pool_t* pool = aes_thread_pool_create(3);
+	TEST_ASSERT_NOT_NULL(pool);
+
+	uint8_t* input = parallel_test_buffer(len);
+	uint8_t* expected = (uint8_t*)malloc(len);
+	uint8_t* output = (uint8_t*)malloc(len);
+	TEST_ASSERT_NOT_NULL(expected);
+	TEST_ASSERT_NOT_NULL(output);
+
+	aes_ecb_encrypt(&ctx, input, len, expected);
+	aes_ecb_encrypt_parallel(pool, &ctx, input, len, output);
+	TEST_ASSERT_EQUAL_MEMORY(expected, output, len);
+
+	aes_ecb_decrypt_parallel(pool, &ctx, output, len, output);
+	TEST_ASSERT_EQUAL_MEMORY(input, output, len);
+
+	free(input);
+	free(expected);
+	free(output);
+	aes_thread_pool_destroy(pool);
+}
+
+void test_parallel_cfb_decrypt_matches_serial(void)
+{
+	aes_context_t ctx;
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, parallel_key, AES_192));
+
+	aes_thread_pool_t* pool = aes_thread_pool_create(4);
+	TEST_ASSERT_NOT_NULL(pool);
+
+	uint8_t* plaintext = parallel_test_buffer(PARALLEL_TEST_LEN);
+	uint8_t* ciphertext = (uint8_t*)malloc(PARALLEL_TEST_LEN);
+	uint8_t* output = (uint8_t*)malloc(PARALLEL_TEST_LEN);
+	TEST_ASSERT_NOT_NULL(ciphertext);
+	TEST_ASSERT_NOT_NULL(output);
+
+	aes_cfb_encrypt(&ctx, parallel_iv, plaintext, PARALLEL_TEST_LEN, ciphertext);
+
+	aes_cfb_decrypt_parallel(pool, &ctx, parallel_iv, ciphertext, PARALLEL_TEST_LEN, output);
+	TEST_ASSERT_EQUAL_MEMORY(plaintext, output, PARALLEL_TEST_LEN);
+
+	// In place: chunk boundaries must use the original ciphertext
+	memcpy(output, ciphertext, PARALLEL_TEST_LEN);
+	aes_cfb_decrypt_parallel(pool, &ctx, parallel_iv, output, PARALLEL_TEST_LEN, output);
+	TEST_ASSERT_EQUAL_MEMORY(plaintext, output, PARALLEL_TEST_LEN);
+
+	free(plaintext);
+	free(ciphertext);
+	free(output);
+	aes_thread_pool_destroy(pool);
+}
+
+void test_parallel_gcm_matches_serial(void)
+{
+	const uint8_t aad[20] = {
+		0xfe, 0xed, 0xfa, 0xce,
+		0xde, 0xad, 0xbe, 0xef,
+		0xfe, 0xed, 0xfa, 0xce,
+		0xde, 0xad, 0xbe, 0xef,
+		0xab, 0xad, 0xda, 0xd2
+	};
+
+	uint8_t expected_tag[16], tag[16];
+	aes_ghash_key_t hkey;
+	aes_context_t ctx;
+
+	TEST_ASSERT_EQUAL_INT(0, aes_context_init(&ctx, parallel_key, AES_192));
+	TEST_ASSERT_EQUAL_INT(0, aes_ghash_key_init(&hkey, &ctx));
+
+	aes_thread_pool_t* pool = aes_thread_pool_create(4);
+	TEST_ASSERT_NOT_NULL(pool);
+
+	uint8_t* plaintext = parallel_test_buffer(PARALLEL_TEST_LEN);
+	uint8_t* expected = (uint8_t*)malloc(PARALLEL_TEST_LEN);
+	uint8_t* output = (uint8_t*)malloc(PARALLEL_TEST_LEN);
+	TEST_ASSERT_NOT_NULL(expected);
+	TEST_ASSERT_NOT_NULL(output);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_encrypt(&ctx, &hkey, parallel_iv, AES_GCM_IV_SIZE, aad, sizeof(aad), plaintext, PARALLEL_TEST_LEN, expected, expected_tag, 16));
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_encrypt_parallel(pool, &ctx, &hkey, parallel_iv, AES_GCM_IV_SIZE, aad, sizeof(aad), plaintext, PARALLEL_TEST_LEN, output, tag, 16));
+	TEST_ASSERT_EQUAL_MEMORY(expected, output, PARALLEL_TEST_LEN);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, 16);
+
+	// In-place decryption, then the same with a 16-byte IV and without a pool
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_decrypt_parallel(pool, &ctx, &hkey, parallel_iv, AES_GCM_IV_SIZE, aad, sizeof(aad), output, PARALLEL_TEST_LEN, output, tag, 16));
+	TEST_ASSERT_EQUAL_MEMORY(plaintext, output, PARALLEL_TEST_LEN);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_encrypt(&ctx, NULL, parallel_iv, sizeof(parallel_iv), NULL, 0, plaintext, PARALLEL_TEST_LEN, expected, expected_tag, 16));
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_encrypt_parallel(pool, &ctx, NULL, parallel_iv, sizeof(parallel_iv), NULL, 0, plaintext, PARALLEL_TEST_LEN, output, tag, 16));
+	TEST_ASSERT_EQUAL_MEMORY(expected, output, PARALLEL_TEST_LEN);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(expected_tag, tag, 16);
+
+	TEST_ASSERT_EQUAL_INT(0, aes_gcm_decrypt_parallel(NULL, &ctx, NULL, parallel_iv, sizeof(parallel_iv), NULL, 0, expected, PARALLEL_TEST_LEN, output, tag, 16));
+	TEST_ASSERT_EQUAL_MEMORY(plaintext, output, PARALLEL_TEST_LEN);
+
+	// A modified ciphertext in the last chunk is rejected and the plaintext wiped
+	expected[PARALLEL_TEST_LEN - 1] ^= 0x01;
+	TEST_ASSERT_NOT_EQUAL_INT(0, aes_gcm_decrypt_parallel(pool, &ctx, &hkey, parallel_iv, sizeof(parallel_iv), NULL, 0, expected, PARALLEL_TEST_LEN, output, tag, 16));
+	TEST_ASSERT_EACH_EQUAL_UINT8(0, output, PARALLEL_TEST_LEN);
+
+	free(plaintext);
+	free(expected);
+	free(output);
+	aes_thread_pool_destroy(pool);
+}
+
+void register_aes_parallel_tests(void)
+{
+	RUN_TEST(test_parallel_ctr_matches_serial);
+	RUN_TEST(test_parallel_ecb_matches_serial);
+	RUN_TEST(test_parallel_cfb_decrypt_matches_serial);
+	RUN_TEST(test_parallel_gcm_matches_serial);
+}
\ No newline at end of file
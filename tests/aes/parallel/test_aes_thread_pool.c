@@ -0,0 +1,61 @@
+#include "unity/unity.h"
+#include "aes/parallel/aes_thread_pool.h"
+#include <string.h>
+
+#define POOL_TEST_TASKS 257
+
+/**
+ * @brief Task recording how many times each index ran.
+ */
+static void count_task(void* arg, size_t task_index)
+{
+	unsigned* counts = (unsigned*)arg;
+	counts[task_index]++;
+}
+
+void test_thread_pool_create_invalid(void)
+{
+	TEST_ASSERT_NULL(aes_thread_pool_create(0));
+	TEST_ASSERT_EQUAL_size_t(1, aes_thread_pool_size(NULL));
+	aes_thread_pool_destroy(NULL);
+}
+
+void test_thread_pool_runs_each_task_once(void)
+{
+	aes_thread_pool_t* pool = aes_thread_pool_create(4);
+	TEST_ASSERT_NOT_NULL(pool);
+	TEST_ASSERT_EQUAL_size_t(4, aes_thread_pool_size(pool));
+
+	unsigned counts[POOL_TEST_TASKS];
+
+	// The pool is reused across submissions
+	for (int round = 1; round <= 3; ++round)
+	{
+		memset(counts, 0, sizeof(counts));
+		aes_thread_pool_run(pool, count_task, counts, POOL_TEST_TASKS);
+		TEST_ASSERT_EACH_EQUAL_UINT(1, counts, POOL_TEST_TASKS);
+	}
+
+	// Fewer tasks than threads
+	memset(counts, 0, sizeof(counts));
+	aes_thread_pool_run(pool, count_task, counts, 2);
+	TEST_ASSERT_EACH_EQUAL_UINT(1, counts, 2);
+	TEST_ASSERT_EACH_EQUAL_UINT(0, counts + 2, POOL_TEST_TASKS - 2);
+
+	aes_thread_pool_destroy(pool);
+}
+
+void test_thread_pool_null_runs_on_caller(void)
+{
+	unsigned counts[POOL_TEST_TASKS] = {0};
+
+	aes_thread_pool_run(NULL, count_task, counts, POOL_TEST_TASKS);
+	TEST_ASSERT_EACH_EQUAL_UINT(1, counts, POOL_TEST_TASKS);
+}
+
+void register_aes_thread_pool_tests(void)
+{
+	RUN_TEST(test_thread_pool_create_invalid);
+	RUN_TEST(test_thread_pool_runs_each_task_once);
+	RUN_TEST(test_thread_pool_null_runs_on_caller);
+}
\ No newline at end of file
@@ -5,14 +5,33 @@ void tearDown(void) {}
 
 extern void register_aes_key_expansion_tests(void);
 extern void register_aes_context_tests(void);
+extern void register_aes_context_arena_tests(void);
+extern void register_aes_key_cache_tests(void);
+extern void register_aes_key_store_tests(void);
 extern void register_aes_encrypt_tests(void);
 extern void register_aes_decrypt_tests(void);
+extern void register_aes_avx2_tests(void);
+extern void register_aes_vaes_tests(void);
+extern void register_aes_cpu_tests(void);
+extern void register_aes_dispatch_tests(void);
 extern void register_aes_padding_tests(void);
 extern void register_aes_ecb_tests(void);
 extern void register_aes_cbc_tests(void);
 extern void register_aes_cfb_tests(void);
 extern void register_aes_ofb_tests(void);
 extern void register_aes_ctr_tests(void);
+extern void register_aes_gcm_tests(void);
+extern void register_aes_gcm_siv_tests(void);
+extern void register_aes_xts_tests(void);
+extern void register_aes_hctr2_tests(void);
+extern void register_aes_ccm_tests(void);
+extern void register_aes_ocb_tests(void);
+extern void register_aes_siv_tests(void);
+extern void register_aes_ghash_tests(void);
+extern void register_aes_cmac_tests(void);
+extern void register_aes_polyval_tests(void);
+extern void register_aes_thread_pool_tests(void);
+extern void register_aes_parallel_tests(void);
 extern void register_utils_tests(void);
 
 int main(void)
@@ -21,14 +40,33 @@ int main(void)
 
 	register_aes_key_expansion_tests();
 	register_aes_context_tests();
+	register_aes_context_arena_tests();
+	register_aes_key_cache_tests();
+	register_aes_key_store_tests();
 	register_aes_encrypt_tests();
 	register_aes_decrypt_tests();
+	register_aes_avx2_tests();
+	register_aes_vaes_tests();
+	register_aes_cpu_tests();
+	register_aes_dispatch_tests();
 	register_aes_padding_tests();
 	register_aes_ecb_tests();
 	register_aes_cbc_tests();
 	register_aes_cfb_tests();
 	register_aes_ofb_tests();
 	register_aes_ctr_tests();
+	register_aes_gcm_tests();
+	register_aes_gcm_siv_tests();
+	register_aes_xts_tests();
+	register_aes_hctr2_tests();
+	register_aes_ccm_tests();
+	register_aes_ocb_tests();
+	register_aes_siv_tests();
+	register_aes_ghash_tests();
+	register_aes_cmac_tests();
+	register_aes_polyval_tests();
+	register_aes_thread_pool_tests();
+	register_aes_parallel_tests();
 	register_utils_tests();
 
 	return UNITY_END();